@@ -0,0 +1,604 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include <openvino/openvino.hpp>
+
+#include <adapters/batching_adapter.h>
+#include <adapters/openvino_adapter.h>
+#include <models/anomaly_model.h>
+#include <models/classification_model.h>
+#include <models/detection_model.h>
+#include <models/input_data.h>
+#include <models/instance_segmentation.h>
+#include <models/result_serialization.h>
+#include <models/results.h>
+#include <models/segmentation_model.h>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using json = nlohmann::json;
+
+struct Args {
+    std::string model;
+    std::string type;
+    std::string input;
+    std::string output;
+    std::string format = "jsonl";
+    std::string device = "CPU";
+    size_t nireq = 0;
+    size_t batch = 1;
+    size_t readers = std::max(1u, std::thread::hardware_concurrency() / 2);
+    bool resume = false;
+    ov::AnyMap configuration;
+};
+
+void printHelp(const char* programName) {
+    std::cout << "Usage: " << programName << " -m <model.xml> -at <model type> -i <images dir or manifest> -o <output> [options]\n"
+              << "  -at <type>        ClassificationModel, DetectionModel, SegmentationModel, MaskRCNNModel or AnomalyDetection\n"
+              << "  -i <path>         directory searched recursively for images, or a text file with an image path per line\n"
+              << "  -o <path>         output file, <path>.checkpoint keeps the progress\n"
+              << "  -format <format>  jsonl (default) or bin\n"
+              << "  -d <device>       inference device, CPU by default\n"
+              << "  -nireq <n>        number of inferences in flight, optimal for the device if not set\n"
+              << "  -batch <n>        stack up to n images of one resolution into an inference, 1 by default\n"
+              << "  -readers <n>      number of threads decoding images, half of the cores by default\n"
+              << "  -resume           continue from the checkpoint instead of starting over\n"
+              << "  -c <key=value>    model configuration value passed to create_model(), can be repeated\n";
+}
+
+Args parseArgs(int argc, char* argv[]) {
+    Args args;
+    for (int i = 1; i < argc; ++i) {
+        const std::string key = argv[i];
+        if (key == "-h") {
+            printHelp(argv[0]);
+            exit(0);
+        }
+        if (key == "-resume") {
+            args.resume = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            throw std::runtime_error("Missing value for " + key);
+        }
+        const std::string value = argv[++i];
+        if (key == "-m") {
+            args.model = value;
+        } else if (key == "-at") {
+            args.type = value;
+        } else if (key == "-i") {
+            args.input = value;
+        } else if (key == "-o") {
+            args.output = value;
+        } else if (key == "-format") {
+            args.format = value;
+        } else if (key == "-d") {
+            args.device = value;
+        } else if (key == "-nireq") {
+            args.nireq = std::stoul(value);
+        } else if (key == "-batch") {
+            args.batch = std::max<size_t>(1, std::stoul(value));
+        } else if (key == "-readers") {
+            args.readers = std::max<size_t>(1, std::stoul(value));
+        } else if (key == "-c") {
+            size_t pos = value.find('=');
+            if (pos == std::string::npos) {
+                throw std::runtime_error("Configuration value must be provided as key=value, got: " + value);
+            }
+            args.configuration[value.substr(0, pos)] = value.substr(pos + 1);
+        } else {
+            throw std::runtime_error("Unknown argument: " + key);
+        }
+    }
+    if (args.model.empty() || args.type.empty() || args.input.empty() || args.output.empty()) {
+        printHelp(argv[0]);
+        throw std::runtime_error("-m, -at, -i and -o are required");
+    }
+    if (args.format != "jsonl" && args.format != "bin") {
+        throw std::runtime_error("Unknown format: " + args.format);
+    }
+    return args;
+}
+
+std::shared_ptr<ModelBase> createWrapper(const std::string& type, const std::string& path, const ov::AnyMap& configuration) {
+    constexpr bool preload = false;
+    if (type == "ClassificationModel") {
+        return ClassificationModel::create_model(path, configuration, preload);
+    } else if (type == "DetectionModel") {
+        return DetectionModel::create_model(path, configuration, "", preload);
+    } else if (type == "SegmentationModel") {
+        return SegmentationModel::create_model(path, configuration, preload);
+    } else if (type == "MaskRCNNModel") {
+        return MaskRCNNModel::create_model(path, configuration, preload);
+    } else if (type == "AnomalyDetection") {
+        return AnomalyModel::create_model(path, configuration, preload);
+    }
+    throw std::runtime_error("Unknown model type: " + type);
+}
+
+std::shared_ptr<ModelBase> createWrapper(const std::string& type, std::shared_ptr<InferenceAdapter>& adapter) {
+    if (type == "ClassificationModel") {
+        return ClassificationModel::create_model(adapter);
+    } else if (type == "DetectionModel") {
+        return DetectionModel::create_model(adapter);
+    } else if (type == "SegmentationModel") {
+        return SegmentationModel::create_model(adapter);
+    } else if (type == "MaskRCNNModel") {
+        return MaskRCNNModel::create_model(adapter);
+    } else if (type == "AnomalyDetection") {
+        return AnomalyModel::create_model(adapter);
+    }
+    throw std::runtime_error("Unknown model type: " + type);
+}
+
+struct Image {
+    std::string key;  // Identifies the image in the output and in the checkpoint
+    std::filesystem::path path;
+};
+
+// Images of a directory sorted by path, or the lines of a manifest with paths relative to the manifest's directory
+std::vector<Image> listImages(const std::filesystem::path& input) {
+    std::vector<Image> images;
+    if (std::filesystem::is_directory(input)) {
+        for (const auto& entry : std::filesystem::recursive_directory_iterator{input}) {
+            std::string ext = entry.path().extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c){ return static_cast<char>(std::tolower(c)); });
+            if (entry.is_regular_file() && (ext == ".jpg" || ext == ".jpeg" || ext == ".png" || ext == ".bmp")) {
+                images.push_back({std::filesystem::relative(entry.path(), input).generic_string(), entry.path()});
+            }
+        }
+        std::sort(images.begin(), images.end(), [](const Image& a, const Image& b) { return a.key < b.key; });
+    } else {
+        std::ifstream manifest{input};
+        if (!manifest) {
+            throw std::runtime_error("Failed to open " + input.string());
+        }
+        std::string line;
+        while (std::getline(manifest, line)) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (line.empty() || line.front() == '#') {
+                continue;
+            }
+            std::filesystem::path path{line};
+            images.push_back({line, path.is_absolute() ? path : input.parent_path() / path});
+        }
+    }
+    return images;
+}
+
+// Every line is "<output size after the record>\t<key>\n". The writer appends lines once the records are flushed, so
+// the output is cut to the last offset on resume, which drops a record torn by a crash and the ones not checkpointed
+struct Checkpoint {
+    std::unordered_set<std::string> done;
+    uint64_t outputSize = 0;
+};
+
+Checkpoint readCheckpoint(const std::string& path) {
+    Checkpoint checkpoint;
+    std::ifstream file{path, std::ios::binary};
+    std::string content{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    size_t start = 0;
+    for (size_t end = content.find('\n'); end != std::string::npos; start = end + 1, end = content.find('\n', start)) {
+        size_t tab = content.find('\t', start);
+        if (tab == std::string::npos || tab > end) {
+            throw std::runtime_error("Malformed checkpoint " + path);
+        }
+        checkpoint.outputSize = std::max<uint64_t>(checkpoint.outputSize, std::stoull(content.substr(start, tab - start)));
+        checkpoint.done.insert(content.substr(tab + 1, end - tab - 1));
+    }
+    // A line without '\n' was torn by a crash
+    return checkpoint;
+}
+
+// Readers and the writer sleep on a condition variable while the queue is full or empty, unlike pipelines/bounded_queue.h
+// whose callers poll
+template <class T>
+class BlockingQueue {
+public:
+    explicit BlockingQueue(size_t capacity) : capacity(capacity) {}
+
+    /// Blocks while the queue is full, returns false if it is closed
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock{mutex};
+        notFull.wait(lock, [this] { return items.size() < capacity || closed; });
+        if (closed) {
+            return false;
+        }
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    /// Returns false once the queue is closed and empty or if nothing comes within timeout
+    bool pop(T& item, Clock::duration timeout = Clock::duration::max()) {
+        std::unique_lock<std::mutex> lock{mutex};
+        auto ready = [this] { return !items.empty() || closed; };
+        if (timeout == Clock::duration::max()) {
+            notEmpty.wait(lock, ready);
+        } else if (!notEmpty.wait_for(lock, timeout, ready)) {
+            return false;
+        }
+        if (items.empty()) {
+            return false;
+        }
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock{mutex};
+        closed = true;
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+
+    bool isClosed() {
+        std::lock_guard<std::mutex> lock{mutex};
+        return closed;
+    }
+
+private:
+    const size_t capacity;
+    std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::deque<T> items;
+    bool closed = false;
+};
+
+struct Frame {
+    std::string key;
+    cv::Mat image;
+};
+
+struct Record {
+    std::string key;
+    std::string bytes;
+};
+
+json toJson(const DetectedObject& object) {
+    return {{"box", {object.x, object.y, object.width, object.height}},
+            {"label_id", object.labelID},
+            {"label", std::string(object.label)},
+            {"confidence", object.confidence}};
+}
+
+// Labels, boxes and scores. Masks, maps and tensors are written only by the binary format
+json toJson(const ResultBase& result, ModelBase& model) {
+    json encoded = json::object();
+    if (auto classification = dynamic_cast<const ClassificationResult*>(&result)) {
+        encoded["top_labels"] = json::array();
+        for (const ClassificationResult::Classification& label : classification->topLabels) {
+            encoded["top_labels"].push_back({{"id", label.id}, {"label", std::string(label.label)}, {"score", label.score}});
+        }
+    } else if (auto detection = dynamic_cast<const DetectionResult*>(&result)) {
+        encoded["objects"] = json::array();
+        for (const DetectedObject& object : detection->objects) {
+            encoded["objects"].push_back(toJson(object));
+        }
+    } else if (auto segmentation = dynamic_cast<const InstanceSegmentationResult*>(&result)) {
+        encoded["objects"] = json::array();
+        for (const SegmentedObject& object : segmentation->segmentedObjects) {
+            encoded["objects"].push_back(toJson(object));
+        }
+    } else if (auto anomaly = dynamic_cast<const AnomalyResult*>(&result)) {
+        encoded["pred_label"] = anomaly->pred_label;
+        encoded["pred_score"] = anomaly->pred_score;
+        encoded["pred_boxes"] = json::array();
+        for (const cv::Rect& box : anomaly->pred_boxes) {
+            encoded["pred_boxes"].push_back({box.x, box.y, box.width, box.height});
+        }
+    } else if (auto soft = dynamic_cast<const ImageResultWithSoftPrediction*>(&result)) {
+        // Contours need the soft prediction, without it only the binary format has the result
+        encoded["contours"] = json::array();
+        for (const Contour& contour : static_cast<SegmentationModel&>(model).getContours(*soft)) {
+            json points = json::array();
+            for (const cv::Point& point : contour.shape) {
+                points.push_back({point.x, point.y});
+            }
+            encoded["contours"].push_back({{"label", std::string(contour.label)}, {"probability", contour.probability},
+                                           {"points", std::move(points)}});
+        }
+    }
+    return encoded;
+}
+
+// "<key>\t<json>\n" would be ambiguous for keys with tabs, so the key is a field of the line
+std::string encodeJsonl(const std::string& key, const ResultBase& result, ModelBase& model) {
+    json line = toJson(result, model);
+    line["path"] = key;
+    return line.dump(-1, ' ', false, json::error_handler_t::replace) + '\n';
+}
+
+// uint32 key size, key, uint64 payload size, payload of result_serialization::serialize()
+std::string encodeBinary(const std::string& key, const ResultBase& result) {
+    thread_local std::vector<uint8_t> payload;
+    result_serialization::serialize(result, payload);
+    uint32_t keySize = static_cast<uint32_t>(key.size());
+    uint64_t payloadSize = payload.size();
+    std::string bytes;
+    bytes.reserve(sizeof(keySize) + key.size() + sizeof(payloadSize) + payload.size());
+    bytes.append(reinterpret_cast<const char*>(&keySize), sizeof(keySize));
+    bytes.append(key);
+    bytes.append(reinterpret_cast<const char*>(&payloadSize), sizeof(payloadSize));
+    bytes.append(reinterpret_cast<const char*>(payload.data()), payload.size());
+    return bytes;
+}
+
+struct Progress {
+    size_t total = 0;
+    std::atomic<size_t> written{0};
+    std::atomic<size_t> failed{0};
+};
+
+// Writes records through a large buffer, flushes them together with the checkpoint every second and reports progress
+void writeRecords(BlockingQueue<Record>& records, const Args& args, uint64_t offset, Progress& progress) {
+    std::vector<char> buffer(4 << 20);
+    std::ofstream output;
+    output.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    output.open(args.output, std::ios::binary | std::ios::app);
+    std::ofstream checkpoint{args.output + ".checkpoint", std::ios::binary | std::ios::app};
+    if (!output || !checkpoint) {
+        throw std::runtime_error("Failed to open " + args.output);
+    }
+    std::string pending;
+    size_t pendingCount = 0;
+    const auto start = Clock::now();
+    auto lastFlush = start;
+    size_t lastWritten = 0;
+    auto flush = [&] {
+        output.flush();
+        if (!output) {
+            throw std::runtime_error("Failed to write " + args.output);
+        }
+        checkpoint << pending;
+        checkpoint.flush();
+        if (!checkpoint) {
+            throw std::runtime_error("Failed to write " + args.output + ".checkpoint");
+        }
+        progress.written += pendingCount;
+        pending.clear();
+        pendingCount = 0;
+    };
+    for (;;) {
+        Record record;
+        bool popped = records.pop(record, std::chrono::milliseconds(100));
+        if (popped) {
+            output.write(record.bytes.data(), static_cast<std::streamsize>(record.bytes.size()));
+            offset += record.bytes.size();
+            pending += std::to_string(offset) + '\t' + record.key + '\n';
+            ++pendingCount;
+        } else if (records.isClosed()) {
+            flush();
+            break;
+        }
+        auto now = Clock::now();
+        if (now - lastFlush >= std::chrono::seconds(1)) {
+            flush();
+            size_t written = progress.written;
+            double fps = (written - lastWritten) / std::chrono::duration<double>(now - lastFlush).count();
+            size_t left = progress.total - std::min(progress.total, written + progress.failed);
+            std::cerr << "\r" << written << '/' << progress.total << " written, " << progress.failed << " failed, "
+                      << std::fixed << std::setprecision(1) << fps << " FPS, ETA "
+                      << (fps > 0 ? static_cast<size_t>(left / fps) : 0) << " s   " << std::flush;
+            lastFlush = now;
+            lastWritten = written;
+        }
+    }
+    std::cerr << '\n';
+}
+}
+
+int main(int argc, char* argv[]) try {
+    const Args args = parseArgs(argc, argv);
+    const std::string checkpointPath = args.output + ".checkpoint";
+
+    Checkpoint checkpoint;
+    if (args.resume && std::filesystem::exists(checkpointPath)) {
+        checkpoint = readCheckpoint(checkpointPath);
+        uint64_t outputSize = std::filesystem::exists(args.output) ? std::filesystem::file_size(args.output) : 0;
+        if (outputSize < checkpoint.outputSize) {
+            throw std::runtime_error(args.output + " is shorter than its checkpoint");
+        }
+        if (outputSize > checkpoint.outputSize) {
+            std::filesystem::resize_file(args.output, checkpoint.outputSize);
+        }
+    } else {
+        std::ofstream{args.output, std::ios::binary | std::ios::trunc};
+        std::ofstream{checkpointPath, std::ios::binary | std::ios::trunc};
+    }
+    std::vector<Image> images = listImages(args.input);
+    images.erase(std::remove_if(images.begin(), images.end(), [&](const Image& image) {
+        return checkpoint.done.count(image.key) != 0;
+    }), images.end());
+    std::cout << "Images: " << images.size() << " to process, " << checkpoint.done.size() << " done before\n";
+
+    // Prepare the model with pre/postprocessing embedded and compile it for throughput like the benchmark does
+    ov::Core core;
+    ModelBase::configureCore(core, args.configuration);
+    std::shared_ptr<ModelBase> prepared = createWrapper(args.type, args.model, args.configuration);
+    ov::AnyMap compilationConfig = prepared->getCompilationConfig();
+    compilationConfig.insert(ov::hint::performance_mode(ov::hint::PerformanceMode::THROUGHPUT));
+    std::shared_ptr<InferenceAdapter> adapter;
+    size_t optimalRequests;
+    if (args.batch > 1) {
+        // Frames wait in the adapter for others of the same resolution, a full batch is inferred at once
+        auto batchingAdapter = std::make_shared<BatchingInferenceAdapter>(args.batch);
+        batchingAdapter->loadModel(prepared->getModel(), core, args.device, compilationConfig);
+        optimalRequests = batchingAdapter->getOptimalNumberOfInferRequests();
+        adapter = batchingAdapter;
+    } else {
+        auto openvinoAdapter = std::make_shared<OpenVINOInferenceAdapter>();
+        openvinoAdapter->loadModel(prepared->getModel(), core, args.device, compilationConfig);
+        optimalRequests = openvinoAdapter->getOptimalNumberOfInferRequests();
+        adapter = openvinoAdapter;
+    }
+    std::shared_ptr<ModelBase> model = createWrapper(args.type, adapter);
+    const size_t nireq = args.nireq ? args.nireq : optimalRequests;
+    // Every infer request needs a batch of frames
+    const size_t maxInflight = nireq * args.batch;
+    std::cout << "Device: " << args.device << ", infer requests: " << nireq << ", batch: " << args.batch
+              << ", readers: " << args.readers << '\n';
+
+    Progress progress;
+    progress.total = images.size();
+    // Decoded images wait for a free request, a few of them per request keep the device busy without holding the
+    // whole dataset in memory
+    BlockingQueue<Frame> frames{2 * maxInflight};
+    BlockingQueue<Record> records{16 * maxInflight};
+
+    std::exception_ptr writerError;
+    std::thread writer{[&] {
+        try {
+            writeRecords(records, args, checkpoint.outputSize, progress);
+        } catch (...) {
+            writerError = std::current_exception();
+            // Unblocks the callbacks and stops the pipeline
+            records.close();
+            frames.close();
+        }
+    }};
+
+    std::atomic<size_t> nextImage{0};
+    std::atomic<size_t> activeReaders{args.readers};
+    std::vector<std::thread> readers;
+    for (size_t i = 0; i < args.readers; ++i) {
+        readers.emplace_back([&] {
+            for (size_t index = nextImage++; index < images.size(); index = nextImage++) {
+                cv::Mat image = cv::imread(images[index].path.string());
+                if (!image.data) {
+                    std::cerr << "\nFailed to read " << images[index].path.string() << '\n';
+                    ++progress.failed;
+                } else if (!frames.push({images[index].key, image})) {
+                    break;
+                }
+            }
+            if (--activeReaders == 0) {
+                frames.close();
+            }
+        });
+    }
+
+    const auto start = Clock::now();
+    std::mutex inflightMutex;
+    std::condition_variable inflightChanged;
+    size_t inflight = 0;
+    auto finish = [&] {
+        std::lock_guard<std::mutex> lock{inflightMutex};
+        --inflight;
+        inflightChanged.notify_all();
+    };
+    auto fail = [&](const std::string& key, std::exception_ptr error) {
+        try {
+            std::rethrow_exception(error);
+        } catch (const std::exception& e) {
+            std::cerr << "\nFailed to process " << key << ": " << e.what() << '\n';
+        } catch (...) {
+            std::cerr << "\nFailed to process " << key << '\n';
+        }
+        ++progress.failed;
+    };
+    Frame frame;
+    while (frames.pop(frame)) {
+        {
+            std::unique_lock<std::mutex> lock{inflightMutex};
+            inflightChanged.wait(lock, [&] { return inflight < maxInflight; });
+            ++inflight;
+        }
+        // The callback keeps the image alive, preprocessing may wrap it into the input tensor
+        std::string key = frame.key;
+        cv::Mat image = frame.image;
+        try {
+            model->inferAsync(ImageInputData(image), [&, key, image](std::unique_ptr<ResultBase> result, std::exception_ptr error) {
+                if (!error) {
+                    try {
+                        std::string bytes = args.format == "jsonl" ? encodeJsonl(key, *result, *model) : encodeBinary(key, *result);
+                        // The queue is closed only if the writer failed, the record would be lost
+                        if (!records.push({key, std::move(bytes)})) {
+                            throw std::runtime_error("the writer has stopped");
+                        }
+                    } catch (...) {
+                        error = std::current_exception();
+                    }
+                }
+                if (error) {
+                    fail(key, error);
+                }
+                finish();
+            });
+        } catch (...) {
+            fail(key, std::current_exception());
+            finish();
+        }
+    }
+    {
+        std::unique_lock<std::mutex> lock{inflightMutex};
+        inflightChanged.wait(lock, [&] { return inflight == 0; });
+    }
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    records.close();
+    writer.join();
+    if (writerError) {
+        std::rethrow_exception(writerError);
+    }
+
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::cout << "Written: " << progress.written << ", failed: " << progress.failed << '\n'
+              << "Duration: " << std::fixed << std::setprecision(2) << seconds << " s\n"
+              << "Throughput: " << progress.written / std::max(seconds, 1e-9) << " FPS\n";
+    return progress.failed == 0 ? 0 : 2;
+} catch (const std::exception& error) {
+    std::cerr << error.what() << '\n';
+    return 1;
+} catch (...) {
+    std::cerr << "Non-exception object thrown\n";
+    return 1;
+}
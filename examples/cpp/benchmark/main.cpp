@@ -0,0 +1,530 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include <openvino/openvino.hpp>
+
+#include <adapters/openvino_adapter.h>
+#include <models/anomaly_model.h>
+#include <models/classification_model.h>
+#include <models/compilation_tuner.h>
+#include <models/detection_model.h>
+#include <models/input_data.h>
+#include <models/instance_segmentation.h>
+#include <models/results.h>
+#include <models/segmentation_model.h>
+#include <tilers/detection.h>
+#include <tilers/instance_segmentation.h>
+#include <utils/memory_usage.hpp>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using Ms = std::chrono::duration<double, std::milli>;
+
+// Accumulates the time spent in the plugin for the modes driven by a wrapper or a tiler
+class BenchmarkAdapter : public OpenVINOInferenceAdapter {
+public:
+    using OpenVINOInferenceAdapter::infer;
+
+    InferenceOutput infer(const InferenceInput& input) override {
+        auto start = Clock::now();
+        InferenceOutput output = OpenVINOInferenceAdapter::infer(input);
+        inferenceTime += Clock::now() - start;
+        return output;
+    }
+
+    Clock::duration inferenceTime = Clock::duration::zero();
+};
+
+struct Args {
+    std::string model;
+    std::string type;
+    std::string images;
+    std::string device = "CPU";
+    std::string mode = "sync";
+    std::string tiler;
+    std::string tune;
+    size_t nstreams = 0;
+    size_t nireq = 0;
+    double duration = 10.0;
+    ov::AnyMap configuration;
+};
+
+void printHelp(const char* programName) {
+    std::cout << "Usage: " << programName << " -m <model.xml> -at <model type> -i <images dir> [options]\n"
+              << "  -at <type>        ClassificationModel, DetectionModel, SegmentationModel, MaskRCNNModel or AnomalyDetection\n"
+              << "  -d <device>       inference device, CPU by default\n"
+              << "  -mode <mode>      sync (default), async or batch\n"
+              << "  -nstreams <n>     number of streams for the compiled model, plugin default if not set\n"
+              << "  -nireq <n>        number of infer requests for async and batch modes, optimal for the device if not set\n"
+              << "  -t <seconds>      benchmark duration, 10 by default\n"
+              << "  -tiler <tiler>    DetectionTiler or InstanceSegmentationTiler, sync mode only\n"
+              << "  -tune <out.xml>   sweep streams and threads, save the model with the fastest configuration for the mode and exit\n"
+              << "  -c <key=value>    model configuration value passed to create_model(), can be repeated\n";
+}
+
+Args parseArgs(int argc, char* argv[]) {
+    Args args;
+    for (int i = 1; i < argc; ++i) {
+        const std::string key = argv[i];
+        if (key == "-h") {
+            printHelp(argv[0]);
+            exit(0);
+        }
+        if (i + 1 >= argc) {
+            throw std::runtime_error("Missing value for " + key);
+        }
+        const std::string value = argv[++i];
+        if (key == "-m") {
+            args.model = value;
+        } else if (key == "-at") {
+            args.type = value;
+        } else if (key == "-i") {
+            args.images = value;
+        } else if (key == "-d") {
+            args.device = value;
+        } else if (key == "-mode") {
+            args.mode = value;
+        } else if (key == "-nstreams") {
+            args.nstreams = std::stoul(value);
+        } else if (key == "-nireq") {
+            args.nireq = std::stoul(value);
+        } else if (key == "-t") {
+            args.duration = std::stod(value);
+        } else if (key == "-tiler") {
+            args.tiler = value;
+        } else if (key == "-tune") {
+            args.tune = value;
+        } else if (key == "-c") {
+            size_t pos = value.find('=');
+            if (pos == std::string::npos) {
+                throw std::runtime_error("Configuration value must be provided as key=value, got: " + value);
+            }
+            args.configuration[value.substr(0, pos)] = value.substr(pos + 1);
+        } else {
+            throw std::runtime_error("Unknown argument: " + key);
+        }
+    }
+    if (args.model.empty() || args.type.empty() || args.images.empty()) {
+        printHelp(argv[0]);
+        throw std::runtime_error("-m, -at and -i are required");
+    }
+    if (args.mode != "sync" && args.mode != "async" && args.mode != "batch") {
+        throw std::runtime_error("Unknown mode: " + args.mode);
+    }
+    if (!args.tiler.empty() && args.mode != "sync") {
+        throw std::runtime_error("Tilers run their own tile loop and support only sync mode");
+    }
+    return args;
+}
+
+std::vector<cv::Mat> readImages(const std::string& dir) {
+    std::vector<std::filesystem::path> paths;
+    for (const auto& entry : std::filesystem::directory_iterator{dir}) {
+        std::string ext = entry.path().extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c){ return static_cast<char>(std::tolower(c)); });
+        if (ext == ".jpg" || ext == ".jpeg" || ext == ".png" || ext == ".bmp") {
+            paths.push_back(entry.path());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+
+    std::vector<cv::Mat> images;
+    for (const auto& path : paths) {
+        cv::Mat image = cv::imread(path.string());
+        if (image.data) {
+            images.push_back(image);
+        }
+    }
+    if (images.empty()) {
+        throw std::runtime_error("No images found in " + dir);
+    }
+    return images;
+}
+
+std::shared_ptr<ModelBase> createWrapper(const std::string& type, const std::string& path, const ov::AnyMap& configuration) {
+    constexpr bool preload = false;
+    if (type == "ClassificationModel") {
+        return ClassificationModel::create_model(path, configuration, preload);
+    } else if (type == "DetectionModel") {
+        return DetectionModel::create_model(path, configuration, "", preload);
+    } else if (type == "SegmentationModel") {
+        return SegmentationModel::create_model(path, configuration, preload);
+    } else if (type == "MaskRCNNModel") {
+        return MaskRCNNModel::create_model(path, configuration, preload);
+    } else if (type == "AnomalyDetection") {
+        return AnomalyModel::create_model(path, configuration, preload);
+    }
+    throw std::runtime_error("Unknown model type: " + type);
+}
+
+std::shared_ptr<ModelBase> createWrapper(const std::string& type, std::shared_ptr<InferenceAdapter>& adapter) {
+    if (type == "ClassificationModel") {
+        return ClassificationModel::create_model(adapter);
+    } else if (type == "DetectionModel") {
+        return DetectionModel::create_model(adapter);
+    } else if (type == "SegmentationModel") {
+        return SegmentationModel::create_model(adapter);
+    } else if (type == "MaskRCNNModel") {
+        return MaskRCNNModel::create_model(adapter);
+    } else if (type == "AnomalyDetection") {
+        return AnomalyModel::create_model(adapter);
+    }
+    throw std::runtime_error("Unknown model type: " + type);
+}
+
+struct Timings {
+    std::vector<double> preprocess;
+    std::vector<double> inference;
+    std::vector<double> postprocess;
+    std::vector<double> latency;
+    Clock::duration wall = Clock::duration::zero();
+};
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    size_t idx = std::min(values.size() - 1, static_cast<size_t>(p / 100.0 * values.size()));
+    return values[idx];
+}
+
+double mean(const std::vector<double>& values) {
+    return values.empty() ? 0.0 : std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+}
+
+void printStage(const std::string& name, const std::vector<double>& values) {
+    std::cout << "  " << std::left << std::setw(13) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << mean(values) << std::setw(10) << percentile(values, 50)
+              << std::setw(10) << percentile(values, 90) << std::setw(10) << percentile(values, 99) << '\n';
+}
+
+void report(const Timings& timings) {
+    double seconds = std::chrono::duration<double>(timings.wall).count();
+    std::cout << "Count:      " << timings.latency.size() << " frames\n"
+              << "Duration:   " << std::fixed << std::setprecision(2) << seconds << " s\n"
+              << "Throughput: " << timings.latency.size() / seconds << " FPS\n"
+              << "Latency, ms:\n"
+              << "  median " << percentile(timings.latency, 50) << ", p90 " << percentile(timings.latency, 90)
+              << ", p99 " << percentile(timings.latency, 99) << ", max " << percentile(timings.latency, 100) << '\n'
+              << "Per-stage breakdown, ms:\n"
+              << "  " << std::left << std::setw(13) << "stage" << std::right << std::setw(10) << "mean"
+              << std::setw(10) << "median" << std::setw(10) << "p90" << std::setw(10) << "p99" << '\n';
+    if (!timings.preprocess.empty()) {
+        printStage("preprocess", timings.preprocess);
+    }
+    printStage("inference", timings.inference);
+    if (!timings.postprocess.empty()) {
+        printStage("postprocess", timings.postprocess);
+    }
+    printStage("end-to-end", timings.latency);
+
+    double overhead = mean(timings.latency) - mean(timings.inference);
+    std::cout << "Wrapper overhead: " << overhead << " ms per frame ("
+              << std::setprecision(1) << 100.0 * overhead / std::max(mean(timings.latency), 1e-9) << "% of end-to-end)\n";
+}
+
+// Wrapper or tiler calls exactly as an application does. Inference time is taken from the adapter
+Timings runSync(const std::shared_ptr<ModelBase>& model, BenchmarkAdapter& adapter, const Args& args,
+                const std::vector<cv::Mat>& images) {
+    std::unique_ptr<TilerBase> tiler;
+    if (args.tiler == "DetectionTiler") {
+        tiler.reset(new DetectionTiler(model, {}));
+    } else if (args.tiler == "InstanceSegmentationTiler") {
+        tiler.reset(new InstanceSegmentationTiler(model, {}));
+    } else if (!args.tiler.empty()) {
+        throw std::runtime_error("Unknown tiler: " + args.tiler);
+    }
+
+    Timings timings;
+    const auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(args.duration));
+    const auto benchmarkStart = Clock::now();
+    for (size_t i = 0; Clock::now() < deadline; ++i) {
+        const cv::Mat& image = images[i % images.size()];
+        adapter.inferenceTime = Clock::duration::zero();
+        auto start = Clock::now();
+        if (tiler) {
+            tiler->run(image);
+        } else {
+            InferenceInput inputs;
+            InferenceResult result;
+            auto internalModelData = model->preprocess(ImageInputData(image), inputs);
+            auto preprocessed = Clock::now();
+            result.outputsData = adapter.infer(inputs);
+            result.internalModelData = std::move(internalModelData);
+            auto inferred = Clock::now();
+            model->postprocess(result);
+            timings.preprocess.push_back(Ms(preprocessed - start).count());
+            timings.postprocess.push_back(Ms(Clock::now() - inferred).count());
+        }
+        timings.latency.push_back(Ms(Clock::now() - start).count());
+        timings.inference.push_back(Ms(adapter.inferenceTime).count());
+    }
+    timings.wall = Clock::now() - benchmarkStart;
+    return timings;
+}
+
+struct Slot {
+    InferenceInput inputs;
+    InferenceOutput outputs;
+    std::shared_ptr<InternalModelData> internalModelData;
+    Clock::time_point start;
+    Clock::time_point submitted;
+    Clock::time_point completed;
+    double preprocess = 0.0;
+};
+
+// Callbacks of the inferences in flight refer to the slots of runAsync(), so it returns or throws only once every
+// submitted inference has pushed its completion
+class Completions {
+public:
+    /// Counts an inference before it is submitted
+    void add() {
+        std::lock_guard<std::mutex> lock{mutex};
+        ++outstanding;
+    }
+
+    /// The submission threw, its callback won't be called
+    void cancel() {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            --outstanding;
+        }
+        cv.notify_all();
+    }
+
+    void push(size_t id, std::exception_ptr error) {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            ids.push(id);
+            --outstanding;
+            if (error && !firstError) {
+                firstError = error;
+            }
+        }
+        cv.notify_all();
+    }
+
+    /// Rethrows the first error after the remaining inferences complete
+    size_t pop() {
+        std::unique_lock<std::mutex> lock{mutex};
+        cv.wait(lock, [this]{ return firstError ? 0 == outstanding : !ids.empty(); });
+        if (firstError) {
+            std::rethrow_exception(firstError);
+        }
+        size_t id = ids.front();
+        ids.pop();
+        return id;
+    }
+
+    void waitAll() {
+        std::unique_lock<std::mutex> lock{mutex};
+        cv.wait(lock, [this]{ return 0 == outstanding; });
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::queue<size_t> ids;
+    size_t outstanding = 0;
+    std::exception_ptr firstError;
+};
+
+// Keeps nireq adapter inferences in flight to keep the device busy. Pre and postprocessing stay on the
+// main thread, so the wrapper is never called concurrently. async mode resubmits every completed slot
+// immediately, batch mode submits nireq frames at once and waits for the whole group. The adapter holds
+// the optimal number of infer requests, a larger -nireq queues the extra frames in the adapter
+Timings runAsync(const std::shared_ptr<ModelBase>& model, BenchmarkAdapter& adapter, const Args& args,
+                 const std::vector<cv::Mat>& images) {
+    size_t nireq = args.nireq ? args.nireq : adapter.getOptimalNumberOfInferRequests();
+    std::cout << "Infer requests: " << nireq << '\n';
+
+    std::vector<Slot> slots(nireq);
+    Completions completions;
+    Timings timings;
+    size_t frame = 0;
+    auto submit = [&](size_t id) {
+        Slot& slot = slots[id];
+        slot.start = Clock::now();
+        slot.inputs.clear();
+        slot.internalModelData = model->preprocess(ImageInputData(images[frame++ % images.size()]), slot.inputs);
+        slot.submitted = Clock::now();
+        slot.preprocess = Ms(slot.submitted - slot.start).count();
+        completions.add();
+        try {
+            adapter.inferAsync(slot.inputs, [&slots, &completions, id](InferenceOutput outputs, std::exception_ptr error) {
+                slots[id].completed = Clock::now();
+                slots[id].outputs = std::move(outputs);
+                completions.push(id, error);
+            });
+        } catch (...) {
+            completions.cancel();
+            throw;
+        }
+    };
+    auto complete = [&](Slot& slot) {
+        InferenceResult result;
+        result.outputsData = std::move(slot.outputs);
+        result.internalModelData = std::move(slot.internalModelData);
+        auto postprocessStart = Clock::now();
+        model->postprocess(result);
+        auto end = Clock::now();
+        timings.preprocess.push_back(slot.preprocess);
+        timings.inference.push_back(Ms(slot.completed - slot.submitted).count());
+        timings.postprocess.push_back(Ms(end - postprocessStart).count());
+        timings.latency.push_back(Ms(end - slot.start).count());
+    };
+
+    const auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(args.duration));
+    auto run = [&] {
+        if (args.mode == "async") {
+            for (size_t id = 0; id < slots.size(); ++id) {
+                submit(id);
+            }
+            size_t inflight = slots.size();
+            while (inflight) {
+                size_t id = completions.pop();
+                complete(slots[id]);
+                if (Clock::now() < deadline) {
+                    submit(id);
+                } else {
+                    --inflight;
+                }
+            }
+        } else {
+            while (Clock::now() < deadline) {
+                for (size_t id = 0; id < slots.size(); ++id) {
+                    submit(id);
+                }
+                for (size_t i = 0; i < slots.size(); ++i) {
+                    completions.pop();
+                }
+                for (Slot& slot : slots) {
+                    complete(slot);
+                }
+            }
+        }
+    };
+    const auto benchmarkStart = Clock::now();
+    try {
+        run();
+    } catch (...) {
+        // Preprocessing, a submission or postprocessing may fail with inferences in flight
+        completions.waitAll();
+        throw;
+    }
+    timings.wall = Clock::now() - benchmarkStart;
+    return timings;
+}
+
+// Picks the fastest streams and threads for the mode and stores them in model_info of the saved model
+void tune(ModelBase& model, ov::Core& core, const Args& args, const cv::Mat& image) {
+    InferenceInput inputs;
+    model.preprocess(ImageInputData(image), inputs);
+    CompilationTuner tuner;
+    CompilationTuner::Result result = tuner.tune(model.getModel(), core, args.device, inputs);
+
+    std::cout << std::left << std::setw(10) << "streams" << std::setw(10) << "threads" << std::right
+              << std::setw(10) << "FPS" << std::setw(14) << "latency, ms" << '\n';
+    for (const CompilationTuner::Trial& trial : result.trials) {
+        auto streams = trial.config.find(ov::num_streams.name());
+        auto threads = trial.config.find(ov::inference_num_threads.name());
+        std::cout << std::left << std::setw(10) << (streams == trial.config.end() ? "default" : streams->second.as<std::string>())
+                  << std::setw(10) << (threads == trial.config.end() ? "default" : threads->second.as<std::string>())
+                  << std::right << std::fixed << std::setprecision(2) << std::setw(10) << trial.fps
+                  << std::setw(14) << trial.latencyMs << '\n';
+    }
+    size_t best = args.mode == "sync" ? result.latencyBest : result.throughputBest;
+    std::cout << "Best for " << args.mode << " mode: " << result.trials[best].fps << " FPS, "
+              << result.trials[best].latencyMs << " ms\n";
+
+    model.load(core, args.device, result.trials[best].config);
+    ov::serialize(model.getModel(), args.tune);
+    std::cout << "Saved to " << args.tune << '\n';
+}
+}
+
+int main(int argc, char* argv[]) try {
+    const Args args = parseArgs(argc, argv);
+    const std::vector<cv::Mat> images = readImages(args.images);
+
+    // Prepare the model with pre/postprocessing embedded, then compile it with benchmark-specific properties
+    // and construct the wrapper from the adapter as a deployment would
+    ov::Core core;
+    // -c cache_dir=<dir> applies to the compilation below as well
+    ModelBase::configureCore(core, args.configuration);
+    auto startupStart = Clock::now();
+    std::shared_ptr<ModelBase> prepared = createWrapper(args.type, args.model, args.configuration);
+    auto prepareEnd = Clock::now();
+    if (!args.tune.empty()) {
+        tune(*prepared, core, args, images.front());
+        return 0;
+    }
+    // Compile properties stored in the model, e.g. by -tune, have priority over the hint of the mode
+    ov::AnyMap compilationConfig = prepared->getCompilationConfig();
+    compilationConfig.insert(ov::hint::performance_mode(args.mode == "sync" ?
+        ov::hint::PerformanceMode::LATENCY : ov::hint::PerformanceMode::THROUGHPUT));
+    if (args.nstreams) {
+        compilationConfig[ov::num_streams.name()] = ov::streams::Num(static_cast<int>(args.nstreams));
+    }
+    auto benchmarkAdapter = std::make_shared<BenchmarkAdapter>();
+    benchmarkAdapter->loadModel(prepared->getModel(), core, args.device, compilationConfig);
+    auto loadEnd = Clock::now();
+    std::shared_ptr<InferenceAdapter> adapter = benchmarkAdapter;
+    std::shared_ptr<ModelBase> model = createWrapper(args.type, adapter);
+
+    std::cout << "Model: " << args.model << " (" << args.type << ")\n"
+              << "Device: " << args.device << ", mode: " << args.mode << ", optimal infer requests: "
+              << benchmarkAdapter->getOptimalNumberOfInferRequests() << '\n'
+              << "Images: " << images.size() << '\n'
+              << "Startup: read and prepare " << Ms(prepareEnd - startupStart).count() << " ms, compile "
+              << Ms(loadEnd - prepareEnd).count() << " ms\n"
+              << "Memory after compilation: RSS " << residentMemoryBytes() / (1 << 20) << " MB, PSS "
+              << proportionalMemoryBytes() / (1 << 20) << " MB\n";
+
+    // Keep the first, slower, inference out of the statistics
+    model->infer(ImageInputData(images.front()));
+
+    Timings timings = args.mode == "sync" ? runSync(model, *benchmarkAdapter, args, images)
+                                          : runAsync(model, *benchmarkAdapter, args, images);
+    report(timings);
+} catch (const std::exception& error) {
+    std::cerr << error.what() << '\n';
+    return 1;
+} catch (...) {
+    std::cerr << "Non-exception object thrown\n";
+    return 1;
+}
@@ -0,0 +1,115 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include <csignal>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <openvino/openvino.hpp>
+
+#include <adapters/shm_adapter.h>
+
+namespace {
+struct Args {
+    std::vector<std::pair<std::string, std::string>> models;  // name, path
+    std::string device = "CPU";
+    std::string socketPath = "/tmp/model_api.sock";
+    ov::AnyMap compilationConfig;
+};
+
+void printHelp(const char* programName) {
+    std::cout << "Usage: " << programName << " -m <name>=<model.xml> [options]\n"
+              << "  -m <name>=<path>  model prepared with create_model() and saved, can be repeated\n"
+              << "  -d <device>       inference device, CPU by default\n"
+              << "  -s <path>         Unix socket path, /tmp/model_api.sock by default\n"
+              << "  -c <key=value>    compilation property, can be repeated\n";
+}
+
+std::pair<std::string, std::string> splitKeyValue(const std::string& value) {
+    size_t pos = value.find('=');
+    if (pos == std::string::npos) {
+        throw std::runtime_error("Value must be provided as key=value, got: " + value);
+    }
+    return {value.substr(0, pos), value.substr(pos + 1)};
+}
+
+Args parseArgs(int argc, char* argv[]) {
+    Args args;
+    for (int i = 1; i < argc; ++i) {
+        const std::string key = argv[i];
+        if (key == "-h") {
+            printHelp(argv[0]);
+            exit(0);
+        }
+        if (i + 1 >= argc) {
+            throw std::runtime_error("Missing value for " + key);
+        }
+        const std::string value = argv[++i];
+        if (key == "-m") {
+            args.models.push_back(splitKeyValue(value));
+        } else if (key == "-d") {
+            args.device = value;
+        } else if (key == "-s") {
+            args.socketPath = value;
+        } else if (key == "-c") {
+            args.compilationConfig.insert(splitKeyValue(value));
+        } else {
+            throw std::runtime_error("Unknown argument: " + key);
+        }
+    }
+    if (args.models.empty()) {
+        printHelp(argv[0]);
+        throw std::runtime_error("At least one -m is required");
+    }
+    return args;
+}
+
+ShmInferenceServer* runningServer = nullptr;
+
+void onSignal(int) {
+    // Only writes to an eventfd, safe in a signal handler
+    runningServer->stop();
+}
+}
+
+int main(int argc, char* argv[]) try {
+    Args args = parseArgs(argc, argv);
+    // Clients of all processes share one compiled model, let the plugin run their requests in parallel
+    args.compilationConfig.insert(ov::hint::performance_mode(ov::hint::PerformanceMode::THROUGHPUT));
+
+    ov::Core core;
+    ShmInferenceServer server{args.socketPath};
+    for (const auto& model : args.models) {
+        server.addModel(model.first, core.read_model(model.second), core, args.device, args.compilationConfig);
+    }
+    runningServer = &server;
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    server.run();
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+} catch (const std::exception& error) {
+    std::cerr << error.what() << '\n';
+    return 1;
+} catch (...) {
+    std::cerr << "Non-exception object thrown\n";
+    return 1;
+}
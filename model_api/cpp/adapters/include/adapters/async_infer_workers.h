@@ -0,0 +1,47 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+#include <stddef.h>
+
+#include <memory>
+
+#include "adapters/inference_adapter.h"
+
+/// Runs inferAsync() calls of an adapter without an asynchronous path on at most maxThreads() threads which call
+/// its infer(), so the caller, e.g. the executor of a coroutine, never waits for it. The adapter declares it as its
+/// last member, so the threads are joined before the other members are destroyed. Calls still queued then get an error
+class AsyncInferWorkers {
+public:
+    explicit AsyncInferWorkers(InferenceAdapter& adapter);
+    ~AsyncInferWorkers();
+    AsyncInferWorkers(const AsyncInferWorkers&) = delete;
+    AsyncInferWorkers& operator=(const AsyncInferWorkers&) = delete;
+
+    /// Queues the call, a thread is started if none is idle
+    void submit(const InferenceInput& input, InferenceCallback callback);
+    /// Fails the queued calls and waits for the running ones. A destructor which releases state in its body calls it
+    /// first, the threads are stopped by ~AsyncInferWorkers() only after the body
+    void stop();
+
+    /// The number of hardware threads
+    static size_t maxThreads();
+
+private:
+    struct State;
+    InferenceAdapter& adapter;
+    std::shared_ptr<State> state;
+};
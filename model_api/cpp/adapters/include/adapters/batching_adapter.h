@@ -0,0 +1,98 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "adapters/inference_adapter.h"
+
+/// Combines infer() calls of concurrent threads into batched inferences. A request waits up to maxDelay for others
+/// with the same input shapes and types, then up to maxBatchSize of them are stacked along the first dimension,
+/// inferred at once and outputs are split back to the callers. Requests of different shapes are batched separately.
+/// loadModel() makes the first dimension of inputs dynamic, all outputs must keep it as the batch dimension.
+/// Wrappers see the original shapes, so they can be created from the adapter unchanged
+class BatchingInferenceAdapter : public InferenceAdapter
+{
+
+public:
+    /// @param padBatch round batches up to a power of two filling the tail with zeros. Limits the number of shapes
+    ///                 the plugin has to prepare kernels for, which matters for GPU
+    explicit BatchingInferenceAdapter(size_t maxBatchSize = 8,
+                                      std::chrono::microseconds maxDelay = std::chrono::milliseconds(1),
+                                      bool padBatch = false);
+    /// Completes requests already submitted
+    virtual ~BatchingInferenceAdapter();
+
+    virtual InferenceOutput infer(const InferenceInput& input) override;
+    std::future<InferenceOutput> inferAsync(const InferenceInput& input);
+    /// Queues the request and returns, the callback is called from the thread completing its batch
+    virtual void inferAsync(const InferenceInput& input, InferenceCallback callback) override;
+    /// Runs every batch size the dispatcher can form, made of copies of the input, on every infer request
+    virtual void warmup(const InferenceInput& input) override;
+    virtual void loadModel(const std::shared_ptr<const ov::Model>& model, ov::Core& core,
+                           const std::string& device = "", const ov::AnyMap& compilationConfig = {}) override;
+    virtual ov::PartialShape getInputShape(const std::string& inputName) const override;
+    virtual std::vector<std::string> getInputNames() const override;
+    virtual std::vector<std::string> getOutputNames() const override;
+    virtual const ov::AnyMap& getModelConfig() const override;
+    /// The number of infer requests the device reported as optimal when the model was loaded. Each of them runs a
+    /// whole batch, so up to maxBatchSize times that many inferAsync() calls are worth keeping in flight
+    uint32_t getOptimalNumberOfInferRequests() const;
+
+private:
+    struct Request {
+        InferenceInput input;
+        std::string bucket;  // Input types and shapes without the batch dimension
+        size_t rows;
+        std::chrono::steady_clock::time_point deadline;
+        InferenceCallback callback;
+    };
+
+    const size_t maxBatchSize;
+    const std::chrono::microseconds maxDelay;
+    const bool padBatch;
+
+    std::vector<std::string> inputNames;
+    std::vector<std::string> outputNames;
+    std::map<std::string, ov::PartialShape> inputShapes;
+    ov::AnyMap modelConfig;
+    ov::CompiledModel compiledModel;
+    std::vector<ov::InferRequest> inferRequests;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<std::unique_ptr<Request>> queue;
+    std::vector<size_t> idleRequests;
+    bool stopping = false;
+    std::thread dispatcher;
+
+    void dispatch();
+    std::vector<std::unique_ptr<Request>> takeBatch(std::unique_lock<std::mutex>& lock);
+    void run(size_t requestIndex, std::vector<std::unique_ptr<Request>> batch);
+    void scatter(ov::InferRequest& request, std::vector<std::unique_ptr<Request>>& batch);
+};
@@ -15,6 +15,8 @@
 */
 
 #pragma once
+#include <exception>
+#include <functional>
 #include <string>
 #include <vector>
 #include <map>
@@ -27,6 +29,8 @@ struct InferenceResult;
 
 using InferenceOutput = std::map<std::string, ov::Tensor>;
 using InferenceInput = std::map<std::string, ov::Tensor>;
+/// Gets the outputs or the error of inferAsync(). Must not throw
+using InferenceCallback = std::function<void(InferenceOutput, std::exception_ptr)>;
 
 // The interface doesn't have implementation
 class InferenceAdapter
@@ -36,8 +40,21 @@ public:
     virtual ~InferenceAdapter() = default;
 
     virtual InferenceOutput infer(const InferenceInput& input) = 0;
+    /// Writes outputs into an existing map. Adapters can override it to reuse the map nodes across calls
+    virtual void infer(const InferenceInput& input, InferenceOutput& output) {
+        output = infer(input);
+    }
+    /// Starts inference and returns, the callback is called from the thread completing it.
+    /// The default completes before returning. Adapters without an asynchronous path hand the call to an
+    /// AsyncInferWorkers member instead, so the caller, e.g. the executor of a coroutine, never waits for infer()
+    virtual void inferAsync(const InferenceInput& input, InferenceCallback callback);
     virtual void loadModel(const std::shared_ptr<const ov::Model>& model, ov::Core& core,
                            const std::string& device = "", const ov::AnyMap& compilationConfig = {}) = 0;
+    /// Runs the input on every infer request the adapter owns and discards the outputs.
+    /// Adapters with a pool of infer requests override it, the others infer once
+    virtual void warmup(const InferenceInput& input) {
+        infer(input);
+    }
     virtual ov::PartialShape getInputShape(const std::string& inputName) const = 0;
     virtual std::vector<std::string> getInputNames() const = 0;
     virtual std::vector<std::string> getOutputNames() const = 0;
@@ -0,0 +1,91 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+#include <stddef.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "adapters/async_infer_workers.h"
+#include "adapters/inference_adapter.h"
+
+/// Runs inference on a model served by OpenVINO Model Server or another server implementing KServe v2 REST API.
+/// Tensors are sent and received with the binary data extension instead of JSON arrays. The adapter keeps a pool of
+/// keep-alive connections, so infer() can be called from several threads at once, each call takes its own
+/// connection. The model must be prepared with create_model() and saved beforehand, the same as for Python OVMSAdapter
+class KServeInferenceAdapter : public InferenceAdapter
+{
+
+public:
+    /// @param target <address>:<port>/models/<model_name>[:<model_version>], e.g. "localhost:8000/models/ssd300"
+    /// @param maxConnections the number of concurrent requests, other infer() calls wait for a free connection
+    /// @param ioTimeout the longest wait for connecting and for each send or receive, a stalled server or a half-open
+    /// connection fails the request after it. Zero waits as long as the system does
+    explicit KServeInferenceAdapter(const std::string& target, size_t maxConnections = 4,
+                                    std::chrono::milliseconds ioTimeout = std::chrono::seconds(30));
+    virtual ~KServeInferenceAdapter();
+
+    virtual InferenceOutput infer(const InferenceInput& input) override;
+    /// Reuses tensors of output if they have the expected type and shape
+    virtual void infer(const InferenceInput& input, InferenceOutput& output) override;
+    /// Runs infer() on the threads of the adapter
+    virtual void inferAsync(const InferenceInput& input, InferenceCallback callback) override;
+    /// Sends all requests over one connection without waiting for responses (HTTP pipelining) and returns outputs
+    /// in the order of inputs. Hides the network round trip for a batch of small requests
+    std::vector<InferenceOutput> inferPipelined(const std::vector<InferenceInput>& inputs);
+    /// The model is loaded by the server, throws std::logic_error
+    virtual void loadModel(const std::shared_ptr<const ov::Model>& model, ov::Core& core,
+                           const std::string& device = "", const ov::AnyMap& compilationConfig = {}) override;
+    virtual ov::PartialShape getInputShape(const std::string& inputName) const override;
+    virtual std::vector<std::string> getInputNames() const override;
+    virtual std::vector<std::string> getOutputNames() const override;
+    /// The content of rt_info/model_info from the model metadata
+    virtual const ov::AnyMap& getModelConfig() const override;
+
+private:
+    struct Connection;
+
+    std::string host;
+    std::string port;
+    std::string modelName;
+    std::string modelVersion;
+    std::string modelPath;  // /v2/models/<model_name>[/versions/<model_version>]
+
+    std::vector<std::string> inputNames;
+    std::vector<std::string> outputNames;
+    std::map<std::string, ov::PartialShape> inputShapes;
+    ov::AnyMap modelConfig;
+
+    const size_t maxConnections;
+    const std::chrono::milliseconds ioTimeout;
+    size_t openConnections = 0;
+    std::vector<std::unique_ptr<Connection>> idleConnections;
+    std::mutex poolMutex;
+    std::condition_variable poolCondition;
+
+    void readMetadata();
+    std::unique_ptr<Connection> acquire(bool& reused);
+    void release(std::unique_ptr<Connection> connection);
+    void discard(std::unique_ptr<Connection> connection);
+
+    AsyncInferWorkers asyncWorkers{*this};  // Must stay the last member
+};
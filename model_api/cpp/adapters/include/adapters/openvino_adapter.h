@@ -15,13 +15,25 @@
 */
 
 #pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <string>
 #include <vector>
 #include <map>
 #include <memory>
+#include <mutex>
 
 #include "adapters/inference_adapter.h"
+#include "adapters/output_bindings.h"
 
+/// infer() can be called from several threads. Every call takes an idle infer request from a pool of the optimal
+/// number of infer requests of the compiled model, waiting if all of them are busy, and writes outputs into tensors
+/// owned by the caller. Buffers of released static output tensors are reused by the following calls. inferAsync()
+/// never waits: if every request is busy, the call is queued and started by the request released next. It completes
+/// in the callback of the infer request, the adapter must outlive the calls in flight. saliency_map and feature_vector
+/// outputs aren't compiled if remove_xai_outputs is set in the model_info section of rt_info
 class OpenVINOInferenceAdapter :public InferenceAdapter
 {
 
@@ -29,21 +41,40 @@ public:
     OpenVINOInferenceAdapter() = default;
 
     virtual InferenceOutput infer(const InferenceInput& input) override;
+    /// Reuses the tensors of the output map if they still fit, so a map passed to every call doesn't reallocate
+    virtual void infer(const InferenceInput& input, InferenceOutput& output) override;
+    virtual void inferAsync(const InferenceInput& input, InferenceCallback callback) override;
+    virtual void warmup(const InferenceInput& input) override;
     virtual void loadModel(const std::shared_ptr<const ov::Model>& model, ov::Core& core,
                                                     const std::string& device = "", const ov::AnyMap& compilationConfig = {}) override;
     virtual ov::PartialShape getInputShape(const std::string& inputName) const override;
     virtual std::vector<std::string> getInputNames() const override;
     virtual std::vector<std::string> getOutputNames() const override;
     virtual const ov::AnyMap& getModelConfig() const override;
+    /// The number of infer requests the device reported as optimal when the model was loaded. The pool holds that many
+    /// requests, so it's the number of inferAsync() calls worth keeping in flight
+    uint32_t getOptimalNumberOfInferRequests() const;
 
 protected:
     void initInputsOutputs();
+    ov::InferRequest& acquireRequest();
+    /// Starts a queued inferAsync() call on the request instead of returning it to the pool if there is one
+    void releaseRequest(ov::InferRequest& request);
+    void startAsync(ov::InferRequest& request, const InferenceInput& input, InferenceCallback callback);
 
 protected:
     //Depends on the implmentation details but we should share the model state in this class
     std::vector<std::string> inputNames;
     std::vector<std::string> outputNames;
     ov::CompiledModel compiledModel;
-    ov::InferRequest inferRequest;
+    // Doesn't change while the model is loaded, so references to the requests stay valid
+    std::deque<ov::InferRequest> requests;
+    std::vector<ov::InferRequest*> idleRequests;
+    std::mutex requestsMutex;
+    std::condition_variable requestReleased;
+    // inferAsync() calls waiting for a request
+    std::deque<std::function<void(ov::InferRequest&)>> pendingStarts;
+    uint32_t optimalRequests = 1;
+    OutputBindings outputBindings;
     ov::AnyMap modelConfig; // the content of model_info section of rt_info
 };
@@ -0,0 +1,44 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include <openvino/openvino.hpp>
+
+#include "adapters/inference_adapter.h"
+
+/// Binds the inputs of a call and the outputs of a compiled model to infer requests shared by several threads.
+/// Static outputs are written to tensors given to the caller. Tensors of the output map are reused if they still fit,
+/// new ones take buffers released by previous callers. Dynamic outputs are allocated by the plugin and copied after
+/// the inference. Both methods can be called from several threads
+class OutputBindings {
+public:
+    OutputBindings() = default;
+    /// Recycles the buffers of the static outputs of twice the given number of infer requests
+    OutputBindings(const ov::CompiledModel& compiledModel, size_t requests);
+
+    void setTensors(ov::InferRequest& request, const InferenceInput& input, InferenceOutput& output) const;
+    void copyDynamicOutputs(ov::InferRequest& request, InferenceOutput& output) const;
+
+private:
+    std::vector<ov::Output<const ov::Node>> outputs;
+    std::vector<std::string> outputNames;
+    ov::Allocator allocator;
+};
@@ -0,0 +1,108 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include "adapters/inference_adapter.h"
+
+/// Thrown when the queue of the priority class is full
+class QueueFullError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/// Thrown when the deadline of a request passes before it is started
+class DeadlineExceededError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/// Orders concurrent requests to an adapter which can run maxConcurrency of them at once. A waiting request of a
+/// higher priority class is always started first, requests of one class are started earliest deadline first.
+/// A request is rejected if its class queue is full and dropped if its deadline passes while it waits.
+/// The scheduler must be owned by std::shared_ptr. Wrappers are created from the adapters returned by createAdapter(),
+/// e.g. live streams from createAdapter(0) and bulk jobs from createAdapter(1) of the same scheduler
+class RequestScheduler : public std::enable_shared_from_this<RequestScheduler> {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct PriorityClass {
+        /// Latency budget of a request, its deadline is the submission time plus the budget
+        std::chrono::microseconds deadline = std::chrono::microseconds::max();
+        size_t maxQueueDepth = std::numeric_limits<size_t>::max();
+    };
+
+    struct ClassStatistics {
+        size_t queueDepth;
+        size_t running;
+        size_t completed;
+        size_t rejected;
+        size_t shed;
+        double meanWaitMs;
+        double maxWaitMs;
+    };
+
+    /// @param adapter a loaded adapter, its infer() must be safe to call from maxConcurrency threads
+    /// @param classes the first class has the highest priority
+    RequestScheduler(std::shared_ptr<InferenceAdapter> adapter, size_t maxConcurrency, std::vector<PriorityClass> classes);
+
+    /// The adapter keeps the scheduler alive
+    std::shared_ptr<InferenceAdapter> createAdapter(size_t priorityClass);
+    InferenceOutput infer(const InferenceInput& input, size_t priorityClass, Clock::time_point deadline);
+    std::vector<ClassStatistics> getStatistics() const;
+
+    const std::shared_ptr<InferenceAdapter>& getAdapter() const {
+        return adapter;
+    }
+
+private:
+    struct Ticket;
+    struct TicketOrder {
+        bool operator()(const Ticket* lhs, const Ticket* rhs) const;
+    };
+    struct ClassState {
+        PriorityClass config;
+        std::set<Ticket*, TicketOrder> waiting;
+        size_t running = 0;
+        size_t completed = 0;
+        size_t rejected = 0;
+        size_t shed = 0;
+        size_t started = 0;
+        Clock::duration totalWait = Clock::duration::zero();
+        Clock::duration maxWait = Clock::duration::zero();
+    };
+
+    const std::shared_ptr<InferenceAdapter> adapter;
+    const size_t maxConcurrency;
+    size_t running = 0;
+    uint64_t sequence = 0;
+    std::vector<ClassState> classes;
+    mutable std::mutex mutex;
+    std::condition_variable condition;
+
+    void grant(Clock::time_point now);
+};
@@ -0,0 +1,154 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "adapters/async_infer_workers.h"
+#include "adapters/inference_adapter.h"
+#include "adapters/output_bindings.h"
+
+class ResidentInferenceAdapter;
+
+/// Keeps the compiled models of several ResidentInferenceAdapter within a memory budget. When a model is loaded and
+/// the budget is exceeded, the least recently used idle compiled models are released. Their adapters keep the
+/// prepared ov::Model and compile it again on the next request. With cacheDir a compiled model is exported there
+/// once and evicted models are imported from the blob instead, which skips compilation.
+/// The memory of a compiled model is the growth of the process resident memory while it is loaded, but not less than
+/// the size of its weights. Device memory isn't counted
+class ResidencyManager {
+public:
+    struct Statistics {
+        size_t hits;       // requests to a resident model
+        size_t misses;     // requests which loaded their model
+        size_t evictions;
+        size_t residentModels;
+        size_t residentBytes;
+        double meanLoadMs;
+        double maxLoadMs;
+    };
+
+    explicit ResidencyManager(size_t budgetBytes, std::string cacheDir = "");
+
+    Statistics getStatistics() const;
+
+    size_t getBudget() const {
+        return budgetBytes;
+    }
+
+private:
+    friend class ResidentInferenceAdapter;
+
+    const size_t budgetBytes;
+    const std::string cacheDir;
+    uint64_t nextId = 0;
+    // Front is the most recently used
+    std::list<ResidentInferenceAdapter*> lru;
+    size_t residentBytes = 0;
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+    size_t loads = 0;
+    double totalLoadMs = 0.0;
+    double maxLoadMs = 0.0;
+
+    mutable std::mutex mutex;
+    std::condition_variable condition;
+    // Loads are sequential, so the growth of resident memory belongs to one model
+    std::mutex loadMutex;
+
+    void evict(size_t requiredBytes, const ResidentInferenceAdapter* keep);
+    void release(ResidentInferenceAdapter& adapter);
+};
+
+/// An adapter whose compiled model is loaded on demand and can be evicted by its ResidencyManager. Wrappers are
+/// created from it with create_model(). infer() can be called from several threads, outputs are owned by the caller.
+/// Buffers of released static output tensors are reused by the following calls until the model is evicted
+class ResidentInferenceAdapter : public InferenceAdapter
+{
+
+public:
+    explicit ResidentInferenceAdapter(std::shared_ptr<ResidencyManager> manager);
+    virtual ~ResidentInferenceAdapter();
+
+    virtual InferenceOutput infer(const InferenceInput& input) override;
+    /// Reuses the tensors of the output map if they still fit, so a map passed to every call doesn't reallocate
+    virtual void infer(const InferenceInput& input, InferenceOutput& output) override;
+    /// Runs infer() on the threads of the adapter
+    virtual void inferAsync(const InferenceInput& input, InferenceCallback callback) override;
+    /// Runs the input on every idle infer request. The input is kept and every later reload is warmed up with it
+    virtual void warmup(const InferenceInput& input) override;
+    /// Stores the model and compiles it, the later loads use the same device and properties
+    virtual void loadModel(const std::shared_ptr<const ov::Model>& model, ov::Core& core,
+                           const std::string& device = "", const ov::AnyMap& compilationConfig = {}) override;
+    virtual ov::PartialShape getInputShape(const std::string& inputName) const override;
+    virtual std::vector<std::string> getInputNames() const override;
+    virtual std::vector<std::string> getOutputNames() const override;
+    virtual const ov::AnyMap& getModelConfig() const override;
+
+    bool isResident() const;
+    /// Memory of the compiled model measured at its last load
+    size_t getModelBytes() const;
+    /// The number of infer requests created at the last load. Concurrent infer() calls wait for an idle one
+    size_t getInferRequestCount() const;
+    /// Releases the compiled model now unless a request is running
+    void evict();
+
+private:
+    friend class ResidencyManager;
+
+    const std::shared_ptr<ResidencyManager> manager;
+    std::shared_ptr<const ov::Model> model;
+    ov::Core core;
+    std::string device;
+    ov::AnyMap compilationConfig;
+    std::vector<std::string> inputNames;
+    std::vector<std::string> outputNames;
+    std::vector<ov::PartialShape> inputShapes;
+    ov::AnyMap modelConfig;
+    std::string blobPath;
+    bool exported = false;  // Guarded by the load mutex of the manager
+    size_t weightsBytes = 0;
+
+    // Guarded by the mutex of the manager
+    ov::CompiledModel compiledModel;
+    OutputBindings outputBindings;
+    // The optimal number of infer requests is created with the compiled model, acquire() waits for an idle one
+    std::vector<ov::InferRequest> idleRequests;
+    size_t requestCount = 0;
+    std::vector<InferenceInput> warmupInputs;
+    size_t inflight = 0;
+    size_t modelBytes = 0;
+    bool resident = false;
+    bool loading = false;
+    std::list<ResidentInferenceAdapter*>::iterator position;
+
+    void enter(std::unique_lock<std::mutex>& lock);
+    ov::InferRequest acquire();
+    void release(ov::InferRequest request);
+    void load(std::unique_lock<std::mutex>& lock);
+    ov::CompiledModel compile(size_t& bytes, std::vector<ov::InferRequest>& requests);
+
+    AsyncInferWorkers asyncWorkers{*this};  // Must stay the last member
+};
@@ -0,0 +1,89 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+#include <stddef.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "adapters/async_infer_workers.h"
+#include "adapters/inference_adapter.h"
+
+/// Compiles the same model several times and dispatches every infer() call to the shard with the least outstanding
+/// requests relative to its number of infer requests. Each shard has its own device and compilation properties, for
+/// example the CPU sockets of a host restricted with ov::inference_num_threads and ov::affinity, or GPU.0 and GPU.1.
+/// infer() can be called from several threads, outputs are owned by the caller. Buffers of released static output
+/// tensors are reused by the following calls of the same shard
+class ShardedInferenceAdapter : public InferenceAdapter
+{
+
+public:
+    struct Shard {
+        std::string device;  // The device passed to loadModel() if empty
+        ov::AnyMap compilationConfig;  // Overrides the properties passed to loadModel()
+    };
+
+    struct ShardStatistics {
+        std::string device;
+        size_t inferRequests;
+        size_t outstanding;
+        size_t completed;
+        double utilization;  // The fraction of time since loadModel() the shard had a request in flight
+    };
+
+    explicit ShardedInferenceAdapter(std::vector<Shard> shards);
+    virtual ~ShardedInferenceAdapter();
+
+    virtual InferenceOutput infer(const InferenceInput& input) override;
+    /// Reuses the tensors of the output map if they still fit, so a map passed to every call doesn't reallocate
+    virtual void infer(const InferenceInput& input, InferenceOutput& output) override;
+    /// Runs infer() on the threads of the adapter
+    virtual void inferAsync(const InferenceInput& input, InferenceCallback callback) override;
+    /// Runs the input on every infer request of every shard. Isn't counted in the statistics
+    virtual void warmup(const InferenceInput& input) override;
+    virtual void loadModel(const std::shared_ptr<const ov::Model>& model, ov::Core& core,
+                           const std::string& device = "", const ov::AnyMap& compilationConfig = {}) override;
+    virtual ov::PartialShape getInputShape(const std::string& inputName) const override;
+    virtual std::vector<std::string> getInputNames() const override;
+    virtual std::vector<std::string> getOutputNames() const override;
+    virtual const ov::AnyMap& getModelConfig() const override;
+
+    std::vector<ShardStatistics> getShardStatistics() const;
+
+private:
+    struct CompiledShard;
+
+    std::vector<Shard> shards;
+    std::vector<std::unique_ptr<CompiledShard>> compiledShards;
+    std::vector<std::string> inputNames;
+    std::vector<std::string> outputNames;
+    ov::AnyMap modelConfig;
+    std::chrono::steady_clock::time_point loadTime;
+
+    mutable std::mutex mutex;
+    std::condition_variable condition;
+
+    size_t acquire(size_t& requestIndex);
+    void release(size_t shardIndex, size_t requestIndex);
+
+    AsyncInferWorkers asyncWorkers{*this};  // Must stay the last member
+};
@@ -0,0 +1,95 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+#ifdef __linux__
+#include <stddef.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "adapters/async_infer_workers.h"
+#include "adapters/inference_adapter.h"
+
+/// Local inference server sharing compiled models between processes of one host. Clients connect to a Unix domain
+/// socket and pass a memfd with slots for requests, sealed against resizing, and eventfds for signalling. Input
+/// tensors are read by the plugin directly from the slots and outputs are written back to them, so tensor data never
+/// goes through the socket.
+/// Requests of all clients of a model are served by one compiled model, compile it with THROUGHPUT hint to let the
+/// plugin run requests of different processes in parallel or batch them
+class ShmInferenceServer {
+public:
+    explicit ShmInferenceServer(const std::string& socketPath);
+    ~ShmInferenceServer();
+
+    /// The model should be prepared with create_model() and saved beforehand, the same as for OVMS
+    void addModel(const std::string& name, const std::shared_ptr<const ov::Model>& model, ov::Core& core,
+                  const std::string& device = "CPU", const ov::AnyMap& compilationConfig = {});
+    /// Accepts clients until stop() is called
+    void run();
+    /// Can be called from any thread or a signal handler
+    void stop();
+
+    struct ServedModel;
+    struct Session;
+
+private:
+    const std::string socketPath;
+    int listener = -1;
+    int stopEvent = -1;
+    std::map<std::string, std::unique_ptr<ServedModel>> models;
+    std::vector<std::unique_ptr<Session>> sessions;
+
+    void accept();
+};
+
+/// Client of ShmInferenceServer. The adapter owns slotCount request slots of slotSize bytes each, a slot holds inputs
+/// and outputs of one request. infer() can be called from several threads, up to slotCount requests are in flight.
+/// Output tensors are views of the slot, the slot is reused after all output tensors of the request are destroyed
+class ShmInferenceAdapter : public InferenceAdapter
+{
+
+public:
+    ShmInferenceAdapter(const std::string& socketPath, const std::string& modelName, size_t slotCount = 4,
+                        size_t slotSize = 16 * 1024 * 1024);
+    virtual ~ShmInferenceAdapter();
+
+    virtual InferenceOutput infer(const InferenceInput& input) override;
+    /// Runs infer() on the threads of the adapter
+    virtual void inferAsync(const InferenceInput& input, InferenceCallback callback) override;
+    /// The model is loaded by the server, throws std::logic_error
+    virtual void loadModel(const std::shared_ptr<const ov::Model>& model, ov::Core& core,
+                           const std::string& device = "", const ov::AnyMap& compilationConfig = {}) override;
+    virtual ov::PartialShape getInputShape(const std::string& inputName) const override;
+    virtual std::vector<std::string> getInputNames() const override;
+    virtual std::vector<std::string> getOutputNames() const override;
+    virtual const ov::AnyMap& getModelConfig() const override;
+
+    struct Channel;
+
+private:
+    std::shared_ptr<Channel> channel;  // Shared with output tensors which keep the mapping alive
+    std::vector<std::string> inputNames;
+    std::vector<std::string> outputNames;
+    std::map<std::string, ov::PartialShape> inputShapes;
+    ov::AnyMap modelConfig;
+    std::thread receiver;
+    AsyncInferWorkers asyncWorkers{*this};  // Must stay the last member
+};
+#endif
@@ -0,0 +1,126 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "adapters/async_infer_workers.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Shared with the threads, so that a thread detached by stop() can still leave its loop
+struct AsyncInferWorkers::State {
+    struct Call {
+        InferenceInput input;
+        InferenceCallback callback;
+    };
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<Call> queue;
+    std::vector<std::thread> threads;
+    size_t idle = 0;
+    bool stopping = false;
+
+    static void run(std::shared_ptr<State> state, InferenceAdapter* adapter) {
+        std::unique_lock<std::mutex> lock{state->mutex};
+        while (true) {
+            ++state->idle;
+            state->condition.wait(lock, [&state] {
+                return state->stopping || !state->queue.empty();
+            });
+            --state->idle;
+            if (state->queue.empty()) {
+                return;
+            }
+            Call call = std::move(state->queue.front());
+            state->queue.pop_front();
+            lock.unlock();
+            InferenceOutput output;
+            std::exception_ptr error;
+            try {
+                output = adapter->infer(call.input);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            call.callback(std::move(output), error);
+            call = {};
+            lock.lock();
+        }
+    }
+};
+
+AsyncInferWorkers::AsyncInferWorkers(InferenceAdapter& adapter) : adapter(adapter), state(std::make_shared<State>()) {}
+
+AsyncInferWorkers::~AsyncInferWorkers() {
+    stop();
+}
+
+void AsyncInferWorkers::submit(const InferenceInput& input, InferenceCallback callback) {
+    {
+        std::lock_guard<std::mutex> lock{state->mutex};
+        if (state->stopping) {
+            throw std::logic_error("inferAsync() was called on an adapter being destroyed");
+        }
+        state->queue.push_back({input, std::move(callback)});
+        // Every idle thread takes one call, a new thread is started only for the calls left over
+        if (state->queue.size() > state->idle && state->threads.size() < maxThreads()) {
+            try {
+                state->threads.emplace_back(State::run, state, &adapter);
+            } catch (...) {
+                if (state->threads.empty()) {
+                    state->queue.pop_back();
+                    throw;
+                }
+            }
+        }
+    }
+    state->condition.notify_one();
+}
+
+void AsyncInferWorkers::stop() {
+    std::deque<State::Call> queued;
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock{state->mutex};
+        state->stopping = true;
+        queued.swap(state->queue);
+        threads.swap(state->threads);
+    }
+    state->condition.notify_all();
+    for (State::Call& call : queued) {
+        call.callback({}, std::make_exception_ptr(std::runtime_error("The adapter was destroyed before the inference started")));
+    }
+    for (std::thread& thread : threads) {
+        // A callback may release the last reference to the adapter
+        if (thread.get_id() == std::this_thread::get_id()) {
+            thread.detach();
+        } else {
+            thread.join();
+        }
+    }
+}
+
+size_t AsyncInferWorkers::maxThreads() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
@@ -0,0 +1,361 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "adapters/batching_adapter.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+#include <openvino/openvino.hpp>
+#include <utils/slog.hpp>
+#include <utils/xai_outputs.hpp>
+
+BatchingInferenceAdapter::BatchingInferenceAdapter(size_t maxBatchSize, std::chrono::microseconds maxDelay, bool padBatch)
+    : maxBatchSize(maxBatchSize), maxDelay(maxDelay), padBatch(padBatch) {
+    if (0 == maxBatchSize) {
+        throw std::invalid_argument("maxBatchSize must be positive");
+    }
+}
+
+BatchingInferenceAdapter::~BatchingInferenceAdapter() {
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        stopping = true;
+    }
+    condition.notify_all();
+    if (dispatcher.joinable()) {
+        dispatcher.join();
+    }
+}
+
+void BatchingInferenceAdapter::loadModel(const std::shared_ptr<const ov::Model>& model, ov::Core& core,
+                                         const std::string& device, const ov::AnyMap& compilationConfig) {
+    if (dispatcher.joinable()) {
+        throw std::logic_error("BatchingInferenceAdapter already has a model loaded");
+    }
+    slog::info << "Loading model to the plugin" << slog::endl;
+
+    std::map<std::string, ov::PartialShape> batchedShapes;
+    for (const ov::Output<const ov::Node>& input : model->inputs()) {
+        const std::string& name = input.get_any_name();
+        ov::PartialShape shape = input.get_partial_shape();
+        inputNames.push_back(name);
+        inputShapes[name] = shape;
+        if (shape.rank().is_dynamic() || shape.size() == 0) {
+            throw std::runtime_error("Input " + name + " doesn't have a batch dimension, the model can't be batched");
+        }
+        shape[0] = ov::Dimension::dynamic();
+        batchedShapes[name] = shape;
+    }
+    // XAI outputs are pruned first, they may lack the batch dimension
+    std::shared_ptr<ov::Model> batched = pruneXaiOutputs(model)->clone();
+    batched->reshape(batchedShapes);
+    for (const ov::Output<ov::Node>& output : batched->outputs()) {
+        const std::string& name = output.get_any_name();
+        const ov::PartialShape& shape = output.get_partial_shape();
+        // An output which didn't follow the input batch mixes results of several images, e.g. SSD DetectionOutput
+        if (shape.rank().is_dynamic() || shape.size() == 0 || shape[0].is_static()) {
+            throw std::runtime_error("Output " + name + " doesn't have a batch dimension, the model can't be batched");
+        }
+        outputNames.push_back(name);
+    }
+
+    compiledModel = core.compile_model(batched, device, compilationConfig);
+    uint32_t nireq = compiledModel.get_property(ov::optimal_number_of_infer_requests);
+    for (uint32_t i = 0; i < std::max(nireq, 1u); ++i) {
+        inferRequests.push_back(compiledModel.create_infer_request());
+        idleRequests.push_back(i);
+    }
+
+    if (model->has_rt_info({"model_info"})) {
+        modelConfig = model->get_rt_info<ov::AnyMap>("model_info");
+    }
+    dispatcher = std::thread([this] { dispatch(); });
+}
+
+InferenceOutput BatchingInferenceAdapter::infer(const InferenceInput& input) {
+    return inferAsync(input).get();
+}
+
+std::future<InferenceOutput> BatchingInferenceAdapter::inferAsync(const InferenceInput& input) {
+    auto promise = std::make_shared<std::promise<InferenceOutput>>();
+    std::future<InferenceOutput> future = promise->get_future();
+    inferAsync(input, [promise](InferenceOutput output, std::exception_ptr error) {
+        if (error) {
+            promise->set_exception(error);
+        } else {
+            promise->set_value(std::move(output));
+        }
+    });
+    return future;
+}
+
+void BatchingInferenceAdapter::inferAsync(const InferenceInput& input, InferenceCallback callback) {
+    if (!dispatcher.joinable()) {
+        throw std::logic_error("BatchingInferenceAdapter has no model loaded");
+    }
+    if (input.empty()) {
+        throw std::invalid_argument("Inference input is empty");
+    }
+    auto request = std::make_unique<Request>();
+    request->rows = 0;
+    for (const auto& item : input) {
+        const ov::Shape& shape = item.second.get_shape();
+        if (shape.empty() || (request->rows && shape[0] != request->rows)) {
+            throw std::invalid_argument("Input tensors must have the same batch dimension");
+        }
+        request->rows = shape[0];
+        request->bucket += item.first + ':' + item.second.get_element_type().get_type_name();
+        for (size_t i = 1; i < shape.size(); ++i) {
+            request->bucket += ',' + std::to_string(shape[i]);
+        }
+        request->bucket += ';';
+    }
+    request->input = input;
+    request->deadline = std::chrono::steady_clock::now() + maxDelay;
+    request->callback = std::move(callback);
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        queue.push_back(std::move(request));
+    }
+    condition.notify_all();
+}
+
+void BatchingInferenceAdapter::warmup(const InferenceInput& input) {
+    if (!dispatcher.joinable()) {
+        throw std::logic_error("BatchingInferenceAdapter has no model loaded");
+    }
+    std::vector<size_t> batchSizes;
+    for (size_t size = 1; size <= maxBatchSize; size = padBatch ? size * 2 : size + 1) {
+        batchSizes.push_back(size);
+    }
+    if (padBatch && batchSizes.back() != maxBatchSize) {
+        batchSizes.push_back(maxBatchSize);
+    }
+    std::vector<InferenceInput> batches;
+    for (size_t size : batchSizes) {
+        InferenceInput batch;
+        for (const auto& item : input) {
+            ov::Shape shape = item.second.get_shape();
+            shape[0] *= size;
+            ov::Tensor packed(item.second.get_element_type(), shape);
+            uint8_t* dst = static_cast<uint8_t*>(packed.data());
+            for (size_t i = 0; i < size; ++i) {
+                std::memcpy(dst + i * item.second.get_byte_size(), item.second.data(), item.second.get_byte_size());
+            }
+            batch.emplace(item.first, packed);
+        }
+        batches.push_back(std::move(batch));
+    }
+
+    for (size_t index = 0; index < inferRequests.size(); ++index) {
+        {
+            // Take the request from the dispatcher, it may be serving other callers
+            std::unique_lock<std::mutex> lock{mutex};
+            condition.wait(lock, [this, index] {
+                return std::find(idleRequests.begin(), idleRequests.end(), index) != idleRequests.end();
+            });
+            idleRequests.erase(std::find(idleRequests.begin(), idleRequests.end(), index));
+        }
+        std::exception_ptr error;
+        try {
+            for (const InferenceInput& batch : batches) {
+                for (const auto& item : batch) {
+                    inferRequests[index].set_tensor(item.first, item.second);
+                }
+                inferRequests[index].infer();
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            idleRequests.push_back(index);
+            condition.notify_all();
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+void BatchingInferenceAdapter::dispatch() {
+    std::unique_lock<std::mutex> lock{mutex};
+    while (true) {
+        condition.wait(lock, [this] { return stopping || !queue.empty(); });
+        if (queue.empty()) {
+            break;
+        }
+        // Requests keep accumulating while all infer requests are busy
+        condition.wait(lock, [this] { return !idleRequests.empty(); });
+        std::vector<std::unique_ptr<Request>> batch = takeBatch(lock);
+        if (batch.empty()) {
+            continue;
+        }
+        size_t index = idleRequests.back();
+        idleRequests.pop_back();
+        lock.unlock();
+        run(index, std::move(batch));
+        lock.lock();
+    }
+    // Callbacks use the infer requests, wait for them before the adapter is destroyed
+    condition.wait(lock, [this] { return idleRequests.size() == inferRequests.size(); });
+}
+
+std::vector<std::unique_ptr<BatchingInferenceAdapter::Request>> BatchingInferenceAdapter::takeBatch(
+        std::unique_lock<std::mutex>& lock) {
+    const std::string bucket = queue.front()->bucket;
+    const std::chrono::steady_clock::time_point deadline = queue.front()->deadline;
+    size_t rows = 0;
+    for (const std::unique_ptr<Request>& request : queue) {
+        if (request->bucket == bucket) {
+            rows += request->rows;
+        }
+    }
+    if (rows < maxBatchSize && !stopping && std::chrono::steady_clock::now() < deadline) {
+        condition.wait_until(lock, deadline);
+        return {};
+    }
+
+    std::vector<std::unique_ptr<Request>> batch;
+    rows = 0;
+    for (auto it = queue.begin(); it != queue.end();) {
+        // A request larger than maxBatchSize goes alone
+        if ((*it)->bucket == bucket && (batch.empty() || rows + (*it)->rows <= maxBatchSize)) {
+            rows += (*it)->rows;
+            batch.push_back(std::move(*it));
+            it = queue.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return batch;
+}
+
+void BatchingInferenceAdapter::run(size_t requestIndex, std::vector<std::unique_ptr<Request>> batch) {
+    auto shared = std::make_shared<std::vector<std::unique_ptr<Request>>>(std::move(batch));
+    ov::InferRequest& request = inferRequests[requestIndex];
+    try {
+        size_t rows = 0;
+        for (const std::unique_ptr<Request>& item : *shared) {
+            rows += item->rows;
+        }
+        size_t padded = rows;
+        if (padBatch && rows < maxBatchSize) {
+            padded = 1;
+            while (padded < rows) {
+                padded *= 2;
+            }
+            padded = std::min(padded, maxBatchSize);
+        }
+        if (shared->size() == 1 && padded == rows) {
+            for (const auto& item : shared->front()->input) {
+                request.set_tensor(item.first, item.second);
+            }
+        } else {
+            for (const auto& item : shared->front()->input) {
+                ov::Shape shape = item.second.get_shape();
+                const size_t rowSize = item.second.get_byte_size() / shape[0];
+                shape[0] = padded;
+                ov::Tensor packed(item.second.get_element_type(), shape);
+                uint8_t* dst = static_cast<uint8_t*>(packed.data());
+                for (const std::unique_ptr<Request>& part : *shared) {
+                    const ov::Tensor& tensor = part->input.at(item.first);
+                    std::memcpy(dst, tensor.data(), tensor.get_byte_size());
+                    dst += tensor.get_byte_size();
+                }
+                std::memset(dst, 0, (padded - rows) * rowSize);
+                request.set_tensor(item.first, packed);
+            }
+        }
+        request.set_callback([this, requestIndex, shared](std::exception_ptr error) {
+            if (!error) {
+                try {
+                    scatter(inferRequests[requestIndex], *shared);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+            }
+            if (error) {
+                for (const std::unique_ptr<Request>& item : *shared) {
+                    item->callback({}, error);
+                }
+            }
+            // Notify under the lock, the adapter may be destroyed as soon as the request is idle
+            std::lock_guard<std::mutex> lock{mutex};
+            idleRequests.push_back(requestIndex);
+            condition.notify_all();
+        });
+        request.start_async();
+    } catch (...) {
+        for (const std::unique_ptr<Request>& item : *shared) {
+            item->callback({}, std::current_exception());
+        }
+        std::lock_guard<std::mutex> lock{mutex};
+        idleRequests.push_back(requestIndex);
+        condition.notify_all();
+    }
+}
+
+void BatchingInferenceAdapter::scatter(ov::InferRequest& request, std::vector<std::unique_ptr<Request>>& batch) {
+    // Build all outputs before calling back, so an error can still be reported to every caller
+    std::vector<InferenceOutput> outputs(batch.size());
+    for (const std::string& name : outputNames) {
+        const ov::Tensor batched = request.get_tensor(name);
+        ov::Shape shape = batched.get_shape();
+        const size_t rowSize = batched.get_byte_size() / shape[0];
+        const uint8_t* src = static_cast<const uint8_t*>(batched.data());
+        for (size_t i = 0; i < batch.size(); ++i) {
+            shape[0] = batch[i]->rows;
+            ov::Tensor tensor(batched.get_element_type(), shape);
+            std::memcpy(tensor.data(), src, tensor.get_byte_size());
+            src += batch[i]->rows * rowSize;
+            outputs[i].emplace(name, tensor);
+        }
+    }
+    for (size_t i = 0; i < batch.size(); ++i) {
+        batch[i]->callback(std::move(outputs[i]), nullptr);
+    }
+}
+
+ov::PartialShape BatchingInferenceAdapter::getInputShape(const std::string& inputName) const {
+    auto it = inputShapes.find(inputName);
+    if (it == inputShapes.end()) {
+        throw std::out_of_range("Model has no input " + inputName);
+    }
+    return it->second;
+}
+
+std::vector<std::string> BatchingInferenceAdapter::getInputNames() const {
+    return inputNames;
+}
+
+std::vector<std::string> BatchingInferenceAdapter::getOutputNames() const {
+    return outputNames;
+}
+
+const ov::AnyMap& BatchingInferenceAdapter::getModelConfig() const {
+    return modelConfig;
+}
+
+uint32_t BatchingInferenceAdapter::getOptimalNumberOfInferRequests() const {
+    return static_cast<uint32_t>(inferRequests.size());
+}
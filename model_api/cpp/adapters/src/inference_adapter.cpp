@@ -0,0 +1,31 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "adapters/inference_adapter.h"
+
+#include <exception>
+#include <utility>
+
+void InferenceAdapter::inferAsync(const InferenceInput& input, InferenceCallback callback) {
+    InferenceOutput output;
+    std::exception_ptr error;
+    try {
+        output = infer(input);
+    } catch (...) {
+        error = std::current_exception();
+    }
+    callback(std::move(output), error);
+}
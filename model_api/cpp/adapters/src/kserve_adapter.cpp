@@ -0,0 +1,769 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "adapters/kserve_adapter.h"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include <openvino/openvino.hpp>
+#include <utils/slog.hpp>
+
+namespace {
+#ifdef _WIN32
+using SocketHandle = SOCKET;
+constexpr SocketHandle INVALID_SOCKET_HANDLE = INVALID_SOCKET;
+
+void closeSocket(SocketHandle socket) {
+    closesocket(socket);
+}
+
+void setBlocking(SocketHandle socket, bool blocking) {
+    u_long nonBlocking = blocking ? 0 : 1;
+    ioctlsocket(socket, FIONBIO, &nonBlocking);
+}
+
+bool connectInProgress() {
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+}
+
+bool timedOut() {
+    return WSAGetLastError() == WSAETIMEDOUT;
+}
+
+int pollSocket(pollfd& fd, int timeout) {
+    return WSAPoll(&fd, 1, timeout);
+}
+
+struct WinsockInit {
+    WinsockInit() {
+        WSADATA data;
+        if (WSAStartup(MAKEWORD(2, 2), &data) != 0) {
+            throw std::runtime_error("WSAStartup failed");
+        }
+    }
+    ~WinsockInit() {
+        WSACleanup();
+    }
+};
+#else
+using SocketHandle = int;
+constexpr SocketHandle INVALID_SOCKET_HANDLE = -1;
+
+void closeSocket(SocketHandle socket) {
+    close(socket);
+}
+
+void setBlocking(SocketHandle socket, bool blocking) {
+    int flags = fcntl(socket, F_GETFL, 0);
+    fcntl(socket, F_SETFL, blocking ? flags & ~O_NONBLOCK : flags | O_NONBLOCK);
+}
+
+bool connectInProgress() {
+    return EINPROGRESS == errno;
+}
+
+// SO_RCVTIMEO and SO_SNDTIMEO make a blocking call fail as if the socket were non-blocking
+bool timedOut() {
+    return EAGAIN == errno || EWOULDBLOCK == errno;
+}
+
+int pollSocket(pollfd& fd, int timeout) {
+    return poll(&fd, 1, timeout);
+}
+#endif
+
+#ifdef MSG_NOSIGNAL
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;  // Report a closed connection as an error instead of SIGPIPE
+#else
+constexpr int SEND_FLAGS = 0;
+#endif
+
+// Thrown when a connection breaks. A request over a reused keep-alive connection is retried once because the
+// server may close idle connections at any moment
+struct ConnectionError : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+// A zero timeout leaves the socket blocking as long as the system does
+bool connectSocket(SocketHandle socket, const addrinfo& address, std::chrono::milliseconds timeout) {
+    if (timeout.count() <= 0) {
+        return connect(socket, address.ai_addr, static_cast<int>(address.ai_addrlen)) == 0;
+    }
+    setBlocking(socket, false);
+    bool connected = connect(socket, address.ai_addr, static_cast<int>(address.ai_addrlen)) == 0;
+    if (!connected && connectInProgress()) {
+        pollfd fd{};
+        fd.fd = socket;
+        fd.events = POLLOUT;
+        int error = 0;
+        socklen_t size = sizeof(error);
+        connected = pollSocket(fd, static_cast<int>(timeout.count())) == 1
+            && getsockopt(socket, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &size) == 0 && 0 == error;
+    }
+    setBlocking(socket, true);
+    return connected;
+}
+
+void setTimeouts(SocketHandle socket, std::chrono::milliseconds timeout) {
+    if (timeout.count() <= 0) {
+        return;
+    }
+#ifdef _WIN32
+    DWORD value = static_cast<DWORD>(timeout.count());
+#else
+    timeval value{};
+    value.tv_sec = static_cast<time_t>(timeout.count() / 1000);
+    value.tv_usec = static_cast<suseconds_t>(timeout.count() % 1000 * 1000);
+#endif
+    setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&value), sizeof(value));
+    setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// A timed out connection is in an unknown state, it's discarded and retried like a broken one
+ConnectionError receiveError(long received) {
+    if (received < 0 && timedOut()) {
+        return ConnectionError("Receiving a response from KServe server timed out");
+    }
+    return ConnectionError("KServe server closed the connection");
+}
+
+const std::map<std::string, ov::element::Type> kserve2ov = {
+    {"BOOL", ov::element::boolean},
+    {"UINT8", ov::element::u8},
+    {"UINT16", ov::element::u16},
+    {"UINT32", ov::element::u32},
+    {"UINT64", ov::element::u64},
+    {"INT8", ov::element::i8},
+    {"INT16", ov::element::i16},
+    {"INT32", ov::element::i32},
+    {"INT64", ov::element::i64},
+    {"FP16", ov::element::f16},
+    {"FP32", ov::element::f32},
+    {"FP64", ov::element::f64},
+    {"BF16", ov::element::bf16},
+};
+
+ov::element::Type toElementType(const std::string& datatype) {
+    auto it = kserve2ov.find(datatype);
+    if (it == kserve2ov.end()) {
+        throw std::runtime_error("Unsupported KServe datatype: " + datatype);
+    }
+    return it->second;
+}
+
+const std::string& toDatatype(const ov::element::Type& type) {
+    for (const auto& item : kserve2ov) {
+        if (item.second == type) {
+            return item.first;
+        }
+    }
+    throw std::runtime_error("Element type " + type.get_type_name() + " can't be sent to KServe server");
+}
+
+ov::PartialShape toPartialShape(const nlohmann::json& shape) {
+    std::vector<ov::Dimension> dims;
+    for (const nlohmann::json& dim : shape) {
+        int64_t value = dim.get<int64_t>();
+        dims.push_back(value < 0 ? ov::Dimension::dynamic() : ov::Dimension(value));
+    }
+    return ov::PartialShape(dims);
+}
+
+ov::AnyMap toAnyMap(const nlohmann::json& object) {
+    ov::AnyMap map;
+    for (const auto& item : object.items()) {
+        if (item.value().is_object()) {
+            map[item.key()] = toAnyMap(item.value());
+        } else if (item.value().is_string()) {
+            map[item.key()] = item.value().get<std::string>();
+        } else {
+            map[item.key()] = item.value().dump();
+        }
+    }
+    return map;
+}
+
+template <typename T>
+void fillFromJson(const nlohmann::json& data, ov::Tensor& tensor) {
+    T* ptr = tensor.data<T>();
+    size_t i = 0;
+    for (const nlohmann::json& value : data) {
+        if (i >= tensor.get_size()) {
+            break;
+        }
+        ptr[i++] = value.get<T>();
+    }
+}
+
+// Fallback for servers ignoring the binary_data request parameter
+void fillFromJson(const nlohmann::json& data, ov::Tensor& tensor) {
+    switch (static_cast<ov::element::Type_t>(tensor.get_element_type())) {
+        case ov::element::Type_t::f32: return fillFromJson<float>(data, tensor);
+        case ov::element::Type_t::f64: return fillFromJson<double>(data, tensor);
+        case ov::element::Type_t::i8: return fillFromJson<int8_t>(data, tensor);
+        case ov::element::Type_t::i16: return fillFromJson<int16_t>(data, tensor);
+        case ov::element::Type_t::i32: return fillFromJson<int32_t>(data, tensor);
+        case ov::element::Type_t::i64: return fillFromJson<int64_t>(data, tensor);
+        case ov::element::Type_t::u8: return fillFromJson<uint8_t>(data, tensor);
+        case ov::element::Type_t::u16: return fillFromJson<uint16_t>(data, tensor);
+        case ov::element::Type_t::u32: return fillFromJson<uint32_t>(data, tensor);
+        case ov::element::Type_t::u64: return fillFromJson<uint64_t>(data, tensor);
+        case ov::element::Type_t::boolean: return fillFromJson<bool>(data, tensor);
+        default: throw std::runtime_error("JSON data of " + tensor.get_element_type().get_type_name() + " outputs isn't supported");
+    }
+}
+
+struct HttpResponse {
+    int status = 0;
+    bool keepAlive = true;
+    size_t inferenceHeaderLength = 0;  // The JSON part of the body, the rest is binary tensor data
+    std::vector<uint8_t> body;
+};
+
+std::string lowercase(std::string str) {
+    std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return str;
+}
+
+std::string trim(const std::string& str) {
+    size_t begin = str.find_first_not_of(" \t");
+    if (begin == std::string::npos) {
+        return {};
+    }
+    return str.substr(begin, str.find_last_not_of(" \t") - begin + 1);
+}
+
+void throwOnError(const HttpResponse& response) {
+    if (response.status >= 200 && response.status < 300) {
+        return;
+    }
+    std::string message(response.body.begin(), response.body.end());
+    nlohmann::json error = nlohmann::json::parse(message, nullptr, false);
+    if (!error.is_discarded() && error.contains("error") && error["error"].is_string()) {
+        message = error["error"].get<std::string>();
+    }
+    throw std::runtime_error("KServe server responded with " + std::to_string(response.status) + ": " + message);
+}
+}  // namespace
+
+struct KServeInferenceAdapter::Connection {
+    SocketHandle socket = INVALID_SOCKET_HANDLE;
+    std::vector<char> readBuffer = std::vector<char>(64 * 1024);
+    size_t readBegin = 0;
+    size_t readEnd = 0;
+    std::string requestHeader;  // Reused between requests
+    HttpResponse response;
+
+    Connection(const std::string& host, const std::string& port, std::chrono::milliseconds ioTimeout) {
+#ifdef _WIN32
+        static WinsockInit winsockInit;
+#endif
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* addresses = nullptr;
+        if (getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0) {
+            throw ConnectionError("Can't resolve " + host + ":" + port);
+        }
+        for (addrinfo* address = addresses; address; address = address->ai_next) {
+            socket = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+            if (socket == INVALID_SOCKET_HANDLE) {
+                continue;
+            }
+            if (connectSocket(socket, *address, ioTimeout)) {
+                break;
+            }
+            closeSocket(socket);
+            socket = INVALID_SOCKET_HANDLE;
+        }
+        freeaddrinfo(addresses);
+        if (socket == INVALID_SOCKET_HANDLE) {
+            throw ConnectionError("Can't connect to " + host + ":" + port);
+        }
+        // Requests are written in several pieces, don't delay them
+        int noDelay = 1;
+        setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+        setTimeouts(socket, ioTimeout);
+#ifdef SO_NOSIGPIPE
+        int noSigPipe = 1;
+        setsockopt(socket, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+    }
+
+    ~Connection() {
+        closeSocket(socket);
+    }
+
+    void sendAll(const void* data, size_t size) {
+        const char* ptr = static_cast<const char*>(data);
+        while (size > 0) {
+            int chunk = static_cast<int>(std::min<size_t>(size, 1 << 30));
+            auto sent = send(socket, ptr, chunk, SEND_FLAGS);
+            if (sent <= 0) {
+                throw ConnectionError(sent < 0 && timedOut() ? "Sending a request to KServe server timed out"
+                                                             : "Failed to send a request to KServe server");
+            }
+            ptr += sent;
+            size -= static_cast<size_t>(sent);
+        }
+    }
+
+    void fill() {
+        if (readBegin == readEnd) {
+            readBegin = readEnd = 0;
+        }
+        auto received = recv(socket, readBuffer.data() + readEnd, static_cast<int>(readBuffer.size() - readEnd), 0);
+        if (received <= 0) {
+            throw receiveError(static_cast<long>(received));
+        }
+        readEnd += static_cast<size_t>(received);
+    }
+
+    std::string readLine() {
+        std::string line;
+        while (true) {
+            const char* begin = readBuffer.data() + readBegin;
+            const char* end = readBuffer.data() + readEnd;
+            const char* newline = std::find(begin, end, '\n');
+            line.append(begin, newline);
+            if (newline != end) {
+                readBegin += newline - begin + 1;
+                if (!line.empty() && line.back() == '\r') {
+                    line.pop_back();
+                }
+                return line;
+            }
+            readBegin = readEnd;
+            if (line.size() > 64 * 1024) {
+                throw std::runtime_error("Too long HTTP header line");
+            }
+            fill();
+        }
+    }
+
+    void readExact(uint8_t* dst, size_t size) {
+        while (size > 0) {
+            if (readBegin == readEnd) {
+                // Large bodies go directly to the destination bypassing the read buffer
+                if (size >= readBuffer.size()) {
+                    auto received = recv(socket, reinterpret_cast<char*>(dst), static_cast<int>(std::min<size_t>(size, 1 << 30)), 0);
+                    if (received <= 0) {
+                        throw receiveError(static_cast<long>(received));
+                    }
+                    dst += received;
+                    size -= static_cast<size_t>(received);
+                    continue;
+                }
+                fill();
+            }
+            size_t chunk = std::min(size, readEnd - readBegin);
+            std::memcpy(dst, readBuffer.data() + readBegin, chunk);
+            readBegin += chunk;
+            dst += chunk;
+            size -= chunk;
+        }
+    }
+
+    void sendRequest(const std::string& method, const std::string& path, const std::string& host,
+                     const std::string& json = {}, const InferenceInput* tensors = nullptr) {
+        size_t contentLength = json.size();
+        if (tensors) {
+            for (const auto& item : *tensors) {
+                contentLength += item.second.get_byte_size();
+            }
+        }
+        requestHeader.clear();
+        requestHeader += method + " " + path + " HTTP/1.1\r\nHost: " + host + "\r\n";
+        if (tensors) {
+            requestHeader += "Content-Type: application/octet-stream\r\nInference-Header-Content-Length: ";
+            requestHeader += std::to_string(json.size()) + "\r\n";
+        } else if (!json.empty()) {
+            requestHeader += "Content-Type: application/json\r\n";
+        }
+        requestHeader += "Content-Length: " + std::to_string(contentLength) + "\r\n\r\n";
+        requestHeader += json;
+        sendAll(requestHeader.data(), requestHeader.size());
+        if (tensors) {
+            // Tensor data is sent from the tensors directly
+            for (const auto& item : *tensors) {
+                sendAll(item.second.data(), item.second.get_byte_size());
+            }
+        }
+    }
+
+    HttpResponse& readResponse() {
+        response.status = 0;
+        response.keepAlive = true;
+        response.inferenceHeaderLength = 0;
+        response.body.clear();
+
+        std::string statusLine = readLine();
+        size_t space = statusLine.find(' ');
+        if (statusLine.compare(0, 5, "HTTP/") != 0 || space == std::string::npos) {
+            throw std::runtime_error("Malformed HTTP response: " + statusLine);
+        }
+        response.status = std::stoi(statusLine.substr(space + 1, 3));
+        if (statusLine.compare(0, 8, "HTTP/1.0") == 0) {
+            response.keepAlive = false;
+        }
+
+        size_t contentLength = 0;
+        bool chunked = false;
+        bool hasInferenceHeaderLength = false;
+        for (std::string line = readLine(); !line.empty(); line = readLine()) {
+            size_t colon = line.find(':');
+            if (colon == std::string::npos) {
+                continue;
+            }
+            std::string name = lowercase(line.substr(0, colon));
+            std::string value = trim(line.substr(colon + 1));
+            if ("content-length" == name) {
+                contentLength = std::stoull(value);
+            } else if ("transfer-encoding" == name) {
+                chunked = lowercase(value).find("chunked") != std::string::npos;
+            } else if ("connection" == name) {
+                std::string connection = lowercase(value);
+                if ("close" == connection) {
+                    response.keepAlive = false;
+                } else if ("keep-alive" == connection) {
+                    response.keepAlive = true;
+                }
+            } else if ("inference-header-content-length" == name) {
+                response.inferenceHeaderLength = std::stoull(value);
+                hasInferenceHeaderLength = true;
+            }
+        }
+
+        if (chunked) {
+            for (size_t size = std::stoull(readLine(), nullptr, 16); size > 0; size = std::stoull(readLine(), nullptr, 16)) {
+                size_t offset = response.body.size();
+                response.body.resize(offset + size);
+                readExact(response.body.data() + offset, size);
+                readLine();
+            }
+            while (!readLine().empty()) {}  // Trailers
+        } else {
+            response.body.resize(contentLength);
+            readExact(response.body.data(), contentLength);
+        }
+        if (!hasInferenceHeaderLength) {
+            response.inferenceHeaderLength = response.body.size();
+        }
+        if (response.inferenceHeaderLength > response.body.size()) {
+            throw std::runtime_error("Inference-Header-Content-Length exceeds the response size");
+        }
+        return response;
+    }
+};
+
+namespace {
+std::string inferenceHeader(const InferenceInput& input, const std::vector<std::string>& outputNames) {
+    nlohmann::json header;
+    nlohmann::json& inputs = header["inputs"] = nlohmann::json::array();
+    for (const auto& item : input) {
+        const ov::Shape& shape = item.second.get_shape();
+        inputs.push_back({
+            {"name", item.first},
+            {"shape", std::vector<size_t>(shape.begin(), shape.end())},
+            {"datatype", toDatatype(item.second.get_element_type())},
+            {"parameters", {{"binary_data_size", item.second.get_byte_size()}}},
+        });
+    }
+    nlohmann::json& outputs = header["outputs"] = nlohmann::json::array();
+    for (const std::string& name : outputNames) {
+        outputs.push_back({{"name", name}, {"parameters", {{"binary_data", true}}}});
+    }
+    return header.dump();
+}
+
+void parseOutputs(const HttpResponse& response, InferenceOutput& output) {
+    throwOnError(response);
+    const char* json = reinterpret_cast<const char*>(response.body.data());
+    nlohmann::json header = nlohmann::json::parse(json, json + response.inferenceHeaderLength);
+    size_t binaryOffset = response.inferenceHeaderLength;
+    for (const nlohmann::json& item : header.at("outputs")) {
+        ov::element::Type type = toElementType(item.at("datatype").get<std::string>());
+        ov::Shape shape(item.at("shape").get<std::vector<size_t>>());
+        ov::Tensor& tensor = output[item.at("name").get<std::string>()];
+        if (!tensor || tensor.get_element_type() != type || tensor.get_shape() != shape) {
+            tensor = ov::Tensor(type, shape);
+        }
+        if (item.contains("parameters") && item["parameters"].contains("binary_data_size")) {
+            size_t size = item["parameters"]["binary_data_size"].get<size_t>();
+            if (size != tensor.get_byte_size() || size > response.body.size() - binaryOffset) {
+                throw std::runtime_error("Binary data size of output " + item.at("name").get<std::string>() + " doesn't match its shape");
+            }
+            std::memcpy(tensor.data(), response.body.data() + binaryOffset, size);
+            binaryOffset += size;
+        } else {
+            fillFromJson(item.at("data"), tensor);
+        }
+    }
+}
+}  // namespace
+
+KServeInferenceAdapter::KServeInferenceAdapter(const std::string& target, size_t maxConnections,
+                                               std::chrono::milliseconds ioTimeout)
+    : maxConnections(std::max<size_t>(maxConnections, 1)), ioTimeout(ioTimeout) {
+    // <address>:<port>/models/<model_name>[:<model_version>]
+    size_t modelsPos = target.find("/models/");
+    size_t portPos = target.rfind(':', modelsPos);
+    if (modelsPos == std::string::npos || portPos == std::string::npos) {
+        throw std::invalid_argument("Model URL must have the format <address>:<port>/models/<model_name>[:<model_version>], got " + target);
+    }
+    host = target.substr(0, portPos);
+    if (host.size() > 2 && '[' == host.front() && ']' == host.back()) {
+        host = host.substr(1, host.size() - 2);  // IPv6 literal
+    }
+    port = target.substr(portPos + 1, modelsPos - portPos - 1);
+    std::string model = target.substr(modelsPos + std::string("/models/").size());
+    size_t versionPos = model.find(':');
+    modelName = model.substr(0, versionPos);
+    if (versionPos != std::string::npos) {
+        modelVersion = model.substr(versionPos + 1);
+    }
+    modelPath = "/v2/models/" + modelName;
+    if (!modelVersion.empty()) {
+        modelPath += "/versions/" + modelVersion;
+    }
+
+    readMetadata();
+}
+
+KServeInferenceAdapter::~KServeInferenceAdapter() = default;
+
+void KServeInferenceAdapter::readMetadata() {
+    slog::info << "Reading model metadata from " << host << ":" << port << modelPath << slog::endl;
+    bool reused;
+    std::unique_ptr<Connection> connection = acquire(reused);
+    connection->sendRequest("GET", modelPath, host + ":" + port);
+    HttpResponse& response = connection->readResponse();
+    throwOnError(response);
+    nlohmann::json metadata = nlohmann::json::parse(response.body.begin(), response.body.end());
+    for (const nlohmann::json& input : metadata.at("inputs")) {
+        const std::string& name = input.at("name").get_ref<const std::string&>();
+        inputNames.push_back(name);
+        inputShapes[name] = toPartialShape(input.at("shape"));
+    }
+    for (const nlohmann::json& output : metadata.at("outputs")) {
+        outputNames.push_back(output.at("name").get<std::string>());
+    }
+    // OVMS exposes rt_info of the model in the metadata
+    if (metadata.contains("rt_info") && metadata["rt_info"].contains("model_info")) {
+        modelConfig = toAnyMap(metadata["rt_info"]["model_info"]);
+    }
+    if (response.keepAlive) {
+        release(std::move(connection));
+    } else {
+        discard(std::move(connection));
+    }
+}
+
+std::unique_ptr<KServeInferenceAdapter::Connection> KServeInferenceAdapter::acquire(bool& reused) {
+    std::unique_lock<std::mutex> lock{poolMutex};
+    poolCondition.wait(lock, [this] { return !idleConnections.empty() || openConnections < maxConnections; });
+    if (!idleConnections.empty()) {
+        std::unique_ptr<Connection> connection = std::move(idleConnections.back());
+        idleConnections.pop_back();
+        reused = true;
+        return connection;
+    }
+    ++openConnections;
+    lock.unlock();
+    reused = false;
+    try {
+        return std::make_unique<Connection>(host, port, ioTimeout);
+    } catch (...) {
+        discard(nullptr);
+        throw;
+    }
+}
+
+void KServeInferenceAdapter::release(std::unique_ptr<Connection> connection) {
+    {
+        std::lock_guard<std::mutex> lock{poolMutex};
+        idleConnections.push_back(std::move(connection));
+    }
+    poolCondition.notify_one();
+}
+
+void KServeInferenceAdapter::discard(std::unique_ptr<Connection> connection) {
+    connection.reset();
+    {
+        std::lock_guard<std::mutex> lock{poolMutex};
+        --openConnections;
+    }
+    poolCondition.notify_one();
+}
+
+InferenceOutput KServeInferenceAdapter::infer(const InferenceInput& input) {
+    InferenceOutput output;
+    infer(input, output);
+    return output;
+}
+
+void KServeInferenceAdapter::infer(const InferenceInput& input, InferenceOutput& output) {
+    const std::string header = inferenceHeader(input, outputNames);
+    const std::string path = modelPath + "/infer";
+    for (bool retry = true;; retry = false) {
+        bool reused;
+        std::unique_ptr<Connection> connection = acquire(reused);
+        try {
+            connection->sendRequest("POST", path, host + ":" + port, header, &input);
+            HttpResponse& response = connection->readResponse();
+            // Release the connection before parsing, so a server error doesn't leak it
+            bool keepAlive = response.keepAlive;
+            try {
+                parseOutputs(response, output);
+            } catch (...) {
+                keepAlive ? release(std::move(connection)) : discard(std::move(connection));
+                throw;
+            }
+            keepAlive ? release(std::move(connection)) : discard(std::move(connection));
+            return;
+        } catch (const ConnectionError&) {
+            if (connection) {
+                discard(std::move(connection));
+            }
+            if (!(retry && reused)) {
+                throw;
+            }
+        } catch (...) {
+            if (connection) {
+                discard(std::move(connection));
+            }
+            throw;
+        }
+    }
+}
+
+void KServeInferenceAdapter::inferAsync(const InferenceInput& input, InferenceCallback callback) {
+    asyncWorkers.submit(input, std::move(callback));
+}
+
+std::vector<InferenceOutput> KServeInferenceAdapter::inferPipelined(const std::vector<InferenceInput>& inputs) {
+    std::vector<InferenceOutput> outputs(inputs.size());
+    if (inputs.empty()) {
+        return outputs;
+    }
+    const std::string path = modelPath + "/infer";
+    const std::string hostHeader = host + ":" + port;
+    // Unsupported inputs throw here, before the reader waits for responses
+    std::vector<std::string> headers;
+    headers.reserve(inputs.size());
+    for (const InferenceInput& input : inputs) {
+        headers.push_back(inferenceHeader(input, outputNames));
+    }
+    bool reused;
+    std::unique_ptr<Connection> connection = acquire(reused);
+    Connection& conn = *connection;
+    auto shutdownConnection = [&conn] {
+#ifdef _WIN32
+        shutdown(conn.socket, SD_BOTH);
+#else
+        shutdown(conn.socket, SHUT_RDWR);
+#endif
+    };
+    // Responses are read while requests are still being written, otherwise both sides may block on full socket
+    // buffers
+    std::future<void> sending = std::async(std::launch::async, [&] {
+        try {
+            for (size_t i = 0; i < inputs.size(); ++i) {
+                conn.sendRequest("POST", path, hostHeader, headers[i], &inputs[i]);
+            }
+        } catch (...) {
+            shutdownConnection();  // Unblocks the reader waiting for responses which won't come
+            throw;
+        }
+    });
+    std::exception_ptr error;
+    size_t received = 0;
+    try {
+        for (; received < inputs.size(); ++received) {
+            HttpResponse& response = conn.readResponse();
+            parseOutputs(response, outputs[received]);
+            if (!response.keepAlive && received + 1 < inputs.size()) {
+                throw std::runtime_error("KServe server closed a pipelined connection");
+            }
+        }
+    } catch (...) {
+        error = std::current_exception();
+        shutdownConnection();  // Unblocks the sending thread
+    }
+    try {
+        sending.get();
+    } catch (...) {
+        // The reader failed because of the shutdown, the sender's error is the cause
+        error = std::current_exception();
+    }
+    if (error) {
+        discard(std::move(connection));
+        std::rethrow_exception(error);
+    }
+    conn.response.keepAlive ? release(std::move(connection)) : discard(std::move(connection));
+    return outputs;
+}
+
+void KServeInferenceAdapter::loadModel(const std::shared_ptr<const ov::Model>&, ov::Core&, const std::string&, const ov::AnyMap&) {
+    throw std::logic_error("KServeInferenceAdapter can't load a model, the model is loaded by the server");
+}
+
+ov::PartialShape KServeInferenceAdapter::getInputShape(const std::string& inputName) const {
+    auto it = inputShapes.find(inputName);
+    if (it == inputShapes.end()) {
+        throw std::out_of_range("Model has no input " + inputName);
+    }
+    return it->second;
+}
+
+std::vector<std::string> KServeInferenceAdapter::getInputNames() const {
+    return inputNames;
+}
+
+std::vector<std::string> KServeInferenceAdapter::getOutputNames() const {
+    return outputNames;
+}
+
+const ov::AnyMap& KServeInferenceAdapter::getModelConfig() const {
+    return modelConfig;
+}
@@ -17,38 +17,163 @@
 #include "adapters/openvino_adapter.h"
 #include <openvino/openvino.hpp>
 #include <utils/slog.hpp>
+#include <utils/xai_outputs.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <utility>
 #include <vector>
 
 void OpenVINOInferenceAdapter::loadModel(const std::shared_ptr<const ov::Model>& model, ov::Core& core,
                                                             const std::string& device, const ov::AnyMap& compilationConfig) {
     slog::info << "Loading model to the plugin" << slog::endl;
 
-    compiledModel = core.compile_model(model, device, compilationConfig);
-    inferRequest = compiledModel.create_infer_request();
+    modelConfig = model->has_rt_info({"model_info"}) ? model->get_rt_info<ov::AnyMap>("model_info") : ov::AnyMap{};
+    compiledModel = core.compile_model(pruneXaiOutputs(model), device, compilationConfig);
+    {
+        // The pool is filled at once, so warmup() reaches every request the plugin can run in parallel
+        optimalRequests = std::max(1u, compiledModel.get_property(ov::optimal_number_of_infer_requests));
+        outputBindings = OutputBindings(compiledModel, optimalRequests);
+        std::lock_guard<std::mutex> lock{requestsMutex};
+        idleRequests.clear();
+        requests.clear();
+        for (uint32_t i = 0; i < optimalRequests; ++i) {
+            requests.push_back(compiledModel.create_infer_request());
+            idleRequests.push_back(&requests.back());
+        }
+    }
 
     initInputsOutputs();
+}
+
+InferenceOutput OpenVINOInferenceAdapter::infer(const InferenceInput& input) {
+    InferenceOutput output;
+    infer(input, output);
+    return output;
+}
 
-    if (model->has_rt_info({"model_info"})) {
-        modelConfig = model->get_rt_info<ov::AnyMap>("model_info");
+void OpenVINOInferenceAdapter::infer(const InferenceInput& input, InferenceOutput& output) {
+    ov::InferRequest& request = acquireRequest();
+    try {
+        outputBindings.setTensors(request, input, output);
+
+        // Do inference
+        request.infer();
+
+        outputBindings.copyDynamicOutputs(request, output);
+    } catch (...) {
+        releaseRequest(request);
+        throw;
     }
+    releaseRequest(request);
 }
 
-InferenceOutput OpenVINOInferenceAdapter::infer(const InferenceInput& input) {
-    // Fill input blobs
-    for (const auto& item : input) {
-        inferRequest.set_tensor(item.first, item.second);
+void OpenVINOInferenceAdapter::inferAsync(const InferenceInput& input, InferenceCallback callback) {
+    ov::InferRequest* request = nullptr;
+    {
+        std::lock_guard<std::mutex> lock{requestsMutex};
+        if (idleRequests.empty()) {
+            // Waiting here would block the executor of a coroutine, the request released next starts the call
+            pendingStarts.push_back([this, input, callback](ov::InferRequest& released) {
+                try {
+                    startAsync(released, input, callback);
+                } catch (...) {
+                    callback(InferenceOutput{}, std::current_exception());
+                }
+            });
+            return;
+        }
+        request = idleRequests.back();
+        idleRequests.pop_back();
     }
+    startAsync(*request, input, std::move(callback));
+}
 
-    // Do inference
-    inferRequest.infer();
+void OpenVINOInferenceAdapter::startAsync(ov::InferRequest& request, const InferenceInput& input,
+                                          InferenceCallback callback) {
+    try {
+        auto output = std::make_shared<InferenceOutput>();
+        outputBindings.setTensors(request, input, *output);
+        request.set_callback([this, &request, output, callback](std::exception_ptr error) {
+            if (!error) {
+                try {
+                    outputBindings.copyDynamicOutputs(request, *output);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+            }
+            // The callback may start the next inference, so this request is released first. It may start a queued
+            // call right away, OpenVINO keeps the running callback alive if the request gets a new one meanwhile
+            releaseRequest(request);
+            callback(error ? InferenceOutput{} : std::move(*output), error);
+        });
+        request.start_async();
+    } catch (...) {
+        releaseRequest(request);
+        throw;
+    }
+}
 
-    // Processing output blobs
-    InferenceOutput output;
-    for (const auto& item : outputNames) {
-        output.emplace(item, inferRequest.get_tensor(item));
+void OpenVINOInferenceAdapter::warmup(const InferenceInput& input) {
+    std::vector<ov::InferRequest*> warming;
+    {
+        std::lock_guard<std::mutex> lock{requestsMutex};
+        warming.swap(idleRequests);
+    }
+    if (warming.empty()) {
+        warming.push_back(&acquireRequest());
+    }
+    std::exception_ptr error;
+    for (ov::InferRequest* request : warming) {
+        try {
+            // Static outputs of the request may still be held by the caller of the previous infer(), so the
+            // request gets its own. Their buffers are recycled once the output map is destroyed
+            InferenceOutput output;
+            outputBindings.setTensors(*request, input, output);
+            request->infer();
+        } catch (...) {
+            error = std::current_exception();
+            break;
+        }
+    }
+    for (ov::InferRequest* request : warming) {
+        releaseRequest(*request);
     }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
 
-    return output;
+ov::InferRequest& OpenVINOInferenceAdapter::acquireRequest() {
+    // More requests than the plugin runs in parallel only add memory, so callers wait for an idle one
+    std::unique_lock<std::mutex> lock{requestsMutex};
+    requestReleased.wait(lock, [this] { return !idleRequests.empty(); });
+    ov::InferRequest* request = idleRequests.back();
+    idleRequests.pop_back();
+    return *request;
+}
+
+void OpenVINOInferenceAdapter::releaseRequest(ov::InferRequest& request) {
+    std::function<void(ov::InferRequest&)> start;
+    {
+        std::lock_guard<std::mutex> lock{requestsMutex};
+        if (pendingStarts.empty()) {
+            idleRequests.push_back(&request);
+        } else {
+            start = std::move(pendingStarts.front());
+            pendingStarts.pop_front();
+        }
+    }
+    if (start) {
+        // Queued calls don't wait for an idle request, so they get the released one before infer() callers
+        start(request);
+    } else {
+        requestReleased.notify_one();
+    }
 }
 
 ov::PartialShape OpenVINOInferenceAdapter::getInputShape(const std::string& inputName) const {
@@ -56,6 +181,8 @@ ov::PartialShape OpenVINOInferenceAdapter::getInputShape(const std::string& inpu
 }
 
 void OpenVINOInferenceAdapter::initInputsOutputs() {
+    inputNames.clear();
+    outputNames.clear();
     for (const auto& input : compiledModel.inputs()) {
         inputNames.push_back(input.get_any_name());
     }
@@ -76,3 +203,7 @@ std::vector<std::string> OpenVINOInferenceAdapter::getOutputNames() const {
 const ov::AnyMap& OpenVINOInferenceAdapter::getModelConfig() const {
     return modelConfig;
 }
+
+uint32_t OpenVINOInferenceAdapter::getOptimalNumberOfInferRequests() const {
+    return optimalRequests;
+}
@@ -0,0 +1,137 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "adapters/output_bindings.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace {
+// Keeps the buffers of released output tensors and gives them to the next tensors of the same size. Tensors hold a
+// copy of the allocator and with it the cache, so the cache outlives the adapter while callers keep outputs. Buffers
+// beyond maxBytes are freed, so the cache holds about as many outputs as the requests produce at once
+class RecyclingAllocator {
+public:
+    explicit RecyclingAllocator(size_t maxBytes) : cache(std::make_shared<Cache>()) {
+        cache->maxBytes = maxBytes;
+    }
+
+    void* allocate(size_t bytes, size_t alignment) {
+        alignment = std::max(alignment, alignof(std::max_align_t));
+        {
+            std::lock_guard<std::mutex> lock{cache->mutex};
+            auto iter = cache->released.find({bytes, alignment});
+            if (iter != cache->released.end()) {
+                void* buffer = iter->second;
+                cache->released.erase(iter);
+                cache->bytes -= bytes;
+                return buffer;
+            }
+        }
+        return ::operator new(bytes, std::align_val_t(alignment));
+    }
+
+    void deallocate(void* buffer, size_t bytes, size_t alignment) {
+        alignment = std::max(alignment, alignof(std::max_align_t));
+        {
+            std::lock_guard<std::mutex> lock{cache->mutex};
+            if (cache->bytes + bytes <= cache->maxBytes) {
+                cache->released.emplace(std::make_pair(bytes, alignment), buffer);
+                cache->bytes += bytes;
+                return;
+            }
+        }
+        ::operator delete(buffer, std::align_val_t(alignment));
+    }
+
+    bool is_equal(const RecyclingAllocator& other) const {
+        return cache == other.cache;
+    }
+
+private:
+    struct Cache {
+        ~Cache() {
+            for (const auto& item : released) {
+                ::operator delete(item.second, std::align_val_t(item.first.second));
+            }
+        }
+
+        std::mutex mutex;
+        std::multimap<std::pair<size_t, size_t>, void*> released;
+        size_t bytes = 0;
+        size_t maxBytes = 0;
+    };
+
+    std::shared_ptr<Cache> cache;
+};
+}
+
+OutputBindings::OutputBindings(const ov::CompiledModel& compiledModel, size_t requests)
+    : outputs(compiledModel.outputs()) {
+    // Only static outputs are recycled. Callers release outputs while next requests run, so twice the outputs of
+    // all requests are kept
+    size_t staticBytes = 0;
+    for (const ov::Output<const ov::Node>& output : outputs) {
+        outputNames.push_back(output.get_any_name());
+        if (output.get_partial_shape().is_static()) {
+            staticBytes += ov::shape_size(output.get_shape()) * output.get_element_type().size();
+        }
+    }
+    allocator = ov::Allocator(RecyclingAllocator{2 * requests * staticBytes});
+}
+
+void OutputBindings::setTensors(ov::InferRequest& request, const InferenceInput& input, InferenceOutput& output) const {
+    // Fill input blobs
+    for (const auto& item : input) {
+        request.set_tensor(item.first, item.second);
+    }
+
+    // The request is reused by other threads, so static outputs are written to tensors given to the caller.
+    // Assigning to existing keys keeps the map nodes, new tensors take buffers released by previous callers
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        if (outputs[i].get_partial_shape().is_static()) {
+            ov::Tensor& tensor = output[outputNames[i]];
+            if (!tensor || tensor.get_element_type() != outputs[i].get_element_type()
+                    || tensor.get_size() != ov::shape_size(outputs[i].get_shape())) {
+                tensor = ov::Tensor(outputs[i].get_element_type(), outputs[i].get_shape(), allocator);
+            }
+            request.set_tensor(outputs[i], tensor);
+        }
+    }
+}
+
+void OutputBindings::copyDynamicOutputs(ov::InferRequest& request, InferenceOutput& output) const {
+    // Dynamic outputs are allocated by the plugin, they are copied. Their sizes change from call to call, so the
+    // copies aren't recycled
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        if (outputs[i].get_partial_shape().is_dynamic()) {
+            const ov::Tensor result = request.get_tensor(outputs[i]);
+            ov::Tensor& tensor = output[outputNames[i]];
+            if (!tensor || tensor.get_element_type() != result.get_element_type()
+                    || tensor.get_shape() != result.get_shape()) {
+                tensor = ov::Tensor(result.get_element_type(), result.get_shape());
+            }
+            std::memcpy(tensor.data(), result.data(), result.get_byte_size());
+        }
+    }
+}
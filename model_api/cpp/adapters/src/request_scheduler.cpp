@@ -0,0 +1,200 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "adapters/request_scheduler.h"
+
+#include <string>
+#include <utility>
+
+#include <openvino/openvino.hpp>
+
+#include "adapters/async_infer_workers.h"
+
+struct RequestScheduler::Ticket {
+    enum State { WAITING, GRANTED, SHED };
+
+    Clock::time_point deadline;
+    uint64_t sequence;
+    Clock::time_point submitted;
+    State state = WAITING;
+};
+
+bool RequestScheduler::TicketOrder::operator()(const Ticket* lhs, const Ticket* rhs) const {
+    if (lhs->deadline != rhs->deadline) {
+        return lhs->deadline < rhs->deadline;
+    }
+    return lhs->sequence < rhs->sequence;
+}
+
+namespace {
+// Wrappers created from it submit all requests to one priority class
+class ScheduledAdapter : public InferenceAdapter {
+public:
+    ScheduledAdapter(std::shared_ptr<RequestScheduler> scheduler, size_t priorityClass, std::chrono::microseconds budget)
+        : scheduler(std::move(scheduler)), priorityClass(priorityClass), budget(budget) {}
+
+    InferenceOutput infer(const InferenceInput& input) override {
+        RequestScheduler::Clock::time_point now = RequestScheduler::Clock::now();
+        RequestScheduler::Clock::time_point deadline = RequestScheduler::Clock::time_point::max();
+        if (budget < std::chrono::duration_cast<std::chrono::microseconds>(deadline - now)) {
+            deadline = now + budget;
+        }
+        return scheduler->infer(input, priorityClass, deadline);
+    }
+
+    void inferAsync(const InferenceInput& input, InferenceCallback callback) override {
+        asyncWorkers.submit(input, std::move(callback));
+    }
+
+    void loadModel(const std::shared_ptr<const ov::Model>&, ov::Core&, const std::string&, const ov::AnyMap&) override {
+        throw std::logic_error("The model of a scheduled adapter is loaded to the adapter given to RequestScheduler");
+    }
+
+    // Warm-up happens before serving, it isn't scheduled
+    void warmup(const InferenceInput& input) override {
+        scheduler->getAdapter()->warmup(input);
+    }
+
+    ov::PartialShape getInputShape(const std::string& inputName) const override {
+        return scheduler->getAdapter()->getInputShape(inputName);
+    }
+
+    std::vector<std::string> getInputNames() const override {
+        return scheduler->getAdapter()->getInputNames();
+    }
+
+    std::vector<std::string> getOutputNames() const override {
+        return scheduler->getAdapter()->getOutputNames();
+    }
+
+    const ov::AnyMap& getModelConfig() const override {
+        return scheduler->getAdapter()->getModelConfig();
+    }
+
+private:
+    std::shared_ptr<RequestScheduler> scheduler;
+    size_t priorityClass;
+    std::chrono::microseconds budget;
+    AsyncInferWorkers asyncWorkers{*this};  // Must stay the last member
+};
+}  // namespace
+
+RequestScheduler::RequestScheduler(std::shared_ptr<InferenceAdapter> adapter, size_t maxConcurrency,
+                                   std::vector<PriorityClass> classes)
+    : adapter(std::move(adapter)), maxConcurrency(maxConcurrency) {
+    if (!this->adapter || 0 == maxConcurrency || classes.empty()) {
+        throw std::invalid_argument("RequestScheduler requires an adapter, positive concurrency and a priority class");
+    }
+    for (const PriorityClass& config : classes) {
+        this->classes.emplace_back();
+        this->classes.back().config = config;
+    }
+}
+
+std::shared_ptr<InferenceAdapter> RequestScheduler::createAdapter(size_t priorityClass) {
+    if (priorityClass >= classes.size()) {
+        throw std::out_of_range("Unknown priority class " + std::to_string(priorityClass));
+    }
+    return std::make_shared<ScheduledAdapter>(shared_from_this(), priorityClass, classes[priorityClass].config.deadline);
+}
+
+InferenceOutput RequestScheduler::infer(const InferenceInput& input, size_t priorityClass, Clock::time_point deadline) {
+    if (priorityClass >= classes.size()) {
+        throw std::out_of_range("Unknown priority class " + std::to_string(priorityClass));
+    }
+    ClassState& state = classes[priorityClass];
+    Ticket ticket;
+    ticket.deadline = deadline;
+    ticket.submitted = Clock::now();
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        if (state.waiting.size() >= state.config.maxQueueDepth) {
+            ++state.rejected;
+            throw QueueFullError("Queue of priority class " + std::to_string(priorityClass) + " is full");
+        }
+        ticket.sequence = sequence++;
+        state.waiting.insert(&ticket);
+        grant(ticket.submitted);
+        if (Clock::time_point::max() == deadline) {
+            condition.wait(lock, [&ticket] { return ticket.state != Ticket::WAITING; });
+        } else if (!condition.wait_until(lock, deadline, [&ticket] { return ticket.state != Ticket::WAITING; })) {
+            state.waiting.erase(&ticket);
+            ticket.state = Ticket::SHED;
+            ++state.shed;
+        }
+        if (Ticket::SHED == ticket.state) {
+            throw DeadlineExceededError("Request of priority class " + std::to_string(priorityClass)
+                + " missed its deadline in the queue");
+        }
+    }
+
+    auto finish = [this, &state] {
+        std::lock_guard<std::mutex> lock{mutex};
+        --running;
+        --state.running;
+        ++state.completed;
+        grant(Clock::now());
+    };
+    try {
+        InferenceOutput output = adapter->infer(input);
+        finish();
+        return output;
+    } catch (...) {
+        finish();
+        throw;
+    }
+}
+
+// Starts waiting requests while there are free slots, sheds expired ones on the way. Called with the mutex locked
+void RequestScheduler::grant(Clock::time_point now) {
+    bool changed = false;
+    for (ClassState& state : classes) {
+        while (running < maxConcurrency && !state.waiting.empty()) {
+            Ticket* ticket = *state.waiting.begin();
+            state.waiting.erase(state.waiting.begin());
+            changed = true;
+            if (ticket->deadline <= now) {
+                ticket->state = Ticket::SHED;
+                ++state.shed;
+                continue;
+            }
+            ticket->state = Ticket::GRANTED;
+            ++running;
+            ++state.running;
+            ++state.started;
+            Clock::duration wait = now - ticket->submitted;
+            state.totalWait += wait;
+            if (wait > state.maxWait) {
+                state.maxWait = wait;
+            }
+        }
+    }
+    if (changed) {
+        condition.notify_all();
+    }
+}
+
+std::vector<RequestScheduler::ClassStatistics> RequestScheduler::getStatistics() const {
+    using Ms = std::chrono::duration<double, std::milli>;
+    std::lock_guard<std::mutex> lock{mutex};
+    std::vector<ClassStatistics> statistics;
+    for (const ClassState& state : classes) {
+        statistics.push_back({state.waiting.size(), state.running, state.completed, state.rejected, state.shed,
+                              state.started ? Ms(state.totalWait).count() / state.started : 0.0,
+                              Ms(state.maxWait).count()});
+    }
+    return statistics;
+}
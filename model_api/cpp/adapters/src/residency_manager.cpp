@@ -0,0 +1,350 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "adapters/residency_manager.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <openvino/openvino.hpp>
+#include <openvino/op/constant.hpp>
+#include <utils/memory_usage.hpp>
+#include <utils/slog.hpp>
+#include <utils/xai_outputs.hpp>
+
+ResidencyManager::ResidencyManager(size_t budgetBytes, std::string cacheDir)
+    : budgetBytes(budgetBytes), cacheDir(std::move(cacheDir)) {}
+
+ResidencyManager::Statistics ResidencyManager::getStatistics() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return {hits, misses, evictions, lru.size(), residentBytes, loads ? totalLoadMs / loads : 0.0, maxLoadMs};
+}
+
+// Releases least recently used idle models until requiredBytes fit into the budget. Called with the mutex locked
+void ResidencyManager::evict(size_t requiredBytes, const ResidentInferenceAdapter* keep) {
+    auto it = lru.end();
+    while (it != lru.begin() && residentBytes + requiredBytes > budgetBytes) {
+        --it;
+        ResidentInferenceAdapter* adapter = *it;
+        if (adapter != keep && 0 == adapter->inflight) {
+            slog::info << "Evicting a compiled model of " << adapter->modelBytes << " bytes" << slog::endl;
+            it = lru.erase(it);
+            release(*adapter);
+            ++evictions;
+        }
+    }
+}
+
+// The adapter must be removed from lru already. Called with the mutex locked
+void ResidencyManager::release(ResidentInferenceAdapter& adapter) {
+    adapter.idleRequests.clear();
+    adapter.compiledModel = {};
+    // Recycled output buffers are freed once callers release their outputs
+    adapter.outputBindings = {};
+    adapter.resident = false;
+    residentBytes -= adapter.modelBytes;
+}
+
+ResidentInferenceAdapter::ResidentInferenceAdapter(std::shared_ptr<ResidencyManager> manager)
+    : manager(std::move(manager)) {
+    if (!this->manager) {
+        throw std::invalid_argument("ResidentInferenceAdapter requires a ResidencyManager");
+    }
+}
+
+ResidentInferenceAdapter::~ResidentInferenceAdapter() {
+    asyncWorkers.stop();
+    {
+        std::lock_guard<std::mutex> lock{manager->mutex};
+        if (resident) {
+            manager->lru.erase(position);
+            manager->release(*this);
+        }
+    }
+    if (!blobPath.empty()) {
+        std::remove(blobPath.c_str());
+    }
+}
+
+void ResidentInferenceAdapter::loadModel(const std::shared_ptr<const ov::Model>& model, ov::Core& core,
+                                         const std::string& device, const ov::AnyMap& compilationConfig) {
+    if (this->model) {
+        throw std::logic_error("ResidentInferenceAdapter already has a model loaded");
+    }
+    // The stored model is compiled again after every eviction
+    this->model = pruneXaiOutputs(model);
+    this->core = core;
+    this->device = device;
+    this->compilationConfig = compilationConfig;
+    for (const auto& input : this->model->inputs()) {
+        inputNames.push_back(input.get_any_name());
+    }
+    for (const auto& output : this->model->outputs()) {
+        outputNames.push_back(output.get_any_name());
+    }
+    if (model->has_rt_info({"model_info"})) {
+        modelConfig = model->get_rt_info<ov::AnyMap>("model_info");
+    }
+    for (const std::shared_ptr<ov::Node>& node : this->model->get_ordered_ops()) {
+        if (auto constant = std::dynamic_pointer_cast<ov::op::v0::Constant>(node)) {
+            weightsBytes += constant->get_byte_size();
+        }
+    }
+    std::unique_lock<std::mutex> lock{manager->mutex};
+    if (!manager->cacheDir.empty()) {
+        blobPath = manager->cacheDir + "/model_" + std::to_string(manager->nextId++) + ".blob";
+    }
+    load(lock);
+}
+
+// Called with the mutex of the manager locked, it is unlocked while the model is compiled
+void ResidentInferenceAdapter::load(std::unique_lock<std::mutex>& lock) {
+    loading = true;
+    manager->evict(std::max(modelBytes, weightsBytes), this);
+    const std::vector<InferenceInput> warmups = warmupInputs;
+    lock.unlock();
+    auto start = std::chrono::steady_clock::now();
+    ov::CompiledModel compiled;
+    std::vector<ov::InferRequest> requests;
+    OutputBindings bindings;
+    size_t bytes = 0;
+    std::exception_ptr error;
+    try {
+        compiled = compile(bytes, requests);
+        bindings = OutputBindings(compiled, requests.size());
+        // A reloaded model serves warm, the same as the one warmup() was called for
+        for (ov::InferRequest& request : requests) {
+            for (const InferenceInput& input : warmups) {
+                InferenceOutput output;
+                bindings.setTensors(request, input, output);
+                request.infer();
+            }
+        }
+    } catch (...) {
+        error = std::current_exception();
+    }
+    double loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    lock.lock();
+    loading = false;
+    manager->condition.notify_all();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    compiledModel = std::move(compiled);
+    idleRequests = std::move(requests);
+    requestCount = idleRequests.size();
+    outputBindings = std::move(bindings);
+    modelBytes = bytes;
+    resident = true;
+    manager->residentBytes += bytes;
+    manager->lru.push_front(this);
+    position = manager->lru.begin();
+    ++manager->loads;
+    manager->totalLoadMs += loadMs;
+    manager->maxLoadMs = std::max(manager->maxLoadMs, loadMs);
+    manager->evict(0, this);
+}
+
+ov::CompiledModel ResidentInferenceAdapter::compile(size_t& bytes, std::vector<ov::InferRequest>& requests) {
+    std::lock_guard<std::mutex> loadLock{manager->loadMutex};
+    size_t before = residentMemoryBytes();
+    ov::CompiledModel compiled;
+    if (exported) {
+        slog::info << "Importing model " << blobPath << slog::endl;
+        std::ifstream blob{blobPath, std::ios::binary};
+        compiled = core.import_model(blob, device, compilationConfig);
+    } else {
+        slog::info << "Loading model to the plugin" << slog::endl;
+        compiled = core.compile_model(model, device, compilationConfig);
+    }
+    // The requests hold intermediate buffers, so they are part of the memory of the model
+    uint32_t nireq = std::max(1u, compiled.get_property(ov::optimal_number_of_infer_requests));
+    for (uint32_t i = 0; i < nireq; ++i) {
+        requests.push_back(compiled.create_infer_request());
+    }
+    size_t after = residentMemoryBytes();
+    bytes = std::max(after > before ? after - before : size_t(0), weightsBytes);
+
+    if (!blobPath.empty() && !exported) {
+        try {
+            std::ofstream blob{blobPath, std::ios::binary};
+            compiled.export_model(blob);
+            exported = bool(blob);
+        } catch (const std::exception& error) {
+            slog::warn << "The compiled model can't be exported, it will be compiled again: " << error.what()
+                       << slog::endl;
+        }
+    }
+    return compiled;
+}
+
+// Called with the mutex of the manager locked
+void ResidentInferenceAdapter::enter(std::unique_lock<std::mutex>& lock) {
+    if (!model) {
+        throw std::logic_error("ResidentInferenceAdapter has no model loaded");
+    }
+    manager->condition.wait(lock, [this] { return !loading; });
+    if (resident) {
+        ++manager->hits;
+        manager->lru.splice(manager->lru.begin(), manager->lru, position);
+    } else {
+        ++manager->misses;
+        load(lock);
+    }
+    // Counted before it waits, so the model isn't evicted under the waiting callers
+    ++inflight;
+}
+
+ov::InferRequest ResidentInferenceAdapter::acquire() {
+    std::unique_lock<std::mutex> lock{manager->mutex};
+    enter(lock);
+    // More requests than the plugin runs in parallel only add memory, so callers wait for an idle one
+    manager->condition.wait(lock, [this] { return !idleRequests.empty(); });
+    ov::InferRequest request = std::move(idleRequests.back());
+    idleRequests.pop_back();
+    return request;
+}
+
+void ResidentInferenceAdapter::release(ov::InferRequest request) {
+    {
+        std::lock_guard<std::mutex> lock{manager->mutex};
+        idleRequests.push_back(std::move(request));
+        --inflight;
+        // Models which were busy during the last load may be over the budget
+        manager->evict(0, nullptr);
+    }
+    // The condition is shared by the adapters of the manager
+    manager->condition.notify_all();
+}
+
+InferenceOutput ResidentInferenceAdapter::infer(const InferenceInput& input) {
+    InferenceOutput output;
+    infer(input, output);
+    return output;
+}
+
+void ResidentInferenceAdapter::infer(const InferenceInput& input, InferenceOutput& output) {
+    ov::InferRequest request = acquire();
+    try {
+        // The compiled model and its bindings stay resident while the request is counted in inflight
+        outputBindings.setTensors(request, input, output);
+        request.infer();
+        outputBindings.copyDynamicOutputs(request, output);
+    } catch (...) {
+        release(std::move(request));
+        throw;
+    }
+    release(std::move(request));
+}
+
+void ResidentInferenceAdapter::warmup(const InferenceInput& input) {
+    std::vector<ov::InferRequest> warming;
+    {
+        std::unique_lock<std::mutex> lock{manager->mutex};
+        enter(lock);
+        // warmup() of the wrapper may be called again with the same shapes
+        bool known = std::any_of(warmupInputs.begin(), warmupInputs.end(), [&input](const InferenceInput& kept) {
+            return std::equal(kept.begin(), kept.end(), input.begin(), input.end(),
+                              [](const InferenceInput::value_type& lhs, const InferenceInput::value_type& rhs) {
+                                  return lhs.first == rhs.first && lhs.second.get_shape() == rhs.second.get_shape();
+                              });
+        });
+        if (!known) {
+            warmupInputs.push_back(input);
+        }
+        manager->condition.wait(lock, [this] { return !idleRequests.empty(); });
+        warming.swap(idleRequests);
+    }
+    std::exception_ptr error;
+    for (ov::InferRequest& request : warming) {
+        try {
+            // Static outputs of the request may still be held by the caller of the previous infer()
+            InferenceOutput output;
+            outputBindings.setTensors(request, input, output);
+            request.infer();
+        } catch (...) {
+            error = std::current_exception();
+            break;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock{manager->mutex};
+        for (ov::InferRequest& request : warming) {
+            idleRequests.push_back(std::move(request));
+        }
+        --inflight;
+        manager->evict(0, nullptr);
+    }
+    manager->condition.notify_all();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void ResidentInferenceAdapter::inferAsync(const InferenceInput& input, InferenceCallback callback) {
+    asyncWorkers.submit(input, std::move(callback));
+}
+
+bool ResidentInferenceAdapter::isResident() const {
+    std::lock_guard<std::mutex> lock{manager->mutex};
+    return resident;
+}
+
+size_t ResidentInferenceAdapter::getModelBytes() const {
+    std::lock_guard<std::mutex> lock{manager->mutex};
+    return modelBytes;
+}
+
+size_t ResidentInferenceAdapter::getInferRequestCount() const {
+    std::lock_guard<std::mutex> lock{manager->mutex};
+    return requestCount;
+}
+
+void ResidentInferenceAdapter::evict() {
+    std::lock_guard<std::mutex> lock{manager->mutex};
+    if (resident && 0 == inflight) {
+        manager->lru.erase(position);
+        manager->release(*this);
+        ++manager->evictions;
+    }
+}
+
+ov::PartialShape ResidentInferenceAdapter::getInputShape(const std::string& inputName) const {
+    if (!model) {
+        throw std::logic_error("ResidentInferenceAdapter has no model loaded");
+    }
+    return model->input(inputName).get_partial_shape();
+}
+
+std::vector<std::string> ResidentInferenceAdapter::getInputNames() const {
+    return inputNames;
+}
+
+std::vector<std::string> ResidentInferenceAdapter::getOutputNames() const {
+    return outputNames;
+}
+
+const ov::AnyMap& ResidentInferenceAdapter::getModelConfig() const {
+    return modelConfig;
+}
@@ -0,0 +1,227 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "adapters/sharded_adapter.h"
+#include "adapters/output_bindings.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+#include <openvino/openvino.hpp>
+#include <utils/slog.hpp>
+#include <utils/xai_outputs.hpp>
+
+struct ShardedInferenceAdapter::CompiledShard {
+    std::string device;
+    ov::CompiledModel compiledModel;
+    OutputBindings outputBindings;
+    std::vector<ov::InferRequest> requests;
+    std::vector<size_t> idleRequests;
+    size_t outstanding = 0;
+    size_t completed = 0;
+    std::chrono::steady_clock::duration busy = std::chrono::steady_clock::duration::zero();
+    std::chrono::steady_clock::time_point busySince;
+};
+
+ShardedInferenceAdapter::ShardedInferenceAdapter(std::vector<Shard> shards) : shards(std::move(shards)) {
+    if (this->shards.empty()) {
+        throw std::invalid_argument("ShardedInferenceAdapter requires at least one shard");
+    }
+}
+
+ShardedInferenceAdapter::~ShardedInferenceAdapter() = default;
+
+void ShardedInferenceAdapter::loadModel(const std::shared_ptr<const ov::Model>& model, ov::Core& core,
+                                        const std::string& device, const ov::AnyMap& compilationConfig) {
+    compiledShards.clear();
+    const std::shared_ptr<const ov::Model> pruned = pruneXaiOutputs(model);
+    for (const Shard& shard : shards) {
+        auto compiled = std::make_unique<CompiledShard>();
+        compiled->device = shard.device.empty() ? device : shard.device;
+        ov::AnyMap config = compilationConfig;
+        for (const auto& item : shard.compilationConfig) {
+            config[item.first] = item.second;
+        }
+        slog::info << "Loading model to the plugin, shard " << compiledShards.size() << " on " << compiled->device
+                   << slog::endl;
+        compiled->compiledModel = core.compile_model(pruned, compiled->device, config);
+        uint32_t nireq = compiled->compiledModel.get_property(ov::optimal_number_of_infer_requests);
+        for (uint32_t i = 0; i < std::max(nireq, 1u); ++i) {
+            compiled->requests.push_back(compiled->compiledModel.create_infer_request());
+            compiled->idleRequests.push_back(i);
+        }
+        compiled->outputBindings = OutputBindings(compiled->compiledModel, compiled->requests.size());
+        compiledShards.push_back(std::move(compiled));
+    }
+
+    inputNames.clear();
+    outputNames.clear();
+    for (const auto& input : compiledShards.front()->compiledModel.inputs()) {
+        inputNames.push_back(input.get_any_name());
+    }
+    for (const auto& output : compiledShards.front()->compiledModel.outputs()) {
+        outputNames.push_back(output.get_any_name());
+    }
+    if (model->has_rt_info({"model_info"})) {
+        modelConfig = model->get_rt_info<ov::AnyMap>("model_info");
+    }
+    loadTime = std::chrono::steady_clock::now();
+}
+
+size_t ShardedInferenceAdapter::acquire(size_t& requestIndex) {
+    std::unique_lock<std::mutex> lock{mutex};
+    size_t best = compiledShards.size();
+    condition.wait(lock, [&] {
+        // Least outstanding requests relative to the shard size, a shard with more infer requests takes more work
+        for (size_t i = 0; i < compiledShards.size(); ++i) {
+            const CompiledShard& shard = *compiledShards[i];
+            if (shard.idleRequests.empty()) {
+                continue;
+            }
+            if (best == compiledShards.size() || shard.outstanding * compiledShards[best]->requests.size()
+                    < compiledShards[best]->outstanding * shard.requests.size()) {
+                best = i;
+            }
+        }
+        return best != compiledShards.size();
+    });
+    CompiledShard& shard = *compiledShards[best];
+    requestIndex = shard.idleRequests.back();
+    shard.idleRequests.pop_back();
+    if (0 == shard.outstanding++) {
+        shard.busySince = std::chrono::steady_clock::now();
+    }
+    return best;
+}
+
+void ShardedInferenceAdapter::release(size_t shardIndex, size_t requestIndex) {
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        CompiledShard& shard = *compiledShards[shardIndex];
+        shard.idleRequests.push_back(requestIndex);
+        ++shard.completed;
+        if (0 == --shard.outstanding) {
+            shard.busy += std::chrono::steady_clock::now() - shard.busySince;
+        }
+    }
+    // warmup() may wait for this particular request
+    condition.notify_all();
+}
+
+InferenceOutput ShardedInferenceAdapter::infer(const InferenceInput& input) {
+    InferenceOutput output;
+    infer(input, output);
+    return output;
+}
+
+void ShardedInferenceAdapter::infer(const InferenceInput& input, InferenceOutput& output) {
+    if (compiledShards.empty()) {
+        throw std::logic_error("ShardedInferenceAdapter has no model loaded");
+    }
+    size_t requestIndex;
+    size_t shardIndex = acquire(requestIndex);
+    CompiledShard& shard = *compiledShards[shardIndex];
+    ov::InferRequest& request = shard.requests[requestIndex];
+    try {
+        shard.outputBindings.setTensors(request, input, output);
+        request.infer();
+        shard.outputBindings.copyDynamicOutputs(request, output);
+    } catch (...) {
+        release(shardIndex, requestIndex);
+        throw;
+    }
+    release(shardIndex, requestIndex);
+}
+
+void ShardedInferenceAdapter::inferAsync(const InferenceInput& input, InferenceCallback callback) {
+    asyncWorkers.submit(input, std::move(callback));
+}
+
+void ShardedInferenceAdapter::warmup(const InferenceInput& input) {
+    if (compiledShards.empty()) {
+        throw std::logic_error("ShardedInferenceAdapter has no model loaded");
+    }
+    for (const std::unique_ptr<CompiledShard>& compiled : compiledShards) {
+        CompiledShard& shard = *compiled;
+        for (size_t index = 0; index < shard.requests.size(); ++index) {
+            {
+                std::unique_lock<std::mutex> lock{mutex};
+                condition.wait(lock, [&shard, index] {
+                    return std::find(shard.idleRequests.begin(), shard.idleRequests.end(), index) != shard.idleRequests.end();
+                });
+                shard.idleRequests.erase(std::find(shard.idleRequests.begin(), shard.idleRequests.end(), index));
+            }
+            std::exception_ptr error;
+            try {
+                ov::InferRequest& request = shard.requests[index];
+                // Static outputs of the request may still be held by the caller of the previous infer(), so the
+                // request gets its own
+                InferenceOutput output;
+                shard.outputBindings.setTensors(request, input, output);
+                request.infer();
+            } catch (...) {
+                error = std::current_exception();
+            }
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                shard.idleRequests.push_back(index);
+            }
+            condition.notify_all();
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+}
+
+std::vector<ShardedInferenceAdapter::ShardStatistics> ShardedInferenceAdapter::getShardStatistics() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    const auto now = std::chrono::steady_clock::now();
+    const double elapsed = std::chrono::duration<double>(now - loadTime).count();
+    std::vector<ShardStatistics> statistics;
+    for (const std::unique_ptr<CompiledShard>& shard : compiledShards) {
+        std::chrono::steady_clock::duration busy = shard->busy;
+        if (shard->outstanding) {
+            busy += now - shard->busySince;
+        }
+        statistics.push_back({shard->device, shard->requests.size(), shard->outstanding, shard->completed,
+                              elapsed > 0 ? std::chrono::duration<double>(busy).count() / elapsed : 0.0});
+    }
+    return statistics;
+}
+
+ov::PartialShape ShardedInferenceAdapter::getInputShape(const std::string& inputName) const {
+    if (compiledShards.empty()) {
+        throw std::logic_error("ShardedInferenceAdapter has no model loaded");
+    }
+    return compiledShards.front()->compiledModel.input(inputName).get_partial_shape();
+}
+
+std::vector<std::string> ShardedInferenceAdapter::getInputNames() const {
+    return inputNames;
+}
+
+std::vector<std::string> ShardedInferenceAdapter::getOutputNames() const {
+    return outputNames;
+}
+
+const ov::AnyMap& ShardedInferenceAdapter::getModelConfig() const {
+    return modelConfig;
+}
@@ -0,0 +1,929 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#ifdef __linux__
+#include "adapters/shm_adapter.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include <openvino/openvino.hpp>
+#include <utils/slog.hpp>
+#include <utils/xai_outputs.hpp>
+
+namespace {
+constexpr uint32_t CHANNEL_MAGIC = 0x4d48534d;  // "MSHM" in little endian
+constexpr uint32_t CHANNEL_VERSION = 1;
+// The server maps the memfd for the whole session, so its size must not change
+constexpr int MEMFD_SEALS = F_SEAL_SHRINK | F_SEAL_GROW;
+constexpr size_t MAX_SLOTS = 64;
+constexpr size_t MAX_TENSORS = 16;
+constexpr size_t MAX_NAME = 128;
+constexpr size_t MAX_RANK = 8;
+constexpr size_t DATA_ALIGNMENT = 64;
+constexpr size_t PAGE_SIZE = 4096;
+
+enum SlotStatus : uint32_t {
+    SLOT_OK = 0,
+    SLOT_ERROR = 1,
+};
+
+struct TensorDescriptor {
+    char name[MAX_NAME];
+    char elementType[16];  // ov::element::Type::get_type_name()
+    uint64_t rank;
+    uint64_t shape[MAX_RANK];
+    uint64_t offset;  // From the beginning of the slot
+    uint64_t size;
+};
+
+struct SlotHeader {
+    uint32_t status;
+    uint32_t inputCount;
+    uint32_t outputCount;
+    uint32_t reserved;
+    TensorDescriptor tensors[MAX_TENSORS];  // Inputs followed by outputs
+    char error[512];
+};
+
+// Single producer single consumer queue of slot indices. A slot is queued at most once, so MAX_SLOTS entries suffice
+struct Ring {
+    std::atomic<uint64_t> head;
+    std::atomic<uint64_t> tail;
+    uint32_t entries[MAX_SLOTS];
+
+    void push(uint32_t slot) {
+        uint64_t t = tail.load(std::memory_order_relaxed);
+        entries[t % MAX_SLOTS] = slot;
+        tail.store(t + 1, std::memory_order_release);
+    }
+
+    bool pop(uint32_t& slot) {
+        uint64_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        slot = entries[h % MAX_SLOTS];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+};
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared memory rings require lock free atomics");
+
+struct ChannelHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slotCount;
+    uint32_t reserved;
+    uint64_t slotSize;
+    Ring submissions;  // Client to server
+    Ring completions;  // Server to client
+};
+static_assert(sizeof(ChannelHeader) <= PAGE_SIZE, "ChannelHeader must fit the first page");
+
+size_t aligned(size_t offset, size_t alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+size_t mappingSize(size_t slotCount, size_t slotSize) {
+    return PAGE_SIZE + slotCount * slotSize;
+}
+
+uint8_t* slotData(uint8_t* mapping, size_t slotSize, uint32_t slot) {
+    return mapping + PAGE_SIZE + slot * slotSize;
+}
+
+constexpr size_t SLOT_DATA_OFFSET = (sizeof(SlotHeader) + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+
+std::runtime_error systemError(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+void signal(int eventFd) {
+    uint64_t one = 1;
+    while (write(eventFd, &one, sizeof(one)) < 0 && EINTR == errno) {}
+}
+
+void drain(int eventFd) {
+    uint64_t count;
+    while (read(eventFd, &count, sizeof(count)) < 0 && EINTR == errno) {}
+}
+
+// Messages are length prefixed JSON, file descriptors are attached to the length
+void sendMessage(int socket, const std::string& message, const std::vector<int>& fds = {}) {
+    uint32_t length = static_cast<uint32_t>(message.size());
+    iovec iov{&length, sizeof(length)};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    std::vector<char> control(CMSG_SPACE(sizeof(int) * fds.size()));
+    if (!fds.empty()) {
+        msg.msg_control = control.data();
+        msg.msg_controllen = control.size();
+        cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fds.size());
+        std::memcpy(CMSG_DATA(cmsg), fds.data(), sizeof(int) * fds.size());
+    }
+    if (sendmsg(socket, &msg, MSG_NOSIGNAL) != sizeof(length)) {
+        throw systemError("Failed to send a message");
+    }
+    for (size_t sent = 0; sent < message.size();) {
+        ssize_t chunk = send(socket, message.data() + sent, message.size() - sent, MSG_NOSIGNAL);
+        if (chunk <= 0) {
+            throw systemError("Failed to send a message");
+        }
+        sent += static_cast<size_t>(chunk);
+    }
+}
+
+std::string receiveMessage(int socket, std::vector<int>& fds) {
+    uint32_t length = 0;
+    iovec iov{&length, sizeof(length)};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * 4)];
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    if (recvmsg(socket, &msg, MSG_WAITALL | MSG_CMSG_CLOEXEC) != sizeof(length)) {
+        throw systemError("Failed to receive a message");
+    }
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (SOL_SOCKET == cmsg->cmsg_level && SCM_RIGHTS == cmsg->cmsg_type) {
+            size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            fds.resize(count);
+            std::memcpy(fds.data(), CMSG_DATA(cmsg), sizeof(int) * count);
+        }
+    }
+    if (length > 64 * 1024 * 1024) {
+        throw std::runtime_error("Message is too long");
+    }
+    std::string message(length, '\0');
+    if (length > 0 && recv(socket, &message[0], length, MSG_WAITALL) != static_cast<ssize_t>(length)) {
+        throw systemError("Failed to receive a message");
+    }
+    return message;
+}
+
+sockaddr_un socketAddress(const std::string& socketPath) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        throw std::invalid_argument("Socket path is too long: " + socketPath);
+    }
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+    return address;
+}
+
+void copyName(char (&dst)[MAX_NAME], const std::string& name) {
+    if (name.size() >= MAX_NAME) {
+        throw std::invalid_argument("Tensor name is too long: " + name);
+    }
+    std::strncpy(dst, name.c_str(), MAX_NAME);
+}
+
+void describe(TensorDescriptor& desc, const std::string& name, const ov::element::Type& type, const ov::Shape& shape,
+              uint64_t offset, uint64_t size) {
+    copyName(desc.name, name);
+    std::strncpy(desc.elementType, type.get_type_name().c_str(), sizeof(desc.elementType) - 1);
+    desc.elementType[sizeof(desc.elementType) - 1] = '\0';
+    if (shape.size() > MAX_RANK) {
+        throw std::invalid_argument("Tensor " + name + " has too many dimensions");
+    }
+    desc.rank = shape.size();
+    std::copy(shape.begin(), shape.end(), desc.shape);
+    desc.offset = offset;
+    desc.size = size;
+}
+
+// Returns a view of the tensor in the slot after checking that it doesn't exceed the slot
+ov::Tensor view(const TensorDescriptor& desc, uint8_t* slot, size_t slotSize) {
+    if (desc.rank > MAX_RANK || desc.offset > slotSize || desc.size > slotSize - desc.offset) {
+        throw std::runtime_error("Tensor descriptor is out of the slot");
+    }
+    ov::element::Type type{std::string(desc.elementType, strnlen(desc.elementType, sizeof(desc.elementType)))};
+    ov::Shape shape(desc.shape, desc.shape + desc.rank);
+    // A product of client dimensions may wrap around to the right size
+    uint64_t elements = 1;
+    for (uint64_t dim : shape) {
+        if (dim != 0 && elements > slotSize / dim) {
+            throw std::runtime_error("Tensor descriptor is out of the slot");
+        }
+        elements *= dim;
+    }
+    if (elements * type.size() != desc.size) {
+        throw std::runtime_error("Tensor descriptor size doesn't match its shape");
+    }
+    return ov::Tensor(type, shape, slot + desc.offset);
+}
+
+nlohmann::json toJson(const ov::AnyMap& map) {
+    nlohmann::json json = nlohmann::json::object();
+    for (const auto& item : map) {
+        if (item.second.is<ov::AnyMap>()) {
+            json[item.first] = toJson(item.second.as<ov::AnyMap>());
+        } else {
+            json[item.first] = item.second.as<std::string>();
+        }
+    }
+    return json;
+}
+
+ov::AnyMap toAnyMap(const nlohmann::json& json) {
+    ov::AnyMap map;
+    for (const auto& item : json.items()) {
+        if (item.value().is_object()) {
+            map[item.key()] = toAnyMap(item.value());
+        } else {
+            map[item.key()] = item.value().get<std::string>();
+        }
+    }
+    return map;
+}
+}  // namespace
+
+struct ShmInferenceServer::ServedModel {
+    ov::CompiledModel compiledModel;
+    nlohmann::json metadata;
+    std::vector<ov::InferRequest> requests;
+    std::vector<size_t> idleRequests;
+    std::mutex mutex;
+    std::condition_variable idleCondition;
+
+    size_t acquire() {
+        std::unique_lock<std::mutex> lock{mutex};
+        idleCondition.wait(lock, [this] { return !idleRequests.empty(); });
+        size_t index = idleRequests.back();
+        idleRequests.pop_back();
+        return index;
+    }
+
+    void release(size_t index) {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            idleRequests.push_back(index);
+        }
+        idleCondition.notify_one();
+    }
+};
+
+struct ShmInferenceServer::Session {
+    int socket;
+    int stopEvent;
+    int memfd = -1;
+    int requestEvent = -1;
+    int responseEvent = -1;
+    uint8_t* mapping = nullptr;
+    size_t size = 0;
+    ChannelHeader* channel = nullptr;
+    // The client can write to the channel header at any time, so the layout is taken from it once it is validated
+    uint32_t slotCount = 0;
+    size_t slotSize = 0;
+    ServedModel* model = nullptr;
+    std::thread thread;
+    std::atomic<bool> finished{false};
+
+    std::mutex completionMutex;
+    size_t inFlight = 0;
+    std::condition_variable inFlightCondition;
+    // Kept by the server, a slot submitted again before its completion is rejected. Guarded by completionMutex
+    std::vector<bool> slotBusy;
+
+    Session(int socket, int stopEvent) : socket(socket), stopEvent(stopEvent) {}
+
+    ~Session() {
+        if (thread.joinable()) {
+            thread.join();
+        }
+        if (mapping) {
+            munmap(mapping, size);
+        }
+        for (int fd : {memfd, requestEvent, responseEvent, socket}) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    void handshake(const std::map<std::string, std::unique_ptr<ServedModel>>& models) {
+        std::vector<int> fds;
+        nlohmann::json hello = nlohmann::json::parse(receiveMessage(socket, fds));
+        if (fds.size() == 3) {
+            memfd = fds[0];
+            requestEvent = fds[1];
+            responseEvent = fds[2];
+        } else {
+            for (int fd : fds) {
+                close(fd);
+            }
+            throw std::runtime_error("Client must pass a memfd and two eventfds");
+        }
+        auto it = models.find(hello.at("model").get<std::string>());
+        if (it == models.end()) {
+            throw std::runtime_error("Model " + hello.at("model").get<std::string>() + " is not served");
+        }
+        model = it->second.get();
+        size_t helloSlotCount = hello.at("slot_count").get<size_t>(), helloSlotSize = hello.at("slot_size").get<size_t>();
+        if (0 == helloSlotCount || helloSlotCount > MAX_SLOTS) {
+            throw std::runtime_error("Slot count must be in [1, " + std::to_string(MAX_SLOTS) + "]");
+        }
+        if (helloSlotSize <= SLOT_DATA_OFFSET || helloSlotSize > (SIZE_MAX - PAGE_SIZE) / helloSlotCount) {
+            throw std::runtime_error("Invalid slot size");
+        }
+        size = mappingSize(helloSlotCount, helloSlotSize);
+        // Accessing a mapping beyond the end of the memfd raises SIGBUS, the seals keep the client from shrinking it later
+        int seals = fcntl(memfd, F_GET_SEALS);
+        if (seals < 0 || (seals & MEMFD_SEALS) != MEMFD_SEALS) {
+            throw std::runtime_error("Client memory must be sealed against resizing");
+        }
+        struct stat memfdStat;
+        if (fstat(memfd, &memfdStat) != 0 || static_cast<size_t>(memfdStat.st_size) < size) {
+            throw std::runtime_error("Client memory is smaller than its slots");
+        }
+        void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0);
+        if (MAP_FAILED == ptr) {
+            throw systemError("Failed to map client memory");
+        }
+        mapping = static_cast<uint8_t*>(ptr);
+        channel = reinterpret_cast<ChannelHeader*>(mapping);
+        if (channel->magic != CHANNEL_MAGIC || channel->version != CHANNEL_VERSION || channel->slotCount != helloSlotCount
+                || channel->slotSize != helloSlotSize) {
+            throw std::runtime_error("Client memory has unexpected layout");
+        }
+        slotCount = static_cast<uint32_t>(helloSlotCount);
+        slotSize = helloSlotSize;
+        slotBusy.assign(slotCount, false);
+        sendMessage(socket, model->metadata.dump());
+    }
+
+    void serve() {
+        pollfd fds[] = {{requestEvent, POLLIN, 0}, {socket, POLLIN, 0}, {stopEvent, POLLIN, 0}};
+        while (true) {
+            if (poll(fds, 3, -1) < 0) {
+                if (EINTR == errno) {
+                    continue;
+                }
+                break;
+            }
+            if (fds[1].revents || fds[2].revents) {
+                break;  // The client disconnected or the server stops
+            }
+            if (fds[0].revents & POLLIN) {
+                drain(requestEvent);
+                // The client can rewrite head and tail of the ring at any time, so a wakeup takes at most slotCount
+                // entries. An entry pushed after drain() signals the event again
+                uint32_t slot;
+                for (uint32_t popped = 0; popped < slotCount && channel->submissions.pop(slot); ++popped) {
+                    if (stopping()) {
+                        break;
+                    }
+                    submit(slot);
+                }
+            }
+        }
+        // Callbacks write to the mapping, wait for them before it is unmapped
+        std::unique_lock<std::mutex> lock{completionMutex};
+        inFlightCondition.wait(lock, [this] { return 0 == inFlight; });
+        finished = true;
+    }
+
+    // submit() may wait for an infer request, so the stop and the disconnect are checked between submissions
+    bool stopping() {
+        pollfd fds[] = {{socket, POLLIN, 0}, {stopEvent, POLLIN, 0}};
+        return poll(fds, 2, 0) > 0;
+    }
+
+    // The slot header stays writable by the client during the request. Every value read from it is copied and
+    // validated once, and complete() only uses the copies
+    void submit(uint32_t slot) {
+        if (slot >= slotCount) {
+            slog::warn << "Client submitted invalid slot " << slot << slog::endl;
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock{completionMutex};
+            if (slotBusy[slot]) {
+                // The slot belongs to the request in flight, it is neither failed nor published twice
+                slog::warn << "Client submitted slot " << slot << " which is in flight" << slog::endl;
+                return;
+            }
+            slotBusy[slot] = true;
+        }
+        uint8_t* data = slotData(mapping, slotSize, slot);
+        SlotHeader* header = reinterpret_cast<SlotHeader*>(data);
+        size_t index = model->acquire();
+        ov::InferRequest& request = model->requests[index];
+        try {
+            // Every input must be replaced, otherwise the request keeps a view of another slot
+            const uint32_t inputCount = header->inputCount;
+            if (inputCount != model->compiledModel.inputs().size() || inputCount > MAX_TENSORS) {
+                throw std::runtime_error("Request must contain all model inputs");
+            }
+            size_t end = SLOT_DATA_OFFSET;
+            for (uint32_t i = 0; i < inputCount; ++i) {
+                const TensorDescriptor desc = header->tensors[i];
+                request.set_tensor(std::string(desc.name, strnlen(desc.name, MAX_NAME)), view(desc, data, slotSize));
+                end = std::max<size_t>(end, desc.offset + desc.size);
+            }
+            // Let the plugin write static outputs directly to the slot
+            size_t offset = aligned(end, DATA_ALIGNMENT);
+            for (const ov::Output<const ov::Node>& output : model->compiledModel.outputs()) {
+                if (output.get_partial_shape().is_dynamic()) {
+                    continue;
+                }
+                ov::Shape shape = output.get_shape();
+                size_t size = ov::shape_size(shape) * output.get_element_type().size();
+                if (offset + size > slotSize) {
+                    // Replace a view of another slot left from a previous request
+                    request.set_tensor(output, ov::Tensor(output.get_element_type(), shape));
+                    continue;
+                }
+                request.set_tensor(output, ov::Tensor(output.get_element_type(), shape, data + offset));
+                offset = aligned(offset + size, DATA_ALIGNMENT);
+            }
+            {
+                std::lock_guard<std::mutex> lock{completionMutex};
+                ++inFlight;
+            }
+            const size_t outputOffset = aligned(end, DATA_ALIGNMENT);
+            request.set_callback([this, slot, index, inputCount, outputOffset](std::exception_ptr error) {
+                complete(slot, index, inputCount, outputOffset, error);
+            });
+            request.start_async();
+        } catch (const std::exception& error) {
+            fail(header, error.what());
+            model->release(index);
+            publish(slot);
+        }
+    }
+
+    // inputCount and outputOffset were validated by submit()
+    void complete(uint32_t slot, size_t index, uint32_t inputCount, size_t outputOffset, std::exception_ptr error) {
+        uint8_t* data = slotData(mapping, slotSize, slot);
+        SlotHeader* header = reinterpret_cast<SlotHeader*>(data);
+        try {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+            ov::InferRequest& request = model->requests[index];
+            size_t offset = outputOffset;
+            const auto& outputs = model->compiledModel.outputs();
+            if (inputCount + outputs.size() > MAX_TENSORS) {
+                throw std::runtime_error("Too many output tensors");
+            }
+            header->outputCount = static_cast<uint32_t>(outputs.size());
+            for (size_t i = 0; i < outputs.size(); ++i) {
+                ov::Tensor tensor = request.get_tensor(outputs[i]);
+                size_t size = tensor.get_byte_size();
+                if (offset > slotSize || size > slotSize - offset) {
+                    throw std::runtime_error("Outputs don't fit the slot, increase slot size");
+                }
+                if (tensor.data() != data + offset) {
+                    std::memcpy(data + offset, tensor.data(), size);
+                }
+                describe(header->tensors[inputCount + i], outputs[i].get_any_name(), tensor.get_element_type(),
+                         tensor.get_shape(), offset, size);
+                offset = aligned(offset + size, DATA_ALIGNMENT);
+            }
+            header->status = SLOT_OK;
+        } catch (const std::exception& e) {
+            fail(header, e.what());
+        }
+        model->release(index);
+        publish(slot);
+        {
+            std::lock_guard<std::mutex> lock{completionMutex};
+            --inFlight;
+        }
+        inFlightCondition.notify_all();
+    }
+
+    static void fail(SlotHeader* header, const char* what) {
+        header->status = SLOT_ERROR;
+        header->outputCount = 0;
+        std::strncpy(header->error, what, sizeof(header->error) - 1);
+        header->error[sizeof(header->error) - 1] = '\0';
+    }
+
+    void publish(uint32_t slot) {
+        {
+            std::lock_guard<std::mutex> lock{completionMutex};
+            // The client may submit the slot again once it sees the completion
+            slotBusy[slot] = false;
+            channel->completions.push(slot);
+        }
+        signal(responseEvent);
+    }
+};
+
+ShmInferenceServer::ShmInferenceServer(const std::string& socketPath) : socketPath(socketPath) {
+    stopEvent = eventfd(0, EFD_CLOEXEC);
+    if (stopEvent < 0) {
+        throw systemError("Failed to create eventfd");
+    }
+    listener = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listener < 0) {
+        throw systemError("Failed to create socket");
+    }
+    sockaddr_un address = socketAddress(socketPath);
+    unlink(socketPath.c_str());
+    // Only the user running the server may connect. Nobody can connect before listen(), so chmod() leaves no window
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+            || chmod(socketPath.c_str(), S_IRUSR | S_IWUSR) != 0 || listen(listener, 64) != 0) {
+        close(listener);
+        close(stopEvent);
+        throw systemError("Failed to listen on " + socketPath);
+    }
+}
+
+ShmInferenceServer::~ShmInferenceServer() {
+    stop();
+    sessions.clear();
+    close(listener);
+    close(stopEvent);
+    unlink(socketPath.c_str());
+}
+
+void ShmInferenceServer::addModel(const std::string& name, const std::shared_ptr<const ov::Model>& model, ov::Core& core,
+                                  const std::string& device, const ov::AnyMap& compilationConfig) {
+    slog::info << "Loading model " << name << " to the plugin" << slog::endl;
+    auto served = std::make_unique<ServedModel>();
+    served->compiledModel = core.compile_model(pruneXaiOutputs(model), device, compilationConfig);
+    uint32_t nireq = served->compiledModel.get_property(ov::optimal_number_of_infer_requests);
+    for (uint32_t i = 0; i < std::max(nireq, 1u); ++i) {
+        served->requests.push_back(served->compiledModel.create_infer_request());
+        served->idleRequests.push_back(i);
+    }
+
+    nlohmann::json& inputs = served->metadata["inputs"] = nlohmann::json::array();
+    for (const ov::Output<const ov::Node>& input : served->compiledModel.inputs()) {
+        std::vector<int64_t> shape;
+        for (const ov::Dimension& dim : input.get_partial_shape()) {
+            shape.push_back(dim.is_dynamic() ? -1 : dim.get_length());
+        }
+        inputs.push_back({{"name", input.get_any_name()}, {"shape", shape}});
+    }
+    nlohmann::json& outputs = served->metadata["outputs"] = nlohmann::json::array();
+    for (const ov::Output<const ov::Node>& output : served->compiledModel.outputs()) {
+        outputs.push_back(output.get_any_name());
+    }
+    served->metadata["model_info"] = nlohmann::json::object();
+    if (model->has_rt_info({"model_info"})) {
+        served->metadata["model_info"] = toJson(model->get_rt_info<ov::AnyMap>("model_info"));
+    }
+    models[name] = std::move(served);
+}
+
+void ShmInferenceServer::run() {
+    slog::info << "Serving on " << socketPath << slog::endl;
+    pollfd fds[] = {{listener, POLLIN, 0}, {stopEvent, POLLIN, 0}};
+    while (true) {
+        if (poll(fds, 2, -1) < 0) {
+            if (EINTR == errno) {
+                continue;
+            }
+            throw systemError("poll failed");
+        }
+        if (fds[1].revents) {
+            return;
+        }
+        if (fds[0].revents & POLLIN) {
+            accept();
+        }
+    }
+}
+
+void ShmInferenceServer::accept() {
+    sessions.erase(std::remove_if(sessions.begin(), sessions.end(), [](const std::unique_ptr<Session>& session) {
+        return session->finished.load();
+    }), sessions.end());
+
+    int client = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+    if (client < 0) {
+        return;
+    }
+    auto session = std::make_unique<Session>(client, stopEvent);
+    try {
+        session->handshake(models);
+    } catch (const std::exception& error) {
+        slog::warn << "Rejected client: " << error.what() << slog::endl;
+        try {
+            sendMessage(client, nlohmann::json{{"error", error.what()}}.dump());
+        } catch (const std::exception&) {}
+        return;
+    }
+    Session* ptr = session.get();
+    session->thread = std::thread([ptr] { ptr->serve(); });
+    sessions.push_back(std::move(session));
+}
+
+void ShmInferenceServer::stop() {
+    signal(stopEvent);
+}
+
+struct ShmInferenceAdapter::Channel {
+    int socket = -1;
+    int memfd = -1;
+    int requestEvent = -1;
+    int responseEvent = -1;
+    int stopEvent = -1;
+    uint8_t* mapping = nullptr;
+    size_t size = 0;
+    ChannelHeader* header = nullptr;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::vector<uint32_t> freeSlots;
+    std::vector<bool> done;
+    bool serverGone = false;
+
+    ~Channel() {
+        if (mapping) {
+            munmap(mapping, size);
+        }
+        for (int fd : {socket, memfd, requestEvent, responseEvent, stopEvent}) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    uint8_t* slot(uint32_t index) {
+        return slotData(mapping, header->slotSize, index);
+    }
+
+    uint32_t acquire() {
+        std::unique_lock<std::mutex> lock{mutex};
+        condition.wait(lock, [this] { return !freeSlots.empty() || serverGone; });
+        if (serverGone) {
+            throw std::runtime_error("Inference server disconnected");
+        }
+        uint32_t index = freeSlots.back();
+        freeSlots.pop_back();
+        return index;
+    }
+
+    void release(uint32_t index) {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            freeSlots.push_back(index);
+        }
+        condition.notify_all();
+    }
+
+    void receive() {
+        pollfd fds[] = {{responseEvent, POLLIN, 0}, {socket, POLLIN, 0}, {stopEvent, POLLIN, 0}};
+        while (true) {
+            if (poll(fds, 3, -1) < 0 && errno != EINTR) {
+                break;
+            }
+            if (fds[2].revents) {
+                return;
+            }
+            if (fds[1].revents) {
+                break;
+            }
+            if (fds[0].revents & POLLIN) {
+                drain(responseEvent);
+                std::lock_guard<std::mutex> lock{mutex};
+                uint32_t index;
+                while (header->completions.pop(index)) {
+                    if (index < done.size()) {
+                        done[index] = true;
+                    }
+                }
+                condition.notify_all();
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            serverGone = true;
+        }
+        condition.notify_all();
+    }
+};
+
+namespace {
+// Output tensors are allocated with it to return the slot once the last of them is destroyed
+struct SlotAllocator {
+    void* data;
+    std::shared_ptr<void> lease;
+
+    void* allocate(size_t, size_t) {
+        return data;
+    }
+    void deallocate(void*, size_t, size_t) {}
+    bool is_equal(const SlotAllocator& other) const {
+        return data == other.data;
+    }
+};
+}  // namespace
+
+ShmInferenceAdapter::ShmInferenceAdapter(const std::string& socketPath, const std::string& modelName, size_t slotCount,
+                                         size_t slotSize)
+    : channel(std::make_shared<Channel>()) {
+    if (0 == slotCount || slotCount > MAX_SLOTS) {
+        throw std::invalid_argument("Slot count must be in [1, " + std::to_string(MAX_SLOTS) + "]");
+    }
+    slotSize = aligned(std::max(slotSize, SLOT_DATA_OFFSET + PAGE_SIZE), PAGE_SIZE);
+
+    channel->socket = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_un address = socketAddress(socketPath);
+    if (channel->socket < 0 || connect(channel->socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        throw systemError("Failed to connect to " + socketPath);
+    }
+    // Pages of the memfd are committed on first touch, unused parts of slots don't consume memory
+    channel->memfd = memfd_create("model_api_shm", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    channel->size = mappingSize(slotCount, slotSize);
+    if (channel->memfd < 0 || ftruncate(channel->memfd, static_cast<off_t>(channel->size)) != 0
+            || fcntl(channel->memfd, F_ADD_SEALS, MEMFD_SEALS) != 0) {
+        throw systemError("Failed to create shared memory");
+    }
+    void* ptr = mmap(nullptr, channel->size, PROT_READ | PROT_WRITE, MAP_SHARED, channel->memfd, 0);
+    if (MAP_FAILED == ptr) {
+        throw systemError("Failed to map shared memory");
+    }
+    channel->mapping = static_cast<uint8_t*>(ptr);
+    channel->header = new (channel->mapping) ChannelHeader{};
+    channel->header->magic = CHANNEL_MAGIC;
+    channel->header->version = CHANNEL_VERSION;
+    channel->header->slotCount = static_cast<uint32_t>(slotCount);
+    channel->header->slotSize = slotSize;
+
+    channel->requestEvent = eventfd(0, EFD_CLOEXEC);
+    channel->responseEvent = eventfd(0, EFD_CLOEXEC);
+    channel->stopEvent = eventfd(0, EFD_CLOEXEC);
+    if (channel->requestEvent < 0 || channel->responseEvent < 0 || channel->stopEvent < 0) {
+        throw systemError("Failed to create eventfd");
+    }
+
+    nlohmann::json hello = {{"model", modelName}, {"slot_count", slotCount}, {"slot_size", slotSize}};
+    sendMessage(channel->socket, hello.dump(), {channel->memfd, channel->requestEvent, channel->responseEvent});
+    std::vector<int> fds;
+    nlohmann::json metadata = nlohmann::json::parse(receiveMessage(channel->socket, fds));
+    for (int fd : fds) {
+        close(fd);
+    }
+    if (metadata.contains("error")) {
+        throw std::runtime_error("Inference server rejected the client: " + metadata["error"].get<std::string>());
+    }
+    for (const nlohmann::json& input : metadata.at("inputs")) {
+        const std::string& name = input.at("name").get_ref<const std::string&>();
+        inputNames.push_back(name);
+        std::vector<ov::Dimension> dims;
+        for (int64_t dim : input.at("shape").get<std::vector<int64_t>>()) {
+            dims.push_back(dim < 0 ? ov::Dimension::dynamic() : ov::Dimension(dim));
+        }
+        inputShapes[name] = ov::PartialShape(dims);
+    }
+    outputNames = metadata.at("outputs").get<std::vector<std::string>>();
+    modelConfig = toAnyMap(metadata.at("model_info"));
+
+    for (uint32_t i = 0; i < slotCount; ++i) {
+        channel->freeSlots.push_back(static_cast<uint32_t>(slotCount - 1 - i));
+    }
+    channel->done.assign(slotCount, false);
+    Channel* ch = channel.get();
+    receiver = std::thread([ch] { ch->receive(); });
+}
+
+ShmInferenceAdapter::~ShmInferenceAdapter() {
+    asyncWorkers.stop();
+    signal(channel->stopEvent);
+    receiver.join();
+    // Outputs still in use keep the channel alive, the server notices the closed socket
+    shutdown(channel->socket, SHUT_RDWR);
+}
+
+InferenceOutput ShmInferenceAdapter::infer(const InferenceInput& input) {
+    Channel& ch = *channel;
+    uint32_t index = ch.acquire();
+    uint8_t* data = ch.slot(index);
+    SlotHeader* header = reinterpret_cast<SlotHeader*>(data);
+    const size_t slotSize = ch.header->slotSize;
+    try {
+        if (input.size() > MAX_TENSORS) {
+            throw std::invalid_argument("Too many input tensors");
+        }
+        size_t offset = SLOT_DATA_OFFSET;
+        uint32_t count = 0;
+        for (const auto& item : input) {
+            size_t size = item.second.get_byte_size();
+            if (offset + size > slotSize) {
+                throw std::invalid_argument("Inputs don't fit the slot, increase slot size");
+            }
+            describe(header->tensors[count++], item.first, item.second.get_element_type(), item.second.get_shape(), offset, size);
+            if (item.second.data() != data + offset) {
+                std::memcpy(data + offset, item.second.data(), size);
+            }
+            offset = aligned(offset + size, DATA_ALIGNMENT);
+        }
+        header->inputCount = count;
+        header->outputCount = 0;
+    } catch (...) {
+        ch.release(index);
+        throw;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock{ch.mutex};
+        ch.done[index] = false;
+        // Callers of several threads submit, the ring has one producer
+        ch.header->submissions.push(index);
+    }
+    signal(ch.requestEvent);
+    {
+        std::unique_lock<std::mutex> lock{ch.mutex};
+        ch.condition.wait(lock, [&] { return ch.done[index] || ch.serverGone; });
+        if (!ch.done[index]) {
+            throw std::runtime_error("Inference server disconnected");
+        }
+    }
+
+    if (header->status != SLOT_OK) {
+        std::string error(header->error, strnlen(header->error, sizeof(header->error)));
+        ch.release(index);
+        throw std::runtime_error("Inference server failed: " + error);
+    }
+    std::shared_ptr<Channel> owner = channel;
+    std::shared_ptr<void> lease(nullptr, [owner, index](void*) { owner->release(index); });
+    InferenceOutput output;
+    try {
+        for (uint32_t i = 0; i < header->outputCount && header->inputCount + i < MAX_TENSORS; ++i) {
+            const TensorDescriptor& desc = header->tensors[header->inputCount + i];
+            ov::Tensor mapped = view(desc, data, slotSize);
+            output[std::string(desc.name, strnlen(desc.name, MAX_NAME))] =
+                ov::Tensor(mapped.get_element_type(), mapped.get_shape(), ov::Allocator(SlotAllocator{mapped.data(), lease}));
+        }
+    } catch (...) {
+        output.clear();
+        throw;
+    }
+    return output;
+}
+
+void ShmInferenceAdapter::inferAsync(const InferenceInput& input, InferenceCallback callback) {
+    asyncWorkers.submit(input, std::move(callback));
+}
+
+void ShmInferenceAdapter::loadModel(const std::shared_ptr<const ov::Model>&, ov::Core&, const std::string&, const ov::AnyMap&) {
+    throw std::logic_error("ShmInferenceAdapter can't load a model, the model is loaded by the server");
+}
+
+ov::PartialShape ShmInferenceAdapter::getInputShape(const std::string& inputName) const {
+    auto it = inputShapes.find(inputName);
+    if (it == inputShapes.end()) {
+        throw std::out_of_range("Model has no input " + inputName);
+    }
+    return it->second;
+}
+
+std::vector<std::string> ShmInferenceAdapter::getInputNames() const {
+    return inputNames;
+}
+
+std::vector<std::string> ShmInferenceAdapter::getOutputNames() const {
+    return outputNames;
+}
+
+const ov::AnyMap& ShmInferenceAdapter::getModelConfig() const {
+    return modelConfig;
+}
+#endif
@@ -0,0 +1,176 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+
+#pragma once
+/// C API of model_api for FFI, e.g. cgo or Rust bindgen. The library is built with MODEL_API_BUILD_C_API=ON.
+/// Functions return MAPI_OK or an error status with the message available from mapi_last_error(). Structs are only
+/// extended at the end and enums only get new values, MAPI_C_API_VERSION grows with every such change
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+#    ifdef model_api_c_EXPORTS
+#        define MAPI_C_API __declspec(dllexport)
+#    else
+#        define MAPI_C_API __declspec(dllimport)
+#    endif
+#else
+#    define MAPI_C_API __attribute__((visibility("default")))
+#endif
+
+#define MAPI_C_API_VERSION 1
+#define MAPI_MAX_DIMS 6
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    MAPI_OK = 0,
+    MAPI_INVALID_ARGUMENT = 1,
+    MAPI_ERROR = 2,  // model_api or OpenVINO failed
+} mapi_status_e;
+
+typedef enum {
+    MAPI_CLASSIFICATION = 0,
+    MAPI_DETECTION = 1,
+    MAPI_SEGMENTATION = 2,
+    MAPI_INSTANCE_SEGMENTATION = 3,  // MaskRCNNModel
+    MAPI_ANOMALY = 4,
+} mapi_model_type_e;
+
+typedef enum {
+    MAPI_BGR8 = 0,  // Passed to the model without copying, the other formats are converted to it
+    MAPI_RGB8 = 1,
+    MAPI_BGRA8 = 2,
+    MAPI_RGBA8 = 3,
+    MAPI_GRAY8 = 4,
+} mapi_pixel_format_e;
+
+typedef enum {
+    MAPI_U8 = 0,
+    MAPI_I8 = 1,
+    MAPI_U16 = 2,
+    MAPI_I16 = 3,
+    MAPI_I32 = 4,
+    MAPI_I64 = 5,
+    MAPI_F16 = 6,
+    MAPI_F32 = 7,
+    MAPI_F64 = 8,
+} mapi_element_type_e;
+
+typedef struct mapi_model mapi_model_t;
+
+/// A value of the model configuration, e.g. {"confidence_threshold", "0.5"}. Values are strings like in model_info
+typedef struct {
+    const char* key;
+    const char* value;
+} mapi_config_entry_t;
+
+/// Caller owned pixels
+typedef struct {
+    const void* data;
+    int32_t width;
+    int32_t height;
+    size_t stride;  // Bytes between the starts of rows, 0 for packed rows. Padded rows are copied once before inference
+    mapi_pixel_format_e format;
+} mapi_image_t;
+
+/// A mask, map or model output. data is NULL if the result doesn't have it
+typedef struct {
+    const void* data;
+    mapi_element_type_e type;
+    int32_t ndims;
+    int64_t shape[MAPI_MAX_DIMS];
+    int64_t strides[MAPI_MAX_DIMS];  // In bytes
+} mapi_array_t;
+
+typedef struct {
+    uint32_t id;
+    const char* label;
+    float score;
+} mapi_label_t;
+
+typedef struct {
+    float x;
+    float y;
+    float width;
+    float height;
+    uint32_t label_id;
+    const char* label;
+    float score;
+    mapi_array_t mask;  // MAPI_INSTANCE_SEGMENTATION only
+} mapi_object_t;
+
+/// Pointers refer to memory owned by the library until mapi_result_release()
+typedef struct {
+    mapi_model_type_e type;
+    // MAPI_CLASSIFICATION: top labels
+    const mapi_label_t* labels;
+    size_t labels_size;
+    // MAPI_DETECTION and MAPI_INSTANCE_SEGMENTATION: objects, MAPI_ANOMALY: boxes of anomalous regions
+    const mapi_object_t* objects;
+    size_t objects_size;
+    // MAPI_SEGMENTATION: the class of every pixel, MAPI_ANOMALY: the predicted mask
+    mapi_array_t mask;
+    // MAPI_SEGMENTATION: per class probabilities if return_soft_prediction is set, MAPI_ANOMALY: the anomaly map
+    mapi_array_t soft_prediction;
+    // Explainability outputs if the model has them. MAPI_INSTANCE_SEGMENTATION has a map per class instead
+    mapi_array_t saliency_map;
+    const mapi_array_t* class_saliency_maps;
+    size_t class_saliency_maps_size;
+    mapi_array_t feature_vector;
+    // MAPI_CLASSIFICATION only
+    mapi_array_t raw_scores;
+    // MAPI_ANOMALY only
+    const char* anomaly_label;
+    double anomaly_score;
+} mapi_result_t;
+
+/// Gets the status and the result, which the callback releases with mapi_result_release(). result is NULL on error
+typedef void (*mapi_callback_t)(mapi_status_e status, const mapi_result_t* result, void* user_data);
+
+/// Returns the message of the last error on the calling thread. Inside a callback it describes the callback's status
+MAPI_C_API const char* mapi_last_error(void);
+
+/// Reads and compiles a model. device may be NULL for "AUTO"
+MAPI_C_API mapi_status_e mapi_model_create(const char* model_path,
+                                           mapi_model_type_e type,
+                                           const mapi_config_entry_t* configuration,
+                                           size_t configuration_size,
+                                           const char* device,
+                                           mapi_model_t** model);
+
+/// Must not be called while inferences of the model are in flight
+MAPI_C_API void mapi_model_free(mapi_model_t* model);
+
+/// Models may be called from many threads at once
+MAPI_C_API mapi_status_e mapi_model_infer(mapi_model_t* model, const mapi_image_t* image, const mapi_result_t** result);
+
+/// Preprocesses the image on the calling thread and returns without waiting for the inference. If MAPI_OK is returned,
+/// callback is called once from the thread completing the inference, and a MAPI_BGR8 image must stay valid until then
+MAPI_C_API mapi_status_e mapi_model_infer_async(mapi_model_t* model,
+                                                const mapi_image_t* image,
+                                                mapi_callback_t callback,
+                                                void* user_data);
+
+/// Frees a result and all the memory it points to. NULL is ignored
+MAPI_C_API void mapi_result_release(const mapi_result_t* result);
+
+#ifdef __cplusplus
+}
+#endif
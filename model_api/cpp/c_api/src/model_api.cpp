@@ -0,0 +1,366 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+
+#include "c_api/model_api.h"
+
+#include <stdint.h>
+
+#include <deque>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+#include <openvino/openvino.hpp>
+
+#include <models/anomaly_model.h>
+#include <models/classification_model.h>
+#include <models/detection_model.h>
+#include <models/input_data.h>
+#include <models/instance_segmentation.h>
+#include <models/model_base.h>
+#include <models/results.h>
+#include <models/segmentation_model.h>
+
+struct mapi_model {
+    std::shared_ptr<ModelBase> model;
+    mapi_model_type_e type;
+};
+
+namespace {
+thread_local std::string lastError;
+
+// Exceptions don't cross the C boundary
+template <class Function>
+mapi_status_e guarded(Function&& function) {
+    try {
+        function();
+        return MAPI_OK;
+    } catch (const std::invalid_argument& e) {
+        lastError = e.what();
+        return MAPI_INVALID_ARGUMENT;
+    } catch (const std::exception& e) {
+        lastError = e.what();
+        return MAPI_ERROR;
+    } catch (...) {
+        lastError = "Unknown exception";
+        return MAPI_ERROR;
+    }
+}
+
+// The result owns every buffer the flat struct points to
+struct ResultArena : mapi_result_t {
+    ResultArena() : mapi_result_t{} {}
+
+    std::unique_ptr<ResultBase> result;
+    std::vector<mapi_label_t> labelStorage;
+    std::vector<mapi_object_t> objectStorage;
+    std::vector<mapi_array_t> classSaliencyMapStorage;
+    std::deque<std::string> strings;  // NUL terminated copies of labels, deque keeps them in place
+
+    const char* keep(std::string_view text) {
+        strings.emplace_back(text);
+        return strings.back().c_str();
+    }
+};
+
+mapi_element_type_e toElementType(int depth) {
+    switch (depth) {
+        case CV_8U: return MAPI_U8;
+        case CV_8S: return MAPI_I8;
+        case CV_16U: return MAPI_U16;
+        case CV_16S: return MAPI_I16;
+        case CV_16F: return MAPI_F16;
+        case CV_32S: return MAPI_I32;
+        case CV_32F: return MAPI_F32;
+        case CV_64F: return MAPI_F64;
+        default: throw std::runtime_error("Unsupported cv::Mat depth: " + std::to_string(depth));
+    }
+}
+
+mapi_element_type_e toElementType(const ov::element::Type& type) {
+    switch (type) {
+        case ov::element::Type_t::u8: return MAPI_U8;
+        case ov::element::Type_t::i8: return MAPI_I8;
+        case ov::element::Type_t::u16: return MAPI_U16;
+        case ov::element::Type_t::i16: return MAPI_I16;
+        case ov::element::Type_t::i32: return MAPI_I32;
+        case ov::element::Type_t::i64: return MAPI_I64;
+        case ov::element::Type_t::f16: return MAPI_F16;
+        case ov::element::Type_t::f32: return MAPI_F32;
+        case ov::element::Type_t::f64: return MAPI_F64;
+        default: throw std::runtime_error("Unsupported tensor element type: " + type.get_type_name());
+    }
+}
+
+mapi_array_t toArray(const cv::Mat& mat) {
+    mapi_array_t array{};
+    if (mat.empty()) {
+        return array;
+    }
+    int ndims = mat.dims + (mat.channels() > 1 ? 1 : 0);
+    if (ndims > MAPI_MAX_DIMS) {
+        throw std::runtime_error("cv::Mat has more than MAPI_MAX_DIMS dimensions");
+    }
+    array.data = mat.data;
+    array.type = toElementType(mat.depth());
+    array.ndims = ndims;
+    for (int i = 0; i < mat.dims; ++i) {
+        array.shape[i] = mat.size[i];
+        array.strides[i] = static_cast<int64_t>(mat.step[i]);
+    }
+    if (mat.channels() > 1) {
+        array.shape[mat.dims] = mat.channels();
+        array.strides[mat.dims] = static_cast<int64_t>(mat.elemSize1());
+    }
+    return array;
+}
+
+mapi_array_t toArray(const ov::Tensor& tensor) {
+    mapi_array_t array{};
+    if (!tensor) {
+        return array;
+    }
+    const ov::Shape shape = tensor.get_shape();
+    if (shape.size() > MAPI_MAX_DIMS) {
+        throw std::runtime_error("ov::Tensor has more than MAPI_MAX_DIMS dimensions");
+    }
+    const ov::Strides strides = tensor.get_strides();
+    array.data = tensor.data();
+    array.type = toElementType(tensor.get_element_type());
+    array.ndims = static_cast<int32_t>(shape.size());
+    for (size_t i = 0; i < shape.size(); ++i) {
+        array.shape[i] = static_cast<int64_t>(shape[i]);
+        array.strides[i] = static_cast<int64_t>(strides[i]);
+    }
+    return array;
+}
+
+mapi_object_t toObject(const DetectedObject& object, ResultArena& arena) {
+    mapi_object_t flat{};
+    flat.x = object.x;
+    flat.y = object.y;
+    flat.width = object.width;
+    flat.height = object.height;
+    flat.label_id = static_cast<uint32_t>(object.labelID);
+    flat.label = arena.keep(object.label);
+    flat.score = object.confidence;
+    return flat;
+}
+
+std::unique_ptr<ResultArena> flatten(std::unique_ptr<ResultBase> result, mapi_model_type_e type) {
+    auto arena = std::make_unique<ResultArena>();
+    arena->type = type;
+    switch (type) {
+        case MAPI_CLASSIFICATION: {
+            const auto& classification = result->asRef<ClassificationResult>();
+            for (const ClassificationResult::Classification& label : classification.topLabels) {
+                arena->labelStorage.push_back({label.id, arena->keep(label.label), label.score});
+            }
+            arena->saliency_map = toArray(classification.saliency_map);
+            arena->feature_vector = toArray(classification.feature_vector);
+            arena->raw_scores = toArray(classification.raw_scores);
+            break;
+        }
+        case MAPI_DETECTION: {
+            const auto& detection = result->asRef<DetectionResult>();
+            for (const DetectedObject& object : detection.objects) {
+                arena->objectStorage.push_back(toObject(object, *arena));
+            }
+            arena->saliency_map = toArray(detection.saliency_map);
+            arena->feature_vector = toArray(detection.feature_vector);
+            break;
+        }
+        case MAPI_SEGMENTATION: {
+            arena->mask = toArray(result->asRef<ImageResult>().resultImage);
+            if (auto soft = dynamic_cast<const ImageResultWithSoftPrediction*>(result.get())) {
+                arena->soft_prediction = toArray(soft->soft_prediction);
+                arena->saliency_map = toArray(soft->saliency_map);
+                arena->feature_vector = toArray(soft->feature_vector);
+            }
+            break;
+        }
+        case MAPI_INSTANCE_SEGMENTATION: {
+            const auto& segmentation = result->asRef<InstanceSegmentationResult>();
+            for (const SegmentedObject& object : segmentation.segmentedObjects) {
+                arena->objectStorage.push_back(toObject(object, *arena));
+                arena->objectStorage.back().mask = toArray(object.mask);
+            }
+            for (const cv::Mat& map : segmentation.saliency_map) {
+                arena->classSaliencyMapStorage.push_back(toArray(map));
+            }
+            arena->feature_vector = toArray(segmentation.feature_vector);
+            break;
+        }
+        case MAPI_ANOMALY: {
+            const auto& anomaly = result->asRef<AnomalyResult>();
+            arena->anomaly_label = arena->keep(anomaly.pred_label);
+            arena->anomaly_score = anomaly.pred_score;
+            for (const cv::Rect& box : anomaly.pred_boxes) {
+                mapi_object_t flat{};
+                flat.x = static_cast<float>(box.x);
+                flat.y = static_cast<float>(box.y);
+                flat.width = static_cast<float>(box.width);
+                flat.height = static_cast<float>(box.height);
+                flat.label = arena->anomaly_label;
+                flat.score = static_cast<float>(anomaly.pred_score);
+                arena->objectStorage.push_back(flat);
+            }
+            arena->mask = toArray(anomaly.pred_mask);
+            arena->soft_prediction = toArray(anomaly.anomaly_map);
+            break;
+        }
+        default:
+            throw std::invalid_argument("Unknown model type: " + std::to_string(type));
+    }
+    arena->labels = arena->labelStorage.data();
+    arena->labels_size = arena->labelStorage.size();
+    arena->objects = arena->objectStorage.data();
+    arena->objects_size = arena->objectStorage.size();
+    arena->class_saliency_maps = arena->classSaliencyMapStorage.data();
+    arena->class_saliency_maps_size = arena->classSaliencyMapStorage.size();
+    arena->result = std::move(result);
+    return arena;
+}
+
+// Wraps packed BGR pixels, copies padded ones and converts the other formats to BGR
+cv::Mat toBgr(const mapi_image_t& image) {
+    if (!image.data || image.width <= 0 || image.height <= 0) {
+        throw std::invalid_argument("The image is empty");
+    }
+    int type;
+    int conversion = -1;
+    switch (image.format) {
+        case MAPI_BGR8: type = CV_8UC3; break;
+        case MAPI_RGB8: type = CV_8UC3; conversion = cv::COLOR_RGB2BGR; break;
+        case MAPI_BGRA8: type = CV_8UC4; conversion = cv::COLOR_BGRA2BGR; break;
+        case MAPI_RGBA8: type = CV_8UC4; conversion = cv::COLOR_RGBA2BGR; break;
+        case MAPI_GRAY8: type = CV_8UC1; conversion = cv::COLOR_GRAY2BGR; break;
+        default: throw std::invalid_argument("Unknown pixel format: " + std::to_string(image.format));
+    }
+    size_t rowSize = static_cast<size_t>(image.width) * CV_ELEM_SIZE(type);
+    if (image.stride != 0 && image.stride < rowSize) {
+        throw std::invalid_argument("The image stride is less than its row");
+    }
+    // Models don't write to the input image
+    cv::Mat pixels(image.height, image.width, type, const_cast<void*>(image.data),
+                   image.stride != 0 ? image.stride : cv::Mat::AUTO_STEP);
+    if (conversion < 0) {
+        // Embedded preprocessing wraps the image into a tensor, which needs packed rows, so padded rows are copied once
+        return pixels.isContinuous() ? pixels : pixels.clone();
+    }
+    cv::Mat bgr;
+    cv::cvtColor(pixels, bgr, conversion);
+    return bgr;
+}
+
+void checkArguments(bool valid, const char* message) {
+    if (!valid) {
+        throw std::invalid_argument(message);
+    }
+}
+}
+
+const char* mapi_last_error(void) {
+    return lastError.c_str();
+}
+
+mapi_status_e mapi_model_create(const char* model_path,
+                                mapi_model_type_e type,
+                                const mapi_config_entry_t* configuration,
+                                size_t configuration_size,
+                                const char* device,
+                                mapi_model_t** model) {
+    return guarded([&] {
+        checkArguments(model_path && model && (configuration || configuration_size == 0),
+                       "mapi_model_create(): model_path, model and configuration must not be NULL");
+        *model = nullptr;
+        ov::AnyMap config;
+        for (size_t i = 0; i < configuration_size; ++i) {
+            checkArguments(configuration[i].key && configuration[i].value, "Configuration keys and values must not be NULL");
+            config.emplace(configuration[i].key, std::string(configuration[i].value));
+        }
+        const std::string deviceName = device ? device : "AUTO";
+        auto created = std::make_unique<mapi_model>();
+        created->type = type;
+        switch (type) {
+            case MAPI_CLASSIFICATION:
+                created->model = ClassificationModel::create_model(model_path, config, true, deviceName);
+                break;
+            case MAPI_DETECTION:
+                created->model = DetectionModel::create_model(model_path, config, "", true, deviceName);
+                break;
+            case MAPI_SEGMENTATION:
+                created->model = SegmentationModel::create_model(model_path, config, true, deviceName);
+                break;
+            case MAPI_INSTANCE_SEGMENTATION:
+                created->model = MaskRCNNModel::create_model(model_path, config, true, deviceName);
+                break;
+            case MAPI_ANOMALY:
+                created->model = AnomalyModel::create_model(model_path, config, true, deviceName);
+                break;
+            default:
+                throw std::invalid_argument("Unknown model type: " + std::to_string(type));
+        }
+        *model = created.release();
+    });
+}
+
+void mapi_model_free(mapi_model_t* model) {
+    delete model;
+}
+
+mapi_status_e mapi_model_infer(mapi_model_t* model, const mapi_image_t* image, const mapi_result_t** result) {
+    return guarded([&] {
+        checkArguments(model && image && result, "mapi_model_infer(): model, image and result must not be NULL");
+        *result = nullptr;
+        std::unique_ptr<ResultBase> inferred = model->model->infer(ImageInputData(toBgr(*image)));
+        *result = flatten(std::move(inferred), model->type).release();
+    });
+}
+
+mapi_status_e mapi_model_infer_async(mapi_model_t* model,
+                                     const mapi_image_t* image,
+                                     mapi_callback_t callback,
+                                     void* user_data) {
+    return guarded([&] {
+        checkArguments(model && image && callback, "mapi_model_infer_async(): model, image and callback must not be NULL");
+        // Keeps a converted image alive until the inference ends, BGR pixels are kept by the caller
+        cv::Mat bgr = toBgr(*image);
+        mapi_model_type_e type = model->type;
+        model->model->inferAsync(ImageInputData(bgr),
+            [bgr, type, callback, user_data](std::unique_ptr<ResultBase> inferred, std::exception_ptr error) {
+                const mapi_result_t* result = nullptr;
+                mapi_status_e status = guarded([&] {
+                    if (error) {
+                        std::rethrow_exception(error);
+                    }
+                    result = flatten(std::move(inferred), type).release();
+                });
+                callback(status, result, user_data);
+            });
+    });
+}
+
+void mapi_result_release(const mapi_result_t* result) {
+    delete static_cast<const ResultArena*>(result);
+}
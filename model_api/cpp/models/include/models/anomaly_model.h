@@ -46,6 +46,7 @@ protected:
     float pixelThreshold{0.5f};
     float normalizationScale{1.0f};
     std::string task = "segmentation";
+    std::string outputPrecision = "f32";
 
     void init_from_config(const ov::AnyMap& top_priority, const ov::AnyMap& mid_priority);
 
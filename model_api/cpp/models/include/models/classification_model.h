@@ -70,6 +70,7 @@ public:
     static std::unique_ptr<ClassificationModel> create_model(std::shared_ptr<InferenceAdapter>& adapter);
 
     std::unique_ptr<ResultBase> postprocess(InferenceResult& infResult) override;
+    void postprocessInto(InferenceResult& infResult, ResultBase& result) override;
 
     virtual std::unique_ptr<ClassificationResult> infer(const ImageInputData& inputData);
     static std::string ModelType;
@@ -80,6 +81,10 @@ protected:
     bool hierarchical = false;
     bool output_raw_scores = false;
     float confidence_threshold = 0.5f;
+    // Multilabel and hierarchical models compute activations and select labels above confidence_threshold in the
+    // graph. The threshold becomes a constant of the saved model, and the extra outputs make the model unsupported by
+    // the Python wrapper, which accepts up to 5 outputs
+    bool embed_postprocessing = false;
     std::string hierarchical_config;
     HierarchicalConfig hierarchical_info;
     GreedyLabelsResolver resolver;
@@ -87,7 +92,10 @@ protected:
     void init_from_config(const ov::AnyMap& top_priority, const ov::AnyMap& mid_priority);
     void prepareInputsOutputs(std::shared_ptr<ov::Model>& model) override;
     void updateModelInfo() override;
-    std::unique_ptr<ResultBase> get_multilabel_predictions(InferenceResult& infResult, bool add_raw_scores);
-    std::unique_ptr<ResultBase> get_multiclass_predictions(InferenceResult& infResult, bool add_raw_scores);
-    std::unique_ptr<ResultBase> get_hierarchical_predictions(InferenceResult& infResult, bool add_raw_scores);
+    void get_multilabel_predictions(InferenceResult& infResult, bool add_raw_scores, ClassificationResult& result);
+    void get_multiclass_predictions(InferenceResult& infResult, bool add_raw_scores, ClassificationResult& result);
+    void get_hierarchical_predictions(InferenceResult& infResult, bool add_raw_scores, ClassificationResult& result);
+    void get_embedded_hierarchical_predictions(InferenceResult& infResult, bool add_raw_scores, ClassificationResult& result);
+    void resolve_hierarchical_labels(const std::vector<std::reference_wrapper<std::string>>& predicted_labels,
+                                     const std::vector<float>& predicted_scores, ClassificationResult& result);
 };
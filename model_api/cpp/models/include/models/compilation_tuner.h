@@ -0,0 +1,73 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+#include <stddef.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <openvino/openvino.hpp>
+
+#include "adapters/inference_adapter.h"
+
+/// Sweeps NUM_STREAMS and INFERENCE_NUM_THREADS of a device for a prepared model. Every combination is compiled
+/// once and measured twice: with the optimal number of infer requests in flight for throughput and with a single
+/// request for latency. The chosen config can be passed to ModelBase::load() which stores it in model_info
+class CompilationTuner {
+public:
+    struct Trial {
+        ov::AnyMap config;
+        double fps;
+        double latencyMs;  // median
+    };
+
+    struct Result {
+        std::vector<Trial> trials;
+        size_t throughputBest;
+        size_t latencyBest;
+
+        const ov::AnyMap& throughputConfig() const {
+            return trials[throughputBest].config;
+        }
+        const ov::AnyMap& latencyConfig() const {
+            return trials[latencyBest].config;
+        }
+    };
+
+    /// 0 keeps the plugin default. Empty streams are powers of two up to the number of hardware threads,
+    /// empty threads are the default and half of the hardware threads
+    CompilationTuner(std::vector<int> streams = {}, std::vector<int> threads = {},
+                     std::chrono::milliseconds duration = std::chrono::milliseconds(1000));
+
+    /// @param inputs a sample for the model, e.g. filled by ModelBase::preprocess()
+    Result tune(const std::shared_ptr<const ov::Model>& model, ov::Core& core, const std::string& device,
+                const InferenceInput& inputs) const;
+
+    const std::vector<int>& getStreams() const {
+        return streams;
+    }
+    const std::vector<int>& getThreads() const {
+        return threads;
+    }
+
+private:
+    std::vector<int> streams;
+    std::vector<int> threads;
+    std::chrono::milliseconds duration;
+};
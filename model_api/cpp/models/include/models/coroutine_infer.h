@@ -0,0 +1,217 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+// The library itself is C++17, only the code including this header has to be built as C++20
+#if !defined(__cpp_impl_coroutine) || !__has_include(<coroutine>)
+#error "models/coroutine_infer.h requires C++20 coroutines"
+#else
+#include <stdint.h>
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "models/input_data.h"
+#include "models/model_base.h"
+#include "models/results.h"
+
+/// Thrown by co_await of a cancelled inference
+class InferenceCancelled : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/// Cancels the inferences it was passed to. Copies share the state, so a copy kept by a timer or a connection handler
+/// cancels an inference awaited by another coroutine
+class InferCancellation {
+public:
+    InferCancellation() : state(std::make_shared<State>()) {}
+
+    /// Resumes the awaiting coroutines with InferenceCancelled at once. The inference itself runs to the end and
+    /// its result is dropped
+    void cancel() {
+        std::map<uint64_t, std::function<void()>> handlers;
+        {
+            std::lock_guard<std::mutex> lock{state->mutex};
+            if (state->cancelled) {
+                return;
+            }
+            state->cancelled = true;
+            handlers.swap(state->handlers);
+        }
+        for (auto& handler : handlers) {
+            handler.second();
+        }
+    }
+
+    bool isCancelled() const {
+        std::lock_guard<std::mutex> lock{state->mutex};
+        return state->cancelled;
+    }
+
+private:
+    template <class Result>
+    friend class InferAwaitable;
+
+    struct State {
+        std::mutex mutex;
+        bool cancelled = false;
+        uint64_t nextId = 0;
+        std::map<uint64_t, std::function<void()>> handlers;
+    };
+
+    /// Returns false if already cancelled
+    bool subscribe(std::function<void()> handler, uint64_t& id) {
+        std::lock_guard<std::mutex> lock{state->mutex};
+        if (state->cancelled) {
+            return false;
+        }
+        id = state->nextId++;
+        state->handlers.emplace(id, std::move(handler));
+        return true;
+    }
+
+    void unsubscribe(uint64_t id) {
+        std::lock_guard<std::mutex> lock{state->mutex};
+        state->handlers.erase(id);
+    }
+
+    std::shared_ptr<State> state;
+};
+
+/// Resumes the awaiting coroutine, e.g. [executor](std::coroutine_handle<> handle) { asio::post(executor, handle); }.
+/// Without a dispatcher the coroutine continues on the thread completing the inference
+using ResumeDispatcher = std::function<void(std::coroutine_handle<>)>;
+
+/// Starts the inference when awaited and suspends the coroutine until ModelBase::inferAsync() calls back, no thread
+/// waits for it. Only the state shared with the callback outlives the awaitable, so a cancelled coroutine can be
+/// destroyed before the inference ends
+template <class Result>
+class InferAwaitable {
+public:
+    using Start = std::function<void(ModelBase::InferCallback)>;
+
+    InferAwaitable(Start start, InferCancellation cancellation, ResumeDispatcher dispatcher)
+        : start(std::move(start)),
+          cancellation(std::move(cancellation)),
+          shared(std::make_shared<Shared>()) {
+        shared->dispatcher = std::move(dispatcher);
+    }
+
+    bool await_ready() const {
+        return cancellation.isCancelled();
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+        std::shared_ptr<Shared> state = shared;
+        uint64_t id = 0;
+        if (!cancellation.subscribe([state] { complete(state, nullptr, cancelledError()); }, id)) {
+            return false;
+        }
+        InferCancellation token = cancellation;
+        try {
+            start([state, token, id](std::unique_ptr<ResultBase> result, std::exception_ptr error) mutable {
+                token.unsubscribe(id);
+                complete(state, std::move(result), error);
+            });
+        } catch (...) {
+            cancellation.unsubscribe(id);
+            std::lock_guard<std::mutex> lock{shared->mutex};
+            shared->finished = true;
+            shared->error = std::current_exception();
+            return false;
+        }
+        // The inference may have completed or been cancelled before the coroutine is suspended
+        std::lock_guard<std::mutex> lock{shared->mutex};
+        if (shared->finished) {
+            return false;
+        }
+        shared->continuation = handle;
+        return true;
+    }
+
+    std::unique_ptr<Result> await_resume() {
+        std::lock_guard<std::mutex> lock{shared->mutex};
+        if (!shared->finished) {
+            // await_ready() found the cancellation
+            throw InferenceCancelled("The inference was cancelled");
+        }
+        if (shared->error) {
+            std::rethrow_exception(shared->error);
+        }
+        return std::unique_ptr<Result>(static_cast<Result*>(shared->result.release()));
+    }
+
+private:
+    struct Shared {
+        std::mutex mutex;
+        bool finished = false;
+        std::coroutine_handle<> continuation;
+        std::unique_ptr<ResultBase> result;
+        std::exception_ptr error;
+        ResumeDispatcher dispatcher;
+    };
+
+    static std::exception_ptr cancelledError() {
+        return std::make_exception_ptr(InferenceCancelled("The inference was cancelled"));
+    }
+
+    // The first of the completion and the cancellation wins, the result coming after a cancellation is dropped
+    static void complete(const std::shared_ptr<Shared>& state, std::unique_ptr<ResultBase> result, std::exception_ptr error) {
+        std::coroutine_handle<> continuation;
+        {
+            std::lock_guard<std::mutex> lock{state->mutex};
+            if (state->finished) {
+                return;
+            }
+            state->finished = true;
+            state->result = std::move(result);
+            state->error = error;
+            continuation = std::exchange(state->continuation, nullptr);
+        }
+        if (continuation) {
+            if (state->dispatcher) {
+                state->dispatcher(continuation);
+            } else {
+                continuation.resume();
+            }
+        }
+    }
+
+    Start start;
+    InferCancellation cancellation;
+    std::shared_ptr<Shared> shared;
+};
+
+/// co_await inferAsync(*model, ImageInputData{image}) returns the result type of model->infer(), e.g.
+/// std::unique_ptr<DetectionResult> for DetectionModel. The model must outlive the inference even if it is cancelled
+template <class Model, class Input>
+auto inferAsync(Model& model, Input input, InferCancellation cancellation = {}, ResumeDispatcher dispatcher = {}) {
+    using Result = typename decltype(model.infer(input))::element_type;
+    ModelBase& base = model;
+    return InferAwaitable<Result>(
+        [&base, input = std::move(input)](ModelBase::InferCallback callback) {
+            base.inferAsync(input, std::move(callback));
+        },
+        std::move(cancellation), std::move(dispatcher));
+}
+#endif
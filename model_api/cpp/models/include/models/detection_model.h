@@ -17,6 +17,8 @@
 #pragma once
 
 #include <string>
+#include <vector>
+
 #include "models/image_model.h"
 
 struct DetectionResult;
@@ -40,5 +42,14 @@ public:
 protected:
     float confidence_threshold = 0.5f;
 
+    // Returns the slot for the next object of a possibly reused result, growing objects only when needed.
+    // Callers truncate objects to count when done
+    static DetectedObject& nextObject(std::vector<DetectedObject>& objects, size_t& count) {
+        if (count == objects.size()) {
+            objects.emplace_back();
+        }
+        return objects[count++];
+    }
+
     void updateModelInfo() override;
 };
@@ -18,6 +18,7 @@
 #include <stddef.h>
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -27,6 +28,7 @@ namespace ov {
 class InferRequest;
 class Model;
 }  // namespace ov
+struct DetectionResult;
 struct InferenceResult;
 struct InputData;
 struct InternalModelData;
@@ -37,13 +39,28 @@ public:
     using DetectionModel::DetectionModel;
     std::shared_ptr<InternalModelData> preprocess(const InputData& inputData, InferenceInput& input) override;
     std::unique_ptr<ResultBase> postprocess(InferenceResult& infResult) override;
+    void postprocessInto(InferenceResult& infResult, ResultBase& result) override;
     static std::string ModelType;
 
 protected:
-    std::unique_ptr<ResultBase> postprocessSingleOutput(InferenceResult& infResult);
-    std::unique_ptr<ResultBase> postprocessMultipleOutputs(InferenceResult& infResult);
+    struct DetectionsLayout {
+        ov::Shape shape;
+        size_t detectionsNum = 0;
+        size_t objectSize = 0;
+    };
+
+    // postprocess() uses a layout of its own since it may run concurrently, postprocessInto() reuses steadyLayout
+    void postprocessDetections(InferenceResult& infResult, DetectionResult& result, DetectionsLayout& layout);
+    void postprocessSingleOutput(InferenceResult& infResult, DetectionResult& result, DetectionsLayout& layout);
+    void postprocessMultipleOutputs(InferenceResult& infResult, DetectionResult& result, DetectionsLayout& layout);
+    // Validates the detections tensor shape only when it changes to avoid copying the shape every frame
+    static void updateDetectionsLayout(const ov::Tensor& detectionsTensor, bool singleOutput, DetectionsLayout& layout);
     void prepareInputsOutputs(std::shared_ptr<ov::Model>& model) override;
     void prepareSingleOutput(std::shared_ptr<ov::Model>& model);
     void prepareMultipleOutputs(std::shared_ptr<ov::Model>& model);
     void updateModelInfo() override;
+
+    std::vector<std::string> namesWithoutXai;
+    std::once_flag namesWithoutXaiOnce;
+    DetectionsLayout steadyLayout;
 };
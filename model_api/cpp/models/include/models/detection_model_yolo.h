@@ -26,9 +26,12 @@
 #include <openvino/op/region_yolo.hpp>
 #include <openvino/openvino.hpp>
 
+#include <utils/nms.hpp>
+
 #include "models/detection_model_ext.h"
 
 struct DetectedObject;
+struct DetectionResult;
 struct InferenceResult;
 struct ResultBase;
 
@@ -90,10 +93,23 @@ class YOLOv5 : public DetectionModelExt {
     void updateModelInfo() override;
     void init_from_config(const ov::AnyMap& top_priority, const ov::AnyMap& mid_priority);
     bool agnostic_nms = false;
+
+    // Postprocessing scratch reused between frames
+    struct Workspace {
+        ov::Shape outShape;
+        std::vector<AnchorLabeled> boxesWithClass;
+        std::vector<float> confidences;
+        std::vector<size_t> keep;
+        NmsWorkspace nmsWorkspace;
+    };
+    // postprocess() uses a workspace of its own since it may run concurrently, postprocessInto() reuses steadyWorkspace
+    void postprocessDetections(InferenceResult& infResult, DetectionResult& result, Workspace& workspace);
+    Workspace steadyWorkspace;
 public:
     YOLOv5(std::shared_ptr<ov::Model>& model, const ov::AnyMap& configuration);
     YOLOv5(std::shared_ptr<InferenceAdapter>& adapter);
     std::unique_ptr<ResultBase> postprocess(InferenceResult& infResult) override;
+    void postprocessInto(InferenceResult& infResult, ResultBase& result) override;
     static std::string ModelType;
 };
 
@@ -0,0 +1,153 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <openvino/openvino.hpp>
+
+#include "utils/memory_usage.hpp"
+
+/// Serves a model wrapper which can be replaced by a new version without stopping the process. A new version is
+/// created, compiled and warmed up while the current one keeps serving, then new requests are switched to it at once
+/// and the previous version is released after its in-flight requests finish.
+/// Model is a wrapper class, e.g. DetectionModel, the factory usually calls its create_model()
+template <class Model>
+class HotSwapModel {
+public:
+    using Factory = std::function<std::unique_ptr<Model>()>;
+
+    struct SwapReport {
+        uint64_t version;
+        double loadMs;    // create, compile and warm up the new version while the previous one serves
+        double switchMs;  // new requests were blocked for it
+        double drainMs;   // wait for in-flight requests of the previous version
+        size_t memoryBeforeBytes;
+        /// Peak resident memory during the swap, both versions are loaded at that point. 0 where it isn't available
+        size_t peakMemoryBytes;
+        size_t memoryAfterBytes;
+    };
+
+    /// @param warmupShapes passed to warmup() of every version before it serves
+    explicit HotSwapModel(Factory factory, std::vector<ov::Shape> warmupShapes = {})
+        : warmupShapes(std::move(warmupShapes)) {
+        current = createVersion(factory);
+    }
+
+    /// The returned pointer keeps its version serving until it is destroyed. Acquire it per request rather than once,
+    /// otherwise a swap can't drain the previous version
+    std::shared_ptr<Model> acquire() const {
+        std::lock_guard<std::mutex> lock{mutex};
+        std::shared_ptr<Version> version = current;
+        {
+            std::lock_guard<std::mutex> versionLock{version->mutex};
+            ++version->inflight;
+        }
+        return std::shared_ptr<Model>(version->model.get(), [version](Model*) {
+            std::lock_guard<std::mutex> versionLock{version->mutex};
+            --version->inflight;
+            version->drained.notify_all();
+        });
+    }
+
+    /// Replaces the served version and blocks until the previous one is released. Concurrent swaps run one after
+    /// another. If the factory or warm-up throws, the current version keeps serving and the exception is rethrown
+    SwapReport swap(const Factory& factory) {
+        using Ms = std::chrono::duration<double, std::milli>;
+        std::lock_guard<std::mutex> swapLock{swapMutex};
+        SwapReport report;
+        report.memoryBeforeBytes = residentMemoryBytes();
+        bool peakTracked = resetPeakResidentMemory();
+
+        auto start = std::chrono::steady_clock::now();
+        std::shared_ptr<Version> next = createVersion(factory);
+        auto loaded = std::chrono::steady_clock::now();
+        report.loadMs = Ms(loaded - start).count();
+        report.peakMemoryBytes = residentMemoryBytes();
+
+        std::shared_ptr<Version> previous;
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            next->number = current->number + 1;
+            previous = std::move(current);
+            current = std::move(next);
+            report.version = current->number;
+        }
+        auto switched = std::chrono::steady_clock::now();
+        report.switchMs = Ms(switched - loaded).count();
+
+        {
+            std::unique_lock<std::mutex> versionLock{previous->mutex};
+            previous->drained.wait(versionLock, [&previous] { return 0 == previous->inflight; });
+        }
+        report.drainMs = Ms(std::chrono::steady_clock::now() - switched).count();
+        previous->model.reset();
+
+        report.memoryAfterBytes = residentMemoryBytes();
+        if (peakTracked) {
+            report.peakMemoryBytes = std::max(report.peakMemoryBytes, peakResidentMemoryBytes());
+        }
+        report.peakMemoryBytes = std::max({report.peakMemoryBytes, report.memoryBeforeBytes, report.memoryAfterBytes});
+        return report;
+    }
+
+    /// Runs swap() in a background thread. The handle must outlive the returned future
+    std::future<SwapReport> swapAsync(Factory factory) {
+        return std::async(std::launch::async, [this, factory = std::move(factory)] { return swap(factory); });
+    }
+
+    /// Starts from 0 and grows by one with every swap
+    uint64_t getVersion() const {
+        std::lock_guard<std::mutex> lock{mutex};
+        return current->number;
+    }
+
+private:
+    struct Version {
+        std::unique_ptr<Model> model;
+        uint64_t number = 0;
+        size_t inflight = 0;
+        std::mutex mutex;
+        std::condition_variable drained;
+    };
+
+    std::shared_ptr<Version> createVersion(const Factory& factory) const {
+        auto version = std::make_shared<Version>();
+        version->model = factory();
+        if (!version->model) {
+            throw std::invalid_argument("HotSwapModel factory returned no model");
+        }
+        version->model->warmup(warmupShapes);
+        return version;
+    }
+
+    const std::vector<ov::Shape> warmupShapes;
+    std::shared_ptr<Version> current;
+    mutable std::mutex mutex;
+    std::mutex swapMutex;
+};
@@ -18,6 +18,7 @@
 #include <stddef.h>
 
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "models/model_base.h"
@@ -28,6 +29,7 @@ class InferRequest;
 }  // namespace ov
 struct InputData;
 struct InternalModelData;
+struct InternalImageModelData;
 
 // ImageModel implements preprocess(), ImageModel's direct or indirect children are expected to implement prostprocess()
 class ImageModel : public ModelBase {
@@ -46,6 +48,8 @@ public:
     using ModelBase::ModelBase;
 
     std::shared_ptr<InternalModelData> preprocess(const InputData& inputData, InferenceInput& input) override;
+    /// Labels referenced by the results of the model
+    const std::shared_ptr<const LabelSet>& getLabelSet();
     static std::vector<std::string> loadLabels(const std::string& labelFilename);
     std::shared_ptr<ov::Model> embedProcessing(std::shared_ptr<ov::Model>& model,
                                                     const std::string& inputName,
@@ -61,10 +65,18 @@ public:
 
 protected:
     RESIZE_MODE selectResizeMode(const std::string& resize_type);
+    InferenceInput createWarmupInput(const ov::Shape& shape) override;
+    /// Sets the element type of a model output to the output_precision value: f32, f16 or u8.
+    /// u8 quantizes values from [0, 1] to [0, 255], so it suits probabilities only
+    static void setOutputPrecision(ov::preprocess::PrePostProcessor& ppp, const std::string& outputName, const std::string& precision);
     void updateModelInfo() override;
 
     std::string getLabelName(size_t labelID) {
-        return labelID < labels.size() ? labels[labelID] : std::string("Label #") + std::to_string(labelID);
+        return getLabel(labelID);
+    }
+    // Doesn't copy the name, the label refers to getLabelSet()
+    Label getLabel(size_t labelID) {
+        return (*getLabelSet())[labelID];
     }
 
     std::vector<std::string> labels = {};
@@ -79,4 +91,10 @@ protected:
     bool reverse_input_channels = false;
     std::vector<float> scale_values;
     std::vector<float> mean_values;
+
+private:
+    // Accessed with std::atomic_exchange() and std::atomic_store() since preprocess() can run concurrently
+    std::shared_ptr<InternalImageModelData> internalImageData;
+    std::shared_ptr<const LabelSet> labelSet;
+    std::once_flag labelSetOnce;
 };
@@ -39,19 +39,21 @@ public:
     static std::unique_ptr<MaskRCNNModel> create_model(std::shared_ptr<InferenceAdapter>& adapter);
 
     std::unique_ptr<ResultBase> postprocess(InferenceResult& infResult) override;
+    /// semanticMasks overrides postprocess_semantic_masks for one call, so concurrent calls may differ in it
+    std::unique_ptr<ResultBase> postprocess(InferenceResult& infResult, bool semanticMasks);
 
     virtual std::unique_ptr<InstanceSegmentationResult> infer(const ImageInputData& inputData);
+    std::unique_ptr<InstanceSegmentationResult> infer(const ImageInputData& inputData, bool semanticMasks);
     static std::string ModelType;
+    // The default for calls which don't pass semanticMasks
     bool postprocess_semantic_masks = true;
 
 protected:
     void prepareInputsOutputs(std::shared_ptr<ov::Model>& model) override;
     void updateModelInfo() override;
-    std::string getLabelName(size_t labelID) {
-        return labelID < labels.size() ? labels[labelID] : std::string("Label #") + std::to_string(labelID);
-    }
 
     float confidence_threshold = 0.5f;
+    std::string output_precision = "f32";
 };
 
 cv::Mat segm_postprocess(const SegmentedObject& box, const cv::Mat& unpadded, int im_h, int im_w);
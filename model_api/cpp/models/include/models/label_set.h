@@ -0,0 +1,103 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+#include <stddef.h>
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Label name of a result object. It refers to a name interned in a LabelSet instead of copying a std::string per
+/// object, and copying it touches no shared state. The labelSet field of the result owns the set, so a label is valid
+/// while its result or the model it came from lives, convert it to std::string to keep the name longer.
+/// Converts to std::string and std::string_view and compares with strings like the std::string it replaces
+class Label {
+public:
+    Label() = default;
+    explicit Label(std::string_view name) : name(name) {}
+
+    operator std::string_view() const noexcept {
+        return name;
+    }
+    operator std::string() const {
+        return std::string{name};
+    }
+    std::string_view view() const noexcept {
+        return name;
+    }
+    const char* data() const noexcept {
+        return name.data();
+    }
+    size_t size() const noexcept {
+        return name.size();
+    }
+    bool empty() const noexcept {
+        return name.empty();
+    }
+
+    friend bool operator==(const Label& label, std::string_view other) {
+        return label.name == other;
+    }
+    friend bool operator==(std::string_view other, const Label& label) {
+        return label.name == other;
+    }
+    friend bool operator!=(const Label& label, std::string_view other) {
+        return label.name != other;
+    }
+    friend bool operator!=(std::string_view other, const Label& label) {
+        return label.name != other;
+    }
+    friend bool operator==(const Label& lhs, const Label& rhs) {
+        return lhs.name == rhs.name;
+    }
+    friend bool operator!=(const Label& lhs, const Label& rhs) {
+        return lhs.name != rhs.name;
+    }
+    friend std::ostream& operator<<(std::ostream& os, const Label& label) {
+        return os << label.name;
+    }
+
+private:
+    std::string_view name;
+};
+
+/// Label names shared by a model and its results through a std::shared_ptr. Known labels are immutable. Names for ids
+/// outside of them ("Label #N") and names passed to intern() are added on first use and never removed
+class LabelSet {
+public:
+    LabelSet() = default;
+    explicit LabelSet(const std::vector<std::string>& names);
+
+    Label operator[](size_t labelID) const;
+    Label intern(std::string_view name) const;
+    size_t size() const {
+        return names.size();
+    }
+
+private:
+    const std::vector<std::string> names;
+
+    mutable std::mutex extraMutex;
+    // Node-based containers keep the addresses of the strings when they grow
+    mutable std::map<size_t, std::string> unknownIds;
+    mutable std::set<std::string, std::less<>> internedNames;
+};
@@ -15,6 +15,9 @@
 */
 
 #pragma once
+#include <atomic>
+#include <exception>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -25,11 +28,9 @@
 #include <utils/args_helper.hpp>
 #include <utils/ocv_common.hpp>
 #include <adapters/inference_adapter.h>
+#include "models/results.h"
 
-struct InferenceResult;
 struct InputData;
-struct InternalModelData;
-struct ResultBase;
 
 class ModelBase {
 public:
@@ -39,15 +40,50 @@ public:
 
     virtual ~ModelBase() = default;
 
+    /// Applies the loading options of the configuration to the core. Weights are mapped read-only from the .bin file
+    /// by default, so processes reading the same model share its page cache pages. mmap_weights=False reads them into
+    /// process memory instead, so the model doesn't depend on the file after reading.
+    /// cache_dir makes the core import the compiled blob saved there by a previous compilation
+    static void configureCore(ov::Core& core, const ov::AnyMap& configuration);
+    /// Reads the model with the core configured by configureCore(), used by create_model()
+    static std::shared_ptr<ov::Model> readModel(ov::Core& core, const std::string& modelFile,
+                                                const ov::AnyMap& configuration = {});
+
     std::shared_ptr<ov::Model> prepare();
-    void load(ov::Core& core, const std::string& device);
+    /// Compiles the model with the compile properties of the configuration overridden by compilationConfig.
+    /// The resulting properties are stored in model_info and reused when the saved model is loaded again.
+    /// Properties the device doesn't support are skipped, so a model tuned for CPU can be loaded on GPU
+    void load(ov::Core& core, const std::string& device, const ov::AnyMap& compilationConfig = {});
+    /// Runs dummy inferences for every expected input shape on every infer request of the adapter, so the first
+    /// real inference doesn't pay for kernel selection, compilation of dynamic shapes and memory allocation.
+    /// ImageModel takes image shapes {height, width} or {height, width, channels}, the model resolution if empty
+    void warmup(const std::vector<ov::Shape>& shapes = {});
+    /// True once warmup() has finished since the last load(), can be polled by a readiness probe from another thread
+    bool isWarmedUp() const {
+        return warmedUp;
+    }
     // Modifying ov::Model doesn't affect the model wrapper
     std::shared_ptr<ov::Model> getModel();
     std::shared_ptr<InferenceAdapter> getInferenceAdapter();
 
     virtual std::shared_ptr<InternalModelData> preprocess(const InputData& inputData, InferenceInput& input) = 0;
     virtual std::unique_ptr<ResultBase> postprocess(InferenceResult& infResult) = 0;
+    /// Can be called from several threads on one wrapper if the adapter's infer() can, as OpenVINOInferenceAdapter's.
+    /// Postprocessing treats outputs as read-only and keeps per-call state on the stack
     virtual std::unique_ptr<ResultBase> infer(const InputData& inputData);
+    /// Gets the result or the error of inferAsync(). Must not throw
+    using InferCallback = std::function<void(std::unique_ptr<ResultBase>, std::exception_ptr)>;
+    /// Preprocesses on the calling thread and returns once the adapter has started the request. The callback is called
+    /// from the thread completing the request after postprocessing, so it should pass heavy work to another thread.
+    /// The wrapper must outlive the call
+    void inferAsync(const InputData& inputData, InferCallback callback);
+
+    /// Steady-state inference: reuses the wrapper's input and output maps and fills a result owned by the caller.
+    /// Passing the same result object to every call lets its containers keep their capacity, so wrappers
+    /// implementing postprocessInto() don't allocate in postprocessing once warmed up. Not thread-safe
+    void inferInto(const InputData& inputData, ResultBase& result);
+    /// Overwrites result with the postprocessed infResult. result must be of the type returned by postprocess()
+    virtual void postprocessInto(InferenceResult& infResult, ResultBase& result);
 
     const std::vector<std::string>& getoutputNames() const {
         return outputNames;
@@ -55,10 +91,17 @@ public:
     const std::vector<std::string>& getinputNames() const {
         return inputNames;
     }
+    const ov::AnyMap& getCompilationConfig() const {
+        return compilationConfig;
+    }
 
 protected:
     virtual void prepareInputsOutputs(std::shared_ptr<ov::Model>& model) = 0;
     virtual void updateModelInfo();
+    /// Creates the adapter input for a warmup() shape, an empty shape stands for the model resolution
+    virtual InferenceInput createWarmupInput(const ov::Shape& shape);
+    /// The part of infer() before postprocessing, for wrappers which postprocess with per-call options
+    void inferOutputs(const InputData& inputData, InferenceResult& result);
 
     InputTransform inputTransform = InputTransform();
 
@@ -68,5 +111,15 @@ protected:
     std::string modelFile;
     std::shared_ptr<InferenceAdapter> inferenceAdapter;
     std::map<std::string, ov::Layout> inputsLayouts;
+    // remove_xai_outputs: drop saliency_map and feature_vector results before compilation
+    bool removeXaiOutputs = false;
+    // OpenVINO compile properties, e.g. PERFORMANCE_HINT or NUM_STREAMS, taken from the configuration
+    ov::AnyMap compilationConfig;
     ov::Layout getInputLayout(const ov::Output<ov::Node>& input);
+
+    std::atomic<bool> warmedUp{false};
+
+    // Buffers reused by inferInto()
+    InferenceInput steadyInputs;
+    InferenceResult steadyResult;
 };
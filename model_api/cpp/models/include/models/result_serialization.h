@@ -0,0 +1,225 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <opencv2/core.hpp>
+#include <openvino/openvino.hpp>
+
+struct ResultBase;
+
+/// Binary encoding of results for IPC and storage.
+///
+/// A buffer consists of a Header, 8-byte aligned sections and a directory of SectionEntry at the end. Every section
+/// is a flat array of the records below, a tensor (TensorHeader followed by raw data) or a matrix (MatHeader followed
+/// by raw data or by RleRun for CV_8UC1 masks). Integers are stored in the byte order of the writer, a reader with
+/// another byte order rejects the buffer because of the magic. Readers skip sections they don't know, so new sections
+/// can be added without changing the version.
+namespace result_serialization {
+
+constexpr uint32_t MAGIC = 0x5250414d;  // "MAPR" in little endian
+constexpr uint16_t VERSION = 1;
+
+enum class ResultType : uint16_t {
+    Detection = 1,
+    RetinaFaceDetection = 2,
+    Classification = 3,
+    Image = 4,
+    ImageWithSoftPrediction = 5,
+    InstanceSegmentation = 6,
+    Anomaly = 7,
+    HumanPose = 8,
+};
+
+enum class SectionId : uint32_t {
+    Strings = 1,  // Concatenated labels referenced by StringRef
+    Objects = 2,  // ObjectRecord
+    TopLabels = 3,  // ClassificationRecord
+    Landmarks = 4,  // Point2fRecord
+    ObjectMask = 5,  // Matrix, SectionEntry::index is the index of the object
+    SaliencyMap = 6,  // Tensor, or a matrix per class for InstanceSegmentationResult and ImageResultWithSoftPrediction
+    FeatureVector = 7,  // Tensor
+    RawScores = 8,  // Tensor
+    ResultImage = 9,  // Matrix
+    SoftPrediction = 10,  // Matrix
+    AnomalyMap = 11,  // Matrix
+    PredMask = 12,  // Matrix
+    PredBoxes = 13,  // RectRecord
+    PredLabel = 14,  // Characters
+    PredScore = 15,  // double
+    Poses = 16,  // PoseRecord
+    Keypoints = 17,  // Point2fRecord
+};
+
+enum class ElementType : uint32_t {
+    f32 = 1, f16 = 2, bf16 = 3, f64 = 4, i8 = 5, u8 = 6, i16 = 7, u16 = 8, i32 = 9, u32 = 10, i64 = 11, u64 = 12, boolean = 13,
+};
+
+enum class MatEncoding : uint32_t {
+    Raw = 0,
+    Rle = 1,
+};
+
+struct Header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t resultType;
+    int64_t frameId;
+    uint64_t directoryOffset;
+    uint32_t sectionCount;
+    uint32_t reserved;
+};
+
+struct SectionEntry {
+    uint32_t id;
+    uint32_t index;
+    uint64_t offset;
+    uint64_t size;
+};
+
+struct StringRef {
+    uint32_t offset;
+    uint32_t size;
+};
+
+struct ObjectRecord {
+    float x, y, width, height;
+    float confidence;
+    uint32_t reserved;
+    uint64_t labelID;
+    StringRef label;
+};
+
+struct ClassificationRecord {
+    uint32_t id;
+    float score;
+    StringRef label;
+};
+
+struct Point2fRecord {
+    float x, y;
+};
+
+struct RectRecord {
+    int32_t x, y, width, height;
+};
+
+struct PoseRecord {
+    float score;
+    uint32_t keypointCount;  // Keypoints of the poses are stored one after another in the Keypoints section
+};
+
+struct TensorHeader {
+    uint32_t elementType;
+    uint32_t rank;
+    uint64_t shape[8];
+};
+
+struct MatHeader {
+    int32_t rows;
+    int32_t cols;
+    int32_t type;  // OpenCV type, e.g. CV_8UC1
+    uint32_t encoding;
+    uint64_t runCount;  // Number of RleRun for MatEncoding::Rle
+};
+
+struct RleRun {
+    uint32_t length;
+    uint32_t value;
+};
+
+/// Read only view of an array stored in a buffer
+template <typename T>
+struct ArrayView {
+    const T* data = nullptr;
+    size_t size = 0;
+
+    const T* begin() const {
+        return data;
+    }
+    const T* end() const {
+        return data + size;
+    }
+    const T& operator[](size_t i) const {
+        return data[i];
+    }
+    bool empty() const {
+        return 0 == size;
+    }
+};
+
+/// Encodes a result into buffer replacing its content. Reusing the buffer between calls avoids reallocations.
+/// Throws std::invalid_argument for result types which can't be serialized
+void serialize(const ResultBase& result, std::vector<uint8_t>& buffer);
+std::vector<uint8_t> serialize(const ResultBase& result);
+
+/// Maps an encoded result without copying. The buffer must outlive the view and must be 8-byte aligned which
+/// holds for std::vector and for memory from malloc or mmap. Returned ov::Tensor and cv::Mat wrap the buffer and must
+/// not be written to, only RLE masks are decoded into new matrices
+class SerializedResultView {
+public:
+    SerializedResultView(const void* data, size_t size);
+
+    ResultType type() const {
+        return static_cast<ResultType>(header->resultType);
+    }
+    uint16_t version() const {
+        return header->version;
+    }
+    int64_t frameId() const {
+        return header->frameId;
+    }
+
+    ArrayView<SectionEntry> sections() const;
+    bool has(SectionId id, uint32_t index = 0) const;
+
+    ArrayView<ObjectRecord> objects() const;
+    ArrayView<ClassificationRecord> topLabels() const;
+    ArrayView<Point2fRecord> landmarks() const;
+    ArrayView<RectRecord> predBoxes() const;
+    ArrayView<PoseRecord> poses() const;
+    ArrayView<Point2fRecord> keypoints() const;
+    std::string_view label(StringRef ref) const;
+    std::string_view predLabel() const;
+    double predScore() const;
+
+    /// Returns an empty tensor if the section is absent
+    ov::Tensor tensor(SectionId id) const;
+    /// Returns an empty matrix if the section is absent. Raw matrices are wrapped, RLE masks are decoded
+    cv::Mat mat(SectionId id, uint32_t index = 0) const;
+    /// Runs of an RLE mask, empty if the section is absent or not RLE encoded
+    ArrayView<RleRun> rleRuns(SectionId id, uint32_t index = 0) const;
+
+    /// Decodes into a regular result owning its data
+    std::unique_ptr<ResultBase> toResult() const;
+
+private:
+    const uint8_t* data;
+    size_t size;
+    const Header* header;
+
+    const SectionEntry* find(SectionId id, uint32_t index) const;
+    template <typename T>
+    ArrayView<T> array(SectionId id, uint32_t index = 0) const;
+};
+
+}  // namespace result_serialization
@@ -25,6 +25,7 @@
 #include <openvino/openvino.hpp>
 
 #include "internal_model_data.h"
+#include "label_set.h"
 
 struct MetaData;
 struct ResultBase {
@@ -146,10 +147,10 @@ struct ClassificationResult : public ResultBase {
 
     struct Classification {
         unsigned int id;
-        std::string label;
+        Label label;
         float score;
 
-        Classification(unsigned int id, const std::string& label, float score) : id(id), label(label), score(score) {}
+        Classification(unsigned int id, Label label, float score) : id(id), label(std::move(label)), score(score) {}
 
         friend std::ostream& operator<< (std::ostream& os, const Classification& prediction) {
             return os << prediction.id << " (" << prediction.label << "): " << std::fixed << std::setprecision(3) << prediction.score;
@@ -158,11 +159,12 @@ struct ClassificationResult : public ResultBase {
 
     std::vector<Classification> topLabels;
     ov::Tensor saliency_map, feature_vector, raw_scores;  // Contains "raw_scores", "saliency_map" and "feature_vector" model outputs if such exist
+    std::shared_ptr<const LabelSet> labelSet;  // Labels of topLabels
 };
 
 struct DetectedObject : public cv::Rect2f {
     size_t labelID;
-    std::string label;
+    Label label;
     float confidence;
 
     friend std::ostream& operator<< (std::ostream& os, const DetectedObject& detection) {
@@ -177,6 +179,7 @@ struct DetectionResult : public ResultBase {
         : ResultBase(frameId, metaData) {}
     std::vector<DetectedObject> objects;
     ov::Tensor saliency_map, feature_vector;  // Contan "saliency_map" and "feature_vector" model outputs if such exist
+    std::shared_ptr<const LabelSet> labelSet;  // Labels of objects
 
     friend std::ostream& operator<< (std::ostream& os, const DetectionResult& prediction) {
         for (const DetectedObject& obj : prediction.objects) {
@@ -257,6 +260,7 @@ struct InstanceSegmentationResult : ResultBase {
     // Contan per class saliency_maps and "feature_vector" model output if feature_vector exists
     std::vector<cv::Mat_<std::uint8_t>> saliency_map;
     ov::Tensor feature_vector;
+    std::shared_ptr<const LabelSet> labelSet;  // Labels of segmentedObjects
 };
 
 struct ImageResult : public ResultBase {
@@ -294,7 +298,7 @@ struct ImageResult : public ResultBase {
 struct ImageResultWithSoftPrediction : public ImageResult {
     ImageResultWithSoftPrediction(int64_t frameId = -1, const std::shared_ptr<MetaData>& metaData = nullptr)
         : ImageResult(frameId, metaData) {}
-    cv::Mat soft_prediction;
+    cv::Mat soft_prediction;  // CV_32F probabilities for any output_precision, CV_8U class ids for models returning them
     // Contain per class saliency_maps and "feature_vector" model output if feature_vector exists
     cv::Mat saliency_map;  // Requires return_soft_prediction==true
     ov::Tensor feature_vector;
@@ -322,7 +326,7 @@ struct ImageResultWithSoftPrediction : public ImageResult {
 };
 
 struct Contour {
-    std::string label;
+    Label label;  // Refers to the LabelSet of the model or the result the contour was computed for
     float probability;
     std::vector<cv::Point> shape;
 
@@ -53,4 +53,5 @@ protected:
     int blur_strength = -1;
     float soft_threshold = -std::numeric_limits<float>::infinity();
     bool return_soft_prediction = true;
+    std::string output_precision = "f32";
 };
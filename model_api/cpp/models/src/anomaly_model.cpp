@@ -37,6 +37,7 @@ void AnomalyModel::init_from_config(const ov::AnyMap& top_priority, const ov::An
     pixelThreshold = get_from_any_maps("pixel_threshold", top_priority, mid_priority, pixelThreshold);
     normalizationScale = get_from_any_maps("normalization_scale", top_priority, mid_priority, normalizationScale);
     task = get_from_any_maps("task", top_priority, mid_priority, task);
+    outputPrecision = get_from_any_maps("output_precision", top_priority, mid_priority, outputPrecision);
 }
 
 AnomalyModel::AnomalyModel(std::shared_ptr<ov::Model>& model, const ov::AnyMap& configuration)
@@ -68,10 +69,14 @@ std::unique_ptr<ResultBase> AnomalyModel::postprocess(InferenceResult& infResult
     } else {
         const ov::Layout& layout = getLayoutFromShape(predictions.get_shape());
         const ov::Shape& predictionsShape = predictions.get_shape();
+        bool isHalf = predictions.get_element_type() == ov::element::f16;
         anomaly_map = cv::Mat(static_cast<int>(predictionsShape[ov::layout::height_idx(layout)]),
                               static_cast<int>(predictionsShape[ov::layout::width_idx(layout)]),
-                              CV_32FC1,
-                              predictions.data<float>());
+                              isHalf ? CV_16FC1 : CV_32FC1,
+                              predictions.data());
+        if (isHalf) {
+            anomaly_map.convertTo(anomaly_map, CV_32F);
+        }
         // find the max predicted score
         cv::minMaxLoc(anomaly_map, NULL, &pred_score);
     }
@@ -136,7 +141,7 @@ std::unique_ptr<AnomalyModel> AnomalyModel::create_model(const std::string& mode
                                                          bool preload,
                                                          const std::string& device) {
     auto core = ov::Core();
-    std::shared_ptr<ov::Model> model = core.read_model(modelFile);
+    std::shared_ptr<ov::Model> model = readModel(core, modelFile, configuration);
 
     std::unique_ptr<AnomalyModel> anomalyModel{new AnomalyModel(model, configuration)};
 
@@ -188,6 +193,15 @@ void AnomalyModel::prepareInputsOutputs(std::shared_ptr<ov::Model>& model) {
             reverse_input_channels,
             mean_values,
             scale_values);
+        // Anomaly scores aren't bounded, so they can't be quantized to u8
+        if ("f32" != outputPrecision && model->output().get_partial_shape().size() > 1) {
+            if ("f16" != outputPrecision) {
+                throw std::runtime_error("AnomalyModel supports f32 and f16 output_precision, got " + outputPrecision);
+            }
+            ov::preprocess::PrePostProcessor ppp(model);
+            setOutputPrecision(ppp, model->output().get_any_name(), outputPrecision);
+            model = ppp.build();
+        }
         embedded_processing = true;
     }
     outputNames.push_back(model->output().get_any_name());
@@ -201,5 +215,6 @@ void AnomalyModel::updateModelInfo() {
     model->set_rt_info(imageThreshold, "model_info", "image_threshold");
     model->set_rt_info(pixelThreshold, "model_info", "pixel_threshold");
     model->set_rt_info(normalizationScale, "model_info", "normalization_scale");
+    model->set_rt_info(outputPrecision, "model_info", "output_precision");
     model->set_rt_info(task, "model_info", "task");
 }
@@ -17,14 +17,26 @@
 #include "models/classification_model.h"
 
 #include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <fstream>
 #include <iterator>
 #include <map>
 #include <stdexcept>
 #include <string>
+#include <tuple>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include <openvino/op/concat.hpp>
+#include <openvino/op/constant.hpp>
+#include <openvino/op/gather.hpp>
+#include <openvino/op/greater.hpp>
+#include <openvino/op/non_zero.hpp>
+#include <openvino/op/reshape.hpp>
+#include <openvino/op/sigmoid.hpp>
+#include <openvino/op/slice.hpp>
 #include <openvino/op/softmax.hpp>
 #include <openvino/op/topk.hpp>
 #include <openvino/openvino.hpp>
@@ -44,6 +56,10 @@ constexpr char scores_name[]{"scores"};
 constexpr char saliency_map_name[]{"saliency_map"};
 constexpr char feature_vector_name[]{"feature_vector"};
 constexpr char raw_scores_name[]{"raw_scores"};
+constexpr char multiclass_indices_name[]{"multiclass_indices"};
+constexpr char multiclass_scores_name[]{"multiclass_scores"};
+constexpr char multilabel_indices_name[]{"multilabel_indices"};
+constexpr char multilabel_scores_name[]{"multilabel_scores"};
 
 float sigmoid(float x) noexcept {
     return 1.0f / (1.0f + std::exp(-x));
@@ -78,6 +94,27 @@ void softmax(float* x_start, float* x_end, float eps = 1e-9) {
     }
 }
 
+// Overwrites the count-th label of a possibly reused result
+void setTopLabel(std::vector<ClassificationResult::Classification>& topLabels, size_t& count,
+                 unsigned int id, Label label, float score) {
+    if (count < topLabels.size()) {
+        ClassificationResult::Classification& classification = topLabels[count];
+        classification.id = id;
+        classification.label = std::move(label);
+        classification.score = score;
+    } else {
+        topLabels.emplace_back(id, std::move(label), score);
+    }
+    ++count;
+}
+
+// Keeps the tensor of a reused result if it matches the type and size of like
+void reuseOrCreate(ov::Tensor& tensor, const ov::Tensor& like) {
+    if (!tensor || tensor.get_element_type() != like.get_element_type() || tensor.get_size() != like.get_size()) {
+        tensor = ov::Tensor(like.get_element_type(), like.get_shape());
+    }
+}
+
 void addOrFindSoftmaxAndTopkOutputs(std::shared_ptr<ov::Model>& model, size_t topk, bool add_raw_scores) {
     auto nodes = model->get_ops();
     std::shared_ptr<ov::Node> softmaxNode;
@@ -144,6 +181,137 @@ void addOrFindSoftmaxAndTopkOutputs(std::shared_ptr<ov::Model>& model, size_t to
     model = ppp.build();
 }
 
+// Keeps the source outputs first, so hosts which decode logits can still use the model, and appends new ones
+void appendOutputs(std::shared_ptr<ov::Model>& model,
+                   const std::vector<std::tuple<ov::Output<ov::Node>, std::string, ov::element::Type>>& outputs) {
+    ov::OutputVector outputs_vector;
+    for (const ov::Output<ov::Node>& output : model->outputs()) {
+        outputs_vector.push_back(output.get_node()->input_value(0));
+    }
+    for (const auto& output : outputs) {
+        outputs_vector.push_back(std::get<0>(output));
+    }
+    std::vector<std::unordered_set<std::string>> names;
+    for (const ov::Output<ov::Node>& output : model->outputs()) {
+        names.push_back(output.get_names());
+    }
+
+    auto source_rt_info = model->has_rt_info("model_info") ? model->get_rt_info<ov::AnyMap>("model_info") : ov::AnyMap{};
+    model = std::make_shared<ov::Model>(outputs_vector, model->get_parameters(), "classification");
+    for (const auto& k : source_rt_info) {
+        model->set_rt_info(k.second, "model_info", k.first);
+    }
+
+    for (size_t i = 0; i < names.size(); ++i) {
+        model->outputs()[i].set_names(names[i]);
+    }
+    ov::preprocess::PrePostProcessor ppp = ov::preprocess::PrePostProcessor(model);
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        model->outputs()[names.size() + i].set_names({std::get<1>(outputs[i])});
+        ppp.output(std::get<1>(outputs[i])).tensor().set_element_type(std::get<2>(outputs[i]));
+    }
+    model = ppp.build();
+}
+
+// Selects the elements of a 1D tensor which are greater than the threshold, the output shapes are dynamic
+std::pair<ov::Output<ov::Node>, ov::Output<ov::Node>> compactAboveThreshold(const ov::Output<ov::Node>& scores,
+                                                                            float threshold) {
+    auto thresholdNode = ov::op::v0::Constant::create(scores.get_element_type(), ov::Shape{}, {threshold});
+    auto mask = std::make_shared<ov::op::v1::Greater>(scores, thresholdNode);
+    auto nonZero = std::make_shared<ov::op::v3::NonZero>(mask, ov::element::i32);
+    auto flat = ov::op::v0::Constant::create(ov::element::i64, ov::Shape{1}, {-1});
+    auto indices = std::make_shared<ov::op::v1::Reshape>(nonZero, flat, false);
+    auto axis = ov::op::v0::Constant::create(ov::element::i64, ov::Shape{}, {0});
+    auto selected = std::make_shared<ov::op::v8::Gather>(scores, indices, axis);
+    return {indices, selected};
+}
+
+ov::Output<ov::Node> flatten(const ov::Output<ov::Node>& output) {
+    auto flat = ov::op::v0::Constant::create(ov::element::i64, ov::Shape{1}, {-1});
+    return std::make_shared<ov::op::v1::Reshape>(output, flat, false);
+}
+
+ov::Output<ov::Node> slice(const ov::Output<ov::Node>& output, size_t begin, size_t end) {
+    auto start = ov::op::v0::Constant::create(ov::element::i64, ov::Shape{1}, {begin});
+    auto stop = ov::op::v0::Constant::create(ov::element::i64, ov::Shape{1}, {end});
+    auto step = ov::op::v0::Constant::create(ov::element::i64, ov::Shape{1}, {1});
+    return std::make_shared<ov::op::v8::Slice>(output, start, stop, step);
+}
+
+// Sigmoid and selection of labels above the threshold
+void addMultilabelOutputs(std::shared_ptr<ov::Model>& model, float threshold, bool add_raw_scores) {
+    auto logits = model->get_output_op(0)->input_value(0);
+    auto probabilities = std::make_shared<ov::op::v0::Sigmoid>(logits);
+    auto selected = compactAboveThreshold(flatten(probabilities), threshold);
+    std::vector<std::tuple<ov::Output<ov::Node>, std::string, ov::element::Type>> outputs{
+        {selected.first, indices_name, ov::element::i32},
+        {selected.second, scores_name, ov::element::f32}};
+    if (add_raw_scores) {
+        outputs.emplace_back(probabilities, raw_scores_name, ov::element::f32);
+    }
+    appendOutputs(model, outputs);
+}
+
+// Softmax and argmax of every multiclass head, sigmoid and selection of multilabel heads above the threshold.
+// Returns false if logits of heads aren't laid out one after another, such models are decoded by the host
+bool addHierarchicalOutputs(std::shared_ptr<ov::Model>& model, const HierarchicalConfig& info, float threshold,
+                            bool add_raw_scores) {
+    size_t expected_begin = 0;
+    for (size_t i = 0; i < info.num_multiclass_heads; ++i) {
+        auto range = info.head_idx_to_logits_range.find(i);
+        if (range == info.head_idx_to_logits_range.end() || range->second.first != expected_begin
+                || range->second.second <= range->second.first) {
+            return false;
+        }
+        expected_begin = range->second.second;
+    }
+    if (expected_begin != info.num_single_label_classes) {
+        return false;
+    }
+
+    auto logits = flatten(model->get_output_op(0)->input_value(0));
+    ov::OutputVector head_indices;
+    ov::OutputVector head_scores;
+    ov::OutputVector probabilities;
+    for (size_t i = 0; i < info.num_multiclass_heads; ++i) {
+        const auto& range = info.head_idx_to_logits_range.at(i);
+        auto softmax = std::make_shared<ov::op::v1::Softmax>(slice(logits, range.first, range.second), 0);
+        auto k = ov::op::v0::Constant::create(ov::element::i32, ov::Shape{}, {1});
+        auto top = std::make_shared<ov::op::v3::TopK>(softmax, k, 0, ov::op::v3::TopK::Mode::MAX,
+                                                      ov::op::v3::TopK::SortType::NONE);
+        head_scores.push_back(top->output(0));
+        head_indices.push_back(top->output(1));
+        probabilities.push_back(softmax);
+    }
+    std::vector<std::tuple<ov::Output<ov::Node>, std::string, ov::element::Type>> outputs;
+    if (info.num_multiclass_heads) {
+        outputs.emplace_back(std::make_shared<ov::op::v0::Concat>(head_indices, 0), multiclass_indices_name, ov::element::i32);
+        outputs.emplace_back(std::make_shared<ov::op::v0::Concat>(head_scores, 0), multiclass_scores_name, ov::element::f32);
+    }
+    if (info.num_multilabel_heads) {
+        auto multilabel = std::make_shared<ov::op::v0::Sigmoid>(
+            slice(logits, info.num_single_label_classes, info.num_single_label_classes + info.num_multilabel_heads));
+        auto selected = compactAboveThreshold(multilabel, threshold);
+        outputs.emplace_back(selected.first, multilabel_indices_name, ov::element::i32);
+        outputs.emplace_back(selected.second, multilabel_scores_name, ov::element::f32);
+        probabilities.push_back(multilabel);
+    }
+    if (add_raw_scores && !probabilities.empty()) {
+        outputs.emplace_back(std::make_shared<ov::op::v0::Concat>(probabilities, 0), raw_scores_name, ov::element::f32);
+    }
+    appendOutputs(model, outputs);
+    return true;
+}
+
+bool hasOutput(const std::shared_ptr<ov::Model>& model, const std::string& name) {
+    for (const ov::Output<ov::Node>& output : model->outputs()) {
+        if (output.get_names().count(name) > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 std::vector<std::string> get_non_xai_names(const std::vector<ov::Output<ov::Node>>& outputs) {
     std::vector<std::string> outputNames;
     outputNames.reserve(std::max(1, int(outputs.size()) - 2));
@@ -174,6 +342,7 @@ void ClassificationModel::init_from_config(const ov::AnyMap& top_priority, const
     confidence_threshold = get_from_any_maps("confidence_threshold", top_priority, mid_priority, confidence_threshold);
     multilabel = get_from_any_maps("multilabel", top_priority, mid_priority, multilabel);
     output_raw_scores = get_from_any_maps("output_raw_scores", top_priority, mid_priority, output_raw_scores);
+    embed_postprocessing = get_from_any_maps("embed_postprocessing", top_priority, mid_priority, embed_postprocessing);
     hierarchical = get_from_any_maps("hierarchical", top_priority, mid_priority, hierarchical);
     hierarchical_config = get_from_any_maps("hierarchical_config", top_priority, mid_priority, hierarchical_config);
     if (hierarchical) {
@@ -203,13 +372,14 @@ void ClassificationModel::updateModelInfo() {
     model->set_rt_info(multilabel, "model_info", "multilabel");
     model->set_rt_info(hierarchical, "model_info", "hierarchical");
     model->set_rt_info(output_raw_scores, "model_info", "output_raw_scores");
+    model->set_rt_info(embed_postprocessing, "model_info", "embed_postprocessing");
     model->set_rt_info(confidence_threshold, "model_info", "confidence_threshold");
     model->set_rt_info(hierarchical_config, "model_info", "hierarchical_config");
 }
 
 std::unique_ptr<ClassificationModel> ClassificationModel::create_model(const std::string& modelFile, const ov::AnyMap& configuration, bool preload, const std::string& device) {
     auto core = ov::Core();
-    std::shared_ptr<ov::Model> model = core.read_model(modelFile);
+    std::shared_ptr<ov::Model> model = readModel(core, modelFile, configuration);
 
     // Check model_type in the rt_info, ignore configuration
     std::string model_type = ClassificationModel::ModelType;
@@ -250,69 +420,96 @@ std::unique_ptr<ClassificationModel> ClassificationModel::create_model(std::shar
 }
 
 std::unique_ptr<ResultBase> ClassificationModel::postprocess(InferenceResult& infResult) {
-    std::unique_ptr<ResultBase> result;
+    ClassificationResult* result = new ClassificationResult(infResult.frameId, infResult.metaData);
+    auto retVal = std::unique_ptr<ResultBase>(result);
+    postprocessInto(infResult, *result);
+    return retVal;
+}
+
+void ClassificationModel::postprocessInto(InferenceResult& infResult, ResultBase& result) {
+    ClassificationResult& cls_res = result.asRef<ClassificationResult>();
+    cls_res.labelSet = getLabelSet();
     if (multilabel) {
-        result = get_multilabel_predictions(infResult, output_raw_scores);
+        get_multilabel_predictions(infResult, output_raw_scores, cls_res);
     } else if (hierarchical) {
-        result = get_hierarchical_predictions(infResult, output_raw_scores);
+        get_hierarchical_predictions(infResult, output_raw_scores, cls_res);
     } else {
-        result = get_multiclass_predictions(infResult, output_raw_scores);
+        get_multiclass_predictions(infResult, output_raw_scores, cls_res);
     }
 
-    ClassificationResult* cls_res = static_cast<ClassificationResult*>(result.get());
+    // Swapping hands the result's previous tensors back to the output map, which the adapter refills for the next frame
     auto saliency_map_iter = infResult.outputsData.find(saliency_map_name);
     if (saliency_map_iter != infResult.outputsData.end()) {
-        cls_res->saliency_map = std::move(saliency_map_iter->second);
+        std::swap(cls_res.saliency_map, saliency_map_iter->second);
     }
     auto feature_vector_iter = infResult.outputsData.find(feature_vector_name);
     if (feature_vector_iter != infResult.outputsData.end()) {
-        cls_res->feature_vector = std::move(feature_vector_iter->second);
+        std::swap(cls_res.feature_vector, feature_vector_iter->second);
     }
-    return result;
 }
 
-std::unique_ptr<ResultBase> ClassificationModel::get_multilabel_predictions(InferenceResult& infResult, bool add_raw_scores) {
+void ClassificationModel::get_multilabel_predictions(InferenceResult& infResult, bool add_raw_scores, ClassificationResult& result) {
+    auto indicesIter = infResult.outputsData.find(indices_name);
+    if (indicesIter != infResult.outputsData.end()) {
+        // Sigmoid and thresholding are embedded into the model
+        const ov::Tensor& indicesTensor = indicesIter->second;
+        const int* indicesPtr = indicesTensor.data<int>();
+        const float* scoresPtr = infResult.outputsData.find(scores_name)->second.data<float>();
+        if (add_raw_scores) {
+            const ov::Tensor& rawScoresTensor = infResult.outputsData.find(raw_scores_name)->second;
+            reuseOrCreate(result.raw_scores, rawScoresTensor);
+            std::memcpy(result.raw_scores.data(), rawScoresTensor.data(), rawScoresTensor.get_byte_size());
+        }
+        size_t count = 0;
+        for (size_t i = 0; i < indicesTensor.get_size(); ++i) {
+            setTopLabel(result.topLabels, count, indicesPtr[i], getLabel(indicesPtr[i]), scoresPtr[i]);
+        }
+        result.topLabels.erase(result.topLabels.begin() + count, result.topLabels.end());
+        return;
+    }
+
     const ov::Tensor& logitsTensor = infResult.outputsData.find(outputNames[0])->second;
     const float* logitsPtr = logitsTensor.data<float>();
 
-    ClassificationResult* result = new ClassificationResult(infResult.frameId, infResult.metaData);
-    auto retVal = std::unique_ptr<ResultBase>(result);
-
-    auto raw_scores = ov::Tensor();
     float* raw_scoresPtr = nullptr;
     if (add_raw_scores) {
-        raw_scores = ov::Tensor(logitsTensor.get_element_type(), logitsTensor.get_shape());
-        raw_scoresPtr = raw_scores.data<float>();
-        result->raw_scores = raw_scores;
+        reuseOrCreate(result.raw_scores, logitsTensor);
+        raw_scoresPtr = result.raw_scores.data<float>();
     }
 
-    result->topLabels.reserve(labels.size());
+    result.topLabels.reserve(labels.size());
+    size_t count = 0;
     for (size_t i = 0; i < labels.size(); ++i) {
         float score = sigmoid(logitsPtr[i]);
         if (score > confidence_threshold) {
-            result->topLabels.emplace_back(i, labels[i], score);
+            setTopLabel(result.topLabels, count, i, getLabel(i), score);
         }
         if (add_raw_scores) {
             raw_scoresPtr[i] = score;
         }
     }
-
-    return retVal;
+    result.topLabels.erase(result.topLabels.begin() + count, result.topLabels.end());
 }
 
-std::unique_ptr<ResultBase> ClassificationModel::get_hierarchical_predictions(InferenceResult& infResult, bool add_raw_scores) {
-    ClassificationResult* result = new ClassificationResult(infResult.frameId, infResult.metaData);
-
+void ClassificationModel::get_hierarchical_predictions(InferenceResult& infResult, bool add_raw_scores, ClassificationResult& result) {
+    if (infResult.outputsData.count(multiclass_indices_name) || infResult.outputsData.count(multilabel_indices_name)) {
+        get_embedded_hierarchical_predictions(infResult, add_raw_scores, result);
+        return;
+    }
     const ov::Tensor& logitsTensor = infResult.outputsData.find(outputNames[0])->second;
-    float* logitsPtr = logitsTensor.data<float>();
 
-    auto raw_scores = ov::Tensor();
-    float* raw_scoresPtr = nullptr;
+    // Outputs are read-only, the caller may share them. Probabilities are computed in raw_scores if they are
+    // requested and in a local copy otherwise
+    std::vector<float> probabilities;
+    float* logitsPtr = nullptr;
     if (add_raw_scores) {
-        raw_scores = ov::Tensor(logitsTensor.get_element_type(), logitsTensor.get_shape());
-        logitsTensor.copy_to(raw_scores);
-        raw_scoresPtr = raw_scores.data<float>();
-        result->raw_scores = raw_scores;
+        reuseOrCreate(result.raw_scores, logitsTensor);
+        logitsTensor.copy_to(result.raw_scores);
+        logitsPtr = result.raw_scores.data<float>();
+    } else {
+        const float* rawLogitsPtr = logitsTensor.data<float>();
+        probabilities.assign(rawLogitsPtr, rawLogitsPtr + logitsTensor.get_size());
+        logitsPtr = probabilities.data();
     }
 
     std::vector<std::reference_wrapper<std::string>> predicted_labels;
@@ -324,9 +521,6 @@ std::unique_ptr<ResultBase> ClassificationModel::get_hierarchical_predictions(In
     for (size_t i = 0; i < hierarchical_info.num_multiclass_heads; ++i) {
         const auto& logits_range = hierarchical_info.head_idx_to_logits_range[i];
         softmax(logitsPtr + logits_range.first, logitsPtr + logits_range.second);
-        if (add_raw_scores) {
-            softmax(raw_scoresPtr + logits_range.first, raw_scoresPtr + logits_range.second);
-        }
         size_t j = fargmax(logitsPtr + logits_range.first, logitsPtr + logits_range.second);
         predicted_labels.push_back(hierarchical_info.all_groups[i][j]);
         predicted_scores.push_back(logitsPtr[logits_range.first + j]);
@@ -341,49 +535,86 @@ std::unique_ptr<ResultBase> ClassificationModel::get_hierarchical_predictions(In
                 predicted_scores.push_back(score);
                 predicted_labels.push_back(hierarchical_info.all_groups[hierarchical_info.num_multiclass_heads + i][0]);
             }
-            if (add_raw_scores) {
-                raw_scoresPtr[hierarchical_info.num_single_label_classes + i] = score;
-            }
+            logitsPtr[hierarchical_info.num_single_label_classes + i] = score;
         }
     }
 
+    resolve_hierarchical_labels(predicted_labels, predicted_scores, result);
+}
+
+void ClassificationModel::get_embedded_hierarchical_predictions(InferenceResult& infResult, bool add_raw_scores,
+                                                                ClassificationResult& result) {
+    std::vector<std::reference_wrapper<std::string>> predicted_labels;
+    std::vector<float> predicted_scores;
+
+    auto multiclassIter = infResult.outputsData.find(multiclass_indices_name);
+    if (multiclassIter != infResult.outputsData.end()) {
+        const int* indicesPtr = multiclassIter->second.data<int>();
+        const float* scoresPtr = infResult.outputsData.find(multiclass_scores_name)->second.data<float>();
+        for (size_t i = 0; i < hierarchical_info.num_multiclass_heads; ++i) {
+            predicted_labels.push_back(hierarchical_info.all_groups[i].at(indicesPtr[i]));
+            predicted_scores.push_back(scoresPtr[i]);
+        }
+    }
+    auto multilabelIter = infResult.outputsData.find(multilabel_indices_name);
+    if (multilabelIter != infResult.outputsData.end()) {
+        const ov::Tensor& indicesTensor = multilabelIter->second;
+        const int* indicesPtr = indicesTensor.data<int>();
+        const float* scoresPtr = infResult.outputsData.find(multilabel_scores_name)->second.data<float>();
+        for (size_t i = 0; i < indicesTensor.get_size(); ++i) {
+            predicted_labels.push_back(hierarchical_info.all_groups.at(hierarchical_info.num_multiclass_heads + indicesPtr[i])[0]);
+            predicted_scores.push_back(scoresPtr[i]);
+        }
+    }
+    if (add_raw_scores) {
+        const ov::Tensor& rawScoresTensor = infResult.outputsData.find(raw_scores_name)->second;
+        reuseOrCreate(result.raw_scores, rawScoresTensor);
+        std::memcpy(result.raw_scores.data(), rawScoresTensor.data(), rawScoresTensor.get_byte_size());
+    }
+
+    resolve_hierarchical_labels(predicted_labels, predicted_scores, result);
+}
+
+void ClassificationModel::resolve_hierarchical_labels(const std::vector<std::reference_wrapper<std::string>>& predicted_labels,
+                                                      const std::vector<float>& predicted_scores,
+                                                      ClassificationResult& result) {
     auto resolved_labels = resolver.resolve_labels(predicted_labels, predicted_scores);
 
-    auto retVal = std::unique_ptr<ResultBase>(result);
-    result->topLabels.reserve(resolved_labels.first.size());
+    result.topLabels.reserve(resolved_labels.first.size());
+    size_t count = 0;
     for (size_t i = 0; i < resolved_labels.first.size(); ++i) {
-        result->topLabels.emplace_back(hierarchical_info.label_to_idx[resolved_labels.first[i]], resolved_labels.first[i], resolved_labels.second[i]);
+        setTopLabel(result.topLabels, count, hierarchical_info.label_to_idx[resolved_labels.first[i]],
+                    getLabelSet()->intern(resolved_labels.first[i]), resolved_labels.second[i]);
     }
-
-    return retVal;
+    result.topLabels.erase(result.topLabels.begin() + count, result.topLabels.end());
 }
 
-std::unique_ptr<ResultBase> ClassificationModel::get_multiclass_predictions(InferenceResult& infResult, bool add_raw_scores) {
+void ClassificationModel::get_multiclass_predictions(InferenceResult& infResult, bool add_raw_scores, ClassificationResult& result) {
     const ov::Tensor& indicesTensor = infResult.outputsData.find(indices_name)->second;
     const int* indicesPtr = indicesTensor.data<int>();
     const ov::Tensor& scoresTensor = infResult.outputsData.find(scores_name)->second;
     const float* scoresPtr = scoresTensor.data<float>();
 
-    ClassificationResult* result = new ClassificationResult(infResult.frameId, infResult.metaData);
-    auto retVal = std::unique_ptr<ResultBase>(result);
-
     if (add_raw_scores) {
         const ov::Tensor& logitsTensor = infResult.outputsData.find(raw_scores_name)->second;
-        result->raw_scores = ov::Tensor(logitsTensor.get_element_type(), logitsTensor.get_shape());
-        logitsTensor.copy_to(result->raw_scores);
-        result->raw_scores.set_shape(ov::Shape({result->raw_scores.get_size()}));
+        // The flattened shape is only built when the tensor has to be created
+        if (!result.raw_scores || result.raw_scores.get_element_type() != logitsTensor.get_element_type()
+                || result.raw_scores.get_size() != logitsTensor.get_size()) {
+            result.raw_scores = ov::Tensor(logitsTensor.get_element_type(), ov::Shape({logitsTensor.get_size()}));
+        }
+        std::memcpy(result.raw_scores.data(), logitsTensor.data(), logitsTensor.get_byte_size());
     }
 
-    result->topLabels.reserve(scoresTensor.get_size());
+    result.topLabels.reserve(scoresTensor.get_size());
+    size_t count = 0;
     for (size_t i = 0; i < scoresTensor.get_size(); ++i) {
         int ind = indicesPtr[i];
         if (ind < 0 || ind >= static_cast<int>(labels.size())) {
             throw std::runtime_error("Invalid index for the class label is found during postprocessing");
         }
-        result->topLabels.emplace_back(ind, labels[ind], scoresPtr[i]);
+        setTopLabel(result.topLabels, count, ind, getLabel(ind), scoresPtr[i]);
     }
-
-    return retVal;
+    result.topLabels.erase(result.topLabels.begin() + count, result.topLabels.end());
 }
 
 void ClassificationModel::prepareInputsOutputs(std::shared_ptr<ov::Model>& model) {
@@ -417,7 +648,8 @@ void ClassificationModel::prepareInputsOutputs(std::shared_ptr<ov::Model>& model
     }
 
     // --------------------------- Prepare output  -----------------------------------------------------
-    if (model->outputs().size() > 5) {
+    // Models with embedded processing have extra postprocessing outputs
+    if (!embedded_processing && model->outputs().size() > 5) {
         throw std::logic_error("Classification model wrapper supports topologies with up to 4 outputs");
     }
 
@@ -450,6 +682,21 @@ void ClassificationModel::prepareInputsOutputs(std::shared_ptr<ov::Model>& model
     }
 
     if (multilabel || hierarchical) {
+        if (!embedded_processing && embed_postprocessing) {
+            if (multilabel) {
+                addMultilabelOutputs(model, confidence_threshold, output_raw_scores);
+            } else if (!addHierarchicalOutputs(model, hierarchical_info, confidence_threshold, output_raw_scores)) {
+                slog::warn << "Logits of hierarchical heads aren't contiguous, they are decoded on the host" << slog::endl;
+            }
+        } else if (embedded_processing && (hasOutput(model, indices_name) || hasOutput(model, multilabel_indices_name))
+                && model->has_rt_info("model_info", "confidence_threshold")) {
+            // The model was saved with the threshold as a constant of the graph
+            float embedded_threshold = model->get_rt_info<float>("model_info", "confidence_threshold");
+            if (std::abs(embedded_threshold - confidence_threshold) > 1e-6f) {
+                throw std::runtime_error("confidence_threshold " + std::to_string(embedded_threshold) + " is embedded "
+                    "into the model, it can't be changed to " + std::to_string(confidence_threshold));
+            }
+        }
         embedded_processing = true;
         outputNames = get_non_xai_names(model->outputs());
         append_xai_names(model->outputs(), outputNames);
@@ -0,0 +1,123 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "models/compilation_tuner.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <openvino/openvino.hpp>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+}  // namespace
+
+CompilationTuner::CompilationTuner(std::vector<int> streams, std::vector<int> threads, std::chrono::milliseconds duration)
+    : streams(std::move(streams)), threads(std::move(threads)), duration(duration) {
+    int hardwareThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    if (this->streams.empty()) {
+        for (int count = 1; count <= hardwareThreads; count *= 2) {
+            this->streams.push_back(count);
+        }
+    }
+    if (this->threads.empty()) {
+        this->threads.push_back(0);
+        if (hardwareThreads > 1) {
+            this->threads.push_back(hardwareThreads / 2);
+        }
+    }
+    if (duration.count() <= 0) {
+        throw std::invalid_argument("CompilationTuner requires a positive duration");
+    }
+}
+
+CompilationTuner::Result CompilationTuner::tune(const std::shared_ptr<const ov::Model>& model, ov::Core& core,
+                                                const std::string& device, const InferenceInput& inputs) const {
+    Result result{{}, 0, 0};
+    for (int streamCount : streams) {
+        for (int threadCount : threads) {
+            Trial trial{{}, 0.0, 0.0};
+            if (streamCount > 0) {
+                trial.config.emplace(ov::num_streams.name(), ov::streams::Num(streamCount));
+            }
+            if (threadCount > 0) {
+                trial.config.emplace(ov::inference_num_threads.name(), threadCount);
+            }
+            ov::CompiledModel compiledModel = core.compile_model(model, device, trial.config);
+            std::vector<ov::InferRequest> requests(compiledModel.get_property(ov::optimal_number_of_infer_requests));
+            for (ov::InferRequest& request : requests) {
+                request = compiledModel.create_infer_request();
+                for (const auto& input : inputs) {
+                    request.set_tensor(input.first, input.second);
+                }
+            }
+            // The first inference is slower, keep it out of the measurement
+            requests.front().infer();
+
+            std::vector<double> latencies;
+            Clock::time_point deadline = Clock::now() + duration;
+            do {
+                Clock::time_point start = Clock::now();
+                requests.front().infer();
+                latencies.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+            } while (Clock::now() < deadline);
+            trial.latencyMs = median(std::move(latencies));
+
+            // Requests are awaited round-robin, all of them run the same work
+            size_t completed = 0;
+            std::vector<bool> inflight(requests.size(), true);
+            Clock::time_point start = Clock::now();
+            deadline = start + duration;
+            for (ov::InferRequest& request : requests) {
+                request.start_async();
+            }
+            for (size_t running = requests.size(); running > 0;) {
+                for (size_t i = 0; i < requests.size(); ++i) {
+                    if (!inflight[i]) {
+                        continue;
+                    }
+                    requests[i].wait();
+                    ++completed;
+                    if (Clock::now() < deadline) {
+                        requests[i].start_async();
+                    } else {
+                        inflight[i] = false;
+                        --running;
+                    }
+                }
+            }
+            trial.fps = completed / std::chrono::duration<double>(Clock::now() - start).count();
+
+            result.trials.push_back(std::move(trial));
+            const Trial& last = result.trials.back();
+            if (last.fps > result.trials[result.throughputBest].fps) {
+                result.throughputBest = result.trials.size() - 1;
+            }
+            if (last.latencyMs < result.trials[result.latencyBest].latencyMs) {
+                result.latencyBest = result.trials.size() - 1;
+            }
+        }
+    }
+    return result;
+}
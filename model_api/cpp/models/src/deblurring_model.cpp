@@ -119,7 +119,7 @@ std::shared_ptr<InternalModelData> DeblurringModel::preprocess(const InputData&
         slog::warn << "\tChosen model aspect ratio doesn't match image aspect ratio" << slog::endl;
         cv::resize(image, resizedImage, cv::Size(netInputWidth, netInputHeight));
     }
-    input.emplace(inputNames[0], wrapMat2Tensor(resizedImage));
+    input[inputNames[0]] = wrapMat2Tensor(resizedImage);
 
     return std::make_shared<InternalImageModelData>(image.cols, image.rows);
 }
@@ -67,7 +67,7 @@ std::unique_ptr<DetectionModel> DetectionModel::create_model(const std::string&
                                                              bool preload,
                                                              const std::string& device) {
     auto core = ov::Core();
-    std::shared_ptr<ov::Model> model = core.read_model(modelFile);
+    std::shared_ptr<ov::Model> model = readModel(core, modelFile, configuration);
     if (model_type.empty()) {
         try {
             if (model->has_rt_info("model_info", "model_type") ) {
@@ -127,6 +127,10 @@ std::unique_ptr<DetectionModel> DetectionModel::create_model(std::shared_ptr<Inf
         detectionModel = std::unique_ptr<DetectionModel>(new ModelYoloX(adapter));
     } else if (model_type == ModelCenterNet::ModelType) {
         detectionModel = std::unique_ptr<DetectionModel>(new ModelCenterNet(adapter));
+    } else if (model_type == YOLOv5::ModelType) {
+        detectionModel = std::unique_ptr<DetectionModel>(new YOLOv5(adapter));
+    } else if (model_type == YOLOv8::ModelType) {
+        detectionModel = std::unique_ptr<DetectionModel>(new YOLOv8(adapter));
     } else {
         throw std::runtime_error("Incorrect or unsupported model_type is provided: " + model_type);
     }
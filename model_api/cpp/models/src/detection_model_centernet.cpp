@@ -144,19 +144,22 @@ std::shared_ptr<InternalModelData> ModelCenterNet::preprocess(const InputData& i
     auto& img = inputData.asRef<ImageInputData>().inputImage;
     const auto& resizedImg = resizeImageExt(img, netInputWidth, netInputHeight, RESIZE_KEEP_ASPECT_LETTERBOX);
 
-    input.emplace(inputNames[0], wrapMat2Tensor(inputTransform(resizedImg)));
+    input[inputNames[0]] = wrapMat2Tensor(inputTransform(resizedImg));
     return std::make_shared<InternalImageModelData>(img.cols, img.rows);
 }
 
 namespace {
-std::vector<std::pair<size_t, float>> nms(float* scoresPtr, const ov::Shape& shape, float threshold, int kernel = 3) {
+std::vector<std::pair<size_t, float>> nms(const float* logitsPtr, const ov::Shape& shape, float threshold, int kernel = 3) {
     std::vector<std::pair<size_t, float>> scores;
     constexpr size_t INIT_VECTOR_SIZE = 200;
     scores.reserve(INIT_VECTOR_SIZE);
     auto chSize = shape[2] * shape[3];
 
-    for (size_t i = 0; i < shape[1] * shape[2] * shape[3]; ++i) {
-        scoresPtr[i] = expf(scoresPtr[i]) / (1 + expf(scoresPtr[i]));
+    // Outputs are read-only, the caller may share them
+    std::vector<float> probabilities(shape[1] * shape[2] * shape[3]);
+    float* scoresPtr = probabilities.data();
+    for (size_t i = 0; i < probabilities.size(); ++i) {
+        scoresPtr[i] = expf(logitsPtr[i]) / (1 + expf(logitsPtr[i]));
     }
 
     for (size_t ch = 0; ch < shape[1]; ++ch) {
@@ -200,7 +203,7 @@ std::vector<std::pair<size_t, float>> nms(float* scoresPtr, const ov::Shape& sha
 
 static std::vector<std::pair<size_t, float>> filterScores(const ov::Tensor& scoresTensor, float threshold) {
     auto shape = scoresTensor.get_shape();
-    float* scoresPtr = scoresTensor.data<float>();
+    const float* scoresPtr = scoresTensor.data<float>();
 
     return nms(scoresPtr, shape, threshold);
 }
@@ -311,13 +314,14 @@ std::unique_ptr<ResultBase> ModelCenterNet::postprocess(InferenceResult& infResu
 
     // --------------------------- Create detection result objects ------------------------------------
     DetectionResult* result = new DetectionResult(infResult.frameId, infResult.metaData);
+    result->labelSet = getLabelSet();
 
     result->objects.reserve(scores.size());
     for (size_t i = 0; i < scores.size(); ++i) {
         DetectedObject desc;
         desc.confidence = scores[i].second;
         desc.labelID = scores[i].first / chSize;
-        desc.label = getLabelName(desc.labelID);
+        desc.label = getLabel(desc.labelID);
         desc.x = clamp(boxes[i].left, 0.f, static_cast<float>(imgWidth));
         desc.y = clamp(boxes[i].top, 0.f, static_cast<float>(imgHeight));
         desc.width = clamp(boxes[i].getWidth(), 0.f, static_cast<float>(imgWidth));
@@ -368,6 +368,7 @@ std::unique_ptr<ResultBase> ModelRetinaFace::postprocess(InferenceResult& infRes
     // --------------------------- Create detection result objects
     // --------------------------------------------------------
     RetinaFaceDetectionResult* result = new RetinaFaceDetectionResult(infResult.frameId, infResult.metaData);
+    result->labelSet = getLabelSet();
 
     const auto imgWidth = infResult.internalModelData->asRef<InternalImageModelData>().inputImgWidth;
     const auto imgHeight = infResult.internalModelData->asRef<InternalImageModelData>().inputImgHeight;
@@ -391,7 +392,7 @@ std::unique_ptr<ResultBase> ModelRetinaFace::postprocess(InferenceResult& infRes
         desc.height = clamp(boxes[i].getHeight(), 0.f, static_cast<float>(imgHeight));
         //--- Default label 0 - Face. If detecting masks then labels would be 0 - No Mask, 1 - Mask
         desc.labelID = shouldDetectMasks ? (masks[i] > maskThreshold) : 0;
-        desc.label = labels[desc.labelID];
+        desc.label = getLabel(desc.labelID);
         result->objects.push_back(desc);
 
         //--- Scaling landmarks coordinates
@@ -269,6 +269,7 @@ std::unique_ptr<ResultBase> ModelRetinaFacePT::postprocess(InferenceResult& infR
     // --------------------------- Create detection result objects
     // --------------------------------------------------------
     RetinaFaceDetectionResult* result = new RetinaFaceDetectionResult(infResult.frameId, infResult.metaData);
+    result->labelSet = getLabelSet();
 
     result->objects.reserve(keptIndicies.size());
     result->landmarks.reserve(keptIndicies.size() * landmarksNum);
@@ -283,7 +284,7 @@ std::unique_ptr<ResultBase> ModelRetinaFacePT::postprocess(InferenceResult& infR
         desc.height = proposals[i].getHeight();
 
         desc.labelID = 0;
-        desc.label = labels[desc.labelID];
+        desc.label = getLabel(desc.labelID);
         result->objects.push_back(desc);
 
         //--- Filtering landmarks coordinates
@@ -21,6 +21,7 @@
 #include <stdexcept>
 #include <string>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include <openvino/openvino.hpp>
@@ -88,41 +89,70 @@ std::vector<std::string> filterOutXai(const std::vector<std::string>& names) {
 std::string ModelSSD::ModelType = "ssd";
 
 std::shared_ptr<InternalModelData> ModelSSD::preprocess(const InputData& inputData, InferenceInput& input) {
-    if (inputNames.size() > 1) {
+    if (inputNames.size() > 1 && input.find(inputNames[1]) == input.end()) {
+        // Image info doesn't depend on the frame, so a reused input map keeps the tensor
         ov::Tensor info{ov::element::i32, ov::Shape({1, 3})};
         int32_t* data = info.data<int32_t>();
         data[0] = netInputHeight;
         data[1] = netInputWidth;
-        data[3] = 1;
-        input.emplace(inputNames[1], std::move(info));
+        data[2] = 1;
+        input[inputNames[1]] = std::move(info);
     }
     return DetectionModel::preprocess(inputData, input);
 }
 
 std::unique_ptr<ResultBase> ModelSSD::postprocess(InferenceResult& infResult) {
-    std::unique_ptr<ResultBase> result = filterOutXai(outputNames).size() > 1 ? postprocessMultipleOutputs(infResult) : postprocessSingleOutput(infResult);
-    DetectionResult* cls_res = static_cast<DetectionResult*>(result.get());
+    DetectionResult* result = new DetectionResult(infResult.frameId, infResult.metaData);
+    auto retVal = std::unique_ptr<ResultBase>(result);
+    DetectionsLayout layout;
+    postprocessDetections(infResult, *result, layout);
+    return retVal;
+}
+
+void ModelSSD::postprocessInto(InferenceResult& infResult, ResultBase& result) {
+    postprocessDetections(infResult, result.asRef<DetectionResult>(), steadyLayout);
+}
+
+void ModelSSD::postprocessDetections(InferenceResult& infResult, DetectionResult& detResult, DetectionsLayout& layout) {
+    std::call_once(namesWithoutXaiOnce, [this] {
+        namesWithoutXai = filterOutXai(outputNames);
+    });
+    detResult.labelSet = getLabelSet();
+    if (namesWithoutXai.size() > 1) {
+        postprocessMultipleOutputs(infResult, detResult, layout);
+    } else {
+        postprocessSingleOutput(infResult, detResult, layout);
+    }
+    // Swapping hands the result's previous tensors back to the output map, which the adapter refills for the next frame
     auto saliency_map_iter = infResult.outputsData.find(saliency_map_name);
     if (saliency_map_iter != infResult.outputsData.end()) {
-        cls_res->saliency_map = std::move(saliency_map_iter->second);
+        std::swap(detResult.saliency_map, saliency_map_iter->second);
     }
     auto feature_vector_iter = infResult.outputsData.find(feature_vector_name);
     if (feature_vector_iter != infResult.outputsData.end()) {
-        cls_res->feature_vector = std::move(feature_vector_iter->second);
+        std::swap(detResult.feature_vector, feature_vector_iter->second);
+    }
+}
+
+void ModelSSD::updateDetectionsLayout(const ov::Tensor& detectionsTensor, bool singleOutput, DetectionsLayout& layout) {
+    // A reshape may keep the size of the tensor, so the whole shape is compared
+    const ov::Shape& shape = detectionsTensor.get_shape();
+    if (shape == layout.shape) {
+        return;
     }
-    return result;
+    NumAndStep numAndStep = singleOutput ? fromSingleOutput(shape) : fromMultipleOutputs(shape);
+    layout.detectionsNum = numAndStep.detectionsNum;
+    layout.objectSize = numAndStep.objectSize;
+    layout.shape = shape;
 }
 
-std::unique_ptr<ResultBase> ModelSSD::postprocessSingleOutput(InferenceResult& infResult) {
-    const std::vector<std::string> namesWithoutXai = filterOutXai(outputNames);
+void ModelSSD::postprocessSingleOutput(InferenceResult& infResult, DetectionResult& result, DetectionsLayout& layout) {
     assert(namesWithoutXai.size() == 1);
     const ov::Tensor& detectionsTensor = infResult.outputsData[namesWithoutXai[0]];
-    NumAndStep numAndStep = fromSingleOutput(detectionsTensor.get_shape());
+    updateDetectionsLayout(detectionsTensor, true, layout);
+    const size_t detectionsNum = layout.detectionsNum, objectSize = layout.objectSize;
     const float* detections = detectionsTensor.data<float>();
 
-    DetectionResult* result = new DetectionResult(infResult.frameId, infResult.metaData);
-    auto retVal = std::unique_ptr<ResultBase>(result);
-
     const auto& internalData = infResult.internalModelData->asRef<InternalImageModelData>();
     float floatInputImgWidth = float(internalData.inputImgWidth),
          floatInputImgHeight = float(internalData.inputImgHeight);
@@ -137,54 +167,51 @@ std::unique_ptr<ResultBase> ModelSSD::postprocessSingleOutput(InferenceResult& i
         }
     }
 
-    for (size_t i = 0; i < numAndStep.detectionsNum; i++) {
-        float image_id = detections[i * numAndStep.objectSize + 0];
+    size_t count = 0;
+    for (size_t i = 0; i < detectionsNum; i++) {
+        float image_id = detections[i * objectSize + 0];
         if (image_id < 0) {
             break;
         }
 
-        float confidence = detections[i * numAndStep.objectSize + 2];
+        float confidence = detections[i * objectSize + 2];
 
         /** Filtering out objects with confidence < confidence_threshold probability **/
         if (confidence > confidence_threshold) {
-            DetectedObject desc;
+            DetectedObject& desc = nextObject(result.objects, count);
 
             desc.confidence = confidence;
-            desc.labelID = static_cast<size_t>(detections[i * numAndStep.objectSize + 1]);
-            desc.label = getLabelName(desc.labelID);
+            desc.labelID = static_cast<size_t>(detections[i * objectSize + 1]);
+            desc.label = getLabel(desc.labelID);
             desc.x = clamp(
-                round((detections[i * numAndStep.objectSize + 3] * netInputWidth - padLeft) * invertedScaleX),
+                round((detections[i * objectSize + 3] * netInputWidth - padLeft) * invertedScaleX),
                 0.f,
                 floatInputImgWidth);
             desc.y = clamp(
-                round((detections[i * numAndStep.objectSize + 4] * netInputHeight - padTop) * invertedScaleY),
+                round((detections[i * objectSize + 4] * netInputHeight - padTop) * invertedScaleY),
                 0.f,
                 floatInputImgHeight);
             desc.width = clamp(
-                round((detections[i * numAndStep.objectSize + 5] * netInputWidth - padLeft) * invertedScaleX),
+                round((detections[i * objectSize + 5] * netInputWidth - padLeft) * invertedScaleX),
                 0.f,
                 floatInputImgWidth) - desc.x;
             desc.height = clamp(
-                round((detections[i * numAndStep.objectSize + 6] * netInputHeight - padTop) * invertedScaleY),
+                round((detections[i * objectSize + 6] * netInputHeight - padTop) * invertedScaleY),
                 0.f,
                 floatInputImgHeight) - desc.y;
-            result->objects.push_back(desc);
         }
     }
-
-    return retVal;
+    result.objects.resize(count);
 }
 
-std::unique_ptr<ResultBase> ModelSSD::postprocessMultipleOutputs(InferenceResult& infResult) {
-    const std::vector<std::string> namesWithoutXai = filterOutXai(outputNames);
-    const float* boxes = infResult.outputsData[namesWithoutXai[0]].data<float>();
-    NumAndStep numAndStep = fromMultipleOutputs(infResult.outputsData[namesWithoutXai[0]].get_shape());
+void ModelSSD::postprocessMultipleOutputs(InferenceResult& infResult, DetectionResult& result, DetectionsLayout& layout) {
+    const ov::Tensor& boxesTensor = infResult.outputsData[namesWithoutXai[0]];
+    updateDetectionsLayout(boxesTensor, false, layout);
+    const size_t detectionsNum = layout.detectionsNum, objectSize = layout.objectSize;
+    const float* boxes = boxesTensor.data<float>();
     const int64_t* labels = infResult.outputsData[namesWithoutXai[1]].data<int64_t>();
     const float* scores = namesWithoutXai.size() > 2 ? infResult.outputsData[namesWithoutXai[2]].data<float>() : nullptr;
 
-    DetectionResult* result = new DetectionResult(infResult.frameId, infResult.metaData);
-    auto retVal = std::unique_ptr<ResultBase>(result);
-
     const auto& internalData = infResult.internalModelData->asRef<InternalImageModelData>();
     float floatInputImgWidth = float(internalData.inputImgWidth),
          floatInputImgHeight = float(internalData.inputImgHeight);
@@ -204,37 +231,36 @@ std::unique_ptr<ResultBase> ModelSSD::postprocessMultipleOutputs(InferenceResult
     float widthScale = scores ? netInputWidth : 1.0f;
     float heightScale = scores ? netInputHeight : 1.0f;
 
-    for (size_t i = 0; i < numAndStep.detectionsNum; i++) {
-        float confidence = scores ? scores[i] : boxes[i * numAndStep.objectSize + 4];
+    size_t count = 0;
+    for (size_t i = 0; i < detectionsNum; i++) {
+        float confidence = scores ? scores[i] : boxes[i * objectSize + 4];
 
         /** Filtering out objects with confidence < confidence_threshold probability **/
         if (confidence > confidence_threshold) {
-            DetectedObject desc;
+            DetectedObject& desc = nextObject(result.objects, count);
 
             desc.confidence = confidence;
             desc.labelID = labels[i];
-            desc.label = getLabelName(desc.labelID);
+            desc.label = getLabel(desc.labelID);
             desc.x = clamp(
-                round((boxes[i * numAndStep.objectSize] * widthScale - padLeft) * invertedScaleX),
+                round((boxes[i * objectSize] * widthScale - padLeft) * invertedScaleX),
                 0.f,
                 floatInputImgWidth);
             desc.y = clamp(
-                round((boxes[i * numAndStep.objectSize + 1] * heightScale - padTop) * invertedScaleY),
+                round((boxes[i * objectSize + 1] * heightScale - padTop) * invertedScaleY),
                 0.f,
                 floatInputImgHeight);
             desc.width = clamp(
-                round((boxes[i * numAndStep.objectSize + 2] * widthScale - padLeft) * invertedScaleX),
+                round((boxes[i * objectSize + 2] * widthScale - padLeft) * invertedScaleX),
                 0.f,
                 floatInputImgWidth) - desc.x;
             desc.height = clamp(
-                round((boxes[i * numAndStep.objectSize + 3] * heightScale - padTop) * invertedScaleY),
+                round((boxes[i * objectSize + 3] * heightScale - padTop) * invertedScaleY),
                 0.f,
                 floatInputImgHeight) - desc.y;
-            result->objects.push_back(desc);
         }
     }
-
-    return retVal;
+    result.objects.resize(count);
 }
 
 void ModelSSD::prepareInputsOutputs(std::shared_ptr<ov::Model>& model) {
@@ -274,6 +274,7 @@ void ModelYolo::prepareInputsOutputs(std::shared_ptr<ov::Model>& model) {
 
 std::unique_ptr<ResultBase> ModelYolo::postprocess(InferenceResult& infResult) {
     DetectionResult* result = new DetectionResult(infResult.frameId, infResult.metaData);
+    result->labelSet = getLabelSet();
     std::vector<DetectedObject> objects;
 
     // Parsing outputs
@@ -424,7 +425,7 @@ void ModelYolo::parseYOLOOutput(const std::string& output_name,
                     if (prob >= confidence_threshold) {
                         obj.confidence = prob;
                         obj.labelID = j;
-                        obj.label = getLabelName(obj.labelID);
+                        obj.label = getLabel(obj.labelID);
                         objects.push_back(obj);
                     }
                 }
@@ -581,33 +582,53 @@ YOLOv5::YOLOv5(std::shared_ptr<InferenceAdapter>& adapter)
 }
 
 std::unique_ptr<ResultBase> YOLOv5::postprocess(InferenceResult& infResult) {
+    DetectionResult* result = new DetectionResult(infResult.frameId, infResult.metaData);
+    result->labelSet = getLabelSet();
+    auto base = std::unique_ptr<ResultBase>(result);
+    Workspace workspace;
+    postprocessDetections(infResult, *result, workspace);
+    return base;
+}
+
+void YOLOv5::postprocessInto(InferenceResult& infResult, ResultBase& result) {
+    postprocessDetections(infResult, result.asRef<DetectionResult>(), steadyWorkspace);
+}
+
+void YOLOv5::postprocessDetections(InferenceResult& infResult, DetectionResult& detResult, Workspace& workspace) {
     if (1 != infResult.outputsData.size()) {
         throw std::runtime_error("YOLO: expect 1 output");
     }
     const ov::Tensor& detectionsTensor = infResult.getFirstOutputTensor();
-    const ov::Shape& out_shape = detectionsTensor.get_shape();
-    if (3 != out_shape.size()) {
+    ov::Shape& outShape = workspace.outShape;
+    std::vector<AnchorLabeled>& boxesWithClass = workspace.boxesWithClass;
+    std::vector<float>& confidences = workspace.confidences;
+    std::vector<size_t>& keep = workspace.keep;
+    // Copy the shape only when it changes. A reshape may keep the size of the tensor, so the whole shape is compared
+    if (detectionsTensor.get_shape() != outShape) {
+        outShape = detectionsTensor.get_shape();
+    }
+    if (3 != outShape.size()) {
         throw std::runtime_error("YOLO: the output must be of rank 3");
     }
-    if (1 != out_shape[0]) {
+    if (1 != outShape[0]) {
         throw std::runtime_error("YOLO: the first dim of the output must be 1");
     }
-    size_t num_proposals = out_shape[2];
-    std::vector<AnchorLabeled> boxes_with_class;
-    std::vector<float> confidences;
+    size_t num_proposals = outShape[2];
+    boxesWithClass.clear();
+    confidences.clear();
     const float* const detections = detectionsTensor.data<float>();
     for (size_t i = 0; i < num_proposals; ++i) {
         float confidence = 0.0f;
         size_t max_id = 0;
         constexpr size_t LABELS_START = 4;
-        for (size_t j = LABELS_START; j < out_shape[1]; ++j) {
+        for (size_t j = LABELS_START; j < outShape[1]; ++j) {
             if (detections[j * num_proposals + i] > confidence) {
                 confidence = detections[j * num_proposals + i];
                 max_id = j;
             }
         }
         if (confidence > confidence_threshold) {
-            boxes_with_class.emplace_back(
+            boxesWithClass.emplace_back(
                 detections[0 * num_proposals + i] - detections[2 * num_proposals + i] / 2.0f,
                 detections[1 * num_proposals + i] - detections[3 * num_proposals + i] / 2.0f,
                 detections[0 * num_proposals + i] + detections[2 * num_proposals + i] / 2.0f,
@@ -619,14 +640,12 @@ std::unique_ptr<ResultBase> YOLOv5::postprocess(InferenceResult& infResult) {
     }
     constexpr bool includeBoundaries = false;
     constexpr size_t keep_top_k = 30000;
-    std::vector<size_t> keep;
     if (agnostic_nms) {
-        keep = nms(boxes_with_class, confidences, iou_threshold, includeBoundaries, keep_top_k);
+        nms(boxesWithClass, confidences, iou_threshold, keep, workspace.nmsWorkspace, includeBoundaries, keep_top_k);
     } else {
-        keep = multiclass_nms(boxes_with_class, confidences, iou_threshold, includeBoundaries, keep_top_k);
+        multiclass_nms(boxesWithClass, confidences, iou_threshold, keep, workspace.nmsWorkspace, includeBoundaries, keep_top_k);
     }
-    DetectionResult* result = new DetectionResult(infResult.frameId, infResult.metaData);
-    auto base = std::unique_ptr<ResultBase>(result);
+    detResult.labelSet = getLabelSet();
     const auto& internalData = infResult.internalModelData->asRef<InternalImageModelData>();
     float floatInputImgWidth = float(internalData.inputImgWidth),
          floatInputImgHeight = float(internalData.inputImgHeight);
@@ -640,30 +659,30 @@ std::unique_ptr<ResultBase> YOLOv5::postprocess(InferenceResult& infResult) {
             padTop = (netInputHeight - int(std::round(floatInputImgHeight / invertedScaleY))) / 2;
         }
     }
+    size_t count = 0;
     for (size_t idx : keep) {
-        DetectedObject desc;
+        DetectedObject& desc = nextObject(detResult.objects, count);
         desc.x = clamp(
-            round((boxes_with_class[idx].left - padLeft) * invertedScaleX),
+            round((boxesWithClass[idx].left - padLeft) * invertedScaleX),
             0.f,
             floatInputImgWidth);
         desc.y = clamp(
-            round((boxes_with_class[idx].top - padTop) * invertedScaleY),
+            round((boxesWithClass[idx].top - padTop) * invertedScaleY),
             0.f,
             floatInputImgHeight);
         desc.width = clamp(
-            round((boxes_with_class[idx].right - padLeft) * invertedScaleX),
+            round((boxesWithClass[idx].right - padLeft) * invertedScaleX),
             0.f,
             floatInputImgWidth) - desc.x;
         desc.height = clamp(
-            round((boxes_with_class[idx].bottom - padTop) * invertedScaleY),
+            round((boxesWithClass[idx].bottom - padTop) * invertedScaleY),
             0.f,
             floatInputImgHeight) - desc.y;
         desc.confidence = confidences[idx];
-        desc.labelID = static_cast<size_t>(boxes_with_class[idx].labelID);
-        desc.label = getLabelName(desc.labelID);
-        result->objects.push_back(desc);
+        desc.labelID = static_cast<size_t>(boxesWithClass[idx].labelID);
+        desc.label = getLabel(desc.labelID);
     }
-    return base;
+    detResult.objects.resize(count);
 }
 
 std::string YOLOv8::ModelType = "YOLOv8";
@@ -118,7 +118,7 @@ std::shared_ptr<InternalModelData> ModelYoloV3ONNX::preprocess(const InputData&
     int32_t* data = info.data<int32_t>();
     data[0] = origImg.rows;
     data[1] = origImg.cols;
-    input.emplace(inputNames[1], std::move(info));
+    input[inputNames[1]] = std::move(info);
     return ImageModel::preprocess(inputData, input);
 }
 
@@ -150,6 +150,7 @@ std::unique_ptr<ResultBase> ModelYoloV3ONNX::postprocess(InferenceResult& infRes
 
     // Generate detection results
     DetectionResult* result = new DetectionResult(infResult.frameId, infResult.metaData);
+    result->labelSet = getLabelSet();
     size_t numberOfBoxes = indicesShape.size() == 3 ? indicesShape[1] : indicesShape[0];
     size_t indicesStride = indicesShape.size() == 3 ? indicesShape[2] : indicesShape[1];
 
@@ -180,7 +181,7 @@ std::unique_ptr<ResultBase> ModelYoloV3ONNX::postprocess(InferenceResult& infRes
             obj.width = clamp(width, 0.f, static_cast<float>(imgWidth));
             obj.confidence = score;
             obj.labelID = classInd;
-            obj.label = getLabelName(classInd);
+            obj.label = getLabel(classInd);
 
             result->objects.push_back(obj);
 
@@ -132,7 +132,7 @@ std::shared_ptr<InternalModelData> ModelYoloX::preprocess(const InputData& input
     cv::Mat resizedImage = resizeImageExt(origImg, netInputWidth, netInputHeight, resizeMode,
                                           interpolationMode, nullptr, cv::Scalar(114, 114, 114));
 
-    input.emplace(inputNames[0], wrapMat2Tensor(resizedImage));
+    input[inputNames[0]] = wrapMat2Tensor(resizedImage);
     return std::make_shared<InternalScaleData>(origImg.cols, origImg.rows, scale, scale);
 }
 
@@ -143,19 +143,12 @@ std::unique_ptr<ResultBase> ModelYoloX::postprocess(InferenceResult& infResult)
     // Get output tensor
     const ov::Tensor& output = infResult.outputsData[outputNames[0]];
     const auto& outputShape = output.get_shape();
-    float* outputPtr = output.data<float>();
+    // Outputs are read-only, the caller may share them
+    const float* outputPtr = output.data<float>();
 
     // Generate detection results
     DetectionResult* result = new DetectionResult(infResult.frameId, infResult.metaData);
-
-    // Update coordinates according to strides
-    for (size_t box_index = 0; box_index < expandedStrides.size(); ++box_index) {
-        size_t startPos = outputShape[2] * box_index;
-        outputPtr[startPos] = (outputPtr[startPos] + grids[box_index].first) * expandedStrides[box_index];
-        outputPtr[startPos + 1] = (outputPtr[startPos + 1] + grids[box_index].second) * expandedStrides[box_index];
-        outputPtr[startPos + 2] = std::exp(outputPtr[startPos + 2]) * expandedStrides[box_index];
-        outputPtr[startPos + 3] = std::exp(outputPtr[startPos + 3]) * expandedStrides[box_index];
-    }
+    result->labelSet = getLabelSet();
 
     // Filter predictions
     std::vector<Anchor> validBoxes;
@@ -183,8 +176,13 @@ std::unique_ptr<ResultBase> ModelYoloX::postprocess(InferenceResult& infResult)
         // Add successful boxes
         scores.push_back(score);
         classes.push_back(mainClass);
-        Anchor trueBox = {outputPtr[startPos + 0] - outputPtr[startPos + 2] / 2, outputPtr[startPos + 1] - outputPtr[startPos + 3] / 2,
-                          outputPtr[startPos + 0] + outputPtr[startPos + 2] / 2, outputPtr[startPos + 1] + outputPtr[startPos + 3] / 2};
+        // Update coordinates according to strides only for the boxes which passed the threshold
+        const float stride = static_cast<float>(expandedStrides[box_index]);
+        const float centerX = (outputPtr[startPos + 0] + grids[box_index].first) * stride;
+        const float centerY = (outputPtr[startPos + 1] + grids[box_index].second) * stride;
+        const float width = std::exp(outputPtr[startPos + 2]) * stride;
+        const float height = std::exp(outputPtr[startPos + 3]) * stride;
+        Anchor trueBox = {centerX - width / 2, centerY - height / 2, centerX + width / 2, centerY + height / 2};
         validBoxes.push_back(Anchor({trueBox.left / scale.scaleX, trueBox.top / scale.scaleY,
                                      trueBox.right / scale.scaleX, trueBox.bottom / scale.scaleY}));
     }
@@ -200,7 +198,7 @@ std::unique_ptr<ResultBase> ModelYoloX::postprocess(InferenceResult& infResult)
         obj.width = clamp(validBoxes[index].right - validBoxes[index].left, 0.f, static_cast<float>(scale.inputImgWidth));
         obj.confidence = scores[index];
         obj.labelID = classes[index];
-        obj.label = getLabelName(classes[index]);
+        obj.label = getLabel(classes[index]);
         result->objects.push_back(obj);
     }
 
@@ -141,7 +141,7 @@ std::shared_ptr<InternalModelData> HpeAssociativeEmbedding::preprocess(const Inp
     if (inputLayerSize.height - stride >= roi.height || inputLayerSize.width - stride >= roi.width) {
         slog::warn << "\tChosen model aspect ratio doesn't match image aspect ratio" << slog::endl;
     }
-    input.emplace(inputNames[0], wrapMat2Tensor(paddedImage));
+    input[inputNames[0]] = wrapMat2Tensor(paddedImage);
 
     return std::make_shared<InternalScaleData>(paddedImage.cols,
                                                paddedImage.rows,
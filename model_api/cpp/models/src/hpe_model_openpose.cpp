@@ -149,7 +149,7 @@ std::shared_ptr<InternalModelData> HPEOpenPose::preprocess(const InputData& inpu
         slog::warn << "\tChosen model aspect ratio doesn't match image aspect ratio" << slog::endl;
     }
 
-    input.emplace(inputNames[0], wrapMat2Tensor(paddedImage));
+    input[inputNames[0]] = wrapMat2Tensor(paddedImage);
 
     return std::make_shared<InternalScaleData>(paddedImage.cols,
                                                paddedImage.rows,
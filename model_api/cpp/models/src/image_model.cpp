@@ -21,6 +21,11 @@
 #include <fstream>
 
 #include <opencv2/core.hpp>
+#include <openvino/op/add.hpp>
+#include <openvino/op/clamp.hpp>
+#include <openvino/op/constant.hpp>
+#include <openvino/op/floor.hpp>
+#include <openvino/op/multiply.hpp>
 #include <openvino/openvino.hpp>
 
 #include <utils/image_utils.h>
@@ -55,6 +60,26 @@ RESIZE_MODE ImageModel::selectResizeMode(const std::string& resize_type) {
     return resize;
 }
 
+void ImageModel::setOutputPrecision(ov::preprocess::PrePostProcessor& ppp, const std::string& outputName, const std::string& precision) {
+    if ("f32" == precision) {
+        ppp.output(outputName).tensor().set_element_type(ov::element::f32);
+    } else if ("f16" == precision) {
+        ppp.output(outputName).tensor().set_element_type(ov::element::f16);
+    } else if ("u8" == precision) {
+        // Round explicitly, the conversion to u8 alone would truncate
+        ppp.output(outputName).postprocess().custom([](const ov::Output<ov::Node>& node) {
+            const ov::element::Type& type = node.get_element_type();
+            auto scaled = std::make_shared<ov::op::v1::Multiply>(node, ov::op::v0::Constant::create(type, ov::Shape{}, {255.0f}));
+            auto shifted = std::make_shared<ov::op::v1::Add>(scaled, ov::op::v0::Constant::create(type, ov::Shape{}, {0.5f}));
+            auto rounded = std::make_shared<ov::op::v0::Floor>(shifted);
+            return std::make_shared<ov::op::v0::Clamp>(rounded, 0.0, 255.0)->output(0);
+        });
+        ppp.output(outputName).tensor().set_element_type(ov::element::u8);
+    } else {
+        throw std::runtime_error("Unknown value for output_precision arg: " + precision);
+    }
+}
+
 ImageModel::ImageModel(std::shared_ptr<ov::Model>& model, const ov::AnyMap& configuration)
     : ModelBase(model, configuration) {
     auto auto_resize_iter = configuration.find("auto_resize");
@@ -277,8 +302,51 @@ std::shared_ptr<InternalModelData> ImageModel::preprocess(const InputData& input
         }
         img = resizeImageExt(img, width, height, resizeMode, interpolationMode);
     }
-    input.emplace(inputNames[0], wrapMat2Tensor(img));
-    return std::make_shared<InternalImageModelData>(origImg.cols, origImg.rows);
+    input[inputNames[0]] = wrapMat2Tensor(img);
+    // Reuse the previous frame's data unless a caller still holds it. Taking it out of the member leaves nothing to
+    // reuse for a concurrent call, which allocates its own
+    std::shared_ptr<InternalImageModelData> data =
+        std::atomic_exchange(&internalImageData, std::shared_ptr<InternalImageModelData>());
+    if (data.use_count() != 1) {
+        data = std::make_shared<InternalImageModelData>(origImg.cols, origImg.rows);
+    } else {
+        data->inputImgWidth = origImg.cols;
+        data->inputImgHeight = origImg.rows;
+    }
+    std::atomic_store(&internalImageData, data);
+    return data;
+}
+
+InferenceInput ImageModel::createWarmupInput(const ov::Shape& shape) {
+    size_t height = netInputHeight, width = netInputWidth, channels = 3;
+    if (shape.empty() && (0 == height || 0 == width)) {
+        const ov::PartialShape& inputShape = inferenceAdapter->getInputShape(inputNames[0]);
+        if (inputShape.is_dynamic()) {
+            throw std::runtime_error("The model input is dynamic, warm-up requires image shapes");
+        }
+        const ov::Layout& layout = getLayoutFromShape(inputShape);
+        height = inputShape.get_shape()[ov::layout::height_idx(layout)];
+        width = inputShape.get_shape()[ov::layout::width_idx(layout)];
+    } else if (shape.size() == 2 || shape.size() == 3) {
+        height = shape[0];
+        width = shape[1];
+        channels = shape.size() == 3 ? shape[2] : channels;
+    } else if (!shape.empty()) {
+        throw std::invalid_argument("Warm-up image shape must be {height, width} or {height, width, channels}");
+    }
+    // Preprocessing an image makes inputs exactly as infer() does, including the resize for non embedded models
+    cv::Mat image(static_cast<int>(height), static_cast<int>(width), CV_8UC(static_cast<int>(channels)), cv::Scalar::all(0));
+    InferenceInput input;
+    preprocess(ImageInputData(image), input);
+    return input;
+}
+
+const std::shared_ptr<const LabelSet>& ImageModel::getLabelSet() {
+    // labels are final once the model is prepared, so the set is created on the first use, which may be concurrent
+    std::call_once(labelSetOnce, [this] {
+        labelSet = std::make_shared<const LabelSet>(labels);
+    });
+    return labelSet;
 }
 
 std::vector<std::string> ImageModel::loadLabels(const std::string& labelFilename) {
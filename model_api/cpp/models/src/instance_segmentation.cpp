@@ -33,6 +33,7 @@
 #include "models/input_data.h"
 #include "models/results.h"
 #include "utils/common.hpp"
+#include "utils/work_stealing_pool.hpp"
 
 namespace {
 constexpr char saliency_map_name[]{"saliency_map"};
@@ -137,7 +138,9 @@ cv::Mat segm_postprocess(const SegmentedObject& box, const cv::Mat& unpadded, in
     cv::Mat resized;
     cv::resize(raw_cls_mask, resized, {w, h});
     cv::Mat im_mask(cv::Size{im_w, im_h}, CV_8UC1, cv::Scalar{0});
-    im_mask(cv::Rect{x0, y0, x1-x0, y1-y0}).setTo(1, resized({cv::Point(x0-extended_box.x, y0-extended_box.y), cv::Point(x1-extended_box.x, y1-extended_box.y)}) > 0.5f);
+    // u8 masks hold probabilities scaled to [0, 255]
+    float threshold = CV_8U == unpadded.depth() ? 127.5f : 0.5f;
+    im_mask(cv::Rect{x0, y0, x1-x0, y1-y0}).setTo(1, resized({cv::Point(x0-extended_box.x, y0-extended_box.y), cv::Point(x1-extended_box.x, y1-extended_box.y)}) > threshold);
     return im_mask;
 }
 
@@ -163,6 +166,14 @@ MaskRCNNModel::MaskRCNNModel(std::shared_ptr<ov::Model>& model, const ov::AnyMap
         std::string val = postprocess_semantic_masks_iter->second.as<std::string>();
         postprocess_semantic_masks = val == "True" || val == "YES";
     }
+    auto output_precision_iter = configuration.find("output_precision");
+    if (output_precision_iter == configuration.end()) {
+        if (model->has_rt_info("model_info", "output_precision")) {
+            output_precision = model->get_rt_info<std::string>("model_info", "output_precision");
+        }
+    } else {
+        output_precision = output_precision_iter->second.as<std::string>();
+    }
 }
 
 MaskRCNNModel::MaskRCNNModel(std::shared_ptr<InferenceAdapter>& adapter)
@@ -181,7 +192,7 @@ MaskRCNNModel::MaskRCNNModel(std::shared_ptr<InferenceAdapter>& adapter)
 
 std::unique_ptr<MaskRCNNModel> MaskRCNNModel::create_model(const std::string& modelFile, const ov::AnyMap& configuration, bool preload, const std::string& device) {
     auto core = ov::Core();
-    std::shared_ptr<ov::Model> model = core.read_model(modelFile);
+    std::shared_ptr<ov::Model> model = readModel(core, modelFile, configuration);
 
     // Check model_type in the rt_info, ignore configuration
     std::string model_type = MaskRCNNModel::ModelType;
@@ -227,6 +238,7 @@ void MaskRCNNModel::updateModelInfo() {
     model->set_rt_info(MaskRCNNModel::ModelType, "model_info", "model_type");
     model->set_rt_info(confidence_threshold, "model_info", "confidence_threshold");
     model->set_rt_info(postprocess_semantic_masks, "model_info", "postprocess_semantic_masks");
+    model->set_rt_info(output_precision, "model_info", "output_precision");
 }
 
 void MaskRCNNModel::prepareInputsOutputs(std::shared_ptr<ov::Model>& model) {
@@ -257,6 +269,18 @@ void MaskRCNNModel::prepareInputsOutputs(std::shared_ptr<ov::Model>& model) {
                                         {},
                                         scale_values);
 
+        if ("f32" != output_precision) {
+            // Only masks are large enough to make their precision matter
+            ov::preprocess::PrePostProcessor ppp(model);
+            for (const ov::Output<ov::Node>& output : model->outputs()) {
+                const std::unordered_set<std::string>& out_names = output.get_names();
+                if (output.get_partial_shape().size() == 4 && out_names.find(saliency_map_name) == out_names.end()) {
+                    setOutputPrecision(ppp, output.get_any_name(), output_precision);
+                }
+            }
+            model = ppp.build();
+        }
+
         netInputWidth = inputShape[ov::layout::width_idx(inputLayout)];
         netInputHeight = inputShape[ov::layout::height_idx(inputLayout)];
         useAutoResize = true; // temporal solution
@@ -301,6 +325,10 @@ void MaskRCNNModel::prepareInputsOutputs(std::shared_ptr<ov::Model>& model) {
 }
 
 std::unique_ptr<ResultBase> MaskRCNNModel::postprocess(InferenceResult& infResult) {
+    return postprocess(infResult, postprocess_semantic_masks);
+}
+
+std::unique_ptr<ResultBase> MaskRCNNModel::postprocess(InferenceResult& infResult, bool semanticMasks) {
     const auto& internalData = infResult.internalModelData->asRef<InternalImageModelData>();
     float floatInputImgWidth = float(internalData.inputImgWidth),
          floatInputImgHeight = float(internalData.inputImgHeight);
@@ -318,9 +346,18 @@ std::unique_ptr<ResultBase> MaskRCNNModel::postprocess(InferenceResult& infResul
     const int64_t* const labels = lbm.labels.data<int64_t>();
     const float* const boxes = lbm.boxes.data<float>();
     size_t objectSize = lbm.boxes.get_shape().back();
-    float* const masks = lbm.masks.data<float>();
+    const ov::element::Type& masks_type = lbm.masks.get_element_type();
+    int masks_depth = CV_32F;
+    if (masks_type == ov::element::f16) {
+        masks_depth = CV_16F;
+    } else if (masks_type == ov::element::u8) {
+        masks_depth = CV_8U;
+    }
+    uint8_t* const masks = static_cast<uint8_t*>(lbm.masks.data());
     const cv::Size& masks_size{int(lbm.masks.get_shape()[3]), int(lbm.masks.get_shape()[2])};
+    const size_t mask_byte_size = masks_size.area() * masks_type.size();
     InstanceSegmentationResult* result = new InstanceSegmentationResult(infResult.frameId, infResult.metaData);
+    result->labelSet = getLabelSet();
     auto retVal = std::unique_ptr<ResultBase>(result);
     std::vector<std::vector<cv::Mat>> saliency_maps;
     bool has_feature_vector_name = std::find(outputNames.begin(), outputNames.end(), feature_vector_name) != outputNames.end();
@@ -330,6 +367,8 @@ std::unique_ptr<ResultBase> MaskRCNNModel::postprocess(InferenceResult& infResul
         }
         saliency_maps.resize(this->labels.size());
     }
+    std::vector<size_t> indices;
+    std::vector<SegmentedObject> objects;
     for (size_t i = 0; i < lbm.labels.get_size(); ++i) {
         float confidence = boxes[i * objectSize + 4];
         if (confidence <= confidence_threshold && !has_feature_vector_name) {
@@ -339,7 +378,7 @@ std::unique_ptr<ResultBase> MaskRCNNModel::postprocess(InferenceResult& infResul
 
         obj.confidence = confidence;
         obj.labelID = labels[i] + 1;
-        obj.label = getLabelName(obj.labelID);
+        obj.label = getLabel(obj.labelID);
 
         obj.x = clamp(
             round((boxes[i * objectSize + 0] - padLeft) * invertedScaleX),
@@ -356,19 +395,37 @@ std::unique_ptr<ResultBase> MaskRCNNModel::postprocess(InferenceResult& infResul
         obj.height = clamp(
             round((boxes[i * objectSize + 3] - padTop) * invertedScaleY - obj.y),
             0.f, floatInputImgHeight);
-        cv::Mat raw_cls_mask{masks_size, CV_32F, masks + masks_size.area() * i};
-        cv::Mat resized_mask;
-        if (postprocess_semantic_masks || has_feature_vector_name) {
-            resized_mask = segm_postprocess(obj, raw_cls_mask, internalData.inputImgHeight, internalData.inputImgWidth);
+        indices.push_back(i);
+        objects.push_back(obj);
+    }
+    // The number of instances varies a lot from frame to frame, so masks are split into tasks of the shared pool
+    std::vector<cv::Mat> resized_masks(objects.size());
+    WorkStealingPool::parallelForShared(objects.size(), [&](size_t k) {
+        SegmentedObject& obj = objects[k];
+        cv::Mat raw_cls_mask{masks_size, masks_depth, masks + mask_byte_size * indices[k]};
+        if (CV_16F == masks_depth) {
+            // cv::resize() doesn't support CV_16F
+            raw_cls_mask.convertTo(raw_cls_mask, CV_32F);
+        }
+        if (semanticMasks || has_feature_vector_name) {
+            resized_masks[k] = segm_postprocess(obj, raw_cls_mask, internalData.inputImgHeight, internalData.inputImgWidth);
+        } else {
+            resized_masks[k] = raw_cls_mask;
+        }
+        if (semanticMasks) {
+            obj.mask = resized_masks[k];
+        } else if (CV_8U == masks_depth) {
+            raw_cls_mask.convertTo(obj.mask, CV_32F, 1.0 / 255);
         } else {
-            resized_mask = raw_cls_mask;
+            obj.mask = raw_cls_mask.clone();
         }
-        obj.mask = postprocess_semantic_masks ? resized_mask : raw_cls_mask.clone();
-        if (confidence > confidence_threshold) {
-            result->segmentedObjects.push_back(obj);
+    });
+    for (size_t k = 0; k < objects.size(); ++k) {
+        if (objects[k].confidence > confidence_threshold) {
+            result->segmentedObjects.push_back(objects[k]);
         }
-        if (has_feature_vector_name && confidence > confidence_threshold) {
-            saliency_maps[obj.labelID - 1].push_back(resized_mask);
+        if (has_feature_vector_name && objects[k].confidence > confidence_threshold) {
+            saliency_maps[objects[k].labelID - 1].push_back(resized_masks[k]);
         }
     }
     result->saliency_map = average_and_normalize(saliency_maps);
@@ -382,3 +439,11 @@ std::unique_ptr<InstanceSegmentationResult> MaskRCNNModel::infer(const ImageInpu
     auto result = ModelBase::infer(static_cast<const InputData&>(inputData));
     return std::unique_ptr<InstanceSegmentationResult>(static_cast<InstanceSegmentationResult*>(result.release()));
 }
+
+std::unique_ptr<InstanceSegmentationResult> MaskRCNNModel::infer(const ImageInputData& inputData, bool semanticMasks) {
+    InferenceResult infResult;
+    inferOutputs(inputData, infResult);
+    auto result = postprocess(infResult, semanticMasks);
+    *result = static_cast<ResultBase&>(infResult);
+    return std::unique_ptr<InstanceSegmentationResult>(static_cast<InstanceSegmentationResult*>(result.release()));
+}
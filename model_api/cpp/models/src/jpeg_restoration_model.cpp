@@ -129,7 +129,7 @@ std::shared_ptr<InternalModelData> JPEGRestorationModel::preprocess(const InputD
         slog::warn << "\tChosen model aspect ratio doesn't match image aspect ratio" << slog::endl;
         cv::resize(image, resizedImage, cv::Size(netInputWidth, netInputHeight));
     }
-    input.emplace(inputNames[0], wrapMat2Tensor(resizedImage));
+    input[inputNames[0]] = wrapMat2Tensor(resizedImage);
 
     return std::make_shared<InternalImageModelData>(image.cols, image.rows);
 }
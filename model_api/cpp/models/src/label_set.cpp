@@ -0,0 +1,42 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "models/label_set.h"
+
+#include <string>
+
+LabelSet::LabelSet(const std::vector<std::string>& names) : names(names) {}
+
+Label LabelSet::operator[](size_t labelID) const {
+    if (labelID < names.size()) {
+        return Label{names[labelID]};
+    }
+    std::lock_guard<std::mutex> lock{extraMutex};
+    auto it = unknownIds.find(labelID);
+    if (it == unknownIds.end()) {
+        it = unknownIds.emplace(labelID, std::string("Label #") + std::to_string(labelID)).first;
+    }
+    return Label{it->second};
+}
+
+Label LabelSet::intern(std::string_view name) const {
+    std::lock_guard<std::mutex> lock{extraMutex};
+    auto it = internedNames.find(name);
+    if (it == internedNames.end()) {
+        it = internedNames.emplace(name).first;
+    }
+    return Label{*it};
+}
@@ -19,19 +19,82 @@
 #include "utils/args_helper.hpp"
 #include <adapters/openvino_adapter.h>
 
+#include <algorithm>
+#include <stdexcept>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include <openvino/openvino.hpp>
 
 #include <utils/common.hpp>
 #include <utils/ocv_common.hpp>
 #include <utils/slog.hpp>
+#include <utils/xai_outputs.hpp>
+
+namespace {
+// Configuration keys forwarded to compile_model(). Names are used instead of ov properties because
+// ENABLE_CPU_PINNING, ENABLE_HYPER_THREADING and SCHEDULING_CORE_TYPE appeared in OpenVINO 2023.1
+constexpr const char* compile_property_names[]{
+    "PERFORMANCE_HINT",
+    "PERFORMANCE_HINT_NUM_REQUESTS",
+    "NUM_STREAMS",
+    "INFERENCE_NUM_THREADS",
+    "INFERENCE_PRECISION_HINT",
+    "AFFINITY",
+    "ENABLE_CPU_PINNING",
+    "ENABLE_HYPER_THREADING",
+    "SCHEDULING_CORE_TYPE",
+};
+
+// model_info keeps properties for every device, e.g. ENABLE_CPU_PINNING of a model tuned on CPU. Compiling them for a
+// device which doesn't support them fails, so they are skipped
+ov::AnyMap filterSupportedProperties(ov::Core& core, const std::string& device, const ov::AnyMap& properties) {
+    if (device.empty() || properties.empty()) {
+        return properties;
+    }
+    std::vector<ov::PropertyName> supported;
+    try {
+        supported = core.get_property(device, ov::supported_properties);
+    } catch (const ov::Exception&) {
+        // Composite devices may not report their properties, the plugin validates them
+        return properties;
+    }
+    ov::AnyMap filtered;
+    for (const auto& property : properties) {
+        if (std::find(supported.begin(), supported.end(), property.first) != supported.end()) {
+            filtered.emplace(property);
+        } else {
+            slog::warn << property.first << " isn't supported by " << device << ", it isn't applied" << slog::endl;
+        }
+    }
+    return filtered;
+}
+}
 
 ModelBase::ModelBase(const std::string& modelFile, const std::string& layout)
         : modelFile(modelFile),
           inputsLayouts(parseLayoutString(layout)) {
     auto core = ov::Core();
-    model = core.read_model(modelFile);
+    model = readModel(core, modelFile);
+}
+
+void ModelBase::configureCore(ov::Core& core, const ov::AnyMap& configuration) {
+    // OpenVINO maps weights by default, so only an explicit value is passed to the core. The property name is used
+    // because ENABLE_MMAP appeared in OpenVINO 2023.0
+    if (configuration.find("mmap_weights") != configuration.end()) {
+        core.set_property({{"ENABLE_MMAP", get_from_any_maps("mmap_weights", configuration, ov::AnyMap{}, true)}});
+    }
+    std::string cacheDir = get_from_any_maps("cache_dir", configuration, ov::AnyMap{}, std::string{});
+    if (!cacheDir.empty()) {
+        core.set_property({{"CACHE_DIR", cacheDir}});
+    }
+}
+
+std::shared_ptr<ov::Model> ModelBase::readModel(ov::Core& core, const std::string& modelFile,
+                                                const ov::AnyMap& configuration) {
+    configureCore(core, configuration);
+    return core.read_model(modelFile);
 }
 
 ModelBase::ModelBase(std::shared_ptr<InferenceAdapter>& adapter)
@@ -43,9 +106,14 @@ ModelBase::ModelBase(std::shared_ptr<InferenceAdapter>& adapter)
         layout = layout_iter->second.as<std::string>();
     }
     inputsLayouts = parseLayoutString(layout);
+    removeXaiOutputs = get_from_any_maps("remove_xai_outputs", configuration, ov::AnyMap{}, removeXaiOutputs);
 
     inputNames = adapter->getInputNames();
     outputNames = adapter->getOutputNames();
+    if (removeXaiOutputs) {
+        // Adapters compiling the model prune them with pruneXaiOutputs(), a remote server may still return them
+        outputNames.erase(std::remove_if(outputNames.begin(), outputNames.end(), isXaiOutputName), outputNames.end());
+    }
 }
 
 ModelBase::ModelBase(std::shared_ptr<ov::Model>& model, const ov::AnyMap& configuration)
@@ -61,6 +129,17 @@ ModelBase::ModelBase(std::shared_ptr<ov::Model>& model, const ov::AnyMap& config
         }
     }
     inputsLayouts = parseLayoutString(layout);
+    removeXaiOutputs = get_from_any_maps("remove_xai_outputs", configuration,
+        model->has_rt_info("model_info") ? model->get_rt_info<ov::AnyMap>("model_info") : ov::AnyMap{}, removeXaiOutputs);
+
+    for (const char* name : compile_property_names) {
+        auto property_iter = configuration.find(name);
+        if (property_iter != configuration.end()) {
+            compilationConfig.emplace(name, property_iter->second);
+        } else if (model->has_rt_info("model_info", name)) {
+            compilationConfig.emplace(name, model->get_rt_info<std::string>("model_info", name));
+        }
+    }
 }
 
 void ModelBase::updateModelInfo() {
@@ -72,20 +151,32 @@ void ModelBase::updateModelInfo() {
         auto layouts = formatLayouts(inputsLayouts);
         model->set_rt_info(layouts, "model_info", "layout");
     }
+    model->set_rt_info(removeXaiOutputs, "model_info", "remove_xai_outputs");
+    for (const auto& property : compilationConfig) {
+        model->set_rt_info(property.second.as<std::string>(), "model_info", property.first);
+    }
 }
 
-void ModelBase::load(ov::Core& core, const std::string& device) {
+void ModelBase::load(ov::Core& core, const std::string& device, const ov::AnyMap& compilationConfig) {
+    // The compiled model is new, it hasn't run yet
+    warmedUp = false;
     if (!inferenceAdapter) {
         inferenceAdapter = std::make_shared<OpenVINOInferenceAdapter>();
     }
 
+    for (const auto& property : compilationConfig) {
+        this->compilationConfig[property.first] = property.second;
+    }
     // Update model_info erased by pre/postprocessing
     updateModelInfo();
 
-    inferenceAdapter->loadModel(model, core, device);
+    inferenceAdapter->loadModel(model, core, device, filterSupportedProperties(core, device, this->compilationConfig));
 }
 
 std::shared_ptr<ov::Model> ModelBase::prepare() {
+    if (removeXaiOutputs) {
+        ::removeXaiOutputs(*model);
+    }
     prepareInputsOutputs(model);
     logBasicModelInfo(model);
     ov::set_batch(model, 1);
@@ -111,16 +202,73 @@ ov::Layout ModelBase::getInputLayout(const ov::Output<ov::Node>& input) {
 }
 
 std::unique_ptr<ResultBase> ModelBase::infer(const InputData& inputData) {
-    InferenceInput inputs;
     InferenceResult result;
+    inferOutputs(inputData, result);
+
+    auto retVal = this->postprocess(result);
+    *retVal = static_cast<ResultBase&>(result);
+    return retVal;
+}
+
+void ModelBase::inferAsync(const InputData& inputData, InferCallback callback) {
+    InferenceInput inputs;
+    std::shared_ptr<InternalModelData> internalModelData = this->preprocess(inputData, inputs);
+    inferenceAdapter->inferAsync(inputs, [this, internalModelData, callback](InferenceOutput output, std::exception_ptr error) {
+        std::unique_ptr<ResultBase> retVal;
+        if (!error) {
+            try {
+                InferenceResult result;
+                result.outputsData = std::move(output);
+                result.internalModelData = internalModelData;
+                retVal = this->postprocess(result);
+                *retVal = static_cast<ResultBase&>(result);
+            } catch (...) {
+                retVal.reset();
+                error = std::current_exception();
+            }
+        }
+        callback(std::move(retVal), error);
+    });
+}
+
+void ModelBase::inferOutputs(const InputData& inputData, InferenceResult& result) {
+    InferenceInput inputs;
     auto internalModelData = this->preprocess(inputData, inputs);
 
     result.outputsData = inferenceAdapter->infer(inputs);
     result.internalModelData = std::move(internalModelData);
+}
 
-    auto retVal = this->postprocess(result);
-    *retVal = static_cast<ResultBase&>(result);
-    return retVal;
+void ModelBase::inferInto(const InputData& inputData, ResultBase& result) {
+    // Release the previous frame's data to let preprocess() reuse it
+    steadyResult.internalModelData.reset();
+    steadyResult.internalModelData = this->preprocess(inputData, steadyInputs);
+
+    inferenceAdapter->infer(steadyInputs, steadyResult.outputsData);
+
+    this->postprocessInto(steadyResult, result);
+    static_cast<ResultBase&>(result) = static_cast<ResultBase&>(steadyResult);
+}
+
+void ModelBase::warmup(const std::vector<ov::Shape>& shapes) {
+    if (!inferenceAdapter) {
+        throw std::runtime_error(std::string("Model wasn't loaded"));
+    }
+    if (shapes.empty()) {
+        inferenceAdapter->warmup(createWarmupInput(ov::Shape{}));
+    }
+    for (const ov::Shape& shape : shapes) {
+        inferenceAdapter->warmup(createWarmupInput(shape));
+    }
+    warmedUp = true;
+}
+
+InferenceInput ModelBase::createWarmupInput(const ov::Shape&) {
+    throw std::logic_error(std::string("The model wrapper doesn't support warm-up: ") + typeid(*this).name());
+}
+
+void ModelBase::postprocessInto(InferenceResult&, ResultBase&) {
+    throw std::logic_error(std::string("The model wrapper doesn't support steady-state inference: ") + typeid(*this).name());
 }
 
 std::shared_ptr<ov::Model> ModelBase::getModel() {
@@ -0,0 +1,640 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "models/result_serialization.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <opencv2/core.hpp>
+#include <openvino/openvino.hpp>
+
+#include "models/label_set.h"
+#include "models/results.h"
+
+namespace result_serialization {
+
+static_assert(sizeof(Header) == 32, "Header layout must not change");
+static_assert(sizeof(SectionEntry) == 24, "SectionEntry layout must not change");
+static_assert(sizeof(ObjectRecord) == 40, "ObjectRecord layout must not change");
+static_assert(sizeof(ClassificationRecord) == 16, "ClassificationRecord layout must not change");
+static_assert(sizeof(TensorHeader) == 72, "TensorHeader layout must not change");
+static_assert(sizeof(MatHeader) == 24, "MatHeader layout must not change");
+static_assert(sizeof(RleRun) == 8, "RleRun layout must not change");
+
+namespace {
+constexpr size_t ALIGNMENT = 8;
+
+size_t aligned(size_t offset) {
+    return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+// Whether elements of the given dimensions fit into available bytes. The dimensions come from the buffer, a product
+// of them may wrap around to a small size, so each multiplication is checked before it's done
+bool fits(const std::vector<uint64_t>& dims, size_t elementSize, size_t available) {
+    if (std::find(dims.begin(), dims.end(), 0) != dims.end()) {
+        return true;
+    }
+    uint64_t bytes = elementSize;
+    for (uint64_t dim : dims) {
+        if (bytes > available / dim) {
+            return false;
+        }
+        bytes *= dim;
+    }
+    return bytes <= available;
+}
+
+// cv::Mat drops the bits beyond the depth and the channel count, which would change the element size
+bool isMatType(int32_t type) {
+    return type >= 0 && type <= CV_MAT_TYPE_MASK && CV_MAT_DEPTH(type) <= CV_16F;
+}
+
+ElementType toElementType(const ov::element::Type& type) {
+    switch (static_cast<ov::element::Type_t>(type)) {
+        case ov::element::Type_t::f32: return ElementType::f32;
+        case ov::element::Type_t::f16: return ElementType::f16;
+        case ov::element::Type_t::bf16: return ElementType::bf16;
+        case ov::element::Type_t::f64: return ElementType::f64;
+        case ov::element::Type_t::i8: return ElementType::i8;
+        case ov::element::Type_t::u8: return ElementType::u8;
+        case ov::element::Type_t::i16: return ElementType::i16;
+        case ov::element::Type_t::u16: return ElementType::u16;
+        case ov::element::Type_t::i32: return ElementType::i32;
+        case ov::element::Type_t::u32: return ElementType::u32;
+        case ov::element::Type_t::i64: return ElementType::i64;
+        case ov::element::Type_t::u64: return ElementType::u64;
+        case ov::element::Type_t::boolean: return ElementType::boolean;
+        default: throw std::invalid_argument("Unsupported tensor element type for serialization: " + type.get_type_name());
+    }
+}
+
+ov::element::Type fromElementType(uint32_t type) {
+    switch (static_cast<ElementType>(type)) {
+        case ElementType::f32: return ov::element::f32;
+        case ElementType::f16: return ov::element::f16;
+        case ElementType::bf16: return ov::element::bf16;
+        case ElementType::f64: return ov::element::f64;
+        case ElementType::i8: return ov::element::i8;
+        case ElementType::u8: return ov::element::u8;
+        case ElementType::i16: return ov::element::i16;
+        case ElementType::u16: return ov::element::u16;
+        case ElementType::i32: return ov::element::i32;
+        case ElementType::u32: return ov::element::u32;
+        case ElementType::i64: return ov::element::i64;
+        case ElementType::u64: return ov::element::u64;
+        case ElementType::boolean: return ov::element::boolean;
+    }
+    throw std::runtime_error("Unknown tensor element type in serialized result: " + std::to_string(type));
+}
+
+class Writer {
+public:
+    explicit Writer(std::vector<uint8_t>& buffer) : buffer(buffer) {
+        buffer.clear();
+        buffer.resize(sizeof(Header));
+    }
+
+    template <typename T>
+    void addArray(SectionId id, const T* items, size_t count, uint32_t index = 0) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable records can be written");
+        if (0 == count) {
+            return;
+        }
+        size_t offset = begin(id, index);
+        append(items, count * sizeof(T));
+        end(offset);
+    }
+
+    void addTensor(SectionId id, const ov::Tensor& tensor) {
+        if (!tensor) {
+            return;
+        }
+        const ov::Shape& shape = tensor.get_shape();
+        TensorHeader tensorHeader{};
+        tensorHeader.elementType = static_cast<uint32_t>(toElementType(tensor.get_element_type()));
+        if (shape.size() > sizeof(tensorHeader.shape) / sizeof(tensorHeader.shape[0])) {
+            throw std::invalid_argument("Tensors of rank above 8 can't be serialized");
+        }
+        tensorHeader.rank = static_cast<uint32_t>(shape.size());
+        for (size_t i = 0; i < shape.size(); ++i) {
+            tensorHeader.shape[i] = shape[i];
+        }
+        size_t offset = begin(id, 0);
+        append(&tensorHeader, sizeof(tensorHeader));
+        append(tensor.data(), tensor.get_byte_size());
+        end(offset);
+    }
+
+    // CV_8UC1 matrices are masks or class maps with long runs of the same value, they are encoded with RLE
+    void addMat(SectionId id, const cv::Mat& mat, uint32_t index = 0) {
+        if (mat.empty()) {
+            return;
+        }
+        if (mat.dims > 2) {
+            throw std::invalid_argument("Only 2D matrices can be serialized");
+        }
+        const cv::Mat continuous = mat.isContinuous() ? mat : mat.clone();
+        MatHeader matHeader{continuous.rows, continuous.cols, continuous.type(), static_cast<uint32_t>(MatEncoding::Raw), 0};
+        size_t offset = begin(id, index);
+        if (CV_8UC1 == continuous.type()) {
+            matHeader.encoding = static_cast<uint32_t>(MatEncoding::Rle);
+            size_t headerOffset = buffer.size();
+            append(&matHeader, sizeof(matHeader));
+            const uint8_t* pixels = continuous.ptr<uint8_t>();
+            const size_t total = continuous.total();
+            uint64_t runCount = 0;
+            for (size_t i = 0; i < total;) {
+                RleRun run{0, pixels[i]};
+                while (i < total && pixels[i] == run.value && run.length < UINT32_MAX) {
+                    ++run.length;
+                    ++i;
+                }
+                append(&run, sizeof(run));
+                ++runCount;
+            }
+            reinterpret_cast<MatHeader*>(buffer.data() + headerOffset)->runCount = runCount;
+        } else {
+            append(&matHeader, sizeof(matHeader));
+            append(continuous.data, continuous.total() * continuous.elemSize());
+        }
+        end(offset);
+    }
+
+    StringRef addString(std::string_view str) {
+        auto it = stringRefs.find(str);
+        if (it != stringRefs.end()) {
+            return it->second;
+        }
+        StringRef ref{static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(str.size())};
+        strings.append(str.data(), str.size());
+        stringRefs.emplace(str, ref);
+        return ref;
+    }
+
+    void finish(ResultType type, int64_t frameId) {
+        addArray(SectionId::Strings, strings.data(), strings.size());
+        buffer.resize(aligned(buffer.size()));
+        Header header{MAGIC, VERSION, static_cast<uint16_t>(type), frameId, buffer.size(),
+                      static_cast<uint32_t>(directory.size()), 0};
+        append(directory.data(), directory.size() * sizeof(SectionEntry));
+        std::memcpy(buffer.data(), &header, sizeof(header));
+    }
+
+private:
+    std::vector<uint8_t>& buffer;
+    std::vector<SectionEntry> directory;
+    std::string strings;
+    // Views point to the serialized result which outlives the writer
+    std::map<std::string_view, StringRef> stringRefs;
+
+    size_t begin(SectionId id, uint32_t index) {
+        buffer.resize(aligned(buffer.size()));
+        directory.push_back({static_cast<uint32_t>(id), index, buffer.size(), 0});
+        return buffer.size();
+    }
+
+    void end(size_t offset) {
+        directory.back().size = buffer.size() - offset;
+    }
+
+    void append(const void* src, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(src);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+    }
+};
+
+template <typename Object>
+std::vector<ObjectRecord> objectRecords(const std::vector<Object>& objects, Writer& writer) {
+    std::vector<ObjectRecord> records;
+    records.reserve(objects.size());
+    for (const DetectedObject& obj : objects) {
+        records.push_back({obj.x, obj.y, obj.width, obj.height, obj.confidence, 0, obj.labelID, writer.addString(obj.label)});
+    }
+    return records;
+}
+
+void writeDetection(const DetectionResult& result, Writer& writer) {
+    std::vector<ObjectRecord> records = objectRecords(result.objects, writer);
+    writer.addArray(SectionId::Objects, records.data(), records.size());
+    writer.addTensor(SectionId::SaliencyMap, result.saliency_map);
+    writer.addTensor(SectionId::FeatureVector, result.feature_vector);
+}
+
+void writeClassification(const ClassificationResult& result, Writer& writer) {
+    std::vector<ClassificationRecord> records;
+    records.reserve(result.topLabels.size());
+    for (const ClassificationResult::Classification& classification : result.topLabels) {
+        records.push_back({classification.id, classification.score, writer.addString(classification.label)});
+    }
+    writer.addArray(SectionId::TopLabels, records.data(), records.size());
+    writer.addTensor(SectionId::SaliencyMap, result.saliency_map);
+    writer.addTensor(SectionId::FeatureVector, result.feature_vector);
+    writer.addTensor(SectionId::RawScores, result.raw_scores);
+}
+
+void writeInstanceSegmentation(const InstanceSegmentationResult& result, Writer& writer) {
+    std::vector<ObjectRecord> records = objectRecords(result.segmentedObjects, writer);
+    writer.addArray(SectionId::Objects, records.data(), records.size());
+    for (size_t i = 0; i < result.segmentedObjects.size(); ++i) {
+        writer.addMat(SectionId::ObjectMask, result.segmentedObjects[i].mask, static_cast<uint32_t>(i));
+    }
+    for (size_t i = 0; i < result.saliency_map.size(); ++i) {
+        writer.addMat(SectionId::SaliencyMap, result.saliency_map[i], static_cast<uint32_t>(i));
+    }
+    writer.addTensor(SectionId::FeatureVector, result.feature_vector);
+}
+
+void writeAnomaly(const AnomalyResult& result, Writer& writer) {
+    writer.addMat(SectionId::AnomalyMap, result.anomaly_map);
+    writer.addMat(SectionId::PredMask, result.pred_mask);
+    std::vector<RectRecord> boxes;
+    boxes.reserve(result.pred_boxes.size());
+    for (const cv::Rect& box : result.pred_boxes) {
+        boxes.push_back({box.x, box.y, box.width, box.height});
+    }
+    writer.addArray(SectionId::PredBoxes, boxes.data(), boxes.size());
+    writer.addArray(SectionId::PredLabel, result.pred_label.data(), result.pred_label.size());
+    writer.addArray(SectionId::PredScore, &result.pred_score, 1);
+}
+
+void writeHumanPose(const HumanPoseResult& result, Writer& writer) {
+    std::vector<PoseRecord> poses;
+    std::vector<Point2fRecord> keypoints;
+    poses.reserve(result.poses.size());
+    for (const HumanPose& pose : result.poses) {
+        poses.push_back({pose.score, static_cast<uint32_t>(pose.keypoints.size())});
+        for (const cv::Point2f& keypoint : pose.keypoints) {
+            keypoints.push_back({keypoint.x, keypoint.y});
+        }
+    }
+    writer.addArray(SectionId::Poses, poses.data(), poses.size());
+    writer.addArray(SectionId::Keypoints, keypoints.data(), keypoints.size());
+}
+
+template <typename Object>
+void readObjects(const SerializedResultView& view, std::vector<Object>& objects, LabelSet& labelSet) {
+    ArrayView<ObjectRecord> records = view.objects();
+    objects.resize(records.size);
+    for (size_t i = 0; i < records.size; ++i) {
+        const ObjectRecord& record = records[i];
+        DetectedObject& obj = objects[i];
+        obj.x = record.x;
+        obj.y = record.y;
+        obj.width = record.width;
+        obj.height = record.height;
+        obj.confidence = record.confidence;
+        obj.labelID = static_cast<size_t>(record.labelID);
+        obj.label = labelSet.intern(view.label(record.label));
+    }
+}
+
+ov::Tensor copyTensor(const SerializedResultView& view, SectionId id) {
+    ov::Tensor mapped = view.tensor(id);
+    if (!mapped) {
+        return {};
+    }
+    ov::Tensor tensor{mapped.get_element_type(), mapped.get_shape()};
+    std::memcpy(tensor.data(), mapped.data(), mapped.get_byte_size());
+    return tensor;
+}
+
+cv::Mat copyMat(const SerializedResultView& view, SectionId id, uint32_t index = 0) {
+    cv::Mat mat = view.mat(id, index);
+    // RLE masks are already decoded into own memory
+    return view.rleRuns(id, index).empty() ? mat.clone() : mat;
+}
+}  // namespace
+
+void serialize(const ResultBase& result, std::vector<uint8_t>& buffer) {
+    Writer writer{buffer};
+    ResultType type;
+    if (auto retinaFace = dynamic_cast<const RetinaFaceDetectionResult*>(&result)) {
+        type = ResultType::RetinaFaceDetection;
+        writeDetection(*retinaFace, writer);
+        std::vector<Point2fRecord> landmarks;
+        landmarks.reserve(retinaFace->landmarks.size());
+        for (const cv::Point2f& landmark : retinaFace->landmarks) {
+            landmarks.push_back({landmark.x, landmark.y});
+        }
+        writer.addArray(SectionId::Landmarks, landmarks.data(), landmarks.size());
+    } else if (auto detection = dynamic_cast<const DetectionResult*>(&result)) {
+        type = ResultType::Detection;
+        writeDetection(*detection, writer);
+    } else if (auto classification = dynamic_cast<const ClassificationResult*>(&result)) {
+        type = ResultType::Classification;
+        writeClassification(*classification, writer);
+    } else if (auto softPrediction = dynamic_cast<const ImageResultWithSoftPrediction*>(&result)) {
+        type = ResultType::ImageWithSoftPrediction;
+        writer.addMat(SectionId::ResultImage, softPrediction->resultImage);
+        writer.addMat(SectionId::SoftPrediction, softPrediction->soft_prediction);
+        writer.addMat(SectionId::SaliencyMap, softPrediction->saliency_map);
+        writer.addTensor(SectionId::FeatureVector, softPrediction->feature_vector);
+    } else if (auto image = dynamic_cast<const ImageResult*>(&result)) {
+        type = ResultType::Image;
+        writer.addMat(SectionId::ResultImage, image->resultImage);
+    } else if (auto instanceSegmentation = dynamic_cast<const InstanceSegmentationResult*>(&result)) {
+        type = ResultType::InstanceSegmentation;
+        writeInstanceSegmentation(*instanceSegmentation, writer);
+    } else if (auto anomaly = dynamic_cast<const AnomalyResult*>(&result)) {
+        type = ResultType::Anomaly;
+        writeAnomaly(*anomaly, writer);
+    } else if (auto humanPose = dynamic_cast<const HumanPoseResult*>(&result)) {
+        type = ResultType::HumanPose;
+        writeHumanPose(*humanPose, writer);
+    } else {
+        throw std::invalid_argument("Serialization isn't supported for this result type");
+    }
+    writer.finish(type, result.frameId);
+}
+
+std::vector<uint8_t> serialize(const ResultBase& result) {
+    std::vector<uint8_t> buffer;
+    serialize(result, buffer);
+    return buffer;
+}
+
+SerializedResultView::SerializedResultView(const void* data, size_t size)
+    : data(static_cast<const uint8_t*>(data)), size(size), header(static_cast<const Header*>(data)) {
+    if (reinterpret_cast<uintptr_t>(data) % ALIGNMENT != 0) {
+        throw std::invalid_argument("Serialized result must be 8-byte aligned");
+    }
+    if (size < sizeof(Header) || header->magic != MAGIC) {
+        throw std::runtime_error("Buffer doesn't contain a serialized result or its byte order differs");
+    }
+    if (header->version > VERSION) {
+        throw std::runtime_error("Unsupported serialized result version: " + std::to_string(header->version));
+    }
+    if (header->directoryOffset % ALIGNMENT != 0 || header->directoryOffset > size
+            || header->sectionCount > (size - header->directoryOffset) / sizeof(SectionEntry)) {
+        throw std::runtime_error("Serialized result directory is out of the buffer");
+    }
+    for (const SectionEntry& entry : sections()) {
+        if (entry.offset % ALIGNMENT != 0 || entry.offset > size || entry.size > size - entry.offset) {
+            throw std::runtime_error("Serialized result section is out of the buffer");
+        }
+    }
+}
+
+ArrayView<SectionEntry> SerializedResultView::sections() const {
+    return {reinterpret_cast<const SectionEntry*>(data + header->directoryOffset), header->sectionCount};
+}
+
+const SectionEntry* SerializedResultView::find(SectionId id, uint32_t index) const {
+    for (const SectionEntry& entry : sections()) {
+        if (entry.id == static_cast<uint32_t>(id) && entry.index == index) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+bool SerializedResultView::has(SectionId id, uint32_t index) const {
+    return find(id, index) != nullptr;
+}
+
+template <typename T>
+ArrayView<T> SerializedResultView::array(SectionId id, uint32_t index) const {
+    const SectionEntry* entry = find(id, index);
+    if (!entry) {
+        return {};
+    }
+    return {reinterpret_cast<const T*>(data + entry->offset), static_cast<size_t>(entry->size / sizeof(T))};
+}
+
+ArrayView<ObjectRecord> SerializedResultView::objects() const {
+    return array<ObjectRecord>(SectionId::Objects);
+}
+
+ArrayView<ClassificationRecord> SerializedResultView::topLabels() const {
+    return array<ClassificationRecord>(SectionId::TopLabels);
+}
+
+ArrayView<Point2fRecord> SerializedResultView::landmarks() const {
+    return array<Point2fRecord>(SectionId::Landmarks);
+}
+
+ArrayView<RectRecord> SerializedResultView::predBoxes() const {
+    return array<RectRecord>(SectionId::PredBoxes);
+}
+
+ArrayView<PoseRecord> SerializedResultView::poses() const {
+    return array<PoseRecord>(SectionId::Poses);
+}
+
+ArrayView<Point2fRecord> SerializedResultView::keypoints() const {
+    return array<Point2fRecord>(SectionId::Keypoints);
+}
+
+std::string_view SerializedResultView::label(StringRef ref) const {
+    ArrayView<char> strings = array<char>(SectionId::Strings);
+    if (ref.offset > strings.size || ref.size > strings.size - ref.offset) {
+        throw std::runtime_error("Serialized result label is out of the strings section");
+    }
+    return {strings.data + ref.offset, ref.size};
+}
+
+std::string_view SerializedResultView::predLabel() const {
+    ArrayView<char> chars = array<char>(SectionId::PredLabel);
+    return {chars.data, chars.size};
+}
+
+double SerializedResultView::predScore() const {
+    ArrayView<double> score = array<double>(SectionId::PredScore);
+    return score.empty() ? 0.0 : score[0];
+}
+
+ov::Tensor SerializedResultView::tensor(SectionId id) const {
+    const SectionEntry* entry = find(id, 0);
+    if (!entry) {
+        return {};
+    }
+    if (entry->size < sizeof(TensorHeader)) {
+        throw std::runtime_error("Serialized tensor is truncated");
+    }
+    const TensorHeader* tensorHeader = reinterpret_cast<const TensorHeader*>(data + entry->offset);
+    if (tensorHeader->rank > sizeof(tensorHeader->shape) / sizeof(tensorHeader->shape[0])) {
+        throw std::runtime_error("Serialized tensor has invalid rank");
+    }
+    std::vector<uint64_t> dims(tensorHeader->shape, tensorHeader->shape + tensorHeader->rank);
+    ov::element::Type type = fromElementType(tensorHeader->elementType);
+    if (!fits(dims, type.size(), entry->size - sizeof(TensorHeader))) {
+        throw std::runtime_error("Serialized tensor is truncated");
+    }
+    // ov::Tensor has no read only constructor, the view is documented as read only
+    return ov::Tensor(type, ov::Shape(dims.begin(), dims.end()), const_cast<uint8_t*>(data + entry->offset + sizeof(TensorHeader)));
+}
+
+ArrayView<RleRun> SerializedResultView::rleRuns(SectionId id, uint32_t index) const {
+    const SectionEntry* entry = find(id, index);
+    if (!entry || entry->size < sizeof(MatHeader)) {
+        return {};
+    }
+    const MatHeader* matHeader = reinterpret_cast<const MatHeader*>(data + entry->offset);
+    if (matHeader->encoding != static_cast<uint32_t>(MatEncoding::Rle)
+            || matHeader->runCount > (entry->size - sizeof(MatHeader)) / sizeof(RleRun)) {
+        return {};
+    }
+    return {reinterpret_cast<const RleRun*>(data + entry->offset + sizeof(MatHeader)), static_cast<size_t>(matHeader->runCount)};
+}
+
+cv::Mat SerializedResultView::mat(SectionId id, uint32_t index) const {
+    const SectionEntry* entry = find(id, index);
+    if (!entry) {
+        return {};
+    }
+    if (entry->size < sizeof(MatHeader)) {
+        throw std::runtime_error("Serialized matrix is truncated");
+    }
+    const MatHeader* matHeader = reinterpret_cast<const MatHeader*>(data + entry->offset);
+    if (matHeader->rows < 0 || matHeader->cols < 0) {
+        throw std::runtime_error("Serialized matrix has invalid size");
+    }
+    if (!isMatType(matHeader->type)) {
+        throw std::runtime_error("Serialized matrix has invalid type");
+    }
+    const size_t total = static_cast<size_t>(matHeader->rows) * static_cast<size_t>(matHeader->cols);
+    const uint8_t* payload = data + entry->offset + sizeof(MatHeader);
+    if (matHeader->encoding == static_cast<uint32_t>(MatEncoding::Raw)) {
+        std::vector<uint64_t> dims{static_cast<uint64_t>(matHeader->rows), static_cast<uint64_t>(matHeader->cols)};
+        if (!fits(dims, CV_ELEM_SIZE(matHeader->type), entry->size - sizeof(MatHeader))) {
+            throw std::runtime_error("Serialized matrix is truncated");
+        }
+        return cv::Mat(matHeader->rows, matHeader->cols, matHeader->type, const_cast<uint8_t*>(payload));
+    }
+    ArrayView<RleRun> runs = rleRuns(id, index);
+    if (matHeader->type != CV_8UC1 || runs.size != matHeader->runCount) {
+        throw std::runtime_error("Serialized mask is corrupted");
+    }
+    cv::Mat mask(matHeader->rows, matHeader->cols, CV_8UC1);
+    uint8_t* pixels = mask.ptr<uint8_t>();
+    size_t filled = 0;
+    for (const RleRun& run : runs) {
+        if (run.length > total - filled) {
+            throw std::runtime_error("Serialized mask is corrupted");
+        }
+        std::memset(pixels + filled, static_cast<int>(run.value), run.length);
+        filled += run.length;
+    }
+    if (filled != total) {
+        throw std::runtime_error("Serialized mask is corrupted");
+    }
+    return mask;
+}
+
+std::unique_ptr<ResultBase> SerializedResultView::toResult() const {
+    switch (type()) {
+        case ResultType::Detection:
+        case ResultType::RetinaFaceDetection: {
+            std::unique_ptr<DetectionResult> result;
+            if (type() == ResultType::RetinaFaceDetection) {
+                auto retinaFace = std::make_unique<RetinaFaceDetectionResult>(frameId());
+                for (const Point2fRecord& landmark : landmarks()) {
+                    retinaFace->landmarks.emplace_back(landmark.x, landmark.y);
+                }
+                result = std::move(retinaFace);
+            } else {
+                result = std::make_unique<DetectionResult>(frameId());
+            }
+            auto labelSet = std::make_shared<LabelSet>();
+            readObjects(*this, result->objects, *labelSet);
+            result->labelSet = std::move(labelSet);
+            result->saliency_map = copyTensor(*this, SectionId::SaliencyMap);
+            result->feature_vector = copyTensor(*this, SectionId::FeatureVector);
+            return result;
+        }
+        case ResultType::Classification: {
+            auto result = std::make_unique<ClassificationResult>(frameId());
+            auto labelSet = std::make_shared<LabelSet>();
+            for (const ClassificationRecord& record : topLabels()) {
+                result->topLabels.emplace_back(record.id, labelSet->intern(label(record.label)), record.score);
+            }
+            result->labelSet = std::move(labelSet);
+            result->saliency_map = copyTensor(*this, SectionId::SaliencyMap);
+            result->feature_vector = copyTensor(*this, SectionId::FeatureVector);
+            result->raw_scores = copyTensor(*this, SectionId::RawScores);
+            return result;
+        }
+        case ResultType::Image: {
+            auto result = std::make_unique<ImageResult>(frameId());
+            result->resultImage = copyMat(*this, SectionId::ResultImage);
+            return result;
+        }
+        case ResultType::ImageWithSoftPrediction: {
+            auto result = std::make_unique<ImageResultWithSoftPrediction>(frameId());
+            result->resultImage = copyMat(*this, SectionId::ResultImage);
+            result->soft_prediction = copyMat(*this, SectionId::SoftPrediction);
+            result->saliency_map = copyMat(*this, SectionId::SaliencyMap);
+            result->feature_vector = copyTensor(*this, SectionId::FeatureVector);
+            return result;
+        }
+        case ResultType::InstanceSegmentation: {
+            auto result = std::make_unique<InstanceSegmentationResult>(frameId());
+            auto labelSet = std::make_shared<LabelSet>();
+            readObjects(*this, result->segmentedObjects, *labelSet);
+            result->labelSet = std::move(labelSet);
+            for (size_t i = 0; i < result->segmentedObjects.size(); ++i) {
+                result->segmentedObjects[i].mask = copyMat(*this, SectionId::ObjectMask, static_cast<uint32_t>(i));
+            }
+            for (uint32_t i = 0; has(SectionId::SaliencyMap, i); ++i) {
+                result->saliency_map.push_back(copyMat(*this, SectionId::SaliencyMap, i));
+            }
+            result->feature_vector = copyTensor(*this, SectionId::FeatureVector);
+            return result;
+        }
+        case ResultType::Anomaly: {
+            auto result = std::make_unique<AnomalyResult>(frameId());
+            result->anomaly_map = copyMat(*this, SectionId::AnomalyMap);
+            result->pred_mask = copyMat(*this, SectionId::PredMask);
+            for (const RectRecord& box : predBoxes()) {
+                result->pred_boxes.emplace_back(box.x, box.y, box.width, box.height);
+            }
+            result->pred_label = std::string{predLabel()};
+            result->pred_score = predScore();
+            return result;
+        }
+        case ResultType::HumanPose: {
+            auto result = std::make_unique<HumanPoseResult>(frameId());
+            ArrayView<Point2fRecord> points = keypoints();
+            size_t next = 0;
+            for (const PoseRecord& record : poses()) {
+                if (record.keypointCount > points.size - next) {
+                    throw std::runtime_error("Serialized pose keypoints are out of the keypoints section");
+                }
+                HumanPose pose;
+                pose.score = record.score;
+                for (size_t i = 0; i < record.keypointCount; ++i, ++next) {
+                    pose.keypoints.emplace_back(points[next].x, points[next].y);
+                }
+                result->poses.push_back(std::move(pose));
+            }
+            return result;
+        }
+    }
+    throw std::runtime_error("Unknown serialized result type: " + std::to_string(header->resultType));
+}
+
+}  // namespace result_serialization
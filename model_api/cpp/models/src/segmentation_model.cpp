@@ -32,10 +32,31 @@
 #include "models/internal_model_data.h"
 #include "models/results.h"
 #include "utils/slog.hpp"
+#include "utils/work_stealing_pool.hpp"
 
 namespace {
 constexpr char feature_vector_name[]{"feature_vector"};
 
+template <typename T>
+void fill_hard_prediction(const cv::Mat& soft_prediction, float min_prob, cv::Mat& hard_prediction) {
+    for (int i = 0; i < soft_prediction.rows; ++i) {
+        for (int j = 0; j < soft_prediction.cols; ++j) {
+            const T* probs = soft_prediction.ptr<T>(i, j);
+            float max_prob = min_prob;
+            uint8_t max_id = 0;
+            for (int c = 0; c < soft_prediction.channels(); ++c) {
+                float prob = probs[c];
+                if (prob > max_prob) {
+                    max_prob = prob;
+                    max_id = c;
+                }
+            }
+            hard_prediction.at<uint8_t>(i, j) = max_id;
+        }
+    }
+}
+
+// soft_prediction is CV_32F or CV_8U holding probabilities scaled to [0, 255]
 cv::Mat create_hard_prediction_from_soft_prediction(const cv::Mat& soft_prediction, float soft_threshold, int blur_strength) {
     if (soft_prediction.channels() == 1) {
         return soft_prediction;
@@ -44,28 +65,17 @@ cv::Mat create_hard_prediction_from_soft_prediction(const cv::Mat& soft_predicti
     cv::Mat soft_prediction_blurred = soft_prediction.clone();
 
     bool applyBlurAndSoftThreshold = (blur_strength > -1 && soft_threshold < std::numeric_limits<float>::infinity());
+    float min_prob = -std::numeric_limits<float>::infinity();
     if (applyBlurAndSoftThreshold) {
         cv::blur(soft_prediction_blurred, soft_prediction_blurred, cv::Size{blur_strength, blur_strength});
+        min_prob = CV_8U == soft_prediction.depth() ? soft_threshold * 255.0f : soft_threshold;
     }
 
     cv::Mat hard_prediction{cv::Size{soft_prediction_blurred.cols, soft_prediction_blurred.rows}, CV_8UC1};
-    for (int i = 0; i < soft_prediction_blurred.rows; ++i) {
-        for (int j = 0; j < soft_prediction_blurred.cols; ++j) {
-            float max_prob = -std::numeric_limits<float>::infinity();
-            if (applyBlurAndSoftThreshold) {
-                max_prob = soft_threshold;
-            }
-
-            uint8_t max_id = 0;
-            for (int c = 0; c < soft_prediction_blurred.channels(); ++c) {
-                float prob = ((float*)soft_prediction_blurred.ptr(i, j))[c];
-                if (prob > max_prob) {
-                    max_prob = prob;
-                    max_id = c;
-                }
-            }
-            hard_prediction.at<uint8_t>(i, j) = max_id;
-        }
+    if (CV_8U == soft_prediction_blurred.depth()) {
+        fill_hard_prediction<uint8_t>(soft_prediction_blurred, min_prob, hard_prediction);
+    } else {
+        fill_hard_prediction<float>(soft_prediction_blurred, min_prob, hard_prediction);
     }
     return hard_prediction;
 }
@@ -110,6 +120,14 @@ SegmentationModel::SegmentationModel(std::shared_ptr<ov::Model>& model, const ov
         std::string val = return_soft_prediction_iter->second.as<std::string>();
         return_soft_prediction = val == "True" || val == "YES";
     }
+    auto output_precision_iter = configuration.find("output_precision");
+    if (output_precision_iter == configuration.end()) {
+        if (model->has_rt_info("model_info", "output_precision")) {
+            output_precision = model->get_rt_info<std::string>("model_info", "output_precision");
+        }
+    } else {
+        output_precision = output_precision_iter->second.as<std::string>();
+    }
 }
 
 SegmentationModel::SegmentationModel(std::shared_ptr<InferenceAdapter>& adapter) : ImageModel(adapter) {
@@ -131,7 +149,7 @@ SegmentationModel::SegmentationModel(std::shared_ptr<InferenceAdapter>& adapter)
 
 std::unique_ptr<SegmentationModel> SegmentationModel::create_model(const std::string& modelFile, const ov::AnyMap& configuration, bool preload, const std::string& device) {
     auto core = ov::Core();
-    std::shared_ptr<ov::Model> model = core.read_model(modelFile);
+    std::shared_ptr<ov::Model> model = readModel(core, modelFile, configuration);
 
     // Check model_type in the rt_info, ignore configuration
     std::string model_type = SegmentationModel::ModelType;
@@ -178,6 +196,7 @@ void SegmentationModel::updateModelInfo() {
     model->set_rt_info(blur_strength, "model_info", "blur_strength");
     model->set_rt_info(soft_threshold, "model_info", "soft_threshold");
     model->set_rt_info(return_soft_prediction, "model_info", "return_soft_prediction");
+    model->set_rt_info(output_precision, "model_info", "output_precision");
 }
 
 void SegmentationModel::prepareInputsOutputs(std::shared_ptr<ov::Model>& model) {
@@ -229,11 +248,12 @@ void SegmentationModel::prepareInputsOutputs(std::shared_ptr<ov::Model>& model)
         ov::preprocess::PrePostProcessor ppp = ov::preprocess::PrePostProcessor(model);
         ov::Layout out_layout = getLayoutFromShape(model->output(out_name).get_partial_shape());
         ppp.output(out_name).model().set_layout(out_layout);
-        ppp.output(out_name).tensor().set_element_type(ov::element::f32);
         if (ov::layout::has_channels(out_layout)) {
+            setOutputPrecision(ppp, out_name, output_precision);
             ppp.output(out_name).tensor().set_layout("NCHW");
         } else {
             // deeplabv3
+            ppp.output(out_name).tensor().set_element_type(ov::element::f32);
             ppp.output(out_name).tensor().set_layout("NHW");
         }
         model = ppp.build();
@@ -272,13 +292,29 @@ std::unique_ptr<ResultBase> SegmentationModel::postprocess(InferenceResult& infR
             reinterpret_cast<int32_t*>(predictions.data)[i] = int32_t(data[i]);
         }
         predictions.convertTo(soft_prediction, CV_8UC1);
-    } else if (outTensor.get_element_type() == ov::element::f32) {
-        float* data = outTensor.data<float>();
+    } else {
+        const ov::element::Type& type = outTensor.get_element_type();
+        int depth;
+        if (type == ov::element::f32) {
+            depth = CV_32F;
+        } else if (type == ov::element::f16) {
+            depth = CV_16F;
+        } else if (type == ov::element::u8) {
+            depth = CV_8U;
+        } else {
+            throw std::runtime_error("Unsupported segmentation output type: " + type.get_type_name());
+        }
+        uint8_t* data = static_cast<uint8_t*>(outTensor.data());
+        size_t planeSize = outHeight * outWidth * type.size();
         std::vector<cv::Mat> channels;
         for (size_t c = 0; c < outTensor.get_shape()[1]; ++c) {
-            channels.emplace_back(cv::Size{outWidth, outHeight}, CV_32FC1, data + c * outHeight * outWidth);
+            channels.emplace_back(cv::Size{outWidth, outHeight}, CV_MAKETYPE(depth, 1), data + c * planeSize);
         }
         cv::merge(channels, soft_prediction);
+        // OpenCV filters don't support CV_16F, u8 probabilities are processed as is
+        if (CV_16F == depth) {
+            soft_prediction.convertTo(soft_prediction, CV_32F);
+        }
     }
 
     cv::Mat hard_prediction = create_hard_prediction_from_soft_prediction(soft_prediction, soft_threshold, blur_strength);
@@ -289,6 +325,10 @@ std::unique_ptr<ResultBase> SegmentationModel::postprocess(InferenceResult& infR
         ImageResultWithSoftPrediction* result = new ImageResultWithSoftPrediction(infResult.frameId, infResult.metaData);
         result->resultImage = hard_prediction;
         cv::resize(soft_prediction, soft_prediction, {inputImgSize.inputImgWidth, inputImgSize.inputImgHeight}, 0.0, 0.0, cv::INTER_NEAREST);
+        // The result holds probabilities for any output_precision
+        if (outTensor.get_element_type() == ov::element::u8) {
+            soft_prediction.convertTo(soft_prediction, CV_32F, 1.0 / 255);
+        }
         result->soft_prediction = soft_prediction;
         auto iter = infResult.outputsData.find(feature_vector_name);
         if (infResult.outputsData.end() != iter) {
@@ -308,26 +348,32 @@ std::vector<Contour> SegmentationModel::getContours(const ImageResultWithSoftPre
         throw std::runtime_error{"Cannot get contours from soft prediction with 1 layer"};
     }
 
-    std::vector<Contour> combined_contours = {};
-    cv::Mat label_index_map;
-    cv::Mat current_label_soft_prediction;
-    for (int index = 1; index < imageResult.soft_prediction.channels(); index++) {
+    // Labels are looked up from the tasks, the set is created here
+    getLabelSet();
+    std::vector<std::vector<Contour>> label_contours(imageResult.soft_prediction.channels() - 1);
+    WorkStealingPool::parallelForShared(label_contours.size(), [&](size_t task) {
+        int index = int(task) + 1;
+        cv::Mat label_index_map;
+        cv::Mat current_label_soft_prediction;
         cv::extractChannel(imageResult.soft_prediction, current_label_soft_prediction, index);
         cv::inRange(imageResult.resultImage, cv::Scalar(index, index, index), cv::Scalar(index, index, index), label_index_map);
         std::vector<std::vector<cv::Point>> contours;
         cv::findContours(label_index_map, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_NONE);
 
-        std::string label = getLabelName(index - 1);
+        Label label = getLabel(index - 1);
 
         for (unsigned int i = 0; i < contours.size(); i++) {
             cv::Mat mask = cv::Mat::zeros(imageResult.resultImage.rows, imageResult.resultImage.cols, imageResult.resultImage.type());
             cv::drawContours(mask, contours, i, 255, -1);
             float probability = (float)cv::mean(current_label_soft_prediction, mask)[0];
-            combined_contours.push_back({label, probability, contours[i]});
+            label_contours[task].push_back({label, probability, contours[i]});
         }
+    });
 
+    std::vector<Contour> combined_contours = {};
+    for (std::vector<Contour>& contours : label_contours) {
+        std::move(contours.begin(), contours.end(), std::back_inserter(combined_contours));
     }
-
     return combined_contours;
 }
 
@@ -161,7 +161,7 @@ std::shared_ptr<InternalModelData> SuperResolutionModel::preprocess(const InputD
     const size_t height = lrShape[ov::layout::height_idx(layout)];
     const size_t width = lrShape[ov::layout::width_idx(layout)];
     img = resizeImageExt(img, width, height);
-    input.emplace(inputNames[0], wrapMat2Tensor(img));
+    input[inputNames[0]] = wrapMat2Tensor(img);
 
     if (inputNames.size() == 2) {
         auto bicShape = inferenceAdapter->getInputShape(inputNames[1]).get_max_shape();
@@ -169,7 +169,7 @@ std::shared_ptr<InternalModelData> SuperResolutionModel::preprocess(const InputD
         const int w = static_cast<int>(bicShape[ov::layout::width_idx(layout)]);
         cv::Mat resized;
         cv::resize(img, resized, cv::Size(w, h), 0, 0, cv::INTER_CUBIC);
-        input.emplace(inputNames[1], wrapMat2Tensor(resized));
+        input[inputNames[1]] = wrapMat2Tensor(resized);
     }
 
     return std::make_shared<InternalImageModelData>(img.cols, img.rows);
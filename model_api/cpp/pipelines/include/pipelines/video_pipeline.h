@@ -0,0 +1,131 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "adapters/inference_adapter.h"
+#include "pipelines/bounded_queue.h"
+
+class ImageModel;
+struct ResultBase;
+
+/// Runs an ImageModel wrapper over several video streams. Every stream has a decode thread which reads frames from
+/// its source into a bounded queue of the stream. One preprocess thread takes frames from the stream queues in turn,
+/// inferThreads threads call the adapter of the model and one postprocess thread calls the result callback. The
+/// stages are connected by bounded queues without locks. A stage waits for space in the next queue, so overload is
+/// resolved at the stream queues by the drop policy of each stream. Wrappers split expensive postprocessing into
+/// tasks of WorkStealingPool::global(), so the single postprocess thread doesn't limit throughput
+class VideoPipeline {
+public:
+    using Clock = std::chrono::steady_clock;
+    /// Fills the frame and returns true, false at the end of the stream. Called from the decode thread of the stream
+    using FrameSource = std::function<bool(cv::Mat& frame)>;
+    /// Called from the postprocess thread. frameId of the result is the index of the frame in its stream
+    using ResultCallback = std::function<void(size_t stream, const cv::Mat& frame, std::unique_ptr<ResultBase> result)>;
+
+    enum class DropPolicy {
+        DROP_OLDEST,   // a new frame replaces the oldest queued one, for live streams
+        DROP_NEWEST,   // a new frame is dropped while the queue is full
+        KEEP_EVERY_K,  // every k-th frame is kept and waits for space in the queue, the others are dropped
+    };
+
+    struct Stream {
+        FrameSource source;
+        DropPolicy dropPolicy = DropPolicy::DROP_OLDEST;
+        size_t keepEvery = 1;  // k of KEEP_EVERY_K
+        size_t queueCapacity = 2;
+    };
+
+    struct Config {
+        size_t stageQueueCapacity = 8;
+        /// More than one requires an adapter whose infer() can be called concurrently. Results of a stream may then
+        /// be delivered out of order
+        size_t inferThreads = 1;
+        /// Outputs are postprocessed while the next frames are inferred. Adapters which return tensors of their
+        /// infer request need them copied. OpenVINOInferenceAdapter, ShardedInferenceAdapter,
+        /// BatchingInferenceAdapter and ResidentInferenceAdapter return tensors owned by the caller
+        bool copyOutputs = true;
+    };
+
+    struct StreamStatistics {
+        size_t decoded;
+        size_t dropped;
+        size_t completed;
+        size_t queueDepth;
+        double fps;  // completed frames per second since start()
+        double meanLatencyMs;  // from decoding to the end of the result callback
+        double maxLatencyMs;
+    };
+
+    /// The model must be loaded and outlive the pipeline. It isn't used by other threads while the pipeline runs
+    VideoPipeline(ImageModel& model, std::vector<Stream> streams, ResultCallback callback, Config config = {});
+    ~VideoPipeline();
+
+    VideoPipeline(const VideoPipeline&) = delete;
+    VideoPipeline& operator=(const VideoPipeline&) = delete;
+
+    void start();
+    /// Blocks until every source has ended and its frames are processed. Rethrows the first error of a stage
+    void wait();
+    /// Stops all stages, queued frames are discarded
+    void stop();
+
+    std::vector<StreamStatistics> getStatistics() const;
+
+private:
+    struct Job;
+    struct StreamState;
+
+    ImageModel& model;
+    std::shared_ptr<InferenceAdapter> adapter;
+    ResultCallback callback;
+    const Config config;
+    std::vector<std::unique_ptr<StreamState>> streams;
+    BoundedQueue<std::unique_ptr<Job>> inferQueue;
+    BoundedQueue<std::unique_ptr<Job>> postprocessQueue;
+
+    std::vector<std::thread> threads;
+    std::atomic<bool> stopping{false};
+    std::atomic<size_t> activeDecoders{0};
+    std::atomic<bool> preprocessDone{false};
+    std::atomic<size_t> activeInfers{0};
+    std::atomic<int64_t> finishedAt{0};  // Clock ticks, 0 while running
+    Clock::time_point startedAt;
+
+    std::mutex errorMutex;
+    std::exception_ptr error;
+
+    void decodeLoop(size_t index);
+    void preprocessLoop();
+    void inferLoop();
+    void postprocessLoop();
+    bool pushWait(BoundedQueue<std::unique_ptr<Job>>& queue, std::unique_ptr<Job>& job);
+    void fail();
+    void join();
+};
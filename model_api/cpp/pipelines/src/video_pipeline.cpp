@@ -0,0 +1,296 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "pipelines/video_pipeline.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <openvino/openvino.hpp>
+
+#include <models/image_model.h>
+#include <models/input_data.h>
+#include <models/internal_model_data.h>
+#include <models/results.h>
+
+struct VideoPipeline::Job {
+    size_t stream;
+    int64_t frameId;
+    cv::Mat frame;
+    Clock::time_point decoded;
+    InferenceInput input;
+    std::shared_ptr<InternalModelData> internalModelData;
+    InferenceOutput output;
+};
+
+struct VideoPipeline::StreamState {
+    explicit StreamState(Stream config) : config(std::move(config)), queue(this->config.queueCapacity) {}
+
+    const Stream config;
+    BoundedQueue<std::unique_ptr<Job>> queue;
+    std::atomic<size_t> decoded{0};
+    std::atomic<size_t> dropped{0};
+    std::atomic<size_t> completed{0};
+    std::atomic<uint64_t> totalLatencyUs{0};
+    std::atomic<uint64_t> maxLatencyUs{0};
+};
+
+VideoPipeline::VideoPipeline(ImageModel& model, std::vector<Stream> streams, ResultCallback callback, Config config)
+    : model(model),
+      adapter(model.getInferenceAdapter()),
+      callback(std::move(callback)),
+      config(config),
+      inferQueue(config.stageQueueCapacity),
+      postprocessQueue(config.stageQueueCapacity) {
+    if (!adapter) {
+        throw std::logic_error("VideoPipeline requires a loaded model");
+    }
+    if (streams.empty() || 0 == config.inferThreads) {
+        throw std::invalid_argument("VideoPipeline requires a stream and an infer thread");
+    }
+    for (Stream& stream : streams) {
+        if (!stream.source || 0 == stream.keepEvery) {
+            throw std::invalid_argument("Every stream of VideoPipeline requires a source and positive keepEvery");
+        }
+        this->streams.push_back(std::make_unique<StreamState>(std::move(stream)));
+    }
+}
+
+VideoPipeline::~VideoPipeline() {
+    stop();
+}
+
+void VideoPipeline::start() {
+    if (!threads.empty()) {
+        throw std::logic_error("VideoPipeline is already started");
+    }
+    startedAt = Clock::now();
+    activeDecoders = streams.size();
+    activeInfers = config.inferThreads;
+    for (size_t i = 0; i < streams.size(); ++i) {
+        threads.emplace_back(&VideoPipeline::decodeLoop, this, i);
+    }
+    threads.emplace_back(&VideoPipeline::preprocessLoop, this);
+    for (size_t i = 0; i < config.inferThreads; ++i) {
+        threads.emplace_back(&VideoPipeline::inferLoop, this);
+    }
+    threads.emplace_back(&VideoPipeline::postprocessLoop, this);
+}
+
+void VideoPipeline::wait() {
+    join();
+    std::lock_guard<std::mutex> lock{errorMutex};
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void VideoPipeline::stop() {
+    stopping = true;
+    join();
+}
+
+void VideoPipeline::join() {
+    for (std::thread& thread : threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void VideoPipeline::fail() {
+    {
+        std::lock_guard<std::mutex> lock{errorMutex};
+        if (!error) {
+            error = std::current_exception();
+        }
+    }
+    stopping = true;
+}
+
+// Returns false if the pipeline stops before the queue has space
+bool VideoPipeline::pushWait(BoundedQueue<std::unique_ptr<Job>>& queue, std::unique_ptr<Job>& job) {
+    Backoff backoff;
+    while (!queue.tryPush(job)) {
+        if (stopping) {
+            return false;
+        }
+        backoff();
+    }
+    return true;
+}
+
+void VideoPipeline::decodeLoop(size_t index) {
+    StreamState& stream = *streams[index];
+    try {
+        for (int64_t frameId = 0; !stopping; ++frameId) {
+            auto job = std::make_unique<Job>();
+            if (!stream.config.source(job->frame)) {
+                break;
+            }
+            job->stream = index;
+            job->frameId = frameId;
+            job->decoded = Clock::now();
+            ++stream.decoded;
+            switch (stream.config.dropPolicy) {
+            case DropPolicy::DROP_OLDEST:
+                while (!stream.queue.tryPush(job)) {
+                    std::unique_ptr<Job> oldest;
+                    if (stream.queue.tryPop(oldest)) {
+                        ++stream.dropped;
+                    }
+                }
+                break;
+            case DropPolicy::DROP_NEWEST:
+                if (!stream.queue.tryPush(job)) {
+                    ++stream.dropped;
+                }
+                break;
+            case DropPolicy::KEEP_EVERY_K:
+                if (0 != frameId % stream.config.keepEvery) {
+                    ++stream.dropped;
+                } else {
+                    pushWait(stream.queue, job);
+                }
+                break;
+            }
+        }
+    } catch (...) {
+        fail();
+    }
+    --activeDecoders;
+}
+
+void VideoPipeline::preprocessLoop() {
+    try {
+        size_t next = 0;
+        Backoff backoff;
+        while (!stopping) {
+            // Read before the queues, a decoder finishes after its last push
+            bool decodersDone = 0 == activeDecoders;
+            std::unique_ptr<Job> job;
+            for (size_t i = 0; i < streams.size() && !job; ++i) {
+                size_t index = (next + i) % streams.size();
+                if (streams[index]->queue.tryPop(job)) {
+                    next = index + 1;
+                }
+            }
+            if (!job) {
+                if (decodersDone) {
+                    break;
+                }
+                backoff();
+                continue;
+            }
+            backoff.reset();
+            job->internalModelData = model.preprocess(ImageInputData{job->frame}, job->input);
+            if (!pushWait(inferQueue, job)) {
+                break;
+            }
+        }
+    } catch (...) {
+        fail();
+    }
+    preprocessDone = true;
+}
+
+void VideoPipeline::inferLoop() {
+    try {
+        Backoff backoff;
+        while (!stopping) {
+            bool upstreamDone = preprocessDone;
+            std::unique_ptr<Job> job;
+            if (!inferQueue.tryPop(job)) {
+                if (upstreamDone) {
+                    break;
+                }
+                backoff();
+                continue;
+            }
+            backoff.reset();
+            job->output = adapter->infer(job->input);
+            job->input.clear();
+            if (config.copyOutputs) {
+                for (auto& item : job->output) {
+                    ov::Tensor copy(item.second.get_element_type(), item.second.get_shape());
+                    std::memcpy(copy.data(), item.second.data(), item.second.get_byte_size());
+                    item.second = copy;
+                }
+            }
+            if (!pushWait(postprocessQueue, job)) {
+                break;
+            }
+        }
+    } catch (...) {
+        fail();
+    }
+    --activeInfers;
+}
+
+void VideoPipeline::postprocessLoop() {
+    try {
+        Backoff backoff;
+        while (!stopping) {
+            bool upstreamDone = 0 == activeInfers;
+            std::unique_ptr<Job> job;
+            if (!postprocessQueue.tryPop(job)) {
+                if (upstreamDone) {
+                    break;
+                }
+                backoff();
+                continue;
+            }
+            backoff.reset();
+            InferenceResult inferenceResult;
+            inferenceResult.outputsData = std::move(job->output);
+            inferenceResult.internalModelData = std::move(job->internalModelData);
+            std::unique_ptr<ResultBase> result = model.postprocess(inferenceResult);
+            *result = static_cast<ResultBase&>(inferenceResult);
+            result->frameId = job->frameId;
+            callback(job->stream, job->frame, std::move(result));
+
+            StreamState& stream = *streams[job->stream];
+            uint64_t latencyUs = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - job->decoded).count());
+            stream.totalLatencyUs += latencyUs;
+            uint64_t maxLatencyUs = stream.maxLatencyUs;
+            while (latencyUs > maxLatencyUs && !stream.maxLatencyUs.compare_exchange_weak(maxLatencyUs, latencyUs)) {
+            }
+            ++stream.completed;
+        }
+    } catch (...) {
+        fail();
+    }
+    finishedAt = Clock::now().time_since_epoch().count();
+}
+
+std::vector<VideoPipeline::StreamStatistics> VideoPipeline::getStatistics() const {
+    int64_t finished = finishedAt;
+    Clock::time_point end = finished ? Clock::time_point(Clock::duration(finished)) : Clock::now();
+    double elapsed = threads.empty() ? 0.0 : std::chrono::duration<double>(end - startedAt).count();
+    std::vector<StreamStatistics> statistics;
+    for (const std::unique_ptr<StreamState>& stream : streams) {
+        size_t completed = stream->completed;
+        statistics.push_back({stream->decoded, stream->dropped, completed, stream->queue.size(),
+                              elapsed > 0 ? completed / elapsed : 0.0,
+                              completed ? stream->totalLatencyUs / 1000.0 / completed : 0.0,
+                              stream->maxLatencyUs / 1000.0});
+    }
+    return statistics;
+}
@@ -0,0 +1,25 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+
+#include "py_utils.hpp"
+
+PYBIND11_MODULE(py_model_api, m) {
+    m.doc() = "Python bindings for the C++ wrappers of OpenVINO Model API";
+    init_results(m);
+    init_models(m);
+    init_tilers(m);
+}
@@ -0,0 +1,86 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+
+#include <memory>
+#include <string>
+
+#include <models/anomaly_model.h>
+#include <models/classification_model.h>
+#include <models/detection_model.h>
+#include <models/image_model.h>
+#include <models/input_data.h>
+#include <models/instance_segmentation.h>
+#include <models/model_base.h>
+#include <models/results.h>
+#include <models/segmentation_model.h>
+
+#include "py_utils.hpp"
+
+namespace {
+// ModelBase::infer() may be called concurrently, so Python threads sharing one model infer in parallel without the GIL
+template <class Model>
+auto infer(Model& model, py::array image) {
+    ImageInputData inputData(wrap_image(image));
+    py::gil_scoped_release release;
+    return model.infer(inputData);
+}
+
+template <class Model>
+py::class_<Model, ImageModel, std::shared_ptr<Model>> bind_model(py::module_& m, const char* name) {
+    return py::class_<Model, ImageModel, std::shared_ptr<Model>>(m, name)
+        .def("__call__", &infer<Model>, py::arg("image"))
+        .def("infer", &infer<Model>, py::arg("image"));
+}
+
+template <class Model>
+std::shared_ptr<Model> create_model(const std::string& model_path, const py::dict& configuration, bool preload,
+                                    const std::string& device) {
+    ov::AnyMap config = to_any_map(configuration);
+    py::gil_scoped_release release;
+    return Model::create_model(model_path, config, preload, device);
+}
+}
+
+void init_models(py::module_& m) {
+    py::class_<ModelBase, std::shared_ptr<ModelBase>>(m, "ModelBase");
+    py::class_<ImageModel, ModelBase, std::shared_ptr<ImageModel>>(m, "ImageModel");
+
+    bind_model<ClassificationModel>(m, "ClassificationModel")
+        .def_static("create_model", &create_model<ClassificationModel>, py::arg("model_path"),
+                    py::arg("configuration") = py::dict(), py::arg("preload") = true, py::arg("device") = "AUTO");
+
+    bind_model<DetectionModel>(m, "DetectionModel")
+        .def_static("create_model", [](const std::string& model_path, const py::dict& configuration,
+                                       const std::string& model_type, bool preload, const std::string& device) {
+            ov::AnyMap config = to_any_map(configuration);
+            py::gil_scoped_release release;
+            return std::shared_ptr<DetectionModel>(DetectionModel::create_model(model_path, config, model_type, preload, device));
+        }, py::arg("model_path"), py::arg("configuration") = py::dict(), py::arg("model_type") = "",
+           py::arg("preload") = true, py::arg("device") = "AUTO");
+
+    bind_model<SegmentationModel>(m, "SegmentationModel")
+        .def_static("create_model", &create_model<SegmentationModel>, py::arg("model_path"),
+                    py::arg("configuration") = py::dict(), py::arg("preload") = true, py::arg("device") = "AUTO");
+
+    bind_model<MaskRCNNModel>(m, "MaskRCNNModel")
+        .def_static("create_model", &create_model<MaskRCNNModel>, py::arg("model_path"),
+                    py::arg("configuration") = py::dict(), py::arg("preload") = true, py::arg("device") = "AUTO");
+
+    bind_model<AnomalyModel>(m, "AnomalyModel")
+        .def_static("create_model", &create_model<AnomalyModel>, py::arg("model_path"),
+                    py::arg("configuration") = py::dict(), py::arg("preload") = true, py::arg("device") = "AUTO");
+}
@@ -0,0 +1,156 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+
+#include <stdint.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <models/results.h>
+
+#include "py_utils.hpp"
+
+namespace {
+template <class Printable>
+std::string to_string(const Printable& printable) {
+    std::stringstream ss;
+    ss << printable;
+    return ss.str();
+}
+
+// Elements refer to the result instead of copying its masks
+template <class Object>
+py::list reference_list(const std::vector<Object>& objects, py::handle owner) {
+    py::list list;
+    for (const Object& object : objects) {
+        list.append(py::cast(&object, py::return_value_policy::reference_internal, owner));
+    }
+    return list;
+}
+}
+
+// Field names follow openvino.model_api.models.utils, so code written for the Python wrappers reads the results as is.
+// Arrays are views of the data owned by the result, they keep the result alive
+void init_results(py::module_& m) {
+    py::class_<ResultBase>(m, "ResultBase")
+        .def_readonly("frame_id", &ResultBase::frameId);
+
+    py::class_<ClassificationResult, ResultBase>(m, "ClassificationResult")
+        .def_property_readonly("top_labels", [](const ClassificationResult& result) {
+            py::list labels;
+            for (const ClassificationResult::Classification& classification : result.topLabels) {
+                labels.append(py::make_tuple(classification.id, std::string(classification.label), classification.score));
+            }
+            return labels;
+        })
+        .def_property_readonly("saliency_map", [](py::object self) {
+            return tensor_view(self.cast<ClassificationResult&>().saliency_map, self);
+        })
+        .def_property_readonly("feature_vector", [](py::object self) {
+            return tensor_view(self.cast<ClassificationResult&>().feature_vector, self);
+        })
+        .def_property_readonly("raw_scores", [](py::object self) {
+            return tensor_view(self.cast<ClassificationResult&>().raw_scores, self);
+        })
+        .def("__str__", &to_string<ClassificationResult>);
+
+    py::class_<DetectedObject>(m, "Detection")
+        .def_property_readonly("xmin", [](const DetectedObject& object) { return object.x; })
+        .def_property_readonly("ymin", [](const DetectedObject& object) { return object.y; })
+        .def_property_readonly("xmax", [](const DetectedObject& object) { return object.x + object.width; })
+        .def_property_readonly("ymax", [](const DetectedObject& object) { return object.y + object.height; })
+        .def_readonly("score", &DetectedObject::confidence)
+        .def_readonly("id", &DetectedObject::labelID)
+        .def_property_readonly("str_label", [](const DetectedObject& object) { return std::string(object.label); })
+        .def("__str__", &to_string<DetectedObject>);
+
+    py::class_<DetectionResult, ResultBase>(m, "DetectionResult")
+        .def_property_readonly("objects", [](py::object self) {
+            return reference_list(self.cast<DetectionResult&>().objects, self);
+        })
+        .def_property_readonly("saliency_map", [](py::object self) {
+            return tensor_view(self.cast<DetectionResult&>().saliency_map, self);
+        })
+        .def_property_readonly("feature_vector", [](py::object self) {
+            return tensor_view(self.cast<DetectionResult&>().feature_vector, self);
+        })
+        .def("__str__", &to_string<DetectionResult>);
+
+    py::class_<SegmentedObject, DetectedObject>(m, "SegmentedObject")
+        .def_property_readonly("mask", [](py::object self) {
+            return mat_view(self.cast<SegmentedObject&>().mask, self);
+        })
+        .def("__str__", &to_string<SegmentedObject>);
+
+    py::class_<InstanceSegmentationResult, ResultBase>(m, "InstanceSegmentationResult")
+        .def_property_readonly("segmentedObjects", [](py::object self) {
+            return reference_list(self.cast<InstanceSegmentationResult&>().segmentedObjects, self);
+        })
+        .def_property_readonly("saliency_map", [](py::object self) {
+            py::list maps;
+            for (const cv::Mat& map : self.cast<InstanceSegmentationResult&>().saliency_map) {
+                maps.append(mat_view(map, self));
+            }
+            return maps;
+        })
+        .def_property_readonly("feature_vector", [](py::object self) {
+            return tensor_view(self.cast<InstanceSegmentationResult&>().feature_vector, self);
+        });
+
+    py::class_<ImageResult, ResultBase>(m, "ImageResult")
+        .def_property_readonly("resultImage", [](py::object self) {
+            return mat_view(self.cast<ImageResult&>().resultImage, self);
+        })
+        .def("__str__", &to_string<ImageResult>);
+
+    py::class_<ImageResultWithSoftPrediction, ImageResult>(m, "ImageResultWithSoftPrediction")
+        .def_property_readonly("soft_prediction", [](py::object self) {
+            return mat_view(self.cast<ImageResultWithSoftPrediction&>().soft_prediction, self);
+        })
+        .def_property_readonly("saliency_map", [](py::object self) {
+            return mat_view(self.cast<ImageResultWithSoftPrediction&>().saliency_map, self);
+        })
+        .def_property_readonly("feature_vector", [](py::object self) {
+            return tensor_view(self.cast<ImageResultWithSoftPrediction&>().feature_vector, self);
+        })
+        .def("__str__", &to_string<ImageResultWithSoftPrediction>);
+
+    py::class_<AnomalyResult, ResultBase>(m, "AnomalyResult")
+        .def_property_readonly("anomaly_map", [](py::object self) {
+            return mat_view(self.cast<AnomalyResult&>().anomaly_map, self);
+        })
+        .def_property_readonly("pred_boxes", [](const AnomalyResult& result) {
+            // [[xmin, ymin, xmax, ymax], ...] like the Python wrapper
+            py::array_t<int32_t> boxes(std::vector<py::ssize_t>{static_cast<py::ssize_t>(result.pred_boxes.size()), 4});
+            auto view = boxes.mutable_unchecked<2>();
+            for (py::ssize_t i = 0; i < view.shape(0); ++i) {
+                const cv::Rect& box = result.pred_boxes[static_cast<size_t>(i)];
+                view(i, 0) = box.x;
+                view(i, 1) = box.y;
+                view(i, 2) = box.x + box.width;
+                view(i, 3) = box.y + box.height;
+            }
+            return boxes;
+        })
+        .def_readonly("pred_label", &AnomalyResult::pred_label)
+        .def_property_readonly("pred_mask", [](py::object self) {
+            return mat_view(self.cast<AnomalyResult&>().pred_mask, self);
+        })
+        .def_readonly("pred_score", &AnomalyResult::pred_score)
+        .def("__str__", &to_string<AnomalyResult>);
+}
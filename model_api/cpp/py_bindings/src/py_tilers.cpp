@@ -0,0 +1,52 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+
+#include <memory>
+
+#include <models/input_data.h>
+#include <models/model_base.h>
+#include <models/results.h>
+#include <tilers/detection.h>
+#include <tilers/instance_segmentation.h>
+#include <tilers/tiler_base.h>
+
+#include "py_utils.hpp"
+
+namespace {
+// TilerBase::run() may be called concurrently like ModelBase::infer()
+std::unique_ptr<ResultBase> run(TilerBase& tiler, py::array image) {
+    ImageInputData inputData(wrap_image(image));
+    py::gil_scoped_release release;
+    return tiler.run(inputData);
+}
+}
+
+void init_tilers(py::module_& m) {
+    py::class_<TilerBase>(m, "TilerBase")
+        .def("__call__", &run, py::arg("image"))
+        .def("run", &run, py::arg("image"));
+
+    py::class_<DetectionTiler, TilerBase>(m, "DetectionTiler")
+        .def(py::init([](const std::shared_ptr<ModelBase>& model, const py::dict& configuration) {
+            return std::make_unique<DetectionTiler>(model, to_any_map(configuration));
+        }), py::arg("model"), py::arg("configuration") = py::dict());
+
+    py::class_<InstanceSegmentationTiler, DetectionTiler>(m, "InstanceSegmentationTiler")
+        .def(py::init([](const std::shared_ptr<ModelBase>& model, const py::dict& configuration) {
+            return std::make_unique<InstanceSegmentationTiler>(model, to_any_map(configuration));
+        }), py::arg("model"), py::arg("configuration") = py::dict());
+}
@@ -0,0 +1,124 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+
+#include "py_utils.hpp"
+
+#include <stdint.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+py::dtype mat_dtype(int depth) {
+    switch (depth) {
+        case CV_8U: return py::dtype::of<uint8_t>();
+        case CV_8S: return py::dtype::of<int8_t>();
+        case CV_16U: return py::dtype::of<uint16_t>();
+        case CV_16S: return py::dtype::of<int16_t>();
+        case CV_16F: return py::dtype("float16");
+        case CV_32S: return py::dtype::of<int32_t>();
+        case CV_32F: return py::dtype::of<float>();
+        case CV_64F: return py::dtype::of<double>();
+        default: throw std::runtime_error("Unsupported cv::Mat depth: " + std::to_string(depth));
+    }
+}
+
+py::dtype tensor_dtype(const ov::element::Type& type) {
+    switch (type) {
+        case ov::element::Type_t::boolean: return py::dtype::of<bool>();
+        case ov::element::Type_t::u8: return py::dtype::of<uint8_t>();
+        case ov::element::Type_t::i8: return py::dtype::of<int8_t>();
+        case ov::element::Type_t::u16: return py::dtype::of<uint16_t>();
+        case ov::element::Type_t::i16: return py::dtype::of<int16_t>();
+        case ov::element::Type_t::u32: return py::dtype::of<uint32_t>();
+        case ov::element::Type_t::i32: return py::dtype::of<int32_t>();
+        case ov::element::Type_t::u64: return py::dtype::of<uint64_t>();
+        case ov::element::Type_t::i64: return py::dtype::of<int64_t>();
+        case ov::element::Type_t::f16: return py::dtype("float16");
+        case ov::element::Type_t::f32: return py::dtype::of<float>();
+        case ov::element::Type_t::f64: return py::dtype::of<double>();
+        default: throw std::runtime_error("Unsupported tensor element type: " + type.get_type_name());
+    }
+}
+}
+
+cv::Mat wrap_image(py::array& image) {
+    if (!py::isinstance<py::array_t<uint8_t>>(image)) {
+        throw py::type_error("Expected a uint8 image, got " + std::string(py::str(image.dtype())));
+    }
+    if (image.ndim() != 3 || image.shape(2) != 3) {
+        throw py::value_error("Expected a HxWx3 BGR image");
+    }
+    // Embedded preprocessing wraps the image into a tensor, which needs packed rows too
+    if (image.strides(2) != 1 || image.strides(1) != 3 || image.strides(0) != image.shape(1) * 3) {
+        image = py::array_t<uint8_t, py::array::c_style>::ensure(image);
+        if (!image) {
+            throw py::error_already_set();
+        }
+    }
+    // Wrappers don't write to the input image
+    return cv::Mat(static_cast<int>(image.shape(0)), static_cast<int>(image.shape(1)), CV_8UC3,
+                   const_cast<void*>(image.data()), static_cast<size_t>(image.strides(0)));
+}
+
+py::object mat_view(const cv::Mat& mat, py::handle owner) {
+    if (mat.empty()) {
+        return py::none();
+    }
+    std::vector<py::ssize_t> shape, strides;
+    for (int i = 0; i < mat.dims; ++i) {
+        shape.push_back(mat.size[i]);
+        strides.push_back(static_cast<py::ssize_t>(mat.step[i]));
+    }
+    if (mat.channels() > 1) {
+        shape.push_back(mat.channels());
+        strides.push_back(static_cast<py::ssize_t>(mat.elemSize1()));
+    }
+    return py::array(mat_dtype(mat.depth()), shape, strides, mat.data, owner);
+}
+
+py::object tensor_view(const ov::Tensor& tensor, py::handle owner) {
+    if (!tensor) {
+        return py::none();
+    }
+    const ov::Shape shape = tensor.get_shape();
+    const ov::Strides strides = tensor.get_strides();  // In bytes
+    return py::array(tensor_dtype(tensor.get_element_type()), std::vector<py::ssize_t>(shape.begin(), shape.end()),
+                     std::vector<py::ssize_t>(strides.begin(), strides.end()), tensor.data(), owner);
+}
+
+ov::AnyMap to_any_map(const py::dict& configuration) {
+    ov::AnyMap map;
+    for (const auto& item : configuration) {
+        std::string value;
+        if (py::isinstance<py::list>(item.second) || py::isinstance<py::tuple>(item.second)) {
+            // model_info keeps lists as space separated values
+            for (py::handle element : item.second) {
+                if (!value.empty()) {
+                    value += ' ';
+                }
+                value += std::string(py::str(element));
+            }
+        } else {
+            // str(True) is "True" which get_from_any_maps() expects for bool
+            value = std::string(py::str(item.second));
+        }
+        map.emplace(std::string(py::str(item.first)), value);
+    }
+    return map;
+}
@@ -0,0 +1,39 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+
+#pragma once
+#include <opencv2/core.hpp>
+#include <openvino/openvino.hpp>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+/// Wraps a HxWx3 uint8 BGR array without copying. An array with unpacked pixels or padded rows, e.g. a slice along the
+/// width, is replaced with a packed copy, so image must stay alive while the returned Mat is used
+cv::Mat wrap_image(py::array& image);
+
+/// Returns a NumPy view of the data keeping owner alive, or None if there is no data
+py::object mat_view(const cv::Mat& mat, py::handle owner);
+py::object tensor_view(const ov::Tensor& tensor, py::handle owner);
+
+/// Converts configuration values to strings which create_model() parses like the values of model_info
+ov::AnyMap to_any_map(const py::dict& configuration);
+
+void init_results(py::module_& m);
+void init_models(py::module_& m);
+void init_tilers(py::module_& m);
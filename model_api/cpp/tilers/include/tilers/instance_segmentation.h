@@ -22,10 +22,10 @@ class InstanceSegmentationTiler : public DetectionTiler {
     /*InstanceSegmentationTiler tiler works with MaskRCNNModel model only*/
 public:
     InstanceSegmentationTiler(std::shared_ptr<ModelBase> model, const ov::AnyMap& configuration);
-    virtual std::unique_ptr<ResultBase> run(const ImageInputData& inputData);
     virtual ~InstanceSegmentationTiler() = default;
 
 protected:
+    virtual std::unique_ptr<ResultBase> infer_tile(const cv::Mat&);
     virtual std::unique_ptr<ResultBase> postprocess_tile(std::unique_ptr<ResultBase>, const cv::Rect&);
     virtual std::unique_ptr<ResultBase> merge_results(const std::vector<std::unique_ptr<ResultBase>>&, const cv::Size&, const std::vector<cv::Rect>&);
 
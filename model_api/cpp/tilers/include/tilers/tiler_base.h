@@ -44,6 +44,8 @@ protected:
     std::vector<cv::Rect> filter_tiles(const cv::Mat&, const std::vector<cv::Rect>&);
     std::unique_ptr<ResultBase> predict_sync(const cv::Mat&, const std::vector<cv::Rect>&);
     cv::Mat crop_tile(const cv::Mat&, const cv::Rect&);
+    // Tilers pass per-call options of the model here instead of changing its state, so run() can be called concurrently
+    virtual std::unique_ptr<ResultBase> infer_tile(const cv::Mat&);
     virtual std::unique_ptr<ResultBase> postprocess_tile(std::unique_ptr<ResultBase>, const cv::Rect&) = 0;
     virtual std::unique_ptr<ResultBase> merge_results(const std::vector<std::unique_ptr<ResultBase>>&, const cv::Size&, const std::vector<cv::Rect>&) = 0;
 
@@ -22,6 +22,7 @@
 #include <tilers/detection.h>
 #include <models/results.h>
 #include <utils/nms.hpp>
+#include <utils/work_stealing_pool.hpp>
 
 
 namespace {
@@ -108,6 +109,7 @@ std::unique_ptr<ResultBase> DetectionTiler::merge_results(const std::vector<std:
 
     if (tiles_results.size()) {
         DetectionResult* det_res = static_cast<DetectionResult*>(tiles_results.begin()->get());
+        result->labelSet = det_res->labelSet;
         if (det_res->feature_vector) {
             result->feature_vector = ov::Tensor(det_res->feature_vector.get_element_type(), det_res->feature_vector.get_shape());
         }
@@ -172,8 +174,17 @@ ov::Tensor DetectionTiler::merge_saliency_maps(const std::vector<std::unique_ptr
         class_map = cv::Mat_<float>(cv::Size{int(image_map_w), int(image_map_h)}, 0.f);
     }
 
-    for (size_t i = 1; i < all_saliency_maps.size(); ++i) {
-        for (size_t class_idx = 0; class_idx < num_classes; ++class_idx) {
+    ov::Tensor merged_map;
+    if (shape_shift) {
+        merged_map = ov::Tensor(ov::element::Type("u8"), {1, num_classes, image_map_h, image_map_w});
+    }
+    else {
+        merged_map = ov::Tensor(ov::element::Type("u8"), {num_classes, image_map_h, image_map_w});
+    }
+
+    // Classes are merged independently
+    WorkStealingPool::parallelForShared(num_classes, [&](size_t class_idx) {
+        for (size_t i = 1; i < all_saliency_maps.size(); ++i) {
             auto current_cls_map_mat = wrap_saliency_map_tensor_to_mat(all_saliency_maps[i], shape_shift, class_idx);
             cv::Mat current_cls_map_mat_float;
             current_cls_map_mat.convertTo(current_cls_map_mat_float, CV_32F);
@@ -200,24 +211,14 @@ ov::Tensor DetectionTiler::merge_saliency_maps(const std::vector<std::unique_ptr
                 }
             }
         }
-    }
 
-    ov::Tensor merged_map;
-    if (shape_shift) {
-        merged_map = ov::Tensor(ov::element::Type("u8"), {1, num_classes, image_map_h, image_map_w});
-    }
-    else {
-        merged_map = ov::Tensor(ov::element::Type("u8"), {num_classes, image_map_h, image_map_w});
-    }
-
-    for (size_t class_idx = 0; class_idx < num_classes; ++class_idx) {
         auto image_map_cls = wrap_saliency_map_tensor_to_mat(image_saliency_map, shape_shift, class_idx);
         cv::resize(image_map_cls, image_map_cls, cv::Size(image_map_w, image_map_h));
         cv::addWeighted(merged_map_mat[class_idx], 1.0, image_map_cls, 0.5, 0., merged_map_mat[class_idx]);
         merged_map_mat[class_idx] = non_linear_normalization(merged_map_mat[class_idx]);
         auto merged_cls_map_mat = wrap_saliency_map_tensor_to_mat(merged_map, shape_shift, class_idx);
         merged_map_mat[class_idx].convertTo(merged_cls_map_mat, merged_cls_map_mat.type());
-    }
+    });
 
     return merged_map;
 }
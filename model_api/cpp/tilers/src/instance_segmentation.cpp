@@ -20,34 +20,19 @@
 #include <opencv2/core.hpp>
 
 #include <tilers/instance_segmentation.h>
+#include <models/input_data.h>
 #include <models/instance_segmentation.h>
 #include <models/results.h>
 #include <utils/nms.hpp>
+#include <utils/work_stealing_pool.hpp>
 #include "utils/common.hpp"
 
-namespace {
-class MaskRCNNModelParamsSetter {
-    public:
-        std::shared_ptr<ModelBase> model;
-        bool state;
-        MaskRCNNModel* model_ptr;
-    MaskRCNNModelParamsSetter(std::shared_ptr<ModelBase> model_) : model(model_) {
-        model_ptr = static_cast<MaskRCNNModel*>(model.get());
-        state = model_ptr->postprocess_semantic_masks;
-        model_ptr->postprocess_semantic_masks = false;
-    }
-    ~MaskRCNNModelParamsSetter() {
-        model_ptr->postprocess_semantic_masks = state;
-    }
-};
-}
-
 InstanceSegmentationTiler::InstanceSegmentationTiler(std::shared_ptr<ModelBase> _model, const ov::AnyMap& configuration) :
     DetectionTiler(std::move(_model), configuration) {}
 
-std::unique_ptr<ResultBase> InstanceSegmentationTiler::run(const ImageInputData& inputData) {
-    auto setter = MaskRCNNModelParamsSetter(model);
-    return TilerBase::run(inputData);
+std::unique_ptr<ResultBase> InstanceSegmentationTiler::infer_tile(const cv::Mat& tile_img) {
+    // Tile masks are pasted into the full image mask after merging, the model keeps them at the box size
+    return static_cast<MaskRCNNModel*>(model.get())->infer(ImageInputData(tile_img), false);
 }
 
 std::unique_ptr<ResultBase> InstanceSegmentationTiler::postprocess_tile(std::unique_ptr<ResultBase> tile_result, const cv::Rect& coord) {
@@ -86,15 +71,19 @@ std::unique_ptr<ResultBase> InstanceSegmentationTiler::merge_results(const std::
 
     auto keep_idx = multiclass_nms(all_detections, all_scores, 0.45f, false, 200);
 
+    // Full image masks are the most expensive part of merging, every object is a task of the shared pool
+    WorkStealingPool::parallelForShared(keep_idx.size(), [&](size_t i) {
+        SegmentedObject& obj = all_detections_ptrs[keep_idx[i]];
+        obj.mask = segm_postprocess(obj, obj.mask, image_size.height, image_size.width);
+    });
     result->segmentedObjects.reserve(keep_idx.size());
     for (auto idx : keep_idx) {
-        all_detections_ptrs[idx].get().mask = segm_postprocess(all_detections_ptrs[idx], all_detections_ptrs[idx].get().mask,
-                                    image_size.height, image_size.width);
         result->segmentedObjects.push_back(all_detections_ptrs[idx]);
     }
 
     if (tiles_results.size()) {
         auto* iseg_res = static_cast<InstanceSegmentationResult*>(tiles_results.begin()->get());
+        result->labelSet = iseg_res->labelSet;
         if (iseg_res->feature_vector) {
             result->feature_vector = ov::Tensor(iseg_res->feature_vector.get_element_type(), iseg_res->feature_vector.get_shape());
         }
@@ -149,8 +138,9 @@ std::vector<cv::Mat_<std::uint8_t>> InstanceSegmentationTiler::merge_saliency_ma
         map = cv::Mat_<std::uint8_t>(image_size, 0);
     }
 
-    for (size_t i = 1; i < all_saliecy_maps.size(); ++i) {
-        for (size_t class_idx = 0; class_idx < num_classes; ++class_idx) {
+    // Classes are merged independently
+    WorkStealingPool::parallelForShared(num_classes, [&](size_t class_idx) {
+        for (size_t i = 1; i < all_saliecy_maps.size(); ++i) {
             auto current_cls_map_mat = all_saliecy_maps[i][class_idx];
             if (current_cls_map_mat.empty()) {
                 continue;
@@ -161,9 +151,7 @@ std::vector<cv::Mat_<std::uint8_t>> InstanceSegmentationTiler::merge_saliency_ma
             auto tile_map_merged = cv::Mat(merged_map[class_idx], tile);
             cv::Mat(cv::max(tile_map, tile_map_merged)).copyTo(tile_map_merged);
         }
-    }
 
-    for (size_t class_idx = 0; class_idx < num_classes; ++class_idx) {
         auto image_map_cls = image_saliency_map[class_idx];
         if (image_map_cls.empty()) {
             if (cv::sum(merged_map[class_idx]) == cv::Scalar(0.)) {
@@ -174,7 +162,7 @@ std::vector<cv::Mat_<std::uint8_t>> InstanceSegmentationTiler::merge_saliency_ma
             cv::resize(image_map_cls, image_map_cls, image_size);
             cv::Mat(cv::max(merged_map[class_idx], image_map_cls)).copyTo(merged_map[class_idx]);
         }
-    }
+    });
 
     return merged_map;
 }
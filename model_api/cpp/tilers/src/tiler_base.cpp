@@ -88,7 +88,7 @@ std::unique_ptr<ResultBase> TilerBase::predict_sync(const cv::Mat& image, const
 
     for (const auto& coord : tile_coords) {
         auto tile_img = crop_tile(image, coord);
-        auto tile_prediction = model->infer(ImageInputData(tile_img.clone()));
+        auto tile_prediction = infer_tile(tile_img.clone());
         auto tile_result = postprocess_tile(std::move(tile_prediction), coord);
         tile_results.push_back(std::move(tile_result));
     }
@@ -100,6 +100,10 @@ cv::Mat TilerBase::crop_tile(const cv::Mat& image, const cv::Rect& coord) {
     return cv::Mat(image, coord);
 }
 
+std::unique_ptr<ResultBase> TilerBase::infer_tile(const cv::Mat& tile_img) {
+    return model->infer(ImageInputData(tile_img));
+}
+
 std::unique_ptr<ResultBase> TilerBase::run(const ImageInputData& inputData) {
     auto& image = inputData.inputImage;
     auto tile_coords = tile(image.size());
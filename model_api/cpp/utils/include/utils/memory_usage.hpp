@@ -0,0 +1,32 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+#include <stddef.h>
+
+/// Resident set size of the process in bytes, 0 where it isn't available. Only Linux is supported
+size_t residentMemoryBytes();
+
+/// Peak resident set size of the process in bytes since start or the last resetPeakResidentMemory(), 0 where it
+/// isn't available
+size_t peakResidentMemoryBytes();
+
+/// Proportional set size of the process in bytes: pages shared with other processes, e.g. memory-mapped weights,
+/// are divided by the number of processes mapping them. 0 where it isn't available
+size_t proportionalMemoryBytes();
+
+/// Restarts tracking of peakResidentMemoryBytes() from the current resident set size, false if it isn't supported
+bool resetPeakResidentMemory();
@@ -52,23 +52,33 @@ struct AnchorLabeled : public Anchor {
         Anchor(_left, _top, _right, _bottom), labelID(_labelID) {}
 };
 
+// Scratch buffers of nms() and multiclass_nms(). Keeping an instance between calls avoids reallocations
+struct NmsWorkspace {
+    std::vector<float> areas;
+    std::vector<int> order;
+    std::vector<Anchor> shifted;
+};
+
 template <typename Anchor>
-std::vector<size_t> nms(const std::vector<Anchor>& boxes, const std::vector<float>& scores, const float thresh, bool includeBoundaries=false, size_t keep_top_k=0) {
+void nms(const std::vector<Anchor>& boxes, const std::vector<float>& scores, const float thresh, std::vector<size_t>& keep,
+         NmsWorkspace& workspace, bool includeBoundaries=false, size_t keep_top_k=0) {
+    keep.clear();
     if (keep_top_k == 0) {
         keep_top_k = boxes.size();
     }
-    std::vector<float> areas(boxes.size());
+    std::vector<float>& areas = workspace.areas;
+    areas.resize(boxes.size());
     for (size_t i = 0; i < boxes.size(); ++i) {
         areas[i] = (boxes[i].right - boxes[i].left + includeBoundaries) * (boxes[i].bottom - boxes[i].top + includeBoundaries);
     }
-    std::vector<int> order(scores.size());
+    std::vector<int>& order = workspace.order;
+    order.resize(scores.size());
     std::iota(order.begin(), order.end(), 0);
     std::sort(order.begin(), order.end(), [&scores](int o1, int o2) { return scores[o1] > scores[o2]; });
 
     size_t ordersNum = 0;
     for (; ordersNum < order.size() && scores[order[ordersNum]] >= 0  && ordersNum < keep_top_k; ordersNum++);
 
-    std::vector<size_t> keep;
     bool shouldContinue = true;
     for (size_t i = 0; shouldContinue && i < ordersNum; ++i) {
         int idx1 = order[i];
@@ -90,8 +100,17 @@ std::vector<size_t> nms(const std::vector<Anchor>& boxes, const std::vector<floa
             }
         }
     }
+}
+
+template <typename Anchor>
+std::vector<size_t> nms(const std::vector<Anchor>& boxes, const std::vector<float>& scores, const float thresh, bool includeBoundaries=false, size_t keep_top_k=0) {
+    std::vector<size_t> keep;
+    NmsWorkspace workspace;
+    nms(boxes, scores, thresh, keep, workspace, includeBoundaries, keep_top_k);
     return keep;
 }
 
 std::vector<size_t> multiclass_nms(const std::vector<AnchorLabeled>& boxes, const std::vector<float>& scores,
                      const float iou_threshold=0.45f, bool includeBoundaries=false, size_t maxNum=200);
+void multiclass_nms(const std::vector<AnchorLabeled>& boxes, const std::vector<float>& scores, const float iou_threshold,
+                    std::vector<size_t>& keep, NmsWorkspace& workspace, bool includeBoundaries=false, size_t maxNum=200);
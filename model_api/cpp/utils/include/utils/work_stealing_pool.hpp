@@ -0,0 +1,90 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+#include <stddef.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Fixed set of worker threads, each with its own deque of tasks. A worker runs its newest task first and, when its
+/// deque is empty, steals the oldest task of another worker, so uneven tasks don't leave threads idle while others
+/// have a backlog. Tasks submitted from outside the pool are spread over the workers in turn
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingPool(size_t threads = std::thread::hardware_concurrency());
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    std::future<void> submit(Task task);
+
+    /// Splits [begin, end) into chunks of at most grain indices, runs body(chunkBegin, chunkEnd) for them on the
+    /// workers and the calling thread and returns when all are done. The chunks aren't bound to a thread, the
+    /// caller takes the ones no worker has started, so it can be called from a task. Rethrows the first exception
+    void parallelForRange(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body, size_t grain = 1);
+    /// Runs body(i) for every i in [0, count)
+    void parallelFor(size_t count, const std::function<void(size_t)>& body, size_t grain = 1);
+
+    size_t getThreadCount() const {
+        return workers.size();
+    }
+    /// Index of the calling worker of this pool from 1, 0 for other threads
+    size_t getThreadIndex() const;
+
+    /// The pool of postprocessing and merging in models and tilers, one worker per hardware thread. It's shared
+    /// with OpenCV when it's created, an application setting its own OpenCV backend should do it after this call
+    static WorkStealingPool& global();
+    /// Runs body(i) for every i in [0, count) on global() if it's shared with OpenCV. Otherwise OpenCV calls of body
+    /// run on OpenCV's threads, so the indices are processed on the calling thread not to oversubscribe the cores
+    static void parallelForShared(size_t count, const std::function<void(size_t)>& body, size_t grain = 1);
+
+    /// Makes cv::parallel_for_ run on this pool, so OpenCV and model_api don't create threads for the same cores.
+    /// The pool must outlive OpenCV calls. Returns false if OpenCV is older than 4.5.2 and has no backend API
+    bool shareWithOpenCV();
+    bool isSharedWithOpenCV() const {
+        return sharedWithOpenCV;
+    }
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<size_t> nextWorker{0};
+    std::atomic<size_t> pending{0};
+    std::atomic<bool> sharedWithOpenCV{false};
+    bool stopping = false;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+
+    void push(Task task);
+    bool tryRun(size_t index);
+    void run(size_t index);
+};
@@ -0,0 +1,31 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+#include <memory>
+#include <string>
+
+#include <openvino/openvino.hpp>
+
+/// True for saliency_map and feature_vector, the explainability outputs dropped by remove_xai_outputs
+bool isXaiOutputName(const std::string& name);
+
+/// Removes the explainability results of the model. The plugin drops subgraphs which no longer lead to a result
+void removeXaiOutputs(ov::Model& model);
+
+/// A copy of the model without explainability results if remove_xai_outputs is set in the model_info section of its
+/// rt_info, the model itself otherwise. Every adapter passes the model through it before compile_model()
+std::shared_ptr<const ov::Model> pruneXaiOutputs(const std::shared_ptr<const ov::Model>& model);
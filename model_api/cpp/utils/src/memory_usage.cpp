@@ -0,0 +1,62 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "utils/memory_usage.hpp"
+
+#include <fstream>
+#include <string>
+
+namespace {
+// Reads a "<field>: <value> kB" line of a /proc/self file
+size_t readProcKb(const char* file, const std::string& field) {
+#ifdef __linux__
+    std::ifstream status{file};
+    std::string line;
+    while (std::getline(status, line)) {
+        if (0 == line.compare(0, field.size(), field) && line.size() > field.size() && ':' == line[field.size()]) {
+            return std::stoull(line.substr(field.size() + 1)) * 1024;
+        }
+    }
+#else
+    (void)file;
+    (void)field;
+#endif
+    return 0;
+}
+}  // namespace
+
+size_t residentMemoryBytes() {
+    return readProcKb("/proc/self/status", "VmRSS");
+}
+
+size_t peakResidentMemoryBytes() {
+    return readProcKb("/proc/self/status", "VmHWM");
+}
+
+size_t proportionalMemoryBytes() {
+    return readProcKb("/proc/self/smaps_rollup", "Pss");
+}
+
+bool resetPeakResidentMemory() {
+#ifdef __linux__
+    std::ofstream clearRefs{"/proc/self/clear_refs"};
+    clearRefs << "5";
+    clearRefs.flush();
+    return bool(clearRefs);
+#else
+    return false;
+#endif
+}
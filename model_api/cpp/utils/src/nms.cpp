@@ -21,7 +21,17 @@
 
 std::vector<size_t> multiclass_nms(const std::vector<AnchorLabeled>& boxes, const std::vector<float>& scores,
                      const float iou_threshold, bool includeBoundaries, size_t maxNum) {
-    std::vector<Anchor> boxes_copy;
+    std::vector<size_t> keep;
+    NmsWorkspace workspace;
+    multiclass_nms(boxes, scores, iou_threshold, keep, workspace, includeBoundaries, maxNum);
+    return keep;
+}
+
+void multiclass_nms(const std::vector<AnchorLabeled>& boxes, const std::vector<float>& scores, const float iou_threshold,
+                    std::vector<size_t>& keep, NmsWorkspace& workspace, bool includeBoundaries, size_t maxNum) {
+    // Shift boxes of different classes apart to suppress only boxes of the same class
+    std::vector<Anchor>& boxes_copy = workspace.shifted;
+    boxes_copy.clear();
     boxes_copy.reserve(boxes.size());
 
     float max_coord = 0.f;
@@ -33,5 +43,5 @@ std::vector<size_t> multiclass_nms(const std::vector<AnchorLabeled>& boxes, cons
         boxes_copy.emplace_back(box.left + offset, box.top + offset, box.right + offset, box.bottom + offset);
     }
 
-    return nms<Anchor>(boxes_copy, scores, iou_threshold, includeBoundaries, maxNum);
+    nms<Anchor>(boxes_copy, scores, iou_threshold, keep, workspace, includeBoundaries, maxNum);
 }
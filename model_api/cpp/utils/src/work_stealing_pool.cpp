@@ -0,0 +1,240 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "utils/work_stealing_pool.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+#if __has_include(<opencv2/core/parallel/parallel_backend.hpp>)
+#include <opencv2/core/parallel/parallel_backend.hpp>
+#define MODEL_API_OPENCV_PARALLEL_BACKEND
+#endif
+
+namespace {
+thread_local const WorkStealingPool* currentPool = nullptr;
+thread_local size_t currentIndex = 0;
+
+#ifdef MODEL_API_OPENCV_PARALLEL_BACKEND
+class PoolParallelForBackend : public cv::parallel::ParallelForAPI {
+public:
+    explicit PoolParallelForBackend(WorkStealingPool& pool) : pool(pool) {}
+
+    void parallel_for(int tasks, FN_parallel_for_body_cb_t body, void* data) override {
+        // OpenCV splits ranges into many small stripes, a chunk per four of them per thread is enough to balance
+        size_t grain = std::max<size_t>(1, size_t(tasks) / (4 * std::max<size_t>(1, pool.getThreadCount())));
+        pool.parallelForRange(0, size_t(tasks), [body, data](size_t begin, size_t end) {
+            body(int(begin), int(end), data);
+        }, grain);
+    }
+
+    int getThreadNum() const override {
+        return int(pool.getThreadIndex());
+    }
+
+    int getNumThreads() const override {
+        return int(pool.getThreadCount()) + 1;
+    }
+
+    // The pool has a fixed size
+    int setNumThreads(int) override {
+        return getNumThreads();
+    }
+
+    const char* getName() const override {
+        return "model_api";
+    }
+
+private:
+    WorkStealingPool& pool;
+};
+#endif
+}  // namespace
+
+WorkStealingPool::WorkStealingPool(size_t threads) {
+    for (size_t i = 0; i < std::max<size_t>(threads, 1); ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i]->thread = std::thread(&WorkStealingPool::run, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock{sleepMutex};
+        stopping = true;
+    }
+    wake.notify_all();
+    for (const std::unique_ptr<Worker>& worker : workers) {
+        worker->thread.join();
+    }
+}
+
+WorkStealingPool& WorkStealingPool::global() {
+    // Without it tasks of the pool calling OpenCV would start OpenCV's own threads for the same cores
+    static WorkStealingPool& pool = [] () -> WorkStealingPool& {
+        static WorkStealingPool instance;
+        instance.shareWithOpenCV();
+        return instance;
+    }();
+    return pool;
+}
+
+void WorkStealingPool::parallelForShared(size_t count, const std::function<void(size_t)>& body, size_t grain) {
+    WorkStealingPool& pool = global();
+    if (pool.isSharedWithOpenCV()) {
+        pool.parallelFor(count, body, grain);
+        return;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        body(i);
+    }
+}
+
+size_t WorkStealingPool::getThreadIndex() const {
+    return this == currentPool ? currentIndex + 1 : 0;
+}
+
+std::future<void> WorkStealingPool::submit(Task task) {
+    auto packaged = std::make_shared<std::packaged_task<void()>>(std::move(task));
+    std::future<void> future = packaged->get_future();
+    push([packaged] { (*packaged)(); });
+    return future;
+}
+
+// A worker pushes to its own deque, where its newest task is taken first while the data is still in its cache
+void WorkStealingPool::push(Task task) {
+    size_t index = this == currentPool ? currentIndex : nextWorker++ % workers.size();
+    {
+        std::lock_guard<std::mutex> lock{workers[index]->mutex};
+        workers[index]->tasks.push_back(std::move(task));
+    }
+    ++pending;
+    {
+        // Orders the increment with a worker checking pending before it sleeps
+        std::lock_guard<std::mutex> lock{sleepMutex};
+    }
+    wake.notify_one();
+}
+
+// Runs the newest task of the worker or the oldest task of another one
+bool WorkStealingPool::tryRun(size_t index) {
+    Task task;
+    for (size_t i = 0; i < workers.size() && !task; ++i) {
+        Worker& victim = *workers[(index + i) % workers.size()];
+        std::lock_guard<std::mutex> lock{victim.mutex};
+        if (!victim.tasks.empty()) {
+            if (0 == i) {
+                task = std::move(victim.tasks.back());
+                victim.tasks.pop_back();
+            } else {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+            }
+        }
+    }
+    if (!task) {
+        return false;
+    }
+    --pending;
+    task();
+    return true;
+}
+
+void WorkStealingPool::run(size_t index) {
+    currentPool = this;
+    currentIndex = index;
+    for (;;) {
+        if (tryRun(index)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock{sleepMutex};
+        wake.wait(lock, [this] { return stopping || pending > 0; });
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+void WorkStealingPool::parallelForRange(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body,
+                                        size_t grain) {
+    if (begin >= end) {
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+    const size_t chunks = (end - begin + grain - 1) / grain;
+    if (1 == chunks) {
+        body(begin, end);
+        return;
+    }
+
+    // Tasks may start after the call has returned, so the state is shared with them
+    struct State {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::mutex mutex;
+        std::condition_variable finished;
+        std::exception_ptr error;
+    };
+    auto state = std::make_shared<State>();
+    auto work = [state, chunks, begin, end, grain, &body] {
+        for (size_t chunk = state->next++; chunk < chunks; chunk = state->next++) {
+            try {
+                size_t chunkBegin = begin + chunk * grain;
+                body(chunkBegin, std::min(chunkBegin + grain, end));
+            } catch (...) {
+                std::lock_guard<std::mutex> lock{state->mutex};
+                if (!state->error) {
+                    state->error = std::current_exception();
+                }
+            }
+            if (++state->done == chunks) {
+                std::lock_guard<std::mutex> lock{state->mutex};
+                state->finished.notify_all();
+            }
+        }
+    };
+    // Every stealable task takes chunks until none is left, body isn't touched by a task which starts after that
+    for (size_t i = 0; i < std::min(chunks - 1, workers.size()); ++i) {
+        push(work);
+    }
+    work();
+    std::unique_lock<std::mutex> lock{state->mutex};
+    state->finished.wait(lock, [&state, chunks] { return state->done == chunks; });
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+void WorkStealingPool::parallelFor(size_t count, const std::function<void(size_t)>& body, size_t grain) {
+    parallelForRange(0, count, [&body](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            body(i);
+        }
+    }, grain);
+}
+
+bool WorkStealingPool::shareWithOpenCV() {
+#ifdef MODEL_API_OPENCV_PARALLEL_BACKEND
+    cv::parallel::setParallelForBackend(std::make_shared<PoolParallelForBackend>(*this));
+    sharedWithOpenCV = true;
+    return true;
+#else
+    return false;
+#endif
+}
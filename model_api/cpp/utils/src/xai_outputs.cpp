@@ -0,0 +1,52 @@
+/*
+// Copyright (C) 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "utils/xai_outputs.hpp"
+
+#include <unordered_set>
+
+#include "utils/args_helper.hpp"
+
+namespace {
+constexpr char saliency_map_name[]{"saliency_map"};
+constexpr char feature_vector_name[]{"feature_vector"};
+}
+
+bool isXaiOutputName(const std::string& name) {
+    return name == saliency_map_name || name == feature_vector_name;
+}
+
+void removeXaiOutputs(ov::Model& model) {
+    // remove_result() changes the vector of results, so the loop goes over a copy
+    const ov::ResultVector results = model.get_results();
+    for (const std::shared_ptr<ov::op::v0::Result>& result : results) {
+        const std::unordered_set<std::string>& names = result->output(0).get_names();
+        if (names.count(saliency_map_name) || names.count(feature_vector_name)) {
+            model.remove_result(result);
+        }
+    }
+}
+
+std::shared_ptr<const ov::Model> pruneXaiOutputs(const std::shared_ptr<const ov::Model>& model) {
+    const ov::AnyMap modelInfo = model->has_rt_info({"model_info"}) ? model->get_rt_info<ov::AnyMap>("model_info")
+                                                                     : ov::AnyMap{};
+    if (!get_from_any_maps("remove_xai_outputs", modelInfo, ov::AnyMap{}, false)) {
+        return model;
+    }
+    std::shared_ptr<ov::Model> pruned = model->clone();
+    removeXaiOutputs(*pruned);
+    return pruned;
+}
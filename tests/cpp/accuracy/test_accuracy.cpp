@@ -1,5 +1,7 @@
 #include <stddef.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <exception>
 #include <iomanip>
@@ -7,6 +9,8 @@
 #include <stdexcept>
 #include <string>
 #include <fstream>
+#include <functional>
+#include <thread>
 
 #include <nlohmann/json.hpp>
 
@@ -30,6 +34,9 @@ using json = nlohmann::json;
 std::string PUBLIC_SCOPE_PATH = "../../tests/cpp/accuracy/public_scope.json";
 std::string DATA_DIR = "../data";
 std::string MODEL_PATH_TEMPLATE = "public/%s/FP16/%s.xml";
+std::string PERF_BASELINE_PATH;
+bool UPDATE_PERF_BASELINE = false;
+size_t PERF_ITERATIONS = 20;
 
 struct TestData {
     std::string image;
@@ -119,23 +126,143 @@ std::vector<std::shared_ptr<DetectionModel>> create_models(const std::string& mo
     }
     return models;
 }
+
+std::string model_xml_path(const std::string& name) {
+    if (name.substr(name.size() - 4) == ".xml") {
+        return DATA_DIR + '/' + name;
+    }
+    return DATA_DIR + '/' + string_format(MODEL_PATH_TEMPLATE, name.c_str(), name.c_str());
+}
+
+template <typename Type>
+void append_models(std::vector<std::shared_ptr<ModelBase>>& models, const std::string& model_path) {
+    for (const std::shared_ptr<Type>& model : create_models<Type>(model_path)) {
+        models.push_back(model);
+    }
+}
+
+std::vector<std::shared_ptr<ModelBase>> create_base_models(const std::string& type, const std::string& model_path) {
+    std::vector<std::shared_ptr<ModelBase>> models;
+    if (type == "DetectionModel") {
+        append_models<DetectionModel>(models, model_path);
+    } else if (type == "ClassificationModel") {
+        append_models<ClassificationModel>(models, model_path);
+    } else if (type == "SegmentationModel") {
+        append_models<SegmentationModel>(models, model_path);
+    } else if (type == "MaskRCNNModel") {
+        append_models<MaskRCNNModel>(models, model_path);
+    } else if (type == "AnomalyDetection") {
+        append_models<AnomalyModel>(models, model_path);
+    } else {
+        throw std::runtime_error("Unknown model type: " + type);
+    }
+    return models;
+}
+
+double median(std::vector<double> values) {
+    if (values.empty()) {
+        throw std::runtime_error("No measurements to take the median of");
+    }
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+struct PerfMeasurement {
+    double end_to_end_ms;
+    double overhead_ms;
+    bool has_overhead;
+};
+
+// Medians over PERF_ITERATIONS warm runs. Wrapper overhead is end-to-end minus adapter inference time.
+// Tilers call the model internally, so only their end-to-end latency is measured
+PerfMeasurement measure(const std::shared_ptr<ModelBase>& model, const std::string& tiler, const std::vector<cv::Mat>& images) {
+    using Ms = std::chrono::duration<double, std::milli>;
+    std::unique_ptr<TilerBase> tiler_ptr;
+    if (tiler == "DetectionTiler") {
+        tiler_ptr.reset(new DetectionTiler(model, {}));
+    } else if (tiler == "InstanceSegmentationTiler") {
+        tiler_ptr.reset(new InstanceSegmentationTiler(model, {}));
+    }
+    std::shared_ptr<InferenceAdapter> adapter = model->getInferenceAdapter();
+    std::vector<double> end_to_end, overhead;
+    constexpr size_t warmup_iterations = 3;
+    for (size_t i = 0; i < warmup_iterations + PERF_ITERATIONS; ++i) {
+        const cv::Mat& image = images[i % images.size()];
+        auto start = std::chrono::steady_clock::now();
+        Ms inference{0};
+        if (tiler_ptr) {
+            tiler_ptr->run(image);
+        } else {
+            InferenceInput inputs;
+            InferenceResult result;
+            result.internalModelData = model->preprocess(ImageInputData(image), inputs);
+            auto infer_start = std::chrono::steady_clock::now();
+            result.outputsData = adapter->infer(inputs);
+            inference = std::chrono::steady_clock::now() - infer_start;
+            model->postprocess(result);
+        }
+        Ms total = std::chrono::steady_clock::now() - start;
+        if (i >= warmup_iterations) {
+            end_to_end.push_back(total.count());
+            overhead.push_back((total - inference).count());
+        }
+    }
+    return {median(end_to_end), median(overhead), !tiler_ptr};
+}
+
+nlohmann::json& perf_baseline() {
+    static nlohmann::json baseline = [] {
+        nlohmann::json j;
+        std::ifstream input(PERF_BASELINE_PATH);
+        if (input) {
+            input >> j;
+        }
+        if (!j.contains("tolerance")) {
+            j["tolerance"] = {{"relative", 0.25}, {"absolute_ms", 1.0}};
+        }
+        if (!j.contains("models")) {
+            j["models"] = nlohmann::json::object();
+        }
+        return j;
+    }();
+    return baseline;
+}
+
+void save_perf_baseline() {
+    std::ofstream output(PERF_BASELINE_PATH);
+    output << std::setw(4) << perf_baseline() << std::endl;
+}
+
+void check_against_baseline(const std::string& key, const std::string& metric, double measured) {
+    nlohmann::json& baseline = perf_baseline();
+    nlohmann::json& entry = baseline["models"][key];
+    std::cout << key << ": " << metric << " " << std::fixed << std::setprecision(3) << measured << " ms" << std::endl;
+    if (UPDATE_PERF_BASELINE) {
+        entry[metric] = measured;
+        return;
+    }
+    if (!entry.contains(metric)) {
+        // A gate which passes without a reference never catches a regression
+        ADD_FAILURE() << key << ": no " << metric << " baseline, run with --update_baseline to record it";
+        return;
+    }
+    double reference = entry.at(metric).get<double>();
+    double limit = reference * (1.0 + baseline["tolerance"]["relative"].get<double>())
+        + baseline["tolerance"]["absolute_ms"].get<double>();
+    EXPECT_LE(measured, limit) << key << ": " << metric << " regressed from " << reference << " ms";
+}
 }
 
 TEST_P(ModelParameterizedTest, AccuracyTest)
 {
     auto modelData = GetParam();
 
-    std::string modelPath;
     const std::string& name = modelData.name;
     if (name.find(".onnx") != std::string::npos) {
         GTEST_SKIP() << "ONNX models are not supported in C++ implementation";
     }
 
-    if (name.substr(name.size() - 4) == ".xml") {
-        modelPath = DATA_DIR + '/' + name;
-    } else {
-        modelPath = DATA_DIR + '/' + string_format(MODEL_PATH_TEMPLATE, name.c_str(), name.c_str());
-    }
+    const std::string modelPath = model_xml_path(name);
     const std::string& basename = modelPath.substr(modelPath.find_last_of("/\\") + 1);
     for (const std::string& modelXml: {modelPath, DATA_DIR + "/serialized/" + basename}) {
         if (modelData.type == "DetectionModel") {
@@ -283,6 +410,209 @@ TEST_P(ModelParameterizedTest, AccuracyTest)
     }
 }
 
+namespace {
+// Share of differing pixels between masks of reduced and full output_precision
+double mismatch(const cv::Mat& actual, const cv::Mat& expected) {
+    if (actual.size() != expected.size()) {
+        return 1.0;
+    }
+    if (expected.empty()) {
+        return 0.0;
+    }
+    return double(cv::countNonZero((actual > 0.5) != (expected > 0.5))) / expected.total();
+}
+}
+
+TEST_P(ModelParameterizedTest, ReducedOutputPrecisionTest)
+{
+    auto modelData = GetParam();
+    const std::string& name = modelData.name;
+    if (name.find(".onnx") != std::string::npos) {
+        GTEST_SKIP() << "ONNX models are not supported in C++ implementation";
+    }
+    if (modelData.type != "SegmentationModel" && modelData.type != "MaskRCNNModel" && modelData.type != "AnomalyDetection") {
+        GTEST_SKIP() << "output_precision isn't supported by " << modelData.type;
+    }
+    // Anomaly maps aren't bounded, so they can't be quantized to u8
+    std::vector<std::string> precisions{"f16"};
+    if (modelData.type != "AnomalyDetection") {
+        precisions.push_back("u8");
+    }
+
+    const std::string modelPath = model_xml_path(name);
+    for (const TestData& data : modelData.testData) {
+        cv::Mat image = cv::imread(DATA_DIR + "/" + data.image);
+        if (!image.data) {
+            throw std::runtime_error{"Failed to read the image"};
+        }
+        for (const std::string& precision : precisions) {
+            SCOPED_TRACE(precision);
+            const ov::AnyMap configuration{{"output_precision", precision}};
+            if (modelData.type == "SegmentationModel") {
+                std::unique_ptr<ImageResult> reference = SegmentationModel::create_model(modelPath, {}, true, "CPU")->infer(image);
+                std::unique_ptr<ImageResult> result = SegmentationModel::create_model(modelPath, configuration, true, "CPU")->infer(image);
+                ASSERT_EQ(result->resultImage.size(), reference->resultImage.size());
+                EXPECT_LT(size_t(cv::countNonZero(result->resultImage != reference->resultImage)), reference->resultImage.total() / 100);
+                auto softReference = dynamic_cast<ImageResultWithSoftPrediction*>(reference.get());
+                auto soft = dynamic_cast<ImageResultWithSoftPrediction*>(result.get());
+                ASSERT_EQ(soft == nullptr, softReference == nullptr);
+                if (soft) {
+                    ASSERT_EQ(soft->soft_prediction.type(), softReference->soft_prediction.type());
+                    // u8 quantizes probabilities with the step of 1/255
+                    EXPECT_LT(cv::norm(soft->soft_prediction, softReference->soft_prediction, cv::NORM_INF), 0.01);
+                }
+            } else if (modelData.type == "MaskRCNNModel") {
+                std::unique_ptr<InstanceSegmentationResult> reference = MaskRCNNModel::create_model(modelPath, {}, true, "CPU")->infer(image);
+                std::unique_ptr<InstanceSegmentationResult> result = MaskRCNNModel::create_model(modelPath, configuration, true, "CPU")->infer(image);
+                ASSERT_EQ(result->segmentedObjects.size(), reference->segmentedObjects.size());
+                for (size_t i = 0; i < reference->segmentedObjects.size(); ++i) {
+                    const SegmentedObject& expected = reference->segmentedObjects[i];
+                    const SegmentedObject& actual = result->segmentedObjects[i];
+                    EXPECT_EQ(actual.labelID, expected.labelID);
+                    EXPECT_EQ(actual.mask.type(), expected.mask.type());
+                    EXPECT_LT(mismatch(actual.mask, expected.mask), 0.01);
+                }
+            } else {
+                std::unique_ptr<AnomalyResult> reference = AnomalyModel::create_model(modelPath, {}, true, "CPU")->infer(image);
+                std::unique_ptr<AnomalyResult> result = AnomalyModel::create_model(modelPath, configuration, true, "CPU")->infer(image);
+                EXPECT_EQ(result->pred_label, reference->pred_label);
+                EXPECT_NEAR(result->pred_score, reference->pred_score, 0.01);
+                ASSERT_EQ(result->anomaly_map.type(), reference->anomaly_map.type());
+                EXPECT_LE(cv::norm(result->anomaly_map, reference->anomaly_map, cv::NORM_INF), 2.0);
+                EXPECT_LT(mismatch(result->pred_mask, reference->pred_mask), 0.01);
+            }
+        }
+    }
+}
+
+TEST_P(ModelParameterizedTest, ConcurrentInferenceTest)
+{
+    auto modelData = GetParam();
+    const std::string& name = modelData.name;
+    if (name.find(".onnx") != std::string::npos) {
+        GTEST_SKIP() << "ONNX models are not supported in C++ implementation";
+    }
+
+    std::vector<cv::Mat> images;
+    for (const TestData& data : modelData.testData) {
+        cv::Mat image = cv::imread(DATA_DIR + "/" + data.image);
+        if (!image.data) {
+            throw std::runtime_error{"Failed to read the image"};
+        }
+        if (!modelData.tiler.empty() && modelData.input_res.height > 0 && modelData.input_res.width > 0) {
+            cv::resize(image, image, modelData.input_res);
+        }
+        images.push_back(image);
+    }
+
+    // One wrapper or tiler is shared by every thread
+    const std::string modelPath = model_xml_path(name);
+    std::function<std::string(const cv::Mat&)> predict;
+    if (modelData.type == "DetectionModel") {
+        std::shared_ptr<DetectionModel> model = DetectionModel::create_model(modelPath, {}, "", true, "CPU");
+        if (modelData.tiler == "DetectionTiler") {
+            auto tiler = std::make_shared<DetectionTiler>(model, ov::AnyMap{});
+            predict = [tiler](const cv::Mat& image) {
+                return std::string{*static_cast<DetectionResult*>(tiler->run(image).get())};
+            };
+        } else {
+            predict = [model](const cv::Mat& image) {
+                return std::string{*model->infer(image)};
+            };
+        }
+    } else if (modelData.type == "ClassificationModel") {
+        std::shared_ptr<ClassificationModel> model = ClassificationModel::create_model(modelPath, {}, true, "CPU");
+        predict = [model](const cv::Mat& image) {
+            return std::string{*model->infer(image)};
+        };
+    } else if (modelData.type == "MaskRCNNModel") {
+        std::shared_ptr<MaskRCNNModel> model = MaskRCNNModel::create_model(modelPath, {}, true, "CPU");
+        auto format = [](const InstanceSegmentationResult& result) {
+            std::stringstream ss;
+            for (const SegmentedObject& obj : result.segmentedObjects) {
+                ss << obj << "; ";
+            }
+            return ss.str();
+        };
+        if (modelData.tiler == "InstanceSegmentationTiler") {
+            auto tiler = std::make_shared<InstanceSegmentationTiler>(model, ov::AnyMap{});
+            predict = [tiler, format](const cv::Mat& image) {
+                return format(*static_cast<InstanceSegmentationResult*>(tiler->run(image).get()));
+            };
+        } else {
+            predict = [model, format](const cv::Mat& image) {
+                return format(*model->infer(image));
+            };
+        }
+    } else {
+        GTEST_SKIP() << "Concurrent inference isn't covered for " << modelData.type;
+    }
+
+    std::vector<std::string> expected;
+    for (const cv::Mat& image : images) {
+        expected.push_back(predict(image));
+    }
+    constexpr size_t threadsNum = 4, calls = 5;
+    std::vector<size_t> mismatches(threadsNum);
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < threadsNum; ++thread) {
+        threads.emplace_back([&, thread] {
+            for (size_t call = 0; call < calls; ++call) {
+                size_t index = (thread + call) % images.size();
+                if (predict(images[index]) != expected[index]) {
+                    ++mismatches[thread];
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(mismatches, std::vector<size_t>(threadsNum, 0));
+}
+
+TEST_P(ModelParameterizedTest, PerformanceTest)
+{
+    if (PERF_BASELINE_PATH.empty()) {
+        GTEST_SKIP() << "Performance baseline is not provided, use -b <path_to_perf_baseline.json>";
+    }
+    auto modelData = GetParam();
+    const std::string& name = modelData.name;
+    if (name.find(".onnx") != std::string::npos) {
+        GTEST_SKIP() << "ONNX models are not supported in C++ implementation";
+    }
+
+    std::vector<cv::Mat> images;
+    for (const TestData& data : modelData.testData) {
+        cv::Mat image = cv::imread(DATA_DIR + "/" + data.image);
+        if (!image.data) {
+            throw std::runtime_error{"Failed to read the image"};
+        }
+        if (!modelData.tiler.empty() && modelData.input_res.height > 0 && modelData.input_res.width > 0) {
+            cv::resize(image, image, modelData.input_res);
+        }
+        images.push_back(image);
+    }
+
+    const std::string modelPath = model_xml_path(name);
+    const std::string& basename = modelPath.substr(modelPath.find_last_of("/\\") + 1);
+    const std::vector<std::pair<std::string, std::string>> sources{
+        {name, modelPath},
+        {"serialized/" + basename, DATA_DIR + "/serialized/" + basename}};
+    for (const auto& source : sources) {
+        const std::vector<std::shared_ptr<ModelBase>>& models = create_base_models(modelData.type, source.second);
+        for (size_t i = 0; i < models.size(); ++i) {
+            // create_models() puts the model created from an adapter after the one created from a path
+            const std::string key = i == 0 ? source.first : source.first + ":adapter";
+            const PerfMeasurement& perf = measure(models[i], modelData.tiler, images);
+            check_against_baseline(key, "end_to_end_ms", perf.end_to_end_ms);
+            if (perf.has_overhead) {
+                check_against_baseline(key, "overhead_ms", perf.overhead_ms);
+            }
+        }
+    }
+}
+
 INSTANTIATE_TEST_SUITE_P(TestAccuracyPublic, ModelParameterizedTest, testing::ValuesIn(GetTestData(PUBLIC_SCOPE_PATH)));
 
 class InputParser{
@@ -312,7 +642,8 @@ class InputParser{
 
 void print_help(const char* program_name)
 {
-    std::cout << "Usage: " << program_name << " -p <path_to_public_scope.json> -d <path_to_data>" << std::endl;
+    std::cout << "Usage: " << program_name << " -p <path_to_public_scope.json> -d <path_to_data>"
+        " [-b <path_to_perf_baseline.json> [-n <iterations>] [--update_baseline]]" << std::endl;
 }
 
 int main(int argc, char **argv)
@@ -340,7 +671,36 @@ int main(int argc, char **argv)
         return 1;
     }
 
+    PERF_BASELINE_PATH = input.getCmdOption("-b");
+    UPDATE_PERF_BASELINE = input.cmdOptionExists("--update_baseline");
+    const std::string &iterations = input.getCmdOption("-n");
+    if (!iterations.empty()){
+        int count = 0;
+        try {
+            size_t parsed = 0;
+            count = std::stoi(iterations, &parsed);
+            if (parsed != iterations.size()) {
+                count = 0;
+            }
+        } catch (const std::logic_error&) {
+            // Not a number or out of the range of int
+        }
+        if (count < 1){
+            std::cerr << "-n must be a positive number of iterations, got: " << iterations << std::endl;
+            return 1;
+        }
+        PERF_ITERATIONS = static_cast<size_t>(count);
+    }
+    if (UPDATE_PERF_BASELINE && PERF_BASELINE_PATH.empty()){
+        print_help(argv[0]);
+        return 1;
+    }
+
     testing::InitGoogleTest(&argc, argv);
 
-    return RUN_ALL_TESTS();
+    int result = RUN_ALL_TESTS();
+    if (UPDATE_PERF_BASELINE){
+        save_perf_baseline();
+    }
+    return result;
 }
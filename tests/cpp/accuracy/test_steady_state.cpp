@@ -0,0 +1,145 @@
+#include <adapters/inference_adapter.h>
+#include <models/classification_model.h>
+#include <models/detection_model.h>
+#include <models/input_data.h>
+#include <models/results.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <new>
+#include <vector>
+
+using namespace std;
+
+namespace {
+// Only allocations of the thread under test are counted, plugin worker threads are ignored
+thread_local bool counting = false;
+thread_local size_t allocations = 0;
+}
+
+void* operator new(size_t size) {
+    if (counting) {
+        ++allocations;
+    }
+    if (void* ptr = malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    free(ptr);
+}
+
+namespace {
+template <typename Func>
+size_t count_allocations(Func func) {
+    allocations = 0;
+    counting = true;
+    func();
+    counting = false;
+    return allocations;
+}
+
+string data() {
+    // Get data from env var, not form cmd arg to stay aligned with test_YOLOv8
+    static const char* const data = getenv("DATA");
+    EXPECT_NE(data, nullptr);
+    return data;
+}
+
+string ultralytics_xml(const char model_name[]) {
+    for (auto const& dir_entry : filesystem::directory_iterator{data() + "/ultralytics/" + model_name}) {
+        if (".xml" == dir_entry.path().extension()) {
+            return dir_entry.path().string();
+        }
+    }
+    return {};
+}
+
+cv::Mat image() {
+    cv::Mat img = cv::imread(data() + "/coco128/images/train2017/000000000074.jpg");
+    EXPECT_TRUE(img.data);
+    return img;
+}
+
+template <typename Result>
+void check_steady_state(ModelBase& model, const cv::Mat& img) {
+    ImageInputData inputData{img};
+    Result result;
+    constexpr size_t warmup_iterations = 3;
+    for (size_t i = 0; i < warmup_iterations; ++i) {
+        model.inferInto(inputData, result);
+    }
+    unique_ptr<ResultBase> reference = model.infer(inputData);
+    EXPECT_EQ(string{result}, string{static_cast<Result&>(*reference)});
+
+    InferenceInput inputs;
+    InferenceResult infResult;
+    shared_ptr<InferenceAdapter> adapter = model.getInferenceAdapter();
+    infResult.internalModelData = model.preprocess(inputData, inputs);
+    adapter->infer(inputs, infResult.outputsData);
+    model.postprocessInto(infResult, result);
+    vector<size_t> preprocessing, inference;
+    for (size_t i = 0; i < 10; ++i) {
+        const InternalModelData* internalData = infResult.internalModelData.get();
+        map<string, const void*> outputData;
+        for (const auto& output : infResult.outputsData) {
+            outputData[output.first] = output.second.data();
+        }
+        // Released the way inferInto() does it, so preprocess() can take it back
+        infResult.internalModelData.reset();
+        preprocessing.push_back(count_allocations([&]{ infResult.internalModelData = model.preprocess(inputData, inputs); }));
+        EXPECT_EQ(infResult.internalModelData.get(), internalData);
+        inference.push_back(count_allocations([&]{ adapter->infer(inputs, infResult.outputsData); }));
+        for (const auto& output : infResult.outputsData) {
+            EXPECT_EQ(output.second.data(), outputData.at(output.first)) << output.first;
+        }
+        EXPECT_EQ(count_allocations([&]{ model.postprocessInto(infResult, result); }), 0);
+    }
+    // Wrapping the image into a tensor and the plugin still allocate, but the amount doesn't grow with frames
+    for (size_t i = 1; i < preprocessing.size(); ++i) {
+        EXPECT_LE(preprocessing[i], preprocessing[0]);
+        EXPECT_LE(inference[i], inference[0]);
+    }
+    EXPECT_EQ(string{result}, string{static_cast<Result&>(*reference)});
+
+    size_t steady = count_allocations([&]{ model.inferInto(inputData, result); });
+    for (size_t i = 0; i < 10; ++i) {
+        EXPECT_LE(count_allocations([&]{ model.inferInto(inputData, result); }), steady);
+    }
+    EXPECT_EQ(string{result}, string{static_cast<Result&>(*reference)});
+}
+
+TEST(SteadyState, Classification) {
+    bool preload = true;
+    auto model = ClassificationModel::create_model(data() + "/public/efficientnet-b0-pytorch/FP16/efficientnet-b0-pytorch.xml", {}, preload, "CPU");
+    check_steady_state<ClassificationResult>(*model, image());
+}
+
+TEST(SteadyState, SSD) {
+    bool preload = true;
+    auto model = DetectionModel::create_model(data() + "/public/ssd300/FP16/ssd300.xml", {}, "", preload, "CPU");
+    check_steady_state<DetectionResult>(*model, image());
+}
+
+TEST(SteadyState, YOLOv8) {
+    bool preload = true;
+    auto model = DetectionModel::create_model(ultralytics_xml("yolov8l_openvino_model"), {}, "", preload, "CPU");
+    check_steady_state<DetectionResult>(*model, image());
+}
+
+TEST(SteadyState, WrongResultTypeThrows) {
+    bool preload = true;
+    auto model = DetectionModel::create_model(data() + "/public/ssd300/FP16/ssd300.xml", {}, "", preload, "CPU");
+    ClassificationResult wrongType;
+    EXPECT_ANY_THROW(model->inferInto(ImageInputData{image()}, wrongType));
+}
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <openvino/openvino.hpp>
+#include <openvino/opsets/opset10.hpp>
+
+#include <adapters/inference_adapter.h>
+
+// Tiny models built in memory, so the precommit tests of adapters and wrappers don't depend on downloaded data
+
+constexpr size_t DOUBLE_SIZE = 64;
+
+// Multiplies a FP32 tensor "input" of shape [1, size] by 2 into "output"
+inline std::shared_ptr<ov::Model> make_double_model(const ov::PartialShape& shape = ov::PartialShape{1, DOUBLE_SIZE}) {
+    auto input = std::make_shared<ov::opset10::Parameter>(ov::element::f32, shape);
+    input->output(0).set_names({"input"});
+    auto two = ov::opset10::Constant::create(ov::element::f32, ov::Shape{}, {2.0f});
+    auto multiply = std::make_shared<ov::opset10::Multiply>(input, two);
+    multiply->output(0).set_names({"output"});
+    auto model = std::make_shared<ov::Model>(ov::OutputVector{multiply}, ov::ParameterVector{input});
+    model->set_rt_info("Classification", "model_info", "model_type");
+    return model;
+}
+
+// start, start + 1, ... to tell outputs of concurrent requests apart
+inline InferenceInput make_double_input(size_t size, float start) {
+    ov::Tensor tensor(ov::element::f32, {1, size});
+    for (size_t i = 0; i < size; ++i) {
+        tensor.data<float>()[i] = start + i;
+    }
+    return {{"input", tensor}};
+}
+
+inline InferenceInput make_double_input(float start) {
+    return make_double_input(DOUBLE_SIZE, start);
+}
+
+inline void check_double_output(const InferenceOutput& output, size_t size, float start) {
+    const ov::Tensor& tensor = output.at("output");
+    ASSERT_EQ(tensor.get_shape(), ov::Shape({1, size}));
+    for (size_t i = 0; i < size; ++i) {
+        ASSERT_EQ(tensor.data<const float>()[i], 2 * (start + i));
+    }
+}
+
+inline void check_double_output(const InferenceOutput& output, float start) {
+    check_double_output(output, DOUBLE_SIZE, start);
+}
+
+// Averages an u8 NHWC image "image" of any resolution into "mean", labels it dark or bright
+inline std::shared_ptr<ov::Model> make_mean_model() {
+    auto input = std::make_shared<ov::opset10::Parameter>(ov::element::u8, ov::PartialShape{1, -1, -1, 3});
+    input->output(0).set_names({"image"});
+    auto converted = std::make_shared<ov::opset10::Convert>(input, ov::element::f32);
+    auto axes = ov::opset10::Constant::create(ov::element::i64, ov::Shape{3}, {1, 2, 3});
+    auto mean = std::make_shared<ov::opset10::ReduceMean>(converted, axes, false);
+    mean->output(0).set_names({"mean"});
+    auto model = std::make_shared<ov::Model>(ov::OutputVector{mean}, ov::ParameterVector{input});
+    model->set_rt_info(true, "model_info", "embedded_processing");
+    model->set_rt_info(std::vector<std::string>{"dark", "bright"}, "model_info", "labels");
+    return model;
+}
+
+// Classification of a NCHW FP32 image "image" of 8x8: averages its channels and projects them to a logit per label in
+// "logits". model_info entries are added to the rt_info of the model
+inline std::shared_ptr<ov::Model> make_classification_model(const std::vector<std::string>& labels,
+                                                            const ov::AnyMap& model_info = {}) {
+    auto input = std::make_shared<ov::opset10::Parameter>(ov::element::f32, ov::Shape{1, 3, 8, 8});
+    input->set_layout("NCHW");
+    input->output(0).set_names({"image"});
+    auto axes = ov::opset10::Constant::create(ov::element::i64, ov::Shape{2}, {2, 3});
+    auto mean = std::make_shared<ov::opset10::ReduceMean>(input, axes, false);
+    // Small weights of both signs, so the logits of an image differ in sign and magnitude
+    std::vector<float> weights(3 * labels.size());
+    for (size_t i = 0; i < weights.size(); ++i) {
+        weights[i] = 0.005f * (static_cast<float>((i * 3) % 7) - 3.0f);
+    }
+    auto logits = std::make_shared<ov::opset10::MatMul>(mean,
+        ov::opset10::Constant::create(ov::element::f32, ov::Shape{3, labels.size()}, weights));
+    logits->output(0).set_names({"logits"});
+    auto model = std::make_shared<ov::Model>(ov::OutputVector{logits}, ov::ParameterVector{input});
+    model->set_rt_info(std::string{"Classification"}, "model_info", "model_type");
+    model->set_rt_info(labels, "model_info", "labels");
+    for (const auto& item : model_info) {
+        model->set_rt_info(item.second, "model_info", item.first);
+    }
+    return model;
+}
+
+// make_classification_model() with the XAI outputs "saliency_map" and "feature_vector". feature_vector is computed by
+// a chain of large matrix multiplications, so it dominates the latency
+inline std::shared_ptr<ov::Model> make_xai_classification_model(const std::vector<std::string>& labels,
+                                                                const ov::AnyMap& model_info = {}) {
+    std::shared_ptr<ov::Model> model = make_classification_model(labels, model_info);
+    std::shared_ptr<ov::Node> input = model->get_parameters().front();
+    auto flat = std::make_shared<ov::opset10::Reshape>(input,
+        ov::opset10::Constant::create(ov::element::i64, ov::Shape{2}, {1, 192}), false);
+    auto projection = ov::opset10::Constant::create(ov::element::f32, ov::Shape{192, 1024},
+        std::vector<float>(192 * 1024, 1.0f / 192));
+    std::shared_ptr<ov::Node> features = std::make_shared<ov::opset10::MatMul>(flat, projection);
+    auto square = ov::opset10::Constant::create(ov::element::f32, ov::Shape{1024, 1024},
+        std::vector<float>(1024 * 1024, 1.0f / 1024));
+    for (int i = 0; i < 16; ++i) {
+        features = std::make_shared<ov::opset10::MatMul>(features, square);
+    }
+    features->output(0).set_names({"feature_vector"});
+    auto saliency = std::make_shared<ov::opset10::Multiply>(input,
+        ov::opset10::Constant::create(ov::element::f32, ov::Shape{}, {2.0f}));
+    saliency->output(0).set_names({"saliency_map"});
+    model->add_results({std::make_shared<ov::opset10::Result>(saliency), std::make_shared<ov::opset10::Result>(features)});
+    return model;
+}
+
+// YOLOX with a NCHW FP32 input "images" of 64x64. Outputs 84 boxes of two classes, shifted by the image mean
+inline std::shared_ptr<ov::Model> make_yolox_model() {
+    auto input = std::make_shared<ov::opset10::Parameter>(ov::element::f32, ov::Shape{1, 3, 64, 64});
+    input->set_layout("NCHW");
+    input->output(0).set_names({"images"});
+    std::vector<float> boxes(84 * 7);
+    std::mt19937 rng{42};
+    auto uniform = [&rng](float from, float to) {
+        return std::uniform_real_distribution<float>{from, to}(rng);
+    };
+    for (size_t box = 0; box < 84; ++box) {
+        float* values = boxes.data() + box * 7;
+        values[0] = uniform(0.0f, 1.0f);
+        values[1] = uniform(0.0f, 1.0f);
+        values[2] = uniform(-0.5f, 1.0f);
+        values[3] = uniform(-0.5f, 1.0f);
+        for (size_t i = 4; i < 7; ++i) {
+            values[i] = uniform(0.3f, 1.0f);
+        }
+    }
+    auto axes = ov::opset10::Constant::create(ov::element::i64, ov::Shape{3}, {1, 2, 3});
+    auto mean = std::make_shared<ov::opset10::ReduceMean>(input, axes, true);
+    auto shift = std::make_shared<ov::opset10::Multiply>(mean,
+        ov::opset10::Constant::create(ov::element::f32, ov::Shape{}, {0.002f}));
+    auto output = std::make_shared<ov::opset10::Add>(
+        ov::opset10::Constant::create(ov::element::f32, ov::Shape{1, 84, 7}, boxes), shift);
+    output->output(0).set_names({"output"});
+    auto model = std::make_shared<ov::Model>(ov::OutputVector{output}, ov::ParameterVector{input});
+    model->set_rt_info(std::vector<std::string>{"cat", "dog"}, "model_info", "labels");
+    return model;
+}
+
+// YOLOv5 with a NCHW input "images" of 8x8 and an output "output" of shape [1, 4 + classes, proposals] which doesn't
+// depend on the image, tests feed postprocessing with output tensors of their own
+inline std::shared_ptr<ov::Model> make_yolo_model(size_t classes, size_t proposals) {
+    auto input = std::make_shared<ov::opset10::Parameter>(ov::element::f32, ov::Shape{1, 3, 8, 8});
+    input->set_layout("NCHW");
+    input->output(0).set_names({"images"});
+    auto axes = ov::opset10::Constant::create(ov::element::i64, ov::Shape{3}, {1, 2, 3});
+    auto mean = std::make_shared<ov::opset10::ReduceMean>(input, axes, false);
+    auto zero = std::make_shared<ov::opset10::Multiply>(mean,
+        ov::opset10::Constant::create(ov::element::f32, ov::Shape{}, {0.0f}));
+    auto output = std::make_shared<ov::opset10::Add>(
+        ov::opset10::Constant::create(ov::element::f32, ov::Shape{1, 4 + classes, proposals}, {0.0f}), zero);
+    output->output(0).set_names({"output"});
+    auto model = std::make_shared<ov::Model>(ov::OutputVector{output}, ov::ParameterVector{input});
+    std::vector<std::string> labels;
+    for (size_t i = 0; i < classes; ++i) {
+        labels.push_back("class" + std::to_string(i));
+    }
+    model->set_rt_info(labels, "model_info", "labels");
+    return model;
+}
@@ -0,0 +1,107 @@
+#include <stddef.h>
+
+#include <chrono>
+#include <exception>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <openvino/openvino.hpp>
+
+#include <adapters/batching_adapter.h>
+
+#include "synthetic_models.h"
+
+TEST(BatchingAdapter, KeepsOriginalShapes) {
+    ov::Core core;
+    BatchingInferenceAdapter adapter;
+    adapter.loadModel(make_double_model({1, 16}), core, "CPU");
+    EXPECT_EQ(adapter.getInputNames(), std::vector<std::string>{"input"});
+    EXPECT_EQ(adapter.getOutputNames(), std::vector<std::string>{"output"});
+    EXPECT_EQ(adapter.getInputShape("input"), ov::PartialShape({1, 16}));
+    EXPECT_EQ(adapter.getModelConfig().at("model_type").as<std::string>(), "Classification");
+}
+
+TEST(BatchingAdapter, CombinesConcurrentRequests) {
+    ov::Core core;
+    constexpr size_t maxBatchSize = 4;
+    BatchingInferenceAdapter adapter{maxBatchSize, std::chrono::seconds(10)};
+    adapter.loadModel(make_double_model({1, 16}), core, "CPU");
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::future<InferenceOutput>> futures;
+    for (size_t i = 0; i < maxBatchSize; ++i) {
+        futures.push_back(adapter.inferAsync(make_double_input(16, float(i * 100))));
+    }
+    for (size_t i = 0; i < maxBatchSize; ++i) {
+        check_double_output(futures[i].get(), 16, float(i * 100));
+    }
+    // A full batch doesn't wait for the delay
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+}
+
+TEST(BatchingAdapter, CallbackFormDoesNotBlock) {
+    ov::Core core;
+    constexpr size_t maxBatchSize = 4;
+    BatchingInferenceAdapter batching{maxBatchSize, std::chrono::seconds(10)};
+    batching.loadModel(make_double_model({1, 16}), core, "CPU");
+    InferenceAdapter& adapter = batching;
+    std::vector<std::promise<InferenceOutput>> promises(maxBatchSize);
+    auto start = std::chrono::steady_clock::now();
+    // A blocking call would wait for the delay before the next request is submitted
+    for (size_t i = 0; i < maxBatchSize; ++i) {
+        adapter.inferAsync(make_double_input(16, float(i * 100)), [&promises, i](InferenceOutput output, std::exception_ptr error) {
+            if (error) {
+                promises[i].set_exception(error);
+            } else {
+                promises[i].set_value(std::move(output));
+            }
+        });
+    }
+    for (size_t i = 0; i < maxBatchSize; ++i) {
+        check_double_output(promises[i].get_future().get(), 16, float(i * 100));
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+}
+
+TEST(BatchingAdapter, BucketsDifferentShapes) {
+    ov::Core core;
+    bool padBatch = true;
+    BatchingInferenceAdapter adapter{8, std::chrono::milliseconds(5), padBatch};
+    adapter.loadModel(make_double_model({1, -1}), core, "CPU");
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 8; ++t) {
+        threads.emplace_back([&adapter, t] {
+            size_t size = t % 2 ? 10 : 20;
+            for (size_t i = 0; i < 20; ++i) {
+                check_double_output(adapter.infer(make_double_input(size, float(t * 100 + i))), size, float(t * 100 + i));
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+TEST(BatchingAdapter, CompletesPendingRequestsOnDestruction) {
+    ov::Core core;
+    std::future<InferenceOutput> future;
+    {
+        BatchingInferenceAdapter adapter{8, std::chrono::seconds(10)};
+        adapter.loadModel(make_double_model({1, 16}), core, "CPU");
+        future = adapter.inferAsync(make_double_input(16, 1.0f));
+    }
+    check_double_output(future.get(), 16, 1.0f);
+}
+
+TEST(BatchingAdapter, WarmsUpEveryBatchSize) {
+    ov::Core core;
+    bool padBatch = true;
+    BatchingInferenceAdapter adapter{4, std::chrono::milliseconds(1), padBatch};
+    adapter.loadModel(make_double_model({1, 16}), core, "CPU");
+    adapter.warmup(make_double_input(16, 0.0f));
+    check_double_output(adapter.infer(make_double_input(16, 5.0f)), 16, 5.0f);
+}
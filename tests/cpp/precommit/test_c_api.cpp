@@ -0,0 +1,181 @@
+#include <stddef.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <c_api/model_api.h>
+
+std::string DATA_DIR = "../data";
+std::string DETECTION_MODEL = "public/ssd300/FP16/ssd300.xml";
+std::string CLASSIFICATION_MODEL = "otx_models/tinynet_imagenet.xml";
+std::string IMAGE_PATH = "coco128/images/train2017/000000000074.jpg";
+
+namespace {
+cv::Mat read_image() {
+    cv::Mat image = cv::imread(DATA_DIR + "/" + IMAGE_PATH);
+    if (!image.data) {
+        throw std::runtime_error{"Failed to read the image"};
+    }
+    return image;
+}
+
+mapi_image_t to_image(const cv::Mat& mat, mapi_pixel_format_e format) {
+    return {mat.data, mat.cols, mat.rows, mat.step[0], format};
+}
+
+mapi_model_t* create(const std::string& path, mapi_model_type_e type) {
+    mapi_config_entry_t configuration[] = {{"confidence_threshold", "0.5"}};
+    mapi_model_t* model = nullptr;
+    EXPECT_EQ(mapi_model_create((DATA_DIR + "/" + path).c_str(), type, configuration, 1, "CPU", &model), MAPI_OK)
+        << mapi_last_error();
+    return model;
+}
+
+std::vector<std::string> labels(const mapi_result_t* result) {
+    std::vector<std::string> labels;
+    for (size_t i = 0; i < result->objects_size; ++i) {
+        labels.push_back(result->objects[i].label);
+    }
+    return labels;
+}
+
+struct Completions {
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::vector<std::vector<std::string>> labels;
+    size_t failed = 0;
+
+    static void callback(mapi_status_e status, const mapi_result_t* result, void* user_data) {
+        auto& completions = *static_cast<Completions*>(user_data);
+        std::lock_guard<std::mutex> lock{completions.mutex};
+        if (status == MAPI_OK) {
+            completions.labels.push_back(::labels(result));
+        } else {
+            ++completions.failed;
+        }
+        mapi_result_release(result);
+        completions.condition.notify_all();
+    }
+
+    void wait(size_t count) {
+        std::unique_lock<std::mutex> lock{mutex};
+        condition.wait(lock, [&] { return labels.size() + failed >= count; });
+    }
+};
+}
+
+TEST(CApi, Classification) {
+    mapi_model_t* model = create(CLASSIFICATION_MODEL, MAPI_CLASSIFICATION);
+    cv::Mat image = read_image();
+    mapi_image_t input = to_image(image, MAPI_BGR8);
+    const mapi_result_t* result = nullptr;
+    ASSERT_EQ(mapi_model_infer(model, &input, &result), MAPI_OK) << mapi_last_error();
+    EXPECT_EQ(result->type, MAPI_CLASSIFICATION);
+    ASSERT_GT(result->labels_size, 0u);
+    EXPECT_NE(result->labels[0].label, nullptr);
+    EXPECT_EQ(result->objects_size, 0u);
+    mapi_result_release(result);
+    mapi_model_free(model);
+}
+
+TEST(CApi, DetectionPixelFormatsAndStrides) {
+    mapi_model_t* model = create(DETECTION_MODEL, MAPI_DETECTION);
+    cv::Mat image = read_image();
+    mapi_image_t bgr = to_image(image, MAPI_BGR8);
+    const mapi_result_t* expected = nullptr;
+    ASSERT_EQ(mapi_model_infer(model, &bgr, &expected), MAPI_OK) << mapi_last_error();
+    EXPECT_GT(expected->objects_size, 0u);
+
+    cv::Mat rgb;
+    cv::cvtColor(image, rgb, cv::COLOR_BGR2RGB);
+    // Rows of a region of a wider image are padded
+    cv::Mat padded(image.rows, image.cols + 7, CV_8UC3);
+    image.copyTo(padded(cv::Rect(0, 0, image.cols, image.rows)));
+    for (const mapi_image_t& input : {to_image(rgb, MAPI_RGB8), to_image(padded(cv::Rect(0, 0, image.cols, image.rows)), MAPI_BGR8)}) {
+        const mapi_result_t* result = nullptr;
+        ASSERT_EQ(mapi_model_infer(model, &input, &result), MAPI_OK) << mapi_last_error();
+        EXPECT_EQ(labels(result), labels(expected));
+        mapi_result_release(result);
+    }
+    mapi_result_release(expected);
+    mapi_model_free(model);
+}
+
+TEST(CApi, ClassificationStrides) {
+    // The model embeds its preprocessing, so the image is wrapped into a tensor instead of being resized
+    mapi_model_t* model = create(CLASSIFICATION_MODEL, MAPI_CLASSIFICATION);
+    cv::Mat image = read_image();
+    mapi_image_t bgr = to_image(image, MAPI_BGR8);
+    const mapi_result_t* expected = nullptr;
+    ASSERT_EQ(mapi_model_infer(model, &bgr, &expected), MAPI_OK) << mapi_last_error();
+    ASSERT_GT(expected->labels_size, 0u);
+
+    cv::Mat padded(image.rows, image.cols + 7, CV_8UC3);
+    image.copyTo(padded(cv::Rect(0, 0, image.cols, image.rows)));
+    mapi_image_t input = to_image(padded(cv::Rect(0, 0, image.cols, image.rows)), MAPI_BGR8);
+    const mapi_result_t* result = nullptr;
+    ASSERT_EQ(mapi_model_infer(model, &input, &result), MAPI_OK) << mapi_last_error();
+    ASSERT_EQ(result->labels_size, expected->labels_size);
+    EXPECT_EQ(result->labels[0].id, expected->labels[0].id);
+    EXPECT_FLOAT_EQ(result->labels[0].score, expected->labels[0].score);
+    mapi_result_release(result);
+    mapi_result_release(expected);
+    mapi_model_free(model);
+}
+
+TEST(CApi, AsyncCallbacks) {
+    mapi_model_t* model = create(DETECTION_MODEL, MAPI_DETECTION);
+    cv::Mat image = read_image();
+    mapi_image_t input = to_image(image, MAPI_BGR8);
+    const mapi_result_t* expected = nullptr;
+    ASSERT_EQ(mapi_model_infer(model, &input, &expected), MAPI_OK) << mapi_last_error();
+    Completions completions;
+    constexpr size_t COUNT = 8;
+    for (size_t i = 0; i < COUNT; ++i) {
+        ASSERT_EQ(mapi_model_infer_async(model, &input, &Completions::callback, &completions), MAPI_OK)
+            << mapi_last_error();
+    }
+    completions.wait(COUNT);
+    EXPECT_EQ(completions.failed, 0u);
+    EXPECT_EQ(completions.labels, std::vector<std::vector<std::string>>(COUNT, labels(expected)));
+    mapi_result_release(expected);
+    mapi_model_free(model);
+}
+
+TEST(CApi, Errors) {
+    mapi_model_t* model = nullptr;
+    EXPECT_EQ(mapi_model_create(nullptr, MAPI_DETECTION, nullptr, 0, nullptr, &model), MAPI_INVALID_ARGUMENT);
+    EXPECT_NE(std::string(mapi_last_error()), "");
+    EXPECT_EQ(mapi_model_create("missing.xml", MAPI_DETECTION, nullptr, 0, "CPU", &model), MAPI_ERROR);
+    EXPECT_EQ(model, nullptr);
+
+    model = create(DETECTION_MODEL, MAPI_DETECTION);
+    mapi_image_t empty{nullptr, 0, 0, 0, MAPI_BGR8};
+    const mapi_result_t* result = nullptr;
+    EXPECT_EQ(mapi_model_infer(model, &empty, &result), MAPI_INVALID_ARGUMENT);
+    EXPECT_EQ(result, nullptr);
+    mapi_result_release(result);
+    mapi_model_free(model);
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) == "-d") {
+            DATA_DIR = argv[i + 1];
+            return RUN_ALL_TESTS();
+        }
+    }
+    std::cout << "Usage: " << argv[0] << " -d <path_to_data>" << std::endl;
+    return 1;
+}
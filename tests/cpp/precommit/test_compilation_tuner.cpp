@@ -0,0 +1,38 @@
+#include <stddef.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <openvino/openvino.hpp>
+
+#include <models/compilation_tuner.h>
+
+#include "synthetic_models.h"
+
+TEST(CompilationTuner, MeasuresEveryCombination) {
+    ov::Core core;
+    CompilationTuner tuner{{1, 2}, {0, 1}, std::chrono::milliseconds(50)};
+    CompilationTuner::Result result = tuner.tune(make_double_model(), core, "CPU", make_double_input(1.0f));
+    ASSERT_EQ(result.trials.size(), 4u);
+    for (const CompilationTuner::Trial& trial : result.trials) {
+        EXPECT_GT(trial.fps, 0.0);
+        EXPECT_GT(trial.latencyMs, 0.0);
+        EXPECT_EQ(trial.config.count(ov::num_streams.name()), 1u);
+    }
+    EXPECT_EQ(result.trials[0].config.count(ov::inference_num_threads.name()), 0u);
+    EXPECT_EQ(result.trials[1].config.count(ov::inference_num_threads.name()), 1u);
+    for (const CompilationTuner::Trial& trial : result.trials) {
+        EXPECT_LE(trial.fps, result.trials[result.throughputBest].fps);
+        EXPECT_GE(trial.latencyMs, result.trials[result.latencyBest].latencyMs);
+    }
+}
+
+TEST(CompilationTuner, DefaultsToHardwareThreads) {
+    CompilationTuner tuner;
+    ASSERT_FALSE(tuner.getStreams().empty());
+    EXPECT_EQ(tuner.getStreams().front(), 1);
+    EXPECT_EQ(tuner.getThreads().front(), 0);
+}
@@ -0,0 +1,232 @@
+#include <stddef.h>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <opencv2/core.hpp>
+#include <openvino/openvino.hpp>
+
+#include <adapters/openvino_adapter.h>
+#include <models/detection_model_yolox.h>
+#include <models/image_model.h>
+#include <models/input_data.h>
+#include <models/internal_model_data.h>
+#include <models/results.h>
+
+#include "synthetic_models.h"
+
+namespace {
+constexpr size_t THREADS = 16;
+constexpr size_t CALLS = 50;
+
+std::shared_ptr<InferenceAdapter> make_adapter() {
+    ov::Core core;
+    auto adapter = std::make_shared<OpenVINOInferenceAdapter>();
+    adapter->loadModel(make_mean_model(), core, "CPU", {ov::inference_num_threads(1)});
+    return adapter;
+}
+
+InferenceInput make_input(int value) {
+    ov::Tensor tensor(ov::element::u8, {1, 2, 2, 3});
+    std::fill_n(tensor.data<uint8_t>(), tensor.get_size(), static_cast<uint8_t>(value));
+    return {{"image", tensor}};
+}
+
+struct MeanResult : public ResultBase {
+    float mean = 0.0f;
+    int width = 0;
+    int height = 0;
+    Label label;
+};
+
+class MeanModel : public ImageModel {
+public:
+    using ImageModel::ImageModel;
+
+    std::unique_ptr<ResultBase> postprocess(InferenceResult& infResult) override {
+        auto result = std::make_unique<MeanResult>();
+        const auto& internalData = infResult.internalModelData->asRef<InternalImageModelData>();
+        result->mean = infResult.getFirstOutputTensor().data<const float>()[0];
+        result->width = internalData.inputImgWidth;
+        result->height = internalData.inputImgHeight;
+        result->label = getLabel(result->mean < 128 ? 0 : 1);
+        return result;
+    }
+
+protected:
+    void prepareInputsOutputs(std::shared_ptr<ov::Model>&) override {}
+};
+
+class PoolAdapter : public OpenVINOInferenceAdapter {
+public:
+    size_t poolSize() {
+        std::lock_guard<std::mutex> lock{requestsMutex};
+        return requests.size();
+    }
+
+    uint32_t optimalRequests() const {
+        return compiledModel.get_property(ov::optimal_number_of_infer_requests);
+    }
+
+    // The output of the last inference of every request
+    std::vector<float> lastMeans() {
+        std::lock_guard<std::mutex> lock{requestsMutex};
+        std::vector<float> means;
+        for (ov::InferRequest& request : requests) {
+            means.push_back(request.get_tensor("mean").data<const float>()[0]);
+        }
+        return means;
+    }
+};
+}
+
+TEST(ConcurrentInfer, AdapterPoolIsBounded) {
+    ov::Core core;
+    auto adapter = std::make_shared<PoolAdapter>();
+    adapter->loadModel(make_mean_model(), core, "CPU", {ov::inference_num_threads(1)});
+    const size_t poolSize = adapter->poolSize();
+    std::vector<std::thread> threads;
+    std::vector<size_t> mismatches(THREADS);
+    for (size_t thread = 0; thread < THREADS; ++thread) {
+        threads.emplace_back([&, thread] {
+            for (size_t call = 0; call < CALLS; ++call) {
+                int value = static_cast<int>(thread * CALLS + call) % 256;
+                if (adapter->infer(make_input(value)).at("mean").data<const float>()[0] != float(value)) {
+                    ++mismatches[thread];
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(mismatches, std::vector<size_t>(THREADS, 0));
+    EXPECT_EQ(adapter->poolSize(), poolSize);
+}
+
+TEST(ConcurrentInfer, AdapterRecyclesReleasedOutputs) {
+    std::shared_ptr<InferenceAdapter> adapter = make_adapter();
+    std::set<const void*> buffers;
+    for (int call = 0; call < 16; ++call) {
+        InferenceOutput output = adapter->infer(make_input(call));
+        EXPECT_EQ(output.at("mean").data<const float>()[0], float(call));
+        buffers.insert(output.at("mean").data());
+    }
+    // The request keeps the output of the previous call until it gets the next one
+    EXPECT_LE(buffers.size(), 2u);
+}
+
+TEST(ConcurrentInfer, AdapterReloadKeepsNames) {
+    ov::Core core;
+    OpenVINOInferenceAdapter adapter;
+    adapter.loadModel(make_mean_model(), core, "CPU");
+    adapter.loadModel(make_mean_model(), core, "CPU");
+    EXPECT_EQ(adapter.getInputNames(), std::vector<std::string>{"image"});
+    EXPECT_EQ(adapter.getOutputNames(), std::vector<std::string>{"mean"});
+}
+
+TEST(ConcurrentInfer, YoloXManyThreads) {
+    std::shared_ptr<ov::Model> ovModel = make_yolox_model();
+    ModelYoloX model{ovModel, {}};
+    model.prepare();
+    ov::Core core;
+    model.load(core, "CPU");
+
+    std::vector<std::string> expected;
+    for (int value = 0; value < 256; value += 16) {
+        expected.push_back(std::string{*model.infer(cv::Mat(48, 80, CV_8UC3, cv::Scalar::all(value)))});
+    }
+    ASSERT_NE(expected.front(), expected.back());
+    std::vector<std::thread> threads;
+    std::vector<size_t> mismatches(THREADS);
+    for (size_t thread = 0; thread < THREADS; ++thread) {
+        threads.emplace_back([&, thread] {
+            for (size_t call = 0; call < CALLS; ++call) {
+                size_t index = (thread + call) % expected.size();
+                cv::Mat image(48, 80, CV_8UC3, cv::Scalar::all(static_cast<int>(index * 16)));
+                if (std::string{*model.infer(image)} != expected[index]) {
+                    ++mismatches[thread];
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(mismatches, std::vector<size_t>(THREADS, 0));
+}
+
+TEST(ConcurrentInfer, WarmupReachesEveryRequest) {
+    ov::Core core;
+    PoolAdapter adapter;
+    adapter.loadModel(make_mean_model(), core, "CPU", {ov::hint::performance_mode(ov::hint::PerformanceMode::THROUGHPUT)});
+    ASSERT_EQ(adapter.poolSize(), std::max(1u, adapter.optimalRequests()));
+    adapter.warmup(make_input(7));
+    EXPECT_EQ(adapter.lastMeans(), std::vector<float>(adapter.poolSize(), 7.0f));
+}
+
+TEST(ConcurrentInfer, AdapterOutputsAreOwnedByCaller) {
+    std::shared_ptr<InferenceAdapter> adapter = make_adapter();
+    std::vector<std::vector<InferenceOutput>> outputs(THREADS);
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < THREADS; ++thread) {
+        threads.emplace_back([&, thread] {
+            for (size_t call = 0; call < CALLS; ++call) {
+                outputs[thread].push_back(adapter->infer(make_input(static_cast<int>(thread * CALLS + call) % 256)));
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    // Outputs held by callers aren't overwritten by the following calls
+    for (size_t thread = 0; thread < THREADS; ++thread) {
+        for (size_t call = 0; call < CALLS; ++call) {
+            EXPECT_EQ(outputs[thread][call].at("mean").data<const float>()[0], float((thread * CALLS + call) % 256));
+        }
+    }
+}
+
+TEST(ConcurrentInfer, AdapterReusesOutputMap) {
+    std::shared_ptr<InferenceAdapter> adapter = make_adapter();
+    InferenceOutput output;
+    adapter->infer(make_input(1), output);
+    const void* data = output.at("mean").data();
+    adapter->infer(make_input(2), output);
+    EXPECT_EQ(output.at("mean").data(), data);
+    EXPECT_EQ(output.at("mean").data<const float>()[0], 2.0f);
+}
+
+TEST(ConcurrentInfer, OneWrapperManyThreads) {
+    std::shared_ptr<InferenceAdapter> adapter = make_adapter();
+    MeanModel model{adapter};
+    model.warmup({{4, 4}});
+    std::vector<std::thread> threads;
+    std::vector<size_t> mismatches(THREADS);
+    for (size_t thread = 0; thread < THREADS; ++thread) {
+        threads.emplace_back([&, thread] {
+            for (size_t call = 0; call < CALLS; ++call) {
+                // Every thread has its own resolution, so swapped preprocessing data shows up in the result
+                int width = static_cast<int>(4 + thread), height = static_cast<int>(4 + call % 8);
+                int value = static_cast<int>(thread * 16 + call) % 256;
+                cv::Mat image(height, width, CV_8UC3, cv::Scalar::all(value));
+                auto result = model.infer(ImageInputData(image));
+                const MeanResult& mean = result->asRef<MeanResult>();
+                if (mean.mean != float(value) || mean.width != width || mean.height != height
+                        || mean.label != (value < 128 ? "dark" : "bright")) {
+                    ++mismatches[thread];
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(mismatches, std::vector<size_t>(THREADS, 0));
+}
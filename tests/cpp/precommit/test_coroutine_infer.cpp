@@ -0,0 +1,365 @@
+#include <stddef.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <opencv2/core.hpp>
+#include <openvino/openvino.hpp>
+
+#include <adapters/async_infer_workers.h>
+#include <adapters/openvino_adapter.h>
+#include <models/coroutine_infer.h>
+#include <models/image_model.h>
+#include <models/input_data.h>
+#include <models/results.h>
+
+#include "synthetic_models.h"
+
+namespace {
+std::shared_ptr<InferenceAdapter> make_adapter() {
+    ov::Core core;
+    auto adapter = std::make_shared<OpenVINOInferenceAdapter>();
+    adapter->loadModel(make_mean_model(), core, "CPU", {ov::inference_num_threads(1)});
+    return adapter;
+}
+
+struct MeanResult : public ResultBase {
+    float mean = 0.0f;
+};
+
+class MeanModel : public ImageModel {
+public:
+    using ImageModel::ImageModel;
+
+    std::unique_ptr<ResultBase> postprocess(InferenceResult& infResult) override {
+        auto result = std::make_unique<MeanResult>();
+        result->mean = infResult.getFirstOutputTensor().data<const float>()[0];
+        return result;
+    }
+
+    std::unique_ptr<MeanResult> infer(const ImageInputData& inputData) {
+        auto result = ModelBase::infer(static_cast<const InputData&>(inputData));
+        return std::unique_ptr<MeanResult>(static_cast<MeanResult*>(result.release()));
+    }
+
+protected:
+    void prepareInputsOutputs(std::shared_ptr<ov::Model>&) override {}
+};
+
+// Fire and forget coroutine
+struct Task {
+    struct promise_type {
+        Task get_return_object() {
+            return {};
+        }
+        std::suspend_never initial_suspend() {
+            return {};
+        }
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+        void return_void() {}
+        void unhandled_exception() {
+            std::terminate();
+        }
+    };
+};
+
+// What a coroutine saw after co_await
+struct Outcome {
+    std::mutex mutex;
+    std::condition_variable condition;
+    size_t finished = 0;
+    size_t correct = 0;
+    size_t cancelled = 0;
+    std::vector<std::thread::id> resumedOn;
+
+    void add(bool isCorrect, bool isCancelled) {
+        std::lock_guard<std::mutex> lock{mutex};
+        ++finished;
+        correct += isCorrect;
+        cancelled += isCancelled;
+        resumedOn.push_back(std::this_thread::get_id());
+        condition.notify_all();
+    }
+
+    void wait(size_t count) {
+        std::unique_lock<std::mutex> lock{mutex};
+        condition.wait(lock, [this, count] { return finished >= count; });
+    }
+};
+
+// Keeps every request of the pool busy until releaseAll()
+class HeldPoolAdapter : public OpenVINOInferenceAdapter {
+public:
+    void holdAll() {
+        for (uint32_t i = 0; i < getOptimalNumberOfInferRequests(); ++i) {
+            held.push_back(&acquireRequest());
+        }
+    }
+
+    void releaseAll() {
+        for (ov::InferRequest* request : held) {
+            releaseRequest(*request);
+        }
+        held.clear();
+    }
+
+private:
+    std::vector<ov::InferRequest*> held;
+};
+
+// An adapter without an asynchronous path, infer() waits until the gate is opened. It fails at once on the thread
+// which created the adapter, where it would block the executor
+class GatedAdapter : public InferenceAdapter {
+public:
+    explicit GatedAdapter(std::shared_ptr<InferenceAdapter> adapter)
+        : adapter(std::move(adapter)),
+          executorThread(std::this_thread::get_id()) {}
+
+    InferenceOutput infer(const InferenceInput& input) override {
+        if (std::this_thread::get_id() == executorThread) {
+            throw std::runtime_error("infer() runs on the executor thread");
+        }
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            ++waiting;
+            condition.notify_all();
+            if (!condition.wait_for(lock, std::chrono::seconds(10), [this] { return opened; })) {
+                throw std::runtime_error("The gate wasn't opened");
+            }
+        }
+        return adapter->infer(input);
+    }
+
+    void inferAsync(const InferenceInput& input, InferenceCallback callback) override {
+        asyncWorkers.submit(input, std::move(callback));
+    }
+
+    void open() {
+        std::lock_guard<std::mutex> lock{mutex};
+        opened = true;
+        condition.notify_all();
+    }
+
+    void waitBlocked(size_t count) {
+        std::unique_lock<std::mutex> lock{mutex};
+        condition.wait(lock, [this, count] { return waiting >= count; });
+    }
+
+    void loadModel(const std::shared_ptr<const ov::Model>& model, ov::Core& core, const std::string& device,
+                   const ov::AnyMap& compilationConfig) override {
+        adapter->loadModel(model, core, device, compilationConfig);
+    }
+    ov::PartialShape getInputShape(const std::string& inputName) const override {
+        return adapter->getInputShape(inputName);
+    }
+    std::vector<std::string> getInputNames() const override {
+        return adapter->getInputNames();
+    }
+    std::vector<std::string> getOutputNames() const override {
+        return adapter->getOutputNames();
+    }
+    const ov::AnyMap& getModelConfig() const override {
+        return adapter->getModelConfig();
+    }
+
+private:
+    std::shared_ptr<InferenceAdapter> adapter;
+    const std::thread::id executorThread;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool opened = false;
+    size_t waiting = 0;
+    AsyncInferWorkers asyncWorkers{*this};  // Must stay the last member
+};
+
+// A single-threaded executor, the test thread runs the queued continuations
+struct Executor {
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<std::coroutine_handle<>> queue;
+
+    ResumeDispatcher dispatcher() {
+        return [this](std::coroutine_handle<> handle) {
+            std::lock_guard<std::mutex> lock{mutex};
+            queue.push_back(handle);
+            condition.notify_all();
+        };
+    }
+
+    void run(size_t count) {
+        for (size_t resumed = 0; resumed < count; ++resumed) {
+            std::coroutine_handle<> handle;
+            {
+                std::unique_lock<std::mutex> lock{mutex};
+                condition.wait(lock, [this] { return !queue.empty(); });
+                handle = queue.front();
+                queue.pop_front();
+            }
+            handle.resume();
+        }
+    }
+};
+
+Task run(MeanModel& model, int value, Outcome& outcome, InferCancellation cancellation = {},
+         ResumeDispatcher dispatcher = {}) {
+    cv::Mat image(8, 8, CV_8UC3, cv::Scalar::all(value));
+    try {
+        std::unique_ptr<MeanResult> result = co_await inferAsync(model, ImageInputData(image), cancellation, dispatcher);
+        outcome.add(result->mean == float(value), false);
+    } catch (const InferenceCancelled&) {
+        outcome.add(false, true);
+    } catch (const std::exception&) {
+        outcome.add(false, false);
+    }
+}
+}
+
+TEST(CoroutineInfer, AwaitsTypedResults) {
+    std::shared_ptr<InferenceAdapter> adapter = make_adapter();
+    MeanModel model{adapter};
+    Outcome outcome;
+    constexpr size_t COUNT = 32;
+    // Every coroutine suspends, so one thread keeps all of them in flight
+    for (size_t i = 0; i < COUNT; ++i) {
+        run(model, static_cast<int>(i), outcome);
+    }
+    outcome.wait(COUNT);
+    EXPECT_EQ(outcome.correct, COUNT);
+}
+
+TEST(CoroutineInfer, ResumesThroughDispatcher) {
+    std::shared_ptr<InferenceAdapter> adapter = make_adapter();
+    MeanModel model{adapter};
+    Outcome outcome;
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<std::coroutine_handle<>> queue;
+    ResumeDispatcher dispatcher = [&](std::coroutine_handle<> handle) {
+        std::lock_guard<std::mutex> lock{mutex};
+        queue.push_back(handle);
+        condition.notify_all();
+    };
+    constexpr size_t COUNT = 4;
+    for (size_t i = 0; i < COUNT; ++i) {
+        run(model, static_cast<int>(i), outcome, {}, dispatcher);
+    }
+    // The test thread stands for the executor
+    for (size_t resumed = 0; resumed < COUNT; ++resumed) {
+        std::coroutine_handle<> handle;
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            condition.wait(lock, [&] { return !queue.empty(); });
+            handle = queue.front();
+            queue.pop_front();
+        }
+        handle.resume();
+    }
+    EXPECT_EQ(outcome.correct, COUNT);
+    EXPECT_EQ(outcome.resumedOn, std::vector<std::thread::id>(COUNT, std::this_thread::get_id()));
+}
+
+TEST(CoroutineInfer, CancellationDropsResult) {
+    std::shared_ptr<InferenceAdapter> adapter = make_adapter();
+    MeanModel model{adapter};
+    Outcome outcome;
+    InferCancellation cancelled;
+    cancelled.cancel();
+    run(model, 1, outcome, cancelled);
+    EXPECT_EQ(outcome.cancelled, 1u);
+
+    InferCancellation cancellation;
+    run(model, 2, outcome, cancellation);
+    cancellation.cancel();
+    outcome.wait(2);
+    // The inference may finish before cancel()
+    EXPECT_EQ(outcome.cancelled + outcome.correct, 2u);
+    // Outlives the dropped result
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+}
+
+TEST(CoroutineInfer, MoreAwaitsThanRequestsDoNotBlockExecutor) {
+    ov::Core core;
+    auto pool = std::make_shared<HeldPoolAdapter>();
+    pool->loadModel(make_mean_model(), core, "CPU", {ov::inference_num_threads(1)});
+    std::shared_ptr<InferenceAdapter> adapter = pool;
+    MeanModel model{adapter};
+    Outcome outcome;
+    Executor executor;
+    // Every request is busy, so all awaits wait for the pool. The executor thread must get through all of them
+    pool->holdAll();
+    const size_t count = 4 * pool->getOptimalNumberOfInferRequests() + 4;
+    for (size_t i = 0; i < count; ++i) {
+        run(model, static_cast<int>(i % 256), outcome, {}, executor.dispatcher());
+    }
+    ASSERT_EQ(outcome.finished, 0u);
+    pool->releaseAll();
+    executor.run(count);
+    EXPECT_EQ(outcome.correct, count);
+}
+
+TEST(CoroutineInfer, AdapterWithoutAsyncPathDoesNotBlockExecutor) {
+    auto gated = std::make_shared<GatedAdapter>(make_adapter());
+    std::shared_ptr<InferenceAdapter> adapter = gated;
+    MeanModel model{adapter};
+    Outcome outcome;
+    Executor executor;
+    constexpr size_t COUNT = 4;
+    // A synchronous fallback would run infer() on this thread and complete every await before it suspends
+    for (size_t i = 0; i < COUNT; ++i) {
+        run(model, static_cast<int>(i), outcome, {}, executor.dispatcher());
+    }
+    ASSERT_EQ(outcome.finished, 0u);
+    gated->open();
+    executor.run(COUNT);
+    EXPECT_EQ(outcome.correct, COUNT);
+}
+
+TEST(CoroutineInfer, DestroyedAdapterFailsQueuedCalls) {
+    auto gated = std::make_unique<GatedAdapter>(make_adapter());
+    GatedAdapter* destroyed = gated.get();
+    const size_t running = AsyncInferWorkers::maxThreads();
+    const size_t queued = 4;
+    std::mutex mutex;
+    std::condition_variable condition;
+    size_t succeeded = 0;
+    size_t failed = 0;
+    cv::Mat image(8, 8, CV_8UC3, cv::Scalar::all(1));
+    InferenceInput input{{"image", ov::Tensor(ov::element::u8, {1, 8, 8, 3}, image.data)}};
+    for (size_t i = 0; i < running + queued; ++i) {
+        gated->inferAsync(input, [&](InferenceOutput, std::exception_ptr error) {
+            std::lock_guard<std::mutex> lock{mutex};
+            ++(error ? failed : succeeded);
+            condition.notify_all();
+        });
+    }
+    // Every worker is inside infer(), the rest of the calls stay queued
+    gated->waitBlocked(running);
+    std::thread destroyer([&gated] {
+        gated.reset();
+    });
+    bool queuedFailed;
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        queuedFailed = condition.wait_for(lock, std::chrono::seconds(10), [&] { return failed == queued; });
+    }
+    // The destructor waits for the running calls, its members are still alive
+    destroyed->open();
+    destroyer.join();
+    EXPECT_TRUE(queuedFailed);
+    EXPECT_EQ(succeeded, running);
+    EXPECT_EQ(failed, queued);
+}
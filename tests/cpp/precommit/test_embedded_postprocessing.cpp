@@ -0,0 +1,121 @@
+#include <stddef.h>
+
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <opencv2/core.hpp>
+#include <openvino/openvino.hpp>
+
+#include <models/classification_model.h>
+#include <models/input_data.h>
+#include <models/results.h>
+
+#include "synthetic_models.h"
+
+namespace {
+const std::string TMP_MODEL_FILE = "tmp_embedded_postprocessing.xml";
+const std::string TMP_SAVED_MODEL_FILE = "tmp_embedded_postprocessing_saved.xml";
+
+const std::string HIERARCHICAL_CONFIG = R"({
+    "cls_heads_info": {
+        "num_multiclass_heads": 2,
+        "num_multilabel_classes": 2,
+        "num_single_label_classes": 4,
+        "label_to_idx": {"a": 0, "b": 1, "c": 2, "d": 3, "e": 4, "f": 5},
+        "all_groups": [["a", "b"], ["c", "d"], ["e"], ["f"]],
+        "head_idx_to_logits_range": {"0": [0, 2], "1": [2, 4]}
+    },
+    "label_tree_edges": []
+})";
+
+cv::Mat make_image(int seed) {
+    cv::Mat image(8, 8, CV_8UC3);
+    cv::theRNG().state = seed;
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(255));
+    return image;
+}
+
+void expect_same(const ClassificationResult& expected, const ClassificationResult& actual) {
+    ASSERT_EQ(actual.topLabels.size(), expected.topLabels.size());
+    for (size_t i = 0; i < expected.topLabels.size(); ++i) {
+        EXPECT_EQ(actual.topLabels[i].id, expected.topLabels[i].id);
+        EXPECT_EQ(actual.topLabels[i].label, expected.topLabels[i].label);
+        EXPECT_NEAR(actual.topLabels[i].score, expected.topLabels[i].score, 1e-5f);
+    }
+    ASSERT_EQ(actual.raw_scores.get_size(), expected.raw_scores.get_size());
+    const float* expectedPtr = expected.raw_scores.data<const float>();
+    const float* actualPtr = actual.raw_scores.data<const float>();
+    for (size_t i = 0; i < expected.raw_scores.get_size(); ++i) {
+        EXPECT_NEAR(actualPtr[i], expectedPtr[i], 1e-5f);
+    }
+}
+
+class EmbeddedPostprocessingTest : public testing::TestWithParam<ov::AnyMap> {
+protected:
+    void SetUp() override {
+        ov::serialize(make_classification_model({"a", "b", "c", "d", "e", "f"}, GetParam()), TMP_MODEL_FILE);
+    }
+
+    void TearDown() override {
+        for (std::string fileName : {TMP_MODEL_FILE, TMP_SAVED_MODEL_FILE}) {
+            std::remove(fileName.c_str());
+            std::remove(fileName.replace(fileName.end() - 4, fileName.end(), ".bin").c_str());
+        }
+    }
+};
+}
+
+TEST_P(EmbeddedPostprocessingTest, MatchesHostPostprocessing) {
+    auto host = ClassificationModel::create_model(TMP_MODEL_FILE, {{"output_raw_scores", true}}, true, "CPU");
+    auto embedded = ClassificationModel::create_model(TMP_MODEL_FILE,
+        {{"output_raw_scores", true}, {"embed_postprocessing", true}}, true, "CPU");
+    EXPECT_LE(host->getModel()->outputs().size(), 5u);
+    EXPECT_GT(embedded->getModel()->outputs().size(), host->getModel()->outputs().size());
+
+    size_t labelled = 0;
+    for (int seed = 0; seed < 8; ++seed) {
+        cv::Mat image = make_image(seed);
+        std::unique_ptr<ClassificationResult> expected = host->infer(image);
+        std::unique_ptr<ClassificationResult> actual = embedded->infer(image);
+        expect_same(*expected, *actual);
+        labelled += expected->topLabels.size();
+    }
+    EXPECT_GT(labelled, 0u);
+}
+
+TEST_P(EmbeddedPostprocessingTest, SavedModelMatchesHostPostprocessing) {
+    auto host = ClassificationModel::create_model(TMP_MODEL_FILE, {{"output_raw_scores", true}}, true, "CPU");
+    auto embedded = ClassificationModel::create_model(TMP_MODEL_FILE,
+        {{"output_raw_scores", true}, {"embed_postprocessing", true}}, false, "CPU");
+    ov::serialize(embedded->getModel(), TMP_SAVED_MODEL_FILE);
+    auto restored = ClassificationModel::create_model(TMP_SAVED_MODEL_FILE, {}, true, "CPU");
+
+    for (int seed = 0; seed < 8; ++seed) {
+        cv::Mat image = make_image(seed);
+        expect_same(*host->infer(image), *restored->infer(image));
+    }
+}
+
+TEST_P(EmbeddedPostprocessingTest, SavedModelRejectsThresholdOverride) {
+    auto embedded = ClassificationModel::create_model(TMP_MODEL_FILE, {{"embed_postprocessing", true}}, false, "CPU");
+    ov::serialize(embedded->getModel(), TMP_SAVED_MODEL_FILE);
+
+    EXPECT_THROW(ClassificationModel::create_model(TMP_SAVED_MODEL_FILE, {{"confidence_threshold", 0.9f}}, false, "CPU"),
+                 std::runtime_error);
+    EXPECT_NO_THROW(ClassificationModel::create_model(TMP_SAVED_MODEL_FILE, {{"confidence_threshold", 0.5f}}, false, "CPU"));
+}
+
+TEST_P(EmbeddedPostprocessingTest, HostModelAcceptsThresholdOverride) {
+    auto host = ClassificationModel::create_model(TMP_MODEL_FILE, {}, false, "CPU");
+    ov::serialize(host->getModel(), TMP_SAVED_MODEL_FILE);
+
+    EXPECT_NO_THROW(ClassificationModel::create_model(TMP_SAVED_MODEL_FILE, {{"confidence_threshold", 0.9f}}, false, "CPU"));
+}
+
+INSTANTIATE_TEST_SUITE_P(ClassificationTestInstance, EmbeddedPostprocessingTest, testing::Values(
+    ov::AnyMap{{"multilabel", true}},
+    ov::AnyMap{{"hierarchical", true}, {"hierarchical_config", HIERARCHICAL_CONFIG}}));
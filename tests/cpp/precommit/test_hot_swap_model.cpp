@@ -0,0 +1,67 @@
+#include <stddef.h>
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <openvino/openvino.hpp>
+
+#include <models/hot_swap_model.h>
+
+namespace {
+// Stands for a wrapper, HotSwapModel only needs warmup()
+struct FakeModel {
+    explicit FakeModel(int id) : id(id) {}
+
+    void warmup(const std::vector<ov::Shape>& shapes) {
+        warmedShapes = shapes.size();
+        warmedUp = true;
+    }
+
+    int id;
+    size_t warmedShapes = 0;
+    bool warmedUp = false;
+};
+
+HotSwapModel<FakeModel>::Factory make_factory(int id) {
+    return [id] { return std::unique_ptr<FakeModel>(new FakeModel(id)); };
+}
+}
+
+TEST(HotSwapModel, ServesWarmedUpVersion) {
+    HotSwapModel<FakeModel> handle(make_factory(0), {{224, 224}, {480, 640}});
+    std::shared_ptr<FakeModel> model = handle.acquire();
+    EXPECT_EQ(model->id, 0);
+    EXPECT_TRUE(model->warmedUp);
+    EXPECT_EQ(model->warmedShapes, 2u);
+    EXPECT_EQ(handle.getVersion(), 0u);
+}
+
+TEST(HotSwapModel, DrainsPreviousVersion) {
+    HotSwapModel<FakeModel> handle(make_factory(0));
+    std::shared_ptr<FakeModel> inflight = handle.acquire();
+    std::future<HotSwapModel<FakeModel>::SwapReport> swapped = handle.swapAsync(make_factory(1));
+    while (handle.getVersion() != 1) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(handle.acquire()->id, 1);
+    EXPECT_EQ(inflight->id, 0);
+    EXPECT_EQ(swapped.wait_for(std::chrono::milliseconds(20)), std::future_status::timeout);
+    inflight.reset();
+    HotSwapModel<FakeModel>::SwapReport report = swapped.get();
+    EXPECT_EQ(report.version, 1u);
+    EXPECT_GE(report.drainMs, 20.0);
+    EXPECT_GE(report.peakMemoryBytes, report.memoryAfterBytes);
+}
+
+TEST(HotSwapModel, KeepsServingWhenLoadFails) {
+    HotSwapModel<FakeModel> handle(make_factory(0));
+    EXPECT_THROW(handle.swap([]() -> std::unique_ptr<FakeModel> { throw std::runtime_error("broken model"); }),
+                 std::runtime_error);
+    EXPECT_EQ(handle.getVersion(), 0u);
+    EXPECT_EQ(handle.acquire()->id, 0);
+}
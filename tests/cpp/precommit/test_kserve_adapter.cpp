@@ -0,0 +1,261 @@
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <stddef.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include <gtest/gtest.h>
+
+#include <adapters/kserve_adapter.h>
+
+#include "synthetic_models.h"
+
+namespace {
+// In-process stand-in for a KServe v2 server. Serves "double" model which multiplies a FP32 tensor by 2.
+// A stalled server answers metadata requests only
+class StandInServer {
+public:
+    explicit StandInServer(bool closeAfterResponse = false, bool stalled = false)
+        : closeAfterResponse(closeAfterResponse), stalled(stalled) {
+        listener = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        EXPECT_EQ(bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+        EXPECT_EQ(listen(listener, 16), 0);
+        socklen_t length = sizeof(address);
+        getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length);
+        port = ntohs(address.sin_port);
+        acceptor = std::thread([this] { acceptLoop(); });
+    }
+
+    ~StandInServer() {
+        stopping = true;
+        shutdown(listener, SHUT_RDWR);
+        close(listener);
+        acceptor.join();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    std::string url(const std::string& model = "double") const {
+        return "127.0.0.1:" + std::to_string(port) + "/models/" + model;
+    }
+
+    std::atomic<size_t> accepted{0};
+
+private:
+    int listener;
+    int port;
+    bool closeAfterResponse;
+    bool stalled;
+    std::atomic<bool> stopping{false};
+    std::thread acceptor;
+    std::vector<std::thread> workers;
+
+    void acceptLoop() {
+        while (!stopping) {
+            int client = accept(listener, nullptr, nullptr);
+            if (client < 0) {
+                return;
+            }
+            ++accepted;
+            workers.emplace_back([this, client] { serve(client); });
+        }
+    }
+
+    static bool readLine(int client, std::string& buffer, std::string& line) {
+        size_t pos;
+        while ((pos = buffer.find("\r\n")) == std::string::npos) {
+            char chunk[4096];
+            ssize_t received = recv(client, chunk, sizeof(chunk), 0);
+            if (received <= 0) {
+                return false;
+            }
+            buffer.append(chunk, received);
+        }
+        line = buffer.substr(0, pos);
+        buffer.erase(0, pos + 2);
+        return true;
+    }
+
+    static bool readBody(int client, std::string& buffer, size_t size) {
+        while (buffer.size() < size) {
+            char chunk[4096];
+            ssize_t received = recv(client, chunk, sizeof(chunk), 0);
+            if (received <= 0) {
+                return false;
+            }
+            buffer.append(chunk, received);
+        }
+        return true;
+    }
+
+    static void respond(int client, int status, const std::string& json, const std::string& binary = {}) {
+        std::string response = "HTTP/1.1 " + std::to_string(status) + " X\r\nContent-Length: "
+            + std::to_string(json.size() + binary.size()) + "\r\n";
+        if (!binary.empty()) {
+            response += "Inference-Header-Content-Length: " + std::to_string(json.size()) + "\r\n";
+        }
+        response += "\r\n" + json + binary;
+        send(client, response.data(), response.size(), MSG_NOSIGNAL);
+    }
+
+    void serve(int client) {
+        std::string buffer;
+        std::string line;
+        while (readLine(client, buffer, line)) {
+            std::string requestLine = line;
+            size_t contentLength = 0;
+            size_t headerLength = 0;
+            while (readLine(client, buffer, line) && !line.empty()) {
+                if (line.rfind("Content-Length:", 0) == 0) {
+                    contentLength = std::stoul(line.substr(15));
+                } else if (line.rfind("Inference-Header-Content-Length:", 0) == 0) {
+                    headerLength = std::stoul(line.substr(32));
+                }
+            }
+            if (!readBody(client, buffer, contentLength)) {
+                break;
+            }
+            std::string body = buffer.substr(0, contentLength);
+            buffer.erase(0, contentLength);
+
+            if (requestLine == "GET /v2/models/double HTTP/1.1") {
+                nlohmann::json metadata = {
+                    {"name", "double"},
+                    {"inputs", {{{"name", "input"}, {"datatype", "FP32"}, {"shape", {1, -1}}}}},
+                    {"outputs", {{{"name", "output"}, {"datatype", "FP32"}, {"shape", {1, -1}}}}},
+                    {"rt_info", {{"model_info", {{"model_type", "Classification"}, {"labels", "cat dog"}}}}},
+                };
+                respond(client, 200, metadata.dump());
+            } else if (requestLine == "POST /v2/models/double/infer HTTP/1.1") {
+                if (stalled) {
+                    continue;
+                }
+                nlohmann::json request = nlohmann::json::parse(body.substr(0, headerLength));
+                const nlohmann::json& input = request["inputs"][0];
+                std::string data = body.substr(headerLength);
+                float* values = reinterpret_cast<float*>(&data[0]);
+                for (size_t i = 0; i < data.size() / sizeof(float); ++i) {
+                    values[i] *= 2;
+                }
+                nlohmann::json response = {{"outputs", {{
+                    {"name", "output"},
+                    {"datatype", "FP32"},
+                    {"shape", input["shape"]},
+                    {"parameters", {{"binary_data_size", data.size()}}},
+                }}}};
+                respond(client, 200, response.dump(), data);
+            } else {
+                respond(client, 404, R"({"error": "Model with requested name is not found"})");
+            }
+            if (closeAfterResponse) {
+                break;
+            }
+        }
+        close(client);
+    }
+};
+}
+
+TEST(KServeAdapter, ReadsMetadata) {
+    StandInServer server;
+    KServeInferenceAdapter adapter{server.url()};
+    EXPECT_EQ(adapter.getInputNames(), std::vector<std::string>{"input"});
+    EXPECT_EQ(adapter.getOutputNames(), std::vector<std::string>{"output"});
+    EXPECT_TRUE(adapter.getInputShape("input")[1].is_dynamic());
+    EXPECT_EQ(adapter.getModelConfig().at("model_type").as<std::string>(), "Classification");
+    EXPECT_EQ(adapter.getModelConfig().at("labels").as<std::string>(), "cat dog");
+}
+
+TEST(KServeAdapter, UnknownModelThrows) {
+    StandInServer server;
+    EXPECT_THROW(KServeInferenceAdapter{server.url("missing")}, std::runtime_error);
+}
+
+TEST(KServeAdapter, InfersBinaryTensors) {
+    StandInServer server;
+    KServeInferenceAdapter adapter{server.url()};
+    check_double_output(adapter.infer(make_double_input(1000, 1.0f)), 1000, 1.0f);
+
+    InferenceOutput output;
+    adapter.infer(make_double_input(10, 3.0f), output);
+    const void* data = output.at("output").data();
+    adapter.infer(make_double_input(10, 5.0f), output);
+    EXPECT_EQ(output.at("output").data(), data);
+    check_double_output(output, 10, 5.0f);
+}
+
+TEST(KServeAdapter, ConcurrentRequestsShareConnectionPool) {
+    StandInServer server;
+    constexpr size_t maxConnections = 2;
+    KServeInferenceAdapter adapter{server.url(), maxConnections};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 8; ++t) {
+        threads.emplace_back([&adapter, t] {
+            for (size_t i = 0; i < 20; ++i) {
+                check_double_output(adapter.infer(make_double_input(64, float(t * 100 + i))), 64, float(t * 100 + i));
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_LE(server.accepted.load(), maxConnections);
+}
+
+TEST(KServeAdapter, PipelinesRequests) {
+    StandInServer server;
+    KServeInferenceAdapter adapter{server.url()};
+    std::vector<InferenceInput> inputs;
+    for (size_t i = 0; i < 32; ++i) {
+        inputs.push_back(make_double_input(100000, float(i)));  // Exceeds socket buffers
+    }
+    std::vector<InferenceOutput> outputs = adapter.inferPipelined(inputs);
+    ASSERT_EQ(outputs.size(), inputs.size());
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        check_double_output(outputs[i], 100000, float(i));
+    }
+    EXPECT_EQ(server.accepted.load(), 1u);
+}
+
+TEST(KServeAdapter, PipelinedUnsupportedInputThrows) {
+    StandInServer server;
+    KServeInferenceAdapter adapter{server.url()};
+    std::vector<InferenceInput> inputs{make_double_input(10, 0.0f), {{"input", ov::Tensor(ov::element::u4, {1, 10})}}};
+    EXPECT_THROW(adapter.inferPipelined(inputs), std::runtime_error);
+    check_double_output(adapter.infer(make_double_input(10, 1.0f)), 10, 1.0f);
+}
+
+TEST(KServeAdapter, RetriesClosedKeepAliveConnection) {
+    bool closeAfterResponse = true;
+    StandInServer server{closeAfterResponse};
+    KServeInferenceAdapter adapter{server.url()};
+    check_double_output(adapter.infer(make_double_input(10, 0.0f)), 10, 0.0f);
+    check_double_output(adapter.infer(make_double_input(10, 1.0f)), 10, 1.0f);
+}
+
+TEST(KServeAdapter, StalledServerTimesOut) {
+    bool closeAfterResponse = false, stalled = true;
+    StandInServer server{closeAfterResponse, stalled};
+    KServeInferenceAdapter adapter{server.url(), 1, std::chrono::milliseconds(200)};
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_THROW(adapter.infer(make_double_input(10, 0.0f)), std::runtime_error);
+    EXPECT_THROW(adapter.inferPipelined({make_double_input(10, 0.0f), make_double_input(10, 1.0f)}), std::runtime_error);
+    // The request over the reused connection is retried once on a new one
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+}
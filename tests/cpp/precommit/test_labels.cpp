@@ -0,0 +1,115 @@
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <opencv2/core.hpp>
+#include <openvino/openvino.hpp>
+
+#include <adapters/openvino_adapter.h>
+#include <models/image_model.h>
+#include <models/input_data.h>
+#include <models/label_set.h>
+#include <models/results.h>
+
+#include "synthetic_models.h"
+
+namespace {
+// Labels an image as dark or bright with an id the model doesn't know for a uniform image
+class BrightnessModel : public ImageModel {
+public:
+    using ImageModel::ImageModel;
+
+    std::unique_ptr<ResultBase> postprocess(InferenceResult& infResult) override {
+        auto result = std::make_unique<DetectionResult>();
+        float mean = infResult.getFirstOutputTensor().data<const float>()[0];
+        DetectedObject obj;
+        obj.labelID = mean < 128 ? 0 : 1;
+        obj.label = getLabel(obj.labelID);
+        obj.confidence = 1.0f;
+        result->objects.push_back(obj);
+        obj.labelID = 7;
+        obj.label = getLabel(obj.labelID);
+        result->objects.push_back(obj);
+        result->labelSet = getLabelSet();
+        return result;
+    }
+
+protected:
+    void prepareInputsOutputs(std::shared_ptr<ov::Model>&) override {}
+};
+}
+
+// Copying a label must not touch a reference count shared by all streams of a model
+static_assert(std::is_trivially_copyable<Label>::value, "Label must be a plain view");
+static_assert(sizeof(Label) == sizeof(std::string_view), "Label must be a plain view");
+
+TEST(Labels, CopiesLiveWithLabelSetOfResult) {
+    auto labelSet = std::make_shared<const LabelSet>(std::vector<std::string>{"cat", "dog"});
+    auto result = std::make_unique<DetectionResult>();
+    DetectedObject obj;
+    obj.labelID = 1;
+    obj.label = (*labelSet)[1];
+    result->objects.push_back(obj);
+    result->objects.push_back(obj);
+    result->objects.back().label = labelSet->intern("hierarchical/dog");
+    result->labelSet = labelSet;
+    labelSet.reset();
+
+    std::vector<DetectedObject> copies = result->objects;
+    std::shared_ptr<const LabelSet> kept = result->labelSet;
+    std::string name = copies[0].label;
+    result.reset();
+    EXPECT_EQ(copies[0].label, "dog");
+    EXPECT_EQ(copies[1].label, "hierarchical/dog");
+    kept.reset();
+    EXPECT_EQ(name, "dog");
+}
+
+TEST(Labels, StringCompatibility) {
+    auto labelSet = std::make_shared<const LabelSet>(std::vector<std::string>{"cat"});
+    ClassificationResult::Classification classification{0, (*labelSet)[0], 0.5f};
+    std::string copy = classification.label;
+    std::string_view view = classification.label;
+    EXPECT_EQ(copy, "cat");
+    EXPECT_EQ(view, "cat");
+    EXPECT_EQ(std::string(classification.label), "cat");
+    EXPECT_TRUE(classification.label == std::string("cat"));
+    EXPECT_TRUE(classification.label != "dog");
+    EXPECT_EQ((*labelSet)[3], "Label #3");
+}
+
+TEST(Labels, ContoursOutliveObjects) {
+    auto labelSet = std::make_shared<const LabelSet>(std::vector<std::string>{"person"});
+    std::vector<Contour> contours;
+    {
+        SegmentedObject obj;
+        obj.labelID = 0;
+        obj.label = (*labelSet)[0];
+        obj.confidence = 0.75f;
+        obj.mask = cv::Mat::zeros(16, 16, CV_8UC1);
+        obj.mask(cv::Rect(4, 4, 6, 6)).setTo(1);
+        contours = getContours({obj});
+    }
+    ASSERT_EQ(contours.size(), 1u);
+    EXPECT_EQ(contours[0].label, "person");
+}
+
+TEST(Labels, ResultsOutliveModel) {
+    std::unique_ptr<ResultBase> result;
+    {
+        ov::Core core;
+        std::shared_ptr<InferenceAdapter> adapter = std::make_shared<OpenVINOInferenceAdapter>();
+        adapter->loadModel(make_mean_model(), core, "CPU");
+        BrightnessModel model{adapter};
+        result = model.infer(ImageInputData(cv::Mat(4, 4, CV_8UC3, cv::Scalar::all(200))));
+    }
+    const DetectionResult& detections = result->asRef<DetectionResult>();
+    ASSERT_EQ(detections.objects.size(), 2u);
+    EXPECT_EQ(detections.objects[0].label, "bright");
+    EXPECT_EQ(detections.objects[1].label, "Label #7");
+}
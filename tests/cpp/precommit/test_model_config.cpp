@@ -8,6 +8,7 @@
 #include <string>
 #include <fstream>
 #include <cstdio>
+#include <cstring>
 
 #include <nlohmann/json.hpp>
 
@@ -162,6 +163,99 @@ TEST_P(ClassificationModelParameterizedTestSaveLoad, TestClassificationCorrectne
     EXPECT_EQ(result_restored[0].score, result[0].score);
 }
 
+TEST_P(ClassificationModelParameterizedTestSaveLoad, TestClassificationCompilePropertiesAfterSaveLoad) {
+    auto model_path = string_format(MODEL_PATH_TEMPLATE, GetParam().name.c_str(), GetParam().name.c_str());
+    bool preload = true;
+    ov::AnyMap configuration = {{"PERFORMANCE_HINT", std::string{"THROUGHPUT"}}, {"NUM_STREAMS", std::string{"2"}}};
+    auto model = ClassificationModel::create_model(DATA_DIR + "/" + model_path, configuration, preload, "CPU");
+
+    auto ov_model = model->getModel();
+    EXPECT_EQ(ov_model->get_rt_info<std::string>("model_info", "PERFORMANCE_HINT"), "THROUGHPUT");
+    EXPECT_EQ(ov_model->get_rt_info<std::string>("model_info", "NUM_STREAMS"), "2");
+    ov::serialize(ov_model, TMP_MODEL_FILE);
+
+    auto model_restored = ClassificationModel::create_model(TMP_MODEL_FILE, {{"NUM_STREAMS", std::string{"1"}}}, preload, "CPU");
+    const ov::AnyMap& restored = model_restored->getCompilationConfig();
+    EXPECT_EQ(restored.at("PERFORMANCE_HINT").as<std::string>(), "THROUGHPUT");
+    EXPECT_EQ(restored.at("NUM_STREAMS").as<std::string>(), "1");
+}
+
+TEST_P(ClassificationModelParameterizedTestSaveLoad, TestClassificationCompilePropertiesOfOtherDevice) {
+    cv::Mat image = cv::imread(DATA_DIR + "/" + IMAGE_PATH);
+    if (!image.data) {
+        throw std::runtime_error{"Failed to read the image"};
+    }
+
+    auto model_path = string_format(MODEL_PATH_TEMPLATE, GetParam().name.c_str(), GetParam().name.c_str());
+    // A property tuned for GPU is kept in model_info, but CPU doesn't support it
+    ov::AnyMap configuration = {{"NUM_STREAMS", std::string{"1"}}};
+    auto model = ClassificationModel::create_model(DATA_DIR + "/" + model_path, configuration, false, "CPU");
+    ov::Core core;
+    ASSERT_NO_THROW(model->load(core, "CPU", {{"GPU_HOST_TASK_PRIORITY", std::string{"HIGH"}}}));
+    EXPECT_EQ(model->getModel()->get_rt_info<std::string>("model_info", "GPU_HOST_TASK_PRIORITY"), "HIGH");
+    EXPECT_EQ(model->getModel()->get_rt_info<std::string>("model_info", "NUM_STREAMS"), "1");
+    EXPECT_GT(model->infer(image)->topLabels.size(), 0);
+}
+
+TEST_P(ClassificationModelParameterizedTest, TestClassificationWarmup) {
+    cv::Mat image = cv::imread(DATA_DIR + "/" + IMAGE_PATH);
+    if (!image.data) {
+        throw std::runtime_error{"Failed to read the image"};
+    }
+
+    auto model_path = string_format(MODEL_PATH_TEMPLATE, GetParam().name.c_str(), GetParam().name.c_str());
+    bool preload = true;
+    auto model = ClassificationModel::create_model(DATA_DIR + "/" + model_path, {}, preload, "CPU");
+    EXPECT_FALSE(model->isWarmedUp());
+    model->warmup({{size_t(image.rows), size_t(image.cols)}, {1080, 1920, 3}});
+    EXPECT_TRUE(model->isWarmedUp());
+    EXPECT_GT(model->infer(image)->topLabels.size(), 0);
+    ov::Core core;
+    model->load(core, "CPU");
+    EXPECT_FALSE(model->isWarmedUp());
+}
+
+TEST_P(ClassificationModelParameterizedTest, TestClassificationLoadingOptions) {
+    cv::Mat image = cv::imread(DATA_DIR + "/" + IMAGE_PATH);
+    if (!image.data) {
+        throw std::runtime_error{"Failed to read the image"};
+    }
+
+    auto model_path = string_format(MODEL_PATH_TEMPLATE, GetParam().name.c_str(), GetParam().name.c_str());
+    bool preload = true;
+    auto mapped = ClassificationModel::create_model(DATA_DIR + "/" + model_path, {}, preload, "CPU");
+    auto copied = ClassificationModel::create_model(DATA_DIR + "/" + model_path,
+        {{"mmap_weights", "False"}, {"cache_dir", ::testing::TempDir()}}, preload, "CPU");
+    // Loading options aren't properties of the model
+    EXPECT_FALSE(copied->getModel()->has_rt_info("model_info", "mmap_weights"));
+    EXPECT_EQ(mapped->infer(image)->topLabels.front().id, copied->infer(image)->topLabels.front().id);
+}
+
+TEST_P(ClassificationModelParameterizedTestSaveLoad, TestClassificationWeightsCopiedWithoutMmap) {
+    auto model_path = string_format(MODEL_PATH_TEMPLATE, GetParam().name.c_str(), GetParam().name.c_str());
+    ov::Core core;
+    std::shared_ptr<ov::Model> original = core.read_model(DATA_DIR + "/" + model_path);
+    ov::serialize(original, TMP_MODEL_FILE);
+    ov::Core copyCore;
+    std::shared_ptr<ov::Model> copied = ModelBase::readModel(copyCore, TMP_MODEL_FILE, {{"mmap_weights", false}});
+    // Weights read into process memory don't depend on the file anymore
+    std::string binFile = TMP_MODEL_FILE;
+    binFile.replace(binFile.end() - 4, binFile.end(), ".bin");
+    std::ofstream{binFile, std::ios::binary | std::ios::trunc};
+
+    ov::Tensor input(original->input().get_element_type(), original->input().get_shape());
+    std::memset(input.data(), 0, input.get_byte_size());
+    ov::InferRequest expected = core.compile_model(original, "CPU").create_infer_request();
+    ov::InferRequest actual = copyCore.compile_model(copied, "CPU").create_infer_request();
+    expected.set_input_tensor(input);
+    actual.set_input_tensor(input);
+    expected.infer();
+    actual.infer();
+    ASSERT_EQ(actual.get_output_tensor().get_byte_size(), expected.get_output_tensor().get_byte_size());
+    EXPECT_EQ(std::memcmp(actual.get_output_tensor().data(), expected.get_output_tensor().data(),
+                          expected.get_output_tensor().get_byte_size()), 0);
+}
+
 TEST_P(SSDModelParameterizedTest, TestDetectionDefaultConfig) {
     auto model_path = string_format(MODEL_PATH_TEMPLATE, GetParam().name.c_str(), GetParam().name.c_str());
     bool preload = true;
@@ -0,0 +1,138 @@
+#include <stddef.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <opencv2/core.hpp>
+#include <openvino/openvino.hpp>
+
+#include <adapters/batching_adapter.h>
+#include <adapters/openvino_adapter.h>
+#include <adapters/residency_manager.h>
+#include <adapters/sharded_adapter.h>
+#include <models/classification_model.h>
+#include <models/input_data.h>
+#include <models/results.h>
+
+#include "synthetic_models.h"
+
+namespace {
+const std::string TMP_MODEL_FILE = "tmp_remove_xai_outputs.xml";
+
+std::shared_ptr<ov::Model> make_model(bool remove_xai_outputs) {
+    return make_xai_classification_model({"a", "b", "c", "d"}, {{"remove_xai_outputs", remove_xai_outputs}});
+}
+
+InferenceInput make_input() {
+    ov::Tensor tensor(ov::element::f32, ov::Shape{1, 3, 8, 8});
+    std::fill_n(tensor.data<float>(), tensor.get_size(), 0.5f);
+    return {{"image", tensor}};
+}
+
+double median_latency_us(InferenceAdapter& adapter, const InferenceInput& input) {
+    InferenceOutput output;
+    adapter.infer(input, output);
+    std::vector<double> latencies;
+    for (int i = 0; i < 50; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        adapter.infer(input, output);
+        latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::nth_element(latencies.begin(), latencies.begin() + latencies.size() / 2, latencies.end());
+    return latencies[latencies.size() / 2];
+}
+
+class RemoveXaiOutputsTest : public testing::Test {
+protected:
+    void TearDown() override {
+        std::string fileName = TMP_MODEL_FILE;
+        std::remove(fileName.c_str());
+        std::remove(fileName.replace(fileName.end() - 4, fileName.end(), ".bin").c_str());
+    }
+};
+}
+
+TEST_F(RemoveXaiOutputsTest, AdapterDoesNotReturnXaiOutputs) {
+    ov::Core core;
+    OpenVINOInferenceAdapter adapter;
+    adapter.loadModel(make_model(true), core, "CPU");
+    EXPECT_EQ(adapter.getOutputNames(), std::vector<std::string>{"logits"});
+
+    InferenceOutput output = adapter.infer(make_input());
+    EXPECT_EQ(output.size(), 1u);
+    EXPECT_EQ(output.count("saliency_map"), 0u);
+    EXPECT_EQ(output.count("feature_vector"), 0u);
+
+    OpenVINOInferenceAdapter full;
+    full.loadModel(make_model(false), core, "CPU");
+    output = full.infer(make_input());
+    EXPECT_EQ(output.count("saliency_map"), 1u);
+    EXPECT_EQ(output.count("feature_vector"), 1u);
+}
+
+TEST_F(RemoveXaiOutputsTest, EveryCompilingAdapterPrunesXaiOutputs) {
+    ov::Core core;
+    std::vector<std::shared_ptr<InferenceAdapter>> adapters{
+        std::make_shared<BatchingInferenceAdapter>(),
+        std::make_shared<ShardedInferenceAdapter>(std::vector<ShardedInferenceAdapter::Shard>{{}, {}}),
+        std::make_shared<ResidentInferenceAdapter>(std::make_shared<ResidencyManager>(size_t(1) << 40)),
+    };
+    for (const std::shared_ptr<InferenceAdapter>& adapter : adapters) {
+        adapter->loadModel(make_model(true), core, "CPU");
+        EXPECT_EQ(adapter->getOutputNames(), std::vector<std::string>{"logits"});
+        InferenceOutput output = adapter->infer(make_input());
+        EXPECT_EQ(output.size(), 1u);
+        EXPECT_EQ(output.count("logits"), 1u);
+    }
+}
+
+TEST_F(RemoveXaiOutputsTest, WrapperDoesNotReceiveXaiOutputs) {
+    ov::serialize(make_model(false), TMP_MODEL_FILE);
+    cv::Mat image(8, 8, CV_8UC3, cv::Scalar::all(100));
+
+    auto model = ClassificationModel::create_model(TMP_MODEL_FILE, {{"remove_xai_outputs", true}}, true, "CPU");
+    std::vector<std::string> outputNames = model->getInferenceAdapter()->getOutputNames();
+    EXPECT_EQ(std::count(outputNames.begin(), outputNames.end(), "saliency_map"), 0);
+    EXPECT_EQ(std::count(outputNames.begin(), outputNames.end(), "feature_vector"), 0);
+    std::unique_ptr<ClassificationResult> result = model->infer(image);
+    EXPECT_FALSE(result->saliency_map);
+    EXPECT_FALSE(result->feature_vector);
+
+    // A wrapper over an adapter reads the option from the model_info the adapter was loaded with
+    ov::Core core;
+    std::shared_ptr<InferenceAdapter> adapter = std::make_shared<OpenVINOInferenceAdapter>();
+    adapter->loadModel(model->getModel(), core, "CPU");
+    auto restored = ClassificationModel::create_model(adapter);
+    outputNames = adapter->getOutputNames();
+    EXPECT_EQ(std::count(outputNames.begin(), outputNames.end(), "saliency_map"), 0);
+    EXPECT_EQ(std::count(outputNames.begin(), outputNames.end(), "feature_vector"), 0);
+    result = restored->infer(image);
+    EXPECT_FALSE(result->saliency_map);
+    EXPECT_FALSE(result->feature_vector);
+
+    auto full = ClassificationModel::create_model(TMP_MODEL_FILE, {}, true, "CPU");
+    result = full->infer(image);
+    EXPECT_TRUE(result->saliency_map);
+    EXPECT_TRUE(result->feature_vector);
+}
+
+TEST_F(RemoveXaiOutputsTest, RemovingXaiOutputsReducesLatency) {
+    ov::Core core;
+    OpenVINOInferenceAdapter pruned;
+    pruned.loadModel(make_model(true), core, "CPU");
+    OpenVINOInferenceAdapter full;
+    full.loadModel(make_model(false), core, "CPU");
+
+    double prunedLatency = median_latency_us(pruned, make_input());
+    double fullLatency = median_latency_us(full, make_input());
+    std::cout << "Median latency with XAI outputs: " << fullLatency << " us, without: " << prunedLatency << " us\n";
+    RecordProperty("latency_with_xai_us", std::to_string(fullLatency));
+    RecordProperty("latency_without_xai_us", std::to_string(prunedLatency));
+    EXPECT_LT(prunedLatency, fullLatency);
+}
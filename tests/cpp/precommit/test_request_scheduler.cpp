@@ -0,0 +1,146 @@
+#include <stddef.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <openvino/openvino.hpp>
+
+#include <adapters/request_scheduler.h>
+
+namespace {
+// Records the order of requests and blocks each of them until the test opens the gate
+class GatedAdapter : public InferenceAdapter {
+public:
+    InferenceOutput infer(const InferenceInput& input) override {
+        std::unique_lock<std::mutex> lock{mutex};
+        order.push_back(input.at("id").data<int>()[0]);
+        ++entered;
+        condition.notify_all();
+        condition.wait(lock, [this] { return open; });
+        return {{"output", input.at("id")}};
+    }
+
+    void loadModel(const std::shared_ptr<const ov::Model>&, ov::Core&, const std::string&, const ov::AnyMap&) override {}
+    ov::PartialShape getInputShape(const std::string&) const override {
+        return ov::PartialShape{1};
+    }
+    std::vector<std::string> getInputNames() const override {
+        return {"id"};
+    }
+    std::vector<std::string> getOutputNames() const override {
+        return {"output"};
+    }
+    const ov::AnyMap& getModelConfig() const override {
+        return config;
+    }
+
+    void waitEntered(size_t count) {
+        std::unique_lock<std::mutex> lock{mutex};
+        condition.wait(lock, [this, count] { return entered >= count; });
+    }
+
+    void release() {
+        std::lock_guard<std::mutex> lock{mutex};
+        open = true;
+        condition.notify_all();
+    }
+
+    std::vector<int> order;
+
+private:
+    std::mutex mutex;
+    std::condition_variable condition;
+    size_t entered = 0;
+    bool open = false;
+    ov::AnyMap config;
+};
+
+InferenceInput make_input(int id) {
+    ov::Tensor tensor(ov::element::i32, {1});
+    tensor.data<int>()[0] = id;
+    return {{"id", tensor}};
+}
+
+void wait_queued(const RequestScheduler& scheduler, size_t priorityClass, size_t depth) {
+    while (scheduler.getStatistics()[priorityClass].queueDepth < depth) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+}
+
+TEST(RequestScheduler, StartsHigherPriorityFirst) {
+    auto gated = std::make_shared<GatedAdapter>();
+    auto scheduler = std::make_shared<RequestScheduler>(gated, 1, std::vector<RequestScheduler::PriorityClass>(2));
+    std::shared_ptr<InferenceAdapter> live = scheduler->createAdapter(0);
+    std::shared_ptr<InferenceAdapter> bulk = scheduler->createAdapter(1);
+
+    auto running = std::async(std::launch::async, [&] { return bulk->infer(make_input(0)); });
+    gated->waitEntered(1);
+    auto bulkWaiting = std::async(std::launch::async, [&] { return bulk->infer(make_input(1)); });
+    wait_queued(*scheduler, 1, 1);
+    auto liveWaiting = std::async(std::launch::async, [&] { return live->infer(make_input(2)); });
+    wait_queued(*scheduler, 0, 1);
+    gated->release();
+    running.get();
+    bulkWaiting.get();
+    liveWaiting.get();
+    EXPECT_EQ(gated->order, std::vector<int>({0, 2, 1}));
+    EXPECT_EQ(scheduler->getStatistics()[0].completed, 1u);
+    EXPECT_EQ(scheduler->getStatistics()[1].completed, 2u);
+}
+
+TEST(RequestScheduler, StartsEarliestDeadlineFirst) {
+    auto gated = std::make_shared<GatedAdapter>();
+    auto scheduler = std::make_shared<RequestScheduler>(gated, 1, std::vector<RequestScheduler::PriorityClass>(1));
+    auto now = RequestScheduler::Clock::now();
+    auto running = std::async(std::launch::async, [&] { return scheduler->infer(make_input(0), 0, now + std::chrono::hours(1)); });
+    gated->waitEntered(1);
+    auto late = std::async(std::launch::async, [&] { return scheduler->infer(make_input(1), 0, now + std::chrono::hours(2)); });
+    wait_queued(*scheduler, 0, 1);
+    auto early = std::async(std::launch::async, [&] { return scheduler->infer(make_input(2), 0, now + std::chrono::hours(1)); });
+    wait_queued(*scheduler, 0, 2);
+    gated->release();
+    running.get();
+    late.get();
+    early.get();
+    EXPECT_EQ(gated->order, std::vector<int>({0, 2, 1}));
+}
+
+TEST(RequestScheduler, RejectsWhenQueueIsFull) {
+    auto gated = std::make_shared<GatedAdapter>();
+    RequestScheduler::PriorityClass bounded;
+    bounded.maxQueueDepth = 1;
+    auto scheduler = std::make_shared<RequestScheduler>(gated, 1, std::vector<RequestScheduler::PriorityClass>{bounded});
+    std::shared_ptr<InferenceAdapter> adapter = scheduler->createAdapter(0);
+    auto running = std::async(std::launch::async, [&] { return adapter->infer(make_input(0)); });
+    gated->waitEntered(1);
+    auto waiting = std::async(std::launch::async, [&] { return adapter->infer(make_input(1)); });
+    wait_queued(*scheduler, 0, 1);
+    EXPECT_THROW(adapter->infer(make_input(2)), QueueFullError);
+    gated->release();
+    running.get();
+    waiting.get();
+    EXPECT_EQ(scheduler->getStatistics()[0].rejected, 1u);
+}
+
+TEST(RequestScheduler, ShedsExpiredRequests) {
+    auto gated = std::make_shared<GatedAdapter>();
+    RequestScheduler::PriorityClass live;
+    live.deadline = std::chrono::milliseconds(20);
+    auto scheduler = std::make_shared<RequestScheduler>(gated, 1,
+        std::vector<RequestScheduler::PriorityClass>{live, RequestScheduler::PriorityClass{}});
+    auto running = std::async(std::launch::async, [&] { return scheduler->createAdapter(1)->infer(make_input(0)); });
+    gated->waitEntered(1);
+    EXPECT_THROW(scheduler->createAdapter(0)->infer(make_input(1)), DeadlineExceededError);
+    gated->release();
+    running.get();
+    EXPECT_EQ(scheduler->getStatistics()[0].shed, 1u);
+    EXPECT_EQ(gated->order, std::vector<int>({0}));
+}
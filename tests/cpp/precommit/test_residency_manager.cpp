@@ -0,0 +1,105 @@
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <openvino/openvino.hpp>
+
+#include <adapters/residency_manager.h>
+
+#include "synthetic_models.h"
+
+TEST(ResidencyManager, KeepsModelsWithinBudget) {
+    ov::Core core;
+    auto manager = std::make_shared<ResidencyManager>(size_t(1) << 40);
+    ResidentInferenceAdapter first{manager}, second{manager};
+    first.loadModel(make_double_model(), core, "CPU");
+    second.loadModel(make_double_model(), core, "CPU");
+    check_double_output(first.infer(make_double_input(1.0f)), 1.0f);
+    check_double_output(second.infer(make_double_input(2.0f)), 2.0f);
+    EXPECT_TRUE(first.isResident());
+    EXPECT_TRUE(second.isResident());
+    EXPECT_GT(first.getModelBytes(), 0u);
+    ResidencyManager::Statistics statistics = manager->getStatistics();
+    EXPECT_EQ(statistics.hits, 2u);
+    EXPECT_EQ(statistics.misses, 0u);
+    EXPECT_EQ(statistics.evictions, 0u);
+    EXPECT_EQ(statistics.residentModels, 2u);
+    EXPECT_EQ(statistics.residentBytes, first.getModelBytes() + second.getModelBytes());
+}
+
+TEST(ResidencyManager, ReloadsEvictedModel) {
+    ov::Core core;
+    // Only the most recently used model stays compiled
+    auto manager = std::make_shared<ResidencyManager>(1);
+    ResidentInferenceAdapter first{manager}, second{manager};
+    first.loadModel(make_double_model(), core, "CPU");
+    second.loadModel(make_double_model(), core, "CPU");
+    EXPECT_FALSE(first.isResident());
+    EXPECT_TRUE(second.isResident());
+    EXPECT_EQ(first.getInputShape("input"), ov::PartialShape({1, DOUBLE_SIZE}));
+    EXPECT_EQ(first.getModelConfig().at("model_type").as<std::string>(), "Classification");
+
+    check_double_output(first.infer(make_double_input(1.0f)), 1.0f);
+    EXPECT_TRUE(first.isResident());
+    EXPECT_FALSE(second.isResident());
+    check_double_output(first.infer(make_double_input(2.0f)), 2.0f);
+    ResidencyManager::Statistics statistics = manager->getStatistics();
+    EXPECT_EQ(statistics.hits, 1u);
+    EXPECT_EQ(statistics.misses, 1u);
+    EXPECT_EQ(statistics.evictions, 2u);
+    EXPECT_EQ(statistics.residentModels, 1u);
+    EXPECT_GT(statistics.maxLoadMs, 0.0);
+}
+
+TEST(ResidencyManager, ImportsEvictedModelFromCache) {
+    ov::Core core;
+    auto manager = std::make_shared<ResidencyManager>(size_t(1) << 40, ::testing::TempDir());
+    ResidentInferenceAdapter adapter{manager};
+    adapter.loadModel(make_double_model(), core, "CPU");
+    adapter.evict();
+    EXPECT_FALSE(adapter.isResident());
+    check_double_output(adapter.infer(make_double_input(3.0f)), 3.0f);
+    EXPECT_TRUE(adapter.isResident());
+    EXPECT_EQ(manager->getStatistics().misses, 1u);
+}
+
+TEST(ResidencyManager, ReusesOutputMapAcrossReloads) {
+    ov::Core core;
+    auto manager = std::make_shared<ResidencyManager>(size_t(1) << 40);
+    ResidentInferenceAdapter adapter{manager};
+    adapter.loadModel(make_double_model(), core, "CPU");
+    InferenceOutput output;
+    adapter.infer(make_double_input(1.0f), output);
+    const void* data = output.at("output").data();
+    adapter.evict();
+    adapter.infer(make_double_input(2.0f), output);
+    EXPECT_EQ(output.at("output").data(), data);
+    check_double_output(output, 2.0f);
+}
+
+TEST(ResidencyManager, ConcurrentRequestsShareFixedPool) {
+    ov::Core core;
+    auto manager = std::make_shared<ResidencyManager>(size_t(1) << 40);
+    ResidentInferenceAdapter adapter{manager};
+    adapter.loadModel(make_double_model(), core, "CPU", {ov::inference_num_threads(1)});
+    const size_t requests = adapter.getInferRequestCount();
+    EXPECT_GE(requests, 1u);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4 * requests + 4; ++t) {
+        threads.emplace_back([&adapter, t] {
+            for (size_t i = 0; i < 20; ++i) {
+                check_double_output(adapter.infer(make_double_input(float(t * 100 + i))), float(t * 100 + i));
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    // Callers waited for the requests created at load instead of creating their own
+    EXPECT_EQ(adapter.getInferRequestCount(), requests);
+    EXPECT_EQ(manager->getStatistics().misses, 0u);
+}
@@ -0,0 +1,194 @@
+#include <stddef.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <models/label_set.h>
+#include <models/result_serialization.h>
+#include <models/results.h>
+
+using namespace result_serialization;
+
+namespace {
+DetectionResult make_detection_result(const std::shared_ptr<const LabelSet>& labelSet) {
+    DetectionResult result{42};
+    result.labelSet = labelSet;
+    for (size_t i = 0; i < 3; ++i) {
+        DetectedObject obj;
+        obj.x = 1.5f * i;
+        obj.y = 2.0f;
+        obj.width = 10.0f;
+        obj.height = 20.0f + i;
+        obj.labelID = i % 2;
+        obj.label = (*labelSet)[obj.labelID];
+        obj.confidence = 0.25f * (i + 1);
+        result.objects.push_back(obj);
+    }
+    result.feature_vector = ov::Tensor(ov::element::f32, {1, 4});
+    float* features = result.feature_vector.data<float>();
+    for (size_t i = 0; i < 4; ++i) {
+        features[i] = 0.5f * i;
+    }
+    return result;
+}
+
+cv::Mat make_mask() {
+    cv::Mat mask = cv::Mat::zeros(32, 48, CV_8UC1);
+    mask(cv::Rect(4, 6, 20, 10)).setTo(1);
+    return mask;
+}
+}
+
+TEST(ResultSerialization, DetectionRoundTrip) {
+    auto labelSet = std::make_shared<const LabelSet>(std::vector<std::string>{"cat", "dog"});
+    DetectionResult result = make_detection_result(labelSet);
+    std::vector<uint8_t> buffer = serialize(result);
+
+    SerializedResultView view{buffer.data(), buffer.size()};
+    EXPECT_EQ(view.type(), ResultType::Detection);
+    EXPECT_EQ(view.version(), VERSION);
+    EXPECT_EQ(view.frameId(), 42);
+    ASSERT_EQ(view.objects().size, 3u);
+    EXPECT_EQ(view.label(view.objects()[1].label), "dog");
+    EXPECT_FALSE(view.has(SectionId::SaliencyMap));
+
+    // Tensors are mapped, not copied
+    ov::Tensor features = view.tensor(SectionId::FeatureVector);
+    EXPECT_GE(static_cast<const uint8_t*>(features.data()), buffer.data());
+    EXPECT_LT(static_cast<const uint8_t*>(features.data()), buffer.data() + buffer.size());
+    EXPECT_EQ(features.get_shape(), result.feature_vector.get_shape());
+
+    std::unique_ptr<ResultBase> decoded = view.toResult();
+    EXPECT_EQ(std::string{decoded->asRef<DetectionResult>()}, std::string{result});
+    buffer.assign(buffer.size(), 0);  // Decoded result owns its data
+    EXPECT_EQ(std::string{decoded->asRef<DetectionResult>()}, std::string{result});
+}
+
+TEST(ResultSerialization, ReusesBuffer) {
+    auto labelSet = std::make_shared<const LabelSet>(std::vector<std::string>{"cat", "dog"});
+    DetectionResult result = make_detection_result(labelSet);
+    std::vector<uint8_t> buffer;
+    serialize(result, buffer);
+    std::vector<uint8_t> first = buffer;
+    serialize(result, buffer);
+    EXPECT_EQ(buffer, first);
+}
+
+TEST(ResultSerialization, ClassificationRoundTrip) {
+    auto labelSet = std::make_shared<const LabelSet>(std::vector<std::string>{"tabby", "tiger"});
+    ClassificationResult result{7};
+    result.labelSet = labelSet;
+    result.topLabels.emplace_back(1, (*labelSet)[1], 0.75f);
+    result.topLabels.emplace_back(5, (*labelSet)[5], 0.125f);
+    result.raw_scores = ov::Tensor(ov::element::f32, {1, 6});
+    std::fill_n(result.raw_scores.data<float>(), 6, 0.5f);
+
+    std::vector<uint8_t> buffer = serialize(result);
+    std::unique_ptr<ResultBase> decoded = SerializedResultView{buffer.data(), buffer.size()}.toResult();
+    auto& classification = decoded->asRef<ClassificationResult>();
+    EXPECT_EQ(classification.frameId, 7);
+    EXPECT_EQ(classification.topLabels[1].label, "Label #5");
+    EXPECT_EQ(std::string{classification}, std::string{result});
+}
+
+TEST(ResultSerialization, MasksAreRunLengthEncoded) {
+    auto labelSet = std::make_shared<const LabelSet>(std::vector<std::string>{"person"});
+    InstanceSegmentationResult result;
+    result.labelSet = labelSet;
+    SegmentedObject obj;
+    obj.x = 4.0f;
+    obj.y = 6.0f;
+    obj.width = 20.0f;
+    obj.height = 10.0f;
+    obj.labelID = 0;
+    obj.label = (*labelSet)[0];
+    obj.confidence = 0.9f;
+    obj.mask = make_mask();
+    result.segmentedObjects.push_back(obj);
+
+    std::vector<uint8_t> buffer = serialize(result);
+    EXPECT_LT(buffer.size(), obj.mask.total());
+    SerializedResultView view{buffer.data(), buffer.size()};
+    EXPECT_EQ(view.rleRuns(SectionId::ObjectMask, 0).size, 21u);
+
+    std::unique_ptr<ResultBase> decoded = view.toResult();
+    const auto& segmentation = decoded->asRef<InstanceSegmentationResult>();
+    ASSERT_EQ(segmentation.segmentedObjects.size(), 1u);
+    EXPECT_EQ(segmentation.segmentedObjects[0].label, "person");
+    EXPECT_EQ(cv::countNonZero(segmentation.segmentedObjects[0].mask != obj.mask), 0);
+}
+
+TEST(ResultSerialization, AnomalyRoundTrip) {
+    AnomalyResult result;
+    result.anomaly_map = cv::Mat(8, 8, CV_32FC1, cv::Scalar(0.25f));
+    result.pred_mask = make_mask();
+    result.pred_boxes = {cv::Rect(4, 6, 20, 10)};
+    result.pred_label = "Anomalous";
+    result.pred_score = 0.75;
+
+    std::vector<uint8_t> buffer = serialize(result);
+    SerializedResultView view{buffer.data(), buffer.size()};
+    EXPECT_EQ(view.predLabel(), "Anomalous");
+    // Raw matrices are mapped
+    EXPECT_GE(view.mat(SectionId::AnomalyMap).data, buffer.data());
+
+    std::unique_ptr<ResultBase> decoded = view.toResult();
+    auto& anomaly = decoded->asRef<AnomalyResult>();
+    EXPECT_EQ(std::string{anomaly}, std::string{result});
+    EXPECT_EQ(anomaly.pred_boxes, result.pred_boxes);
+}
+
+TEST(ResultSerialization, HumanPoseRoundTrip) {
+    HumanPoseResult result;
+    result.poses.push_back({{cv::Point2f(1, 2), cv::Point2f(3, 4)}, 0.5f});
+    result.poses.push_back({{cv::Point2f(5, 6)}, 0.25f});
+
+    std::vector<uint8_t> buffer = serialize(result);
+    std::unique_ptr<ResultBase> decoded = SerializedResultView{buffer.data(), buffer.size()}.toResult();
+    const auto& poses = decoded->asRef<HumanPoseResult>().poses;
+    ASSERT_EQ(poses.size(), 2u);
+    EXPECT_EQ(poses[0].keypoints, result.poses[0].keypoints);
+    EXPECT_EQ(poses[1].keypoints, result.poses[1].keypoints);
+    EXPECT_EQ(poses[1].score, 0.25f);
+}
+
+TEST(ResultSerialization, RejectsCorruptedBuffer) {
+    std::vector<uint8_t> buffer = serialize(ImageResult{});
+    std::vector<uint8_t> truncated(buffer.begin(), buffer.begin() + 16);
+    EXPECT_ANY_THROW((SerializedResultView{truncated.data(), truncated.size()}));
+    buffer[0] ^= 0xff;
+    EXPECT_ANY_THROW((SerializedResultView{buffer.data(), buffer.size()}));
+}
+
+TEST(ResultSerialization, RejectsOverflowingDimensions) {
+    auto labelSet = std::make_shared<const LabelSet>(std::vector<std::string>{"cat", "dog"});
+    std::vector<uint8_t> buffer = serialize(make_detection_result(labelSet));
+    SerializedResultView view{buffer.data(), buffer.size()};
+    auto* tensorHeader = reinterpret_cast<TensorHeader*>(
+        static_cast<uint8_t*>(view.tensor(SectionId::FeatureVector).data()) - sizeof(TensorHeader));
+    // 2^62 * 4 elements of 4 bytes wrap around to 0 bytes
+    tensorHeader->shape[0] = uint64_t{1} << 62;
+    EXPECT_ANY_THROW(view.tensor(SectionId::FeatureVector));
+
+    AnomalyResult anomaly;
+    anomaly.anomaly_map = cv::Mat(8, 8, CV_32FC1, cv::Scalar(0.25f));
+    buffer = serialize(anomaly);
+    SerializedResultView anomalyView{buffer.data(), buffer.size()};
+    auto* matHeader = reinterpret_cast<MatHeader*>(anomalyView.mat(SectionId::AnomalyMap).data - sizeof(MatHeader));
+    // 2^30 * 2^30 elements of 2^12 bytes wrap around to 0 bytes
+    matHeader->rows = 1 << 30;
+    matHeader->cols = 1 << 30;
+    matHeader->type = CV_64FC(512);
+    EXPECT_ANY_THROW(anomalyView.mat(SectionId::AnomalyMap));
+    matHeader->rows = 8;
+    matHeader->cols = 8;
+    matHeader->type = -1;
+    EXPECT_ANY_THROW(anomalyView.mat(SectionId::AnomalyMap));
+}
@@ -93,6 +93,39 @@ TEST_P(ModelParameterizedTest, SynchronousInference)
     }
 }
 
+TEST_P(ModelParameterizedTest, ReducedPrecisionSegmentationOutput)
+{
+    if ("SegmentationModel" != GetParam().type) {
+        GTEST_SKIP();
+    }
+    cv::Mat image = cv::imread(DATA_DIR + "/" + IMAGE_PATH);
+    if (!image.data) {
+        throw std::runtime_error{"Failed to read the image"};
+    }
+
+    std::string model_path;
+    const std::string& name = GetParam().name;
+    if (name.substr(name.size() - 4) == ".xml") {
+        model_path = name;
+    } else {
+        model_path = string_format(MODEL_PATH_TEMPLATE, name.c_str(), name.c_str());
+    }
+
+    auto reference = SegmentationModel::create_model(DATA_DIR + "/" + model_path, {}, true, "CPU")->infer(image);
+    for (const std::string& precision : {"f16", "u8"}) {
+        SCOPED_TRACE(precision);
+        auto model = SegmentationModel::create_model(DATA_DIR + "/" + model_path, {{"output_precision", precision}}, true, "CPU");
+        auto result = model->infer(image);
+        ASSERT_EQ(result->resultImage.size(), reference->resultImage.size());
+        size_t mismatched = cv::countNonZero(result->resultImage != reference->resultImage);
+        EXPECT_LT(mismatched, reference->resultImage.total() / 100);
+        auto soft = dynamic_cast<ImageResultWithSoftPrediction*>(result.get());
+        if (soft) {
+            EXPECT_EQ(soft->soft_prediction.depth(), CV_32F);
+        }
+    }
+}
+
 INSTANTIATE_TEST_SUITE_P(TestSanityPublic, ModelParameterizedTest, testing::ValuesIn(GetTestData(PUBLIC_SCOPE_PATH)));
 
 class InputParser{
@@ -0,0 +1,94 @@
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <openvino/openvino.hpp>
+
+#include <adapters/sharded_adapter.h>
+
+#include "synthetic_models.h"
+
+namespace {
+std::vector<ShardedInferenceAdapter::Shard> make_shards() {
+    return {{"", {ov::inference_num_threads(1)}}, {"", {ov::inference_num_threads(1)}}};
+}
+}
+
+TEST(ShardedAdapter, LooksLikeOneModel) {
+    ov::Core core;
+    ShardedInferenceAdapter adapter{make_shards()};
+    adapter.loadModel(make_double_model(), core, "CPU");
+    EXPECT_EQ(adapter.getInputNames(), std::vector<std::string>{"input"});
+    EXPECT_EQ(adapter.getOutputNames(), std::vector<std::string>{"output"});
+    EXPECT_EQ(adapter.getInputShape("input"), ov::PartialShape({1, DOUBLE_SIZE}));
+    EXPECT_EQ(adapter.getModelConfig().at("model_type").as<std::string>(), "Classification");
+    EXPECT_EQ(adapter.getShardStatistics().size(), 2u);
+}
+
+TEST(ShardedAdapter, OutputsOutliveNextRequest) {
+    ov::Core core;
+    ShardedInferenceAdapter adapter{make_shards()};
+    adapter.loadModel(make_double_model(), core, "CPU");
+    InferenceOutput first = adapter.infer(make_double_input(1.0f));
+    InferenceOutput second = adapter.infer(make_double_input(2.0f));
+    check_double_output(first, 1.0f);
+    check_double_output(second, 2.0f);
+    // Idle shards are equally loaded, the first one is taken
+    std::vector<ShardedInferenceAdapter::ShardStatistics> statistics = adapter.getShardStatistics();
+    EXPECT_EQ(statistics[0].completed, 2u);
+    EXPECT_EQ(statistics[1].completed, 0u);
+}
+
+TEST(ShardedAdapter, ReusesOutputMap) {
+    ov::Core core;
+    ShardedInferenceAdapter adapter{make_shards()};
+    adapter.loadModel(make_double_model(), core, "CPU");
+    InferenceOutput output;
+    adapter.infer(make_double_input(1.0f), output);
+    const void* data = output.at("output").data();
+    adapter.infer(make_double_input(2.0f), output);
+    EXPECT_EQ(output.at("output").data(), data);
+    check_double_output(output, 2.0f);
+}
+
+TEST(ShardedAdapter, ConcurrentRequests) {
+    ov::Core core;
+    ShardedInferenceAdapter adapter{make_shards()};
+    adapter.loadModel(make_double_model(), core, "CPU");
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 8; ++t) {
+        threads.emplace_back([&adapter, t] {
+            for (size_t i = 0; i < 50; ++i) {
+                check_double_output(adapter.infer(make_double_input(float(t * 100 + i))), float(t * 100 + i));
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    size_t completed = 0;
+    for (const ShardedInferenceAdapter::ShardStatistics& shard : adapter.getShardStatistics()) {
+        EXPECT_EQ(shard.outstanding, 0u);
+        EXPECT_GE(shard.utilization, 0.0);
+        EXPECT_LE(shard.utilization, 1.0);
+        completed += shard.completed;
+    }
+    EXPECT_EQ(completed, 8u * 50u);
+}
+
+TEST(ShardedAdapter, WarmupKeepsPreviousOutputs) {
+    ov::Core core;
+    ShardedInferenceAdapter adapter{make_shards()};
+    adapter.loadModel(make_double_model(), core, "CPU");
+    InferenceOutput output = adapter.infer(make_double_input(1.0f));
+    adapter.warmup(make_double_input(100.0f));
+    check_double_output(output, 1.0f);
+    for (const ShardedInferenceAdapter::ShardStatistics& statistics : adapter.getShardStatistics()) {
+        EXPECT_EQ(statistics.outstanding, 0u);
+    }
+    EXPECT_EQ(adapter.getShardStatistics()[0].completed + adapter.getShardStatistics()[1].completed, 1u);
+}
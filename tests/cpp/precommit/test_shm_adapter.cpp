@@ -0,0 +1,220 @@
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <openvino/openvino.hpp>
+
+#include <adapters/shm_adapter.h>
+
+#include "synthetic_models.h"
+
+namespace {
+class ShmServer {
+public:
+    ShmServer() : socketPath("/tmp/model_api_test_" + std::to_string(getpid()) + ".sock"), server(socketPath) {
+        ov::Core core;
+        std::shared_ptr<ov::Model> model = make_double_model();
+        model->set_rt_info("cat dog", "model_info", "labels");
+        server.addModel("double", model, core);
+        thread = std::thread([this] { server.run(); });
+    }
+
+    ~ShmServer() {
+        server.stop();
+        thread.join();
+    }
+
+    const std::string socketPath;
+
+private:
+    ShmInferenceServer server;
+    std::thread thread;
+};
+
+// The layout of the channel header in shm_adapter.cpp, the raw clients below write it directly
+struct RawRing {
+    std::atomic<uint64_t> head;
+    std::atomic<uint64_t> tail;
+    uint32_t entries[64];
+};
+
+struct RawChannel {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slotCount;
+    uint32_t reserved;
+    uint64_t slotSize;
+    RawRing submissions;
+    RawRing completions;
+};
+
+int connectRaw(const std::string& socketPath) {
+    int client = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+    EXPECT_EQ(connect(client, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    return client;
+}
+
+// Sends the hello with a memfd and two eventfds, returns the reply of the server
+std::string handshake(int client, const int (&fds)[3], size_t slotCount, size_t slotSize) {
+    std::string hello = R"({"model":"double","slot_count":)" + std::to_string(slotCount) + R"(,"slot_size":)"
+        + std::to_string(slotSize) + "}";
+    uint32_t length = static_cast<uint32_t>(hello.size());
+    iovec iov{&length, sizeof(length)};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(fds))];
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+    std::memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+    EXPECT_EQ(sendmsg(client, &msg, MSG_NOSIGNAL), static_cast<ssize_t>(sizeof(length)));
+    EXPECT_EQ(send(client, hello.data(), hello.size(), MSG_NOSIGNAL), static_cast<ssize_t>(hello.size()));
+
+    if (recv(client, &length, sizeof(length), MSG_WAITALL) != static_cast<ssize_t>(sizeof(length))) {
+        return {};
+    }
+    std::string reply(length, '\0');
+    EXPECT_EQ(recv(client, &reply[0], length, MSG_WAITALL), static_cast<ssize_t>(length));
+    return reply;
+}
+}
+
+TEST(ShmAdapter, ReadsMetadata) {
+    ShmServer server;
+    ShmInferenceAdapter adapter{server.socketPath, "double"};
+    EXPECT_EQ(adapter.getInputNames(), std::vector<std::string>{"input"});
+    EXPECT_EQ(adapter.getOutputNames(), std::vector<std::string>{"output"});
+    EXPECT_EQ(adapter.getInputShape("input"), ov::PartialShape({1, DOUBLE_SIZE}));
+    EXPECT_EQ(adapter.getModelConfig().at("model_type").as<std::string>(), "Classification");
+    EXPECT_EQ(adapter.getModelConfig().at("labels").as<std::string>(), "cat dog");
+}
+
+TEST(ShmAdapter, SocketIsPrivate) {
+    ShmServer server;
+    struct stat socketStat;
+    ASSERT_EQ(stat(server.socketPath.c_str(), &socketStat), 0);
+    EXPECT_EQ(socketStat.st_mode & 0777, 0600u);
+}
+
+TEST(ShmAdapter, UnknownModelThrows) {
+    ShmServer server;
+    EXPECT_THROW(ShmInferenceAdapter(server.socketPath, "missing"), std::runtime_error);
+}
+
+TEST(ShmAdapter, RejectsResizableMemory) {
+    ShmServer server;
+    int client = connectRaw(server.socketPath);
+    // A client which could shrink the memory later and crash the server with SIGBUS
+    const size_t slotSize = 64 * 1024;
+    int fds[] = {memfd_create("unsealed", MFD_CLOEXEC), eventfd(0, EFD_CLOEXEC), eventfd(0, EFD_CLOEXEC)};
+    ASSERT_EQ(ftruncate(fds[0], static_cast<off_t>(4096 + slotSize)), 0);
+
+    std::string reply = handshake(client, fds, 1, slotSize);
+    EXPECT_NE(reply.find("sealed"), std::string::npos) << reply;
+    for (int fd : fds) {
+        close(fd);
+    }
+    close(client);
+}
+
+TEST(ShmAdapter, Infers) {
+    ShmServer server;
+    ShmInferenceAdapter adapter{server.socketPath, "double"};
+    for (size_t i = 0; i < 10; ++i) {
+        check_double_output(adapter.infer(make_double_input(float(i))), float(i));
+    }
+}
+
+TEST(ShmAdapter, ConcurrentClients) {
+    ShmServer server;
+    ShmInferenceAdapter first{server.socketPath, "double"};
+    ShmInferenceAdapter second{server.socketPath, "double", 2};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 8; ++t) {
+        ShmInferenceAdapter& adapter = t % 2 ? first : second;
+        threads.emplace_back([&adapter, t] {
+            for (size_t i = 0; i < 20; ++i) {
+                check_double_output(adapter.infer(make_double_input(float(t * 100 + i))), float(t * 100 + i));
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+TEST(ShmAdapter, OutputsHoldSlot) {
+    ShmServer server;
+    ShmInferenceAdapter adapter{server.socketPath, "double", 1};
+    InferenceOutput held = adapter.infer(make_double_input(1.0f));
+    std::future<InferenceOutput> next = std::async(std::launch::async, [&adapter] {
+        return adapter.infer(make_double_input(2.0f));
+    });
+    EXPECT_EQ(next.wait_for(std::chrono::milliseconds(100)), std::future_status::timeout);
+    check_double_output(held, 1.0f);
+    held.clear();
+    check_double_output(next.get(), 2.0f);
+}
+
+TEST(ShmAdapter, BoundsSubmissionsOfHostileClient) {
+    auto server = std::make_unique<ShmServer>();
+    int client = connectRaw(server->socketPath);
+    const size_t slotSize = 64 * 1024;
+    const size_t size = 4096 + slotSize;
+    int fds[] = {memfd_create("hostile", MFD_CLOEXEC | MFD_ALLOW_SEALING), eventfd(0, EFD_CLOEXEC),
+                 eventfd(0, EFD_CLOEXEC)};
+    ASSERT_EQ(ftruncate(fds[0], static_cast<off_t>(size)), 0);
+    ASSERT_EQ(fcntl(fds[0], F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW), 0);
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fds[0], 0);
+    ASSERT_NE(mapping, MAP_FAILED);
+    RawChannel* channel = static_cast<RawChannel*>(mapping);
+    channel->magic = 0x4d48534d;
+    channel->version = 1;
+    channel->slotCount = 1;
+    channel->slotSize = slotSize;
+    // The tail claims far more entries than there are slots, all of them slot 0. Its zeroed header fails at once, so
+    // without a bound the server would keep failing and publishing it
+    channel->submissions.tail = UINT64_MAX;
+    EXPECT_NE(handshake(client, fds, 1, slotSize).find("inputs"), std::string::npos);
+
+    uint64_t one = 1;
+    ASSERT_EQ(write(fds[1], &one, sizeof(one)), static_cast<ssize_t>(sizeof(one)));
+    uint64_t count;
+    ASSERT_EQ(read(fds[2], &count, sizeof(count)), static_cast<ssize_t>(sizeof(count)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    // A wakeup takes at most slot count entries
+    EXPECT_EQ(channel->completions.tail.load(), 1u);
+
+    auto start = std::chrono::steady_clock::now();
+    server.reset();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+    munmap(mapping, size);
+    for (int fd : fds) {
+        close(fd);
+    }
+    close(client);
+}
@@ -0,0 +1,168 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <opencv2/core.hpp>
+#include <openvino/openvino.hpp>
+
+#include <models/image_model.h>
+#include <models/results.h>
+#include <pipelines/video_pipeline.h>
+
+namespace {
+// Stands for a compiled model with embedded preprocessing, sleeps for the inference time
+class SleepingAdapter : public InferenceAdapter {
+public:
+    explicit SleepingAdapter(std::chrono::milliseconds delay, bool fails = false) : delay(delay), fails(fails) {}
+
+    InferenceOutput infer(const InferenceInput&) override {
+        std::this_thread::sleep_for(delay);
+        if (fails) {
+            throw std::runtime_error("inference failed");
+        }
+        return {{"output", ov::Tensor(ov::element::f32, {1})}};
+    }
+
+    void loadModel(const std::shared_ptr<const ov::Model>&, ov::Core&, const std::string&, const ov::AnyMap&) override {}
+    ov::PartialShape getInputShape(const std::string&) const override {
+        return ov::PartialShape{1, 8, 8, 3};
+    }
+    std::vector<std::string> getInputNames() const override {
+        return {"image"};
+    }
+    std::vector<std::string> getOutputNames() const override {
+        return {"output"};
+    }
+    const ov::AnyMap& getModelConfig() const override {
+        return config;
+    }
+
+private:
+    std::chrono::milliseconds delay;
+    bool fails;
+    ov::AnyMap config{{"embedded_processing", true}};
+};
+
+class EmptyResultModel : public ImageModel {
+public:
+    using ImageModel::ImageModel;
+
+    std::unique_ptr<ResultBase> postprocess(InferenceResult&) override {
+        return std::make_unique<ResultBase>();
+    }
+
+protected:
+    void prepareInputsOutputs(std::shared_ptr<ov::Model>&) override {}
+};
+
+VideoPipeline::FrameSource make_source(int64_t frames) {
+    auto next = std::make_shared<int64_t>(0);
+    return [next, frames](cv::Mat& frame) {
+        if (*next == frames) {
+            return false;
+        }
+        frame = cv::Mat(8, 8, CV_8UC3, cv::Scalar::all(static_cast<double>(*next % 256)));
+        ++*next;
+        return true;
+    };
+}
+
+// Frame ids delivered per stream
+struct Delivered {
+    std::mutex mutex;
+    std::map<size_t, std::vector<int64_t>> frameIds;
+
+    VideoPipeline::ResultCallback callback() {
+        return [this](size_t stream, const cv::Mat&, std::unique_ptr<ResultBase> result) {
+            std::lock_guard<std::mutex> lock{mutex};
+            frameIds[stream].push_back(result->frameId);
+        };
+    }
+};
+
+std::vector<VideoPipeline::StreamStatistics> run(std::chrono::milliseconds delay, std::vector<VideoPipeline::Stream> streams,
+                                                 Delivered& delivered) {
+    std::shared_ptr<InferenceAdapter> adapter = std::make_shared<SleepingAdapter>(delay);
+    EmptyResultModel model{adapter};
+    VideoPipeline pipeline{model, std::move(streams), delivered.callback()};
+    pipeline.start();
+    pipeline.wait();
+    return pipeline.getStatistics();
+}
+}
+
+TEST(VideoPipeline, DeliversEveryFrameInOrder) {
+    Delivered delivered;
+    VideoPipeline::Stream stream;
+    stream.dropPolicy = VideoPipeline::DropPolicy::KEEP_EVERY_K;
+    std::vector<VideoPipeline::Stream> streams{stream, stream};
+    streams[0].source = make_source(20);
+    streams[1].source = make_source(30);
+    std::vector<VideoPipeline::StreamStatistics> statistics = run(std::chrono::milliseconds(0), streams, delivered);
+    ASSERT_EQ(statistics.size(), 2u);
+    EXPECT_EQ(statistics[0].completed, 20u);
+    EXPECT_EQ(statistics[1].completed, 30u);
+    EXPECT_EQ(statistics[0].dropped + statistics[1].dropped, 0u);
+    EXPECT_GT(statistics[0].fps, 0.0);
+    EXPECT_GE(statistics[1].maxLatencyMs, statistics[1].meanLatencyMs);
+    for (int64_t i = 0; i < 30; ++i) {
+        EXPECT_EQ(delivered.frameIds[1][i], i);
+    }
+}
+
+TEST(VideoPipeline, KeepsEveryKthFrame) {
+    Delivered delivered;
+    VideoPipeline::Stream stream;
+    stream.source = make_source(10);
+    stream.dropPolicy = VideoPipeline::DropPolicy::KEEP_EVERY_K;
+    stream.keepEvery = 3;
+    std::vector<VideoPipeline::StreamStatistics> statistics = run(std::chrono::milliseconds(0), {stream}, delivered);
+    EXPECT_EQ(statistics[0].decoded, 10u);
+    EXPECT_EQ(statistics[0].dropped, 6u);
+    EXPECT_EQ(delivered.frameIds[0], std::vector<int64_t>({0, 3, 6, 9}));
+}
+
+TEST(VideoPipeline, DropsNewestUnderOverload) {
+    Delivered delivered;
+    VideoPipeline::Stream stream;
+    stream.source = make_source(100);
+    stream.dropPolicy = VideoPipeline::DropPolicy::DROP_NEWEST;
+    stream.queueCapacity = 1;
+    std::vector<VideoPipeline::StreamStatistics> statistics = run(std::chrono::milliseconds(5), {stream}, delivered);
+    EXPECT_EQ(statistics[0].decoded, 100u);
+    EXPECT_GT(statistics[0].dropped, 0u);
+    EXPECT_EQ(statistics[0].completed + statistics[0].dropped, 100u);
+    EXPECT_EQ(delivered.frameIds[0].front(), 0);
+}
+
+TEST(VideoPipeline, DropsOldestUnderOverload) {
+    Delivered delivered;
+    VideoPipeline::Stream stream;
+    stream.source = make_source(100);
+    stream.dropPolicy = VideoPipeline::DropPolicy::DROP_OLDEST;
+    stream.queueCapacity = 1;
+    std::vector<VideoPipeline::StreamStatistics> statistics = run(std::chrono::milliseconds(5), {stream}, delivered);
+    EXPECT_GT(statistics[0].dropped, 0u);
+    EXPECT_EQ(statistics[0].completed + statistics[0].dropped, 100u);
+    // The latest frame is never replaced
+    EXPECT_EQ(delivered.frameIds[0].back(), 99);
+}
+
+TEST(VideoPipeline, RethrowsStageError) {
+    std::shared_ptr<InferenceAdapter> adapter = std::make_shared<SleepingAdapter>(std::chrono::milliseconds(0), true);
+    EmptyResultModel model{adapter};
+    VideoPipeline::Stream stream;
+    stream.source = make_source(10);
+    VideoPipeline pipeline{model, {stream}, [](size_t, const cv::Mat&, std::unique_ptr<ResultBase>) {}};
+    pipeline.start();
+    EXPECT_THROW(pipeline.wait(), std::runtime_error);
+}
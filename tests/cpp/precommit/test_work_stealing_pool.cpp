@@ -0,0 +1,78 @@
+#include <stddef.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <opencv2/core.hpp>
+
+#include <utils/work_stealing_pool.hpp>
+
+TEST(WorkStealingPool, RunsEveryIndexOnce) {
+    WorkStealingPool pool{4};
+    std::vector<std::atomic<int>> visits(1000);
+    pool.parallelFor(visits.size(), [&](size_t i) { ++visits[i]; }, 7);
+    for (const std::atomic<int>& count : visits) {
+        ASSERT_EQ(count, 1);
+    }
+}
+
+TEST(WorkStealingPool, NestedCallsFromTasks) {
+    WorkStealingPool pool{2};
+    std::atomic<size_t> sum{0};
+    pool.parallelFor(16, [&](size_t) {
+        pool.parallelFor(100, [&](size_t j) { sum += j; });
+    });
+    EXPECT_EQ(sum, 16u * 4950u);
+}
+
+TEST(WorkStealingPool, IdleWorkersStealFromBusyOne) {
+    WorkStealingPool pool{2};
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    // Occupies one worker, the other one and the caller take all chunks
+    std::future<void> blocked = pool.submit([released] { released.wait(); });
+    std::atomic<size_t> done{0};
+    pool.parallelFor(64, [&](size_t) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        ++done;
+    });
+    EXPECT_EQ(done, 64u);
+    release.set_value();
+    blocked.get();
+}
+
+TEST(WorkStealingPool, RethrowsTaskError) {
+    WorkStealingPool pool{2};
+    EXPECT_THROW(pool.parallelFor(10, [](size_t i) {
+        if (5 == i) {
+            throw std::runtime_error("task failed");
+        }
+    }), std::runtime_error);
+    EXPECT_THROW(pool.submit([] { throw std::runtime_error("task failed"); }).get(), std::runtime_error);
+}
+
+TEST(WorkStealingPool, ReportsThreadIndex) {
+    WorkStealingPool pool{3};
+    EXPECT_EQ(pool.getThreadIndex(), 0u);
+    size_t index = 0;
+    pool.submit([&] { index = pool.getThreadIndex(); }).get();
+    EXPECT_GE(index, 1u);
+    EXPECT_LE(index, 3u);
+}
+
+TEST(WorkStealingPool, GlobalPoolIsSharedWithOpenCV) {
+    WorkStealingPool& pool = WorkStealingPool::global();
+    std::vector<std::atomic<int>> visits(100);
+    WorkStealingPool::parallelForShared(visits.size(), [&](size_t i) { ++visits[i]; });
+    for (const std::atomic<int>& count : visits) {
+        ASSERT_EQ(count, 1);
+    }
+    if (!pool.isSharedWithOpenCV()) {
+        GTEST_SKIP() << "OpenCV has no parallel backend API";
+    }
+    EXPECT_EQ(cv::getNumThreads(), int(pool.getThreadCount()) + 1);
+}
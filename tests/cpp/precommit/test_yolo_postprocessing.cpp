@@ -0,0 +1,53 @@
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <openvino/openvino.hpp>
+
+#include <models/detection_model_yolo.h>
+#include <models/internal_model_data.h>
+#include <models/results.h>
+
+#include "synthetic_models.h"
+
+namespace {
+constexpr size_t CLASSES = 2;
+constexpr size_t PROPOSALS = 4;
+
+// PROPOSALS separate 1x1 boxes of class 0 laid out as [1, 4 + CLASSES, PROPOSALS]
+ov::Tensor make_detections() {
+    ov::Tensor tensor(ov::element::f32, {1, 4 + CLASSES, PROPOSALS});
+    float* data = tensor.data<float>();
+    for (size_t i = 0; i < PROPOSALS; ++i) {
+        data[0 * PROPOSALS + i] = 1.0f + 2.0f * i;  // x center
+        data[1 * PROPOSALS + i] = 4.0f;  // y center
+        data[2 * PROPOSALS + i] = 1.0f;  // width
+        data[3 * PROPOSALS + i] = 1.0f;  // height
+        data[4 * PROPOSALS + i] = 0.9f;
+        data[5 * PROPOSALS + i] = 0.0f;
+    }
+    return tensor;
+}
+}
+
+TEST(YoloPostprocessing, RereadsOutputShapeOfTheSameSize) {
+    std::shared_ptr<ov::Model> ovModel = make_yolo_model(CLASSES, PROPOSALS);
+    YOLOv5 model{ovModel, {}};
+    model.prepare();
+
+    InferenceResult infResult;
+    infResult.internalModelData = std::make_shared<InternalImageModelData>(8, 8);
+    ov::Tensor detections = make_detections();
+    infResult.outputsData = {{"output", detections}};
+    DetectionResult result;
+    model.postprocessInto(infResult, result);
+    EXPECT_EQ(result.objects.size(), PROPOSALS);
+
+    // The same data read as 4 + CLASSES proposals without classes has no detections. A cached shape of the
+    // previous frame would find them again
+    infResult.outputsData = {{"output", ov::Tensor(ov::element::f32, {1, PROPOSALS, 4 + CLASSES}, detections.data())}};
+    model.postprocessInto(infResult, result);
+    EXPECT_TRUE(result.objects.empty());
+}
@@ -0,0 +1,74 @@
+from concurrent.futures import ThreadPoolExecutor
+
+import cv2
+import numpy as np
+import pytest
+
+# Built from model_api/cpp/py_bindings, the tests are skipped if the module isn't on PYTHONPATH
+py_model_api = pytest.importorskip("py_model_api")
+
+IMAGE = "data/BloodImage_00007.jpg"
+
+
+def test_classification():
+    model = py_model_api.ClassificationModel.create_model(
+        "data/otx_models/tinynet_imagenet.xml", device="CPU"
+    )
+    result = model(cv2.imread(IMAGE))
+    assert isinstance(result, py_model_api.ClassificationResult)
+    idx, label, score = result.top_labels[0]
+    assert isinstance(idx, int) and isinstance(label, str) and 0 <= score <= 1
+
+
+def test_classification_cropped_image():
+    # The model embeds its preprocessing, it wraps the image into a tensor instead of resizing it
+    model = py_model_api.ClassificationModel.create_model(
+        "data/otx_models/tinynet_imagenet.xml", device="CPU"
+    )
+    image = cv2.imread(IMAGE)[:, 10:200]
+    assert str(model(image)) == str(model(np.ascontiguousarray(image)))
+
+
+def test_detection_unpacked_image():
+    model = py_model_api.DetectionModel.create_model(
+        "data/public/ssd300/FP16/ssd300.xml", device="CPU"
+    )
+    image = cv2.imread(IMAGE)[:, ::2]
+    assert str(model(image)) == str(model(np.ascontiguousarray(image)))
+
+
+def test_detection_threads():
+    model = py_model_api.DetectionModel.create_model(
+        "data/public/ssd300/FP16/ssd300.xml", device="CPU"
+    )
+    image = cv2.imread(IMAGE)
+    expected = str(model(image))
+    with ThreadPoolExecutor(4) as executor:
+        results = list(executor.map(lambda _: str(model(image)), range(16)))
+    assert results == [expected] * 16
+
+
+def test_segmentation_views_outlive_result():
+    model = py_model_api.SegmentationModel.create_model(
+        "data/public/hrnet-v2-c1-segmentation/FP16/hrnet-v2-c1-segmentation.xml",
+        configuration={"return_soft_prediction": True},
+        device="CPU",
+    )
+    image = cv2.imread(IMAGE)
+    result = model(image)
+    soft_prediction = result.soft_prediction
+    assert soft_prediction.base is not None
+    expected = soft_prediction.copy()
+    del result
+    model(image)
+    assert np.array_equal(soft_prediction, expected)
+
+
+def test_wrong_image():
+    model = py_model_api.DetectionModel.create_model(
+        "data/public/ssd300/FP16/ssd300.xml", device="CPU"
+    )
+    with pytest.raises(TypeError):
+        model(np.zeros((8, 8, 3), np.float32))
+    with pytest.raises(ValueError):
+        model(np.zeros((8, 8), np.uint8))